@@ -23,12 +23,11 @@
 
 #include "alg/ContextALG.hh"
 #include "bo/ContextBO.hh"
-#include "bo/MachineBO.hh"
-#include "bo/NeighborhoodBO.hh"
-#include "bo/ProcessBO.hh"
+#include "bo/InstanceCoreBO.hh"
 #include "bo/ServiceBO.hh"
 #include "dtoout/SolutionDtoout.hh"
 #include "tools/Checker.hh"
+#include "tools/FusedChecker.hh"
 #include <algorithm>
 #include <cassert>
 #include <boost/foreach.hpp>
@@ -37,9 +36,24 @@ using namespace std;
 
 ContextALG::ContextALG(ContextBO const * pContextBO_p, bool mustWriteBestSol_p, bool solInitToCheck_p) :
     pContextBO_m(pContextBO_p),
-    currentSol_m(pContextBO_p->getSolInit()),
-    mustWriteBestSol_m(mustWriteBestSol_p)
-{}
+    pCore_m(pContextBO_p->getInstanceCore()),
+    currentSol_m(pCore_m->getSolInit()),
+    mustWriteBestSol_m(mustWriteBestSol_p),
+    pFusedChecker_m(pContextBO_p->getFusedChecker())
+{
+    buildRessUsed();
+}
+
+ContextALG::ContextALG(ContextBO const * pContextBO_p, const vector<int>& curSol_p, bool mustWriteBestSol_p) :
+    pContextBO_m(pContextBO_p),
+    pCore_m(pContextBO_p->getInstanceCore()),
+    currentSol_m(curSol_p),
+    mustWriteBestSol_m(mustWriteBestSol_p),
+    pFusedChecker_m(pContextBO_p->getFusedChecker())
+{
+    assert((int) curSol_p.size() == pCore_m->getNbProcesses());
+    buildRessUsed();
+}
 
 void ContextALG::setMustWriteBestSol(bool mustWriteBestSol_p){
     mustWriteBestSol_m = mustWriteBestSol_p;
@@ -49,6 +63,10 @@ ContextBO const * ContextALG::getContextBO() const {
     return pContextBO_m;
 }
 
+boost::shared_ptr<InstanceCoreBO const> ContextALG::getInstanceCore() const {
+    return pCore_m;
+}
+
 const vector<int>& ContextALG::getCurrentSol() const {
     return currentSol_m;
 }
@@ -56,6 +74,57 @@ const vector<int>& ContextALG::getCurrentSol() const {
 void ContextALG::setCurrentSol(const vector<int>& curSol_p){
     assert((int) curSol_p.size() == pContextBO_m->getNbProcesses());
     currentSol_m = curSol_p;
+    buildRessUsed();
+}
+
+void ContextALG::swapCurrentSol(vector<int>& curSol_p){
+    assert((int) curSol_p.size() == pContextBO_m->getNbProcesses());
+    currentSol_m.swap(curSol_p);
+    buildRessUsed();
+}
+
+void ContextALG::assign(int idxP_p, int idxMachine_p){
+    const int idxMachineOld_l = currentSol_m[idxP_p];
+    if ( idxMachineOld_l == idxMachine_p ){
+        return;
+    }
+
+    majRessUsed(idxP_p, idxMachineOld_l, -1);
+    currentSol_m[idxP_p] = idxMachine_p;
+    majRessUsed(idxP_p, idxMachine_p, 1);
+}
+
+void ContextALG::unassign(int idxP_p){
+    assign(idxP_p, -1);
+}
+
+void ContextALG::buildRessUsed(){
+    const int nbCases_l = pContextBO_m->getNbRessources() * pContextBO_m->getNbMachines();
+    ressUsed_m.assign(nbCases_l, 0);
+    transientRessUsed_m.assign(nbCases_l, 0);
+
+    const int nbP_l = currentSol_m.size();
+    for ( int idxP_l=0 ; idxP_l < nbP_l ; idxP_l++ ){
+        majRessUsed(idxP_l, currentSol_m[idxP_l], 1);
+    }
+}
+
+void ContextALG::majRessUsed(int idxP_p, int idxMachine_p, int signe_p){
+    const int nbMachines_l = pCore_m->getNbMachines();
+    const int nbRess_l = pCore_m->getNbRessources();
+    const int idxMachineInit_l = pCore_m->getSolInit()[idxP_p];
+    const vector<int>& requirements_l = pCore_m->getRequirements();
+    const vector<char>& isTransient_l = pCore_m->getIsTransient();
+
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+        const int req_l = signe_p * requirements_l[idxP_p*nbRess_l + idxRess_l];
+        if ( idxMachine_p != -1 ){
+            ressUsed_m[idxRess_l*nbMachines_l + idxMachine_p] += req_l;
+        }
+        if ( idxMachine_p != idxMachineInit_l && isTransient_l[idxRess_l] ){
+            transientRessUsed_m[idxRess_l*nbMachines_l + idxMachineInit_l] += req_l;
+        }
+    }
 }
 
 unordered_set<int> ContextALG::getNeighsUsedByService(int idxService_p) const {
@@ -64,9 +133,13 @@ unordered_set<int> ContextALG::getNeighsUsedByService(int idxService_p) const {
 
 unordered_set<int> ContextALG::getNeighsUsedByService(ServiceBO const * pService_p) const {
     unordered_set<int> result_l;
-    BOOST_FOREACH(int idProcess_l, pService_p->getProcesses()){
+    BOOST_FOREACH(int idProcess_l, pCore_m->getProcessesByService().getLigne(pService_p->getId())){
         const int idxMachine_l = currentSol_m[idProcess_l];
-        const int idxNeigh_l = pContextBO_m->getMachine(idxMachine_l)->getNeighborhood()->getId();
+        //Un process desaffecte (cf #unassign) n'occupe aucun voisinage
+        if ( idxMachine_l == -1 ){
+            continue;
+        }
+        const int idxNeigh_l = pCore_m->getMachineNeighborhood()[idxMachine_l];
         result_l.insert(idxNeigh_l);
     }
 
@@ -74,14 +147,11 @@ unordered_set<int> ContextALG::getNeighsUsedByService(ServiceBO const * pService
 }
 
 int ContextALG::getRessUsedOnMachine(int idxRess_p, int idxMachine_p) const {
-    int result_l(0);
-    for ( int idxP_l=0 ; idxP_l < (int) currentSol_m.size() ; idxP_l++ ){
-        if ( currentSol_m[idxP_l] == idxMachine_p ){
-            result_l += pContextBO_m->getProcess(idxP_l)->getRequirement(idxRess_p);
-        }
-    }
+    return ressUsed_m[idxRess_p*pCore_m->getNbMachines() + idxMachine_p];
+}
 
-    return result_l;
+int ContextALG::getTransientRessUsedOnMachine(int idxRess_p, int idxMachine_p) const {
+    return transientRessUsed_m[idxRess_p*pCore_m->getNbMachines() + idxMachine_p];
 }
 
 uint64_t ContextALG::getScoreBestSol() const {
@@ -89,10 +159,25 @@ uint64_t ContextALG::getScoreBestSol() const {
 }
 
 bool ContextALG::checkCompletAndMajBestSol(const vector<int>& candidatBestSol_p, bool checkValidite_p){
-    Checker checker_l(pContextBO_m, candidatBestSol_p);
-    if ( checkValidite_p && !checker_l.isValid() ){
+    /* Seule une solution strictement meilleure que la meilleure connue sera ecrite :
+     * inutile de finir d'evaluer celles qui font deja pire
+     */
+    const uint64_t bestScore_l = SolutionDtoout::getBestScore();
+    if ( bestScore_l == 0 ){
+        return false;
+    }
+    CheckerResult result_l;
+    getFusedChecker()->evaluateBounded(candidatBestSol_p, bestScore_l - 1, result_l);
+    if ( result_l.dominated ){
         return false;
     }
+    if ( checkValidite_p && !result_l.valid ){
+        return false;
+    }
+
+    return SolutionDtoout::writeSol(candidatBestSol_p, result_l.score);
+}
 
-    return SolutionDtoout::writeSol(candidatBestSol_p, checker_l.computeScore());
+FusedChecker const * ContextALG::getFusedChecker() const {
+    return pFusedChecker_m.get();
 }
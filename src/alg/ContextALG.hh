@@ -26,10 +26,13 @@
 #include <vector>
 #include <tr1/unordered_set>
 #include <stdint.h>
+#include <boost/shared_ptr.hpp>
 using namespace std;
 using namespace std::tr1;
 
 class ContextBO;
+class FusedChecker;
+class InstanceCoreBO;
 class ServiceBO;
 
 class ContextALG {
@@ -41,28 +44,65 @@ class ContextALG {
          * @param Doit-on checker la sol init fournie par le ContextBO ?
          */
         ContextALG(ContextBO const * pContextBO_p, bool mustWriteBestSol_p=true, bool solInitToCheck_p=false);
+
+        /**
+         * Comme ci-dessus, mais en partant directement de la solution fournie plutot que de la solution
+         * initiale (le cache des consommations n'est ainsi calcule qu'une fois)
+         */
+        ContextALG(ContextBO const * pContextBO_p, const vector<int>& curSol_p, bool mustWriteBestSol_p);
         ContextBO const * getContextBO() const;
 
+        /**
+         * Donnees a plat de l'instance telles qu'elles etaient a la construction du ContextALG
+         */
+        boost::shared_ptr<InstanceCoreBO const> getInstanceCore() const;
+
         /* TODO : ecrire des tests pour ces methodes
          * TODO : ajouter un cache pour ces methodes (et gestion de son invalidation lors de la modif de la sol) (ou pas, si c'est au detriment des perfs et qu'il vaut mieux que les classes clientes le gere...)
          */
         unordered_set<int> getNeighsUsedByService(int idxService_p) const;
         unordered_set<int> getNeighsUsedByService(ServiceBO const * pService_p) const;
 
-        /* TODO : tester cette methode */
-        /* TODO : ameliorer les perfs de cette methode par exemple en calculant
-         * tous les resultats, et en gerant un cache...
-         */
         /**
          * Retourne la quantite de ressource consomme par les process d'une machine donnee
+         * (lu dans le cache, donc en O(1))
          */
         int getRessUsedOnMachine(int idxRess_p, int idxMachine_p) const;
 
+        /**
+         * Retourne la quantite de ressource transient reservee sur une machine par les
+         * process qui l'occupaient initialement et qui n'y sont plus (ou pas encore affectes)
+         */
+        int getTransientRessUsedOnMachine(int idxRess_p, int idxMachine_p) const;
+
         void setMustWriteBestSol(bool mustWriteBestSol_p);
 
         const vector<int>& getCurrentSol() const;
+
+        /**
+         * Remplace la solution courante, et recalcule le cache des consommations en O(P.R)
+         */
         void setCurrentSol(const vector<int>& curSol_p);
 
+        /**
+         * Comme setCurrentSol(), mais sans copie : la solution fournie devient la solution courante,
+         * et curSol_p recoit l'ancienne
+         */
+        void swapCurrentSol(vector<int>& curSol_p);
+
+        /**
+         * Affecte le process a la machine (en le retirant de sa machine actuelle s'il en a une)
+         * Le cache des consommations est mis a jour en O(R)
+         */
+        void assign(int idxP_p, int idxMachine_p);
+
+        /**
+         * Retire le process de sa machine : il est alors affecte a -1.
+         * Tant qu'il n'est pas reaffecte, il continue de reserver ses ressources
+         * transient sur sa machine initiale
+         */
+        void unassign(int idxP_p);
+
         /**
          * Evalue "from scratch" la solution soumise, et la memorise s'il s'agit de la meilleure
          * Attention : methode lente a cause de l'evaluation
@@ -75,7 +115,25 @@ class ContextALG {
         const vector<int>& getBestSol() const;
         uint64_t getScoreBestSol() const;
 
+        /**
+         * Checker rapide (validation et score en une passe) sur l'instance de ce contexte.
+         * Il est fourni par le ContextBO, et partage par tous les ContextALG de la meme instance
+         * (il est immuable : plusieurs threads peuvent s'en servir en meme temps)
+         */
+        FusedChecker const * getFusedChecker() const;
+
     private:
+        /**
+         * Recalcule entierement le cache des consommations a partir de currentSol_m
+         */
+        void buildRessUsed();
+
+        /**
+         * Ajoute (signe_p = 1) ou retire (signe_p = -1) du cache les consommations du process
+         * sur la machine donnee (qui peut valoir -1 si le process n'est pas affecte)
+         */
+        void majRessUsed(int idxP_p, int idxMachine_p, int signe_p);
+
         /**
          * Represente l'instance en cours.
          * Plusieurs ContextALG peuvent partager le meme ContextBO,
@@ -84,18 +142,36 @@ class ContextALG {
          */
         ContextBO const * pContextBO_m;
 
+        /**
+         * Donnees a plat de l'instance, partagees avec le ContextBO (elles restent valides
+         * meme si le ContextBO est modifie ensuite)
+         */
+        boost::shared_ptr<InstanceCoreBO const> pCore_m;
+
         /**
          * vecteur de taille nbProcesses representant la solution actuelle
          * currentSol_m[idxProcess] = idxMachine sur laquelle il est affecte
          */
         vector<int> currentSol_m;
 
+        /**
+         * Cache des consommations de la solution courante, stocke ressource par ressource :
+         * ressUsed_m[idxRess * nbMachines + idxMachine] = quantite consommee par les process
+         * affectes a la machine.
+         * transientRessUsed_m a le meme format, et contient les reservations transient
+         * des process qui ont quitte leur machine initiale
+         */
+        vector<int> ressUsed_m;
+        vector<int> transientRessUsed_m;
+
         /**
          * Quand une meilleure sol est trouvee, celle-ci est aussitot ecrite.
          * Ce comportement n'est pas souhaitable lorsque l'on travaille sur un sous-contexte
          * Cette attribut permet de piloter ce comportement
          */
         bool mustWriteBestSol_m;
+
+        boost::shared_ptr<FusedChecker const> pFusedChecker_m;
 };
 
 #endif
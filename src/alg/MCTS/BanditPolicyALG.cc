@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "BanditPolicyALG.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    const uint32_t TAILLE_TABLE = 4096;
+
+    /** Table des 1 / sqrt(n), remplie au chargement */
+    struct TableInvSqrt
+    {
+        TableInvSqrt()
+        {
+            val_m[0] = 0;
+            for (uint32_t i_l = 1; i_l < TAILLE_TABLE; ++i_l) {
+                val_m[i_l] = 1. / sqrt((double) i_l);
+            }
+        }
+        double val_m[TAILLE_TABLE];
+    };
+    const TableInvSqrt TABLE_INV_SQRT;
+
+    // sqrt(2 log p), le terme d'exploration commun a tous les fils
+    inline double exploration(uint32_t nbSimuFather_p)
+    {
+        return nbSimuFather_p > 1 ? sqrt(2. * log((double) nbSimuFather_p)) : 0.;
+    }
+
+    /** UCB1 : moyenne + C * sqrt(2 log p / n) */
+    class UCB1PolicyALG : public BanditPolicyALG
+    {
+        public:
+            explicit UCB1PolicyALG(double constant_p) : BanditPolicyALG(constant_p) {}
+            virtual size_t choose(const NodeContentALG *, size_t, uint32_t);
+    };
+
+    /** UCB1-Tuned : le terme d'exploration est module par une estimation de
+     * la variance des recompenses, bornee par 1/4. La variance empirique est
+     * tiree de la somme des carres des evaluations stockee dans chaque noeud.
+     */
+    class UCB1TunedPolicyALG : public BanditPolicyALG
+    {
+        public:
+            explicit UCB1TunedPolicyALG(double constant_p) : BanditPolicyALG(constant_p) {}
+            virtual size_t choose(const NodeContentALG *, size_t, uint32_t);
+    };
+
+    /** UCB1 sur les rangs : la moyenne d'un fils est remplacee par son rang
+     * parmi ses freres, ramene dans [0,1]. Insensible a l'echelle des
+     * evaluations, qui se tassent pres de 1/2 quand le score bouge peu.
+     */
+    class RankPolicyALG : public BanditPolicyALG
+    {
+        public:
+            explicit RankPolicyALG(double constant_p) : BanditPolicyALG(constant_p) {}
+            virtual size_t choose(const NodeContentALG *, size_t, uint32_t);
+        private:
+            // reutilise d'un choix a l'autre : pas d'allocation en regime etabli
+            vector< pair<double, uint32_t> > moyennes_m;
+            vector<double> rangs_m;
+    };
+
+    size_t UCB1PolicyALG::choose(const NodeContentALG * pChildren_p, size_t nb_p,
+                                 uint32_t nbSimuFather_p)
+    {
+        size_t res_l = firstUnvisited(pChildren_p, nb_p);
+        if (res_l != nb_p) {
+            return res_l;
+        }
+
+        const double coef_l = constant_m * exploration(nbSimuFather_p);
+        double maxValue_l = -numeric_limits<double>::infinity();
+        for (size_t i_l = 0; i_l < nb_p; ++i_l) {
+            const NodeContentALG & child_l = pChildren_p[i_l];
+            double value_l = child_l.sumEval_m / child_l.nbSimu_m
+                             + coef_l * invSqrt(child_l.nbSimu_m);
+            if (value_l > maxValue_l) {
+                maxValue_l = value_l;
+                res_l = i_l;
+            }
+        }
+        return res_l;
+    }
+
+    size_t UCB1TunedPolicyALG::choose(const NodeContentALG * pChildren_p, size_t nb_p,
+                                      uint32_t nbSimuFather_p)
+    {
+        size_t res_l = firstUnvisited(pChildren_p, nb_p);
+        if (res_l != nb_p) {
+            return res_l;
+        }
+
+        const double explo_l = exploration(nbSimuFather_p);
+        const double logP_l = explo_l * explo_l / 2.;
+        double maxValue_l = -numeric_limits<double>::infinity();
+        for (size_t i_l = 0; i_l < nb_p; ++i_l) {
+            const NodeContentALG & child_l = pChildren_p[i_l];
+            double inv_l = invSqrt(child_l.nbSimu_m);
+            double mean_l = child_l.sumEval_m / child_l.nbSimu_m;
+            double variance_l = max(0., child_l.sumEval2_m / child_l.nbSimu_m - mean_l * mean_l)
+                                + explo_l * inv_l;
+            double value_l = mean_l + constant_m * inv_l
+                             * sqrt(logP_l * min(0.25, variance_l));
+            if (value_l > maxValue_l) {
+                maxValue_l = value_l;
+                res_l = i_l;
+            }
+        }
+        return res_l;
+    }
+
+    size_t RankPolicyALG::choose(const NodeContentALG * pChildren_p, size_t nb_p,
+                                 uint32_t nbSimuFather_p)
+    {
+        size_t res_l = firstUnvisited(pChildren_p, nb_p);
+        if (res_l != nb_p) {
+            return res_l;
+        }
+        if (nb_p == 1) {
+            return 0;
+        }
+
+        moyennes_m.resize(nb_p);
+        rangs_m.resize(nb_p);
+        for (size_t i_l = 0; i_l < nb_p; ++i_l) {
+            moyennes_m[i_l].first = pChildren_p[i_l].sumEval_m / pChildren_p[i_l].nbSimu_m;
+            moyennes_m[i_l].second = i_l;
+        }
+        sort(moyennes_m.begin(), moyennes_m.end());
+        // les ex aequo partagent le meme rang
+        const double pas_l = 1. / (nb_p - 1);
+        size_t rang_l = 0;
+        for (size_t i_l = 0; i_l < nb_p; ++i_l) {
+            if (i_l != 0 && moyennes_m[i_l].first != moyennes_m[i_l - 1].first) {
+                rang_l = i_l;
+            }
+            rangs_m[moyennes_m[i_l].second] = rang_l * pas_l;
+        }
+
+        const double coef_l = constant_m * exploration(nbSimuFather_p);
+        double maxValue_l = -numeric_limits<double>::infinity();
+        for (size_t i_l = 0; i_l < nb_p; ++i_l) {
+            double value_l = rangs_m[i_l] + coef_l * invSqrt(pChildren_p[i_l].nbSimu_m);
+            if (value_l > maxValue_l) {
+                maxValue_l = value_l;
+                res_l = i_l;
+            }
+        }
+        return res_l;
+    }
+}
+
+BanditPolicyALG::BanditPolicyALG(double constant_p) :
+    constant_m(constant_p)
+{
+}
+
+BanditPolicyALG::~BanditPolicyALG()
+{
+}
+
+double BanditPolicyALG::getConstant() const
+{
+    return constant_m;
+}
+
+BanditPolicyALG * BanditPolicyALG::build(const string & name_p, double constant_p)
+{
+    if (name_p == "ucb1") {
+        return new UCB1PolicyALG(constant_p);
+    } else if (name_p == "ucb1tuned") {
+        return new UCB1TunedPolicyALG(constant_p);
+    } else if (name_p == "rang") {
+        return new RankPolicyALG(constant_p);
+    }
+    throw string("Politique de bandit inconnue : " + name_p);
+}
+
+size_t BanditPolicyALG::firstUnvisited(const NodeContentALG * pChildren_p, size_t nb_p)
+{
+    for (size_t i_l = 0; i_l < nb_p; ++i_l) {
+        if (pChildren_p[i_l].nbSimu_m == 0) {
+            return i_l;
+        }
+    }
+    return nb_p;
+}
+
+double BanditPolicyALG::invSqrt(uint32_t n_p)
+{
+    if (n_p < TAILLE_TABLE) {
+        return TABLE_INV_SQRT.val_m[n_p];
+    }
+    return 1. / sqrt((double) n_p);
+}
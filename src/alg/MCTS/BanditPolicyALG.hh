@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef BANDITPOLICYALG_HH
+#define BANDITPOLICYALG_HH
+
+#include "TreeALG.hh"
+
+#include <string>
+#include <stdint.h>
+
+/** Politique de bandit utilisee lors de la descente pour choisir le fils a
+ * explorer. Les contenus des fils sont fournis sous forme d'un tableau
+ * contigu, ce qui permet de les parcourir d'un trait : le log du nombre de
+ * visites du pere n'est calcule qu'une fois par choix et l'inverse de la
+ * racine du nombre de visites d'un fils est lu dans une table.
+ * Un fils jamais visite est toujours prefere (le premier d'entre eux).
+ */
+class BanditPolicyALG
+{
+    public:
+        virtual ~BanditPolicyALG();
+
+        /**
+         * Renvoie l'indice du fils a explorer parmi les nb_p fils (nb_p > 0)
+         * dont les contenus sont ranges a partir de pChildren_p
+         */
+        virtual size_t choose(const NodeContentALG * pChildren_p, size_t nb_p,
+                              uint32_t nbSimuFather_p) = 0;
+
+        double getConstant() const;
+
+        /**
+         * Construit la politique de nom name_p ("ucb1", "ucb1tuned" ou
+         * "rang"), avec la constante d'exploration constant_p.
+         * Leve une string si le nom est inconnu
+         */
+        static BanditPolicyALG * build(const std::string & name_p, double constant_p);
+
+    protected:
+        explicit BanditPolicyALG(double constant_p);
+
+        // renvoie l'indice du premier fils jamais visite, nb_p s'il n'y en a pas
+        static size_t firstUnvisited(const NodeContentALG * pChildren_p, size_t nb_p);
+
+        // 1 / sqrt(n_p), tabule pour les petites valeurs
+        static double invSqrt(uint32_t n_p);
+
+        const double constant_m;
+};
+
+#endif
@@ -38,6 +38,7 @@ ConstraintSystemALG::~ConstraintSystemALG()
 void ConstraintSystemALG::setpContext(ContextALG * pContext_p)
 {
     pContext_m = pContext_p;
+    pSweep_m.reset(new MachineSweep(pContext_m->getContextBO()));
 }
 
 ContextALG * ConstraintSystemALG::getpContext() const
@@ -59,24 +60,23 @@ ConstraintSystemALG::MachinePool ConstraintSystemALG::getLegalMachinePool(Proces
     return return_l;
 }
 
-void ConstraintSystemALG::unassign(ProcessId, MachineId)
+void ConstraintSystemALG::initUsage(MachineSweep::Usage & usage_p) const
 {
-    
+    pSweep_m->initUsage(usage_p);
 }
 
-void ConstraintSystemALG::assign(ProcessId,MachineId)
+void ConstraintSystemALG::unassign(MachineSweep::Usage & usage_p, ProcessId process_p, MachineId machine_p) const
 {
-    
+    pSweep_m->unassign(usage_p, process_p, machine_p);
 }
 
-
-void ConstraintSystemALG::filter(ProcessPool & processPool_p) const
+void ConstraintSystemALG::assign(MachineSweep::Usage & usage_p, ProcessId process_p, MachineId machine_p) const
 {
-    
+    pSweep_m->assign(usage_p, process_p, machine_p);
 }
 
-void ConstraintSystemALG::filter( ProcessId const & process_p, 
-                                  MachinePool & machinePool_p) const
+void ConstraintSystemALG::sweepFit(ProcessId process_p, MachineSweep::Usage const & usage_p,
+                                   MachineMask & fit_p) const
 {
-    
+    pSweep_m->sweepFit(process_p, -1, usage_p, fit_p);
 }
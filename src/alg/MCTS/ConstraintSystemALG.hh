@@ -24,34 +24,51 @@
 #ifndef CONSTRAINTSYSTEMALG_HH
 #define CONSTRAINTSYSTEMALG_HH
 
-#include "RestrictionALG.hh"
+#include "SolutionALG.hh"
+#include "tools/MachineSweep.hh"
+#include <boost/scoped_ptr.hpp>
+#include <vector>
 
 class ContextALG;
 
-class ConstraintSystemALG : public RestrictionALG
+class ConstraintSystemALG
 {
     public:
-        typedef RestrictionALG::ProcessId ProcessId;
-        typedef RestrictionALG::ProcessPool ProcessPool;
-        typedef RestrictionALG::MachineId MachineId;
-        typedef RestrictionALG::MachinePool MachinePool;
+        typedef SolutionALG::ProcessId ProcessId;
+        typedef std::vector<ProcessId> ProcessPool;
+        typedef SolutionALG::MachineId MachineId;
+        typedef std::vector<MachineId> MachinePool;
+
+        /**
+         * Masque indexe par machine : 1 si la machine est autorisee, 0 sinon
+         */
+        typedef std::vector<unsigned char> MachineMask;
         
         ConstraintSystemALG();
         ~ConstraintSystemALG();
         
-        void unassign(ProcessId, MachineId);
-        void assign(ProcessId, MachineId);
+        /**
+         * Initialise les consommations d'une solution vide
+         */
+        void initUsage(MachineSweep::Usage &) const;
+
+        void unassign(MachineSweep::Usage &, ProcessId, MachineId) const;
+        void assign(MachineSweep::Usage &, ProcessId, MachineId) const;
         
-        void filter(ProcessPool &) const;
-        void filter(ProcessId const &, MachinePool &) const;
-    
         void setpContext(ContextALG *);
         ContextALG * getpContext() const;
         
         MachinePool getLegalMachinePool(ProcessId) const;
+
+        /**
+         * Calcule en une passe les machines sur lesquelles le process (non affecte) tient,
+         * compte tenu des consommations de la solution partielle
+         */
+        void sweepFit(ProcessId, MachineSweep::Usage const &, MachineMask & fit_p) const;
         
     private:
         ContextALG * pContext_m;
+        boost::scoped_ptr<MachineSweep> pSweep_m;
 };
 
 #endif
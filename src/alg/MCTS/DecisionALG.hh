@@ -24,19 +24,38 @@
 #ifndef DECISIONALG_HH
 #define DECISIONALG_HH
 
-class RestrictionALG;
-class SolutionALG;
+#include <stdint.h>
 
-class DecisionALG
+/** Decision de branchement : le process target_m est restreint aux machines
+ * de l'intervalle [min_m, max_m].
+ * C'est une simple valeur, stockee telle quelle dans les noeuds de l'arbre
+ * et appliquee directement par SolutionALG : developper un noeud ou rejouer
+ * un chemin ne demande aucune allocation par decision.
+ * Une decision "une machine" (OPPM) a min_m == max_m, une decision de
+ * branchement Gecode (CP) coupe le domaine du process en deux intervalles.
+ */
+struct DecisionALG
 {
-    public:
-        typedef int ProcessId;
+    typedef int32_t ProcessId;
+    typedef int32_t MachineId;
+
+    ProcessId target_m;
+    MachineId min_m;
+    MachineId max_m;
+
+    DecisionALG() : target_m(-1), min_m(-1), max_m(-1) {}
+    DecisionALG(ProcessId target_p, MachineId min_p, MachineId max_p) :
+        target_m(target_p), min_m(min_p), max_m(max_p)
+    {}
 
-        DecisionALG();
-        virtual ~DecisionALG();
-        
-        virtual RestrictionALG * getRestriction(SolutionALG *) const = 0;
-        virtual bool workOnProcess(ProcessId) const = 0;
+    // vrai pour une decision reellement prise (pas celle, vide, de la racine)
+    bool isValid() const {return target_m >= 0;}
+    bool workOnProcess(ProcessId process_p) const {return process_p == target_m;}
+    bool operator==(const DecisionALG & decision_p) const
+    {
+        return target_m == decision_p.target_m && min_m == decision_p.min_m
+            && max_m == decision_p.max_m;
+    }
 };
 
 #endif
@@ -22,24 +22,27 @@
  */
 
 #include "MCTSStrategyOptim.hh"
-#include "dtoout/SolutionDtoout.hh"
 #include "tools/Checker.hh"
 #include "tools/Log.hh"
+#include "tools/MeilleureSolution.hh"
 
+#include "BanditPolicyALG.hh"
 #include "ConstraintSystemALG.hh"
 #include "EvaluationSystemALG.hh"
 #include "oneprocessdecisions/OPPMSpaceALG.hh"
 #include "MonteCarloTreeSearchALG.hh"
-#include "TreeSimpleImplALGDefs.hh"
+#include "TreeArenaImplALGDefs.hh"
 #include "TreeALGDefs.hh"
 
+#include <boost/scoped_ptr.hpp>
+
 #ifdef USE_GECODE
 #include "cpdecisions/CPSpaceALG.hh"
 #endif
 
 using namespace std;
 
-ContextALG MCTSStrategyOptim::run( ContextALG contextAlg_p,
+void MCTSStrategyOptim::run( ContextALG& contextAlg_p,
                                    time_t heureFinMaxPreconisee_p,
                                    boost::program_options::variables_map const & argv_p) {
     const vector<int>& sol_l = contextAlg_p.getCurrentSol();
@@ -47,9 +50,11 @@ ContextALG MCTSStrategyOptim::run( ContextALG contextAlg_p,
     /* "ContextAlg, cette solution est peut etre mieux que ce que tu connais, 
      * mais peut etre pas. Verifie le, et met toi a jour si c'est le cas"
      */
-    if ( contextAlg_p.checkCompletAndMajBestSol(sol_l, true) ){
+    const bool solPubliee_l = contextAlg_p.checkCompletAndMajBestSol(sol_l, true);
+    if ( solPubliee_l ){
         LOG(USELESS) << "La solution initialement sur le contextALG envoie du pate !" << endl;
     }
+    const uint64_t versionDebut_l = MeilleureSolution::getVersion();
 
     LOG(USELESS) << "initialisation des objets" << endl;
     Checker checker_l(&contextAlg_p);
@@ -68,18 +73,29 @@ ContextALG MCTSStrategyOptim::run( ContextALG contextAlg_p,
     
     LOG(USELESS) << "construction de l'arbre" << endl;
     MonteCarloTreeSearchALG mcts_l;
-    TreeALG< TreeSimpleImplALG<NodeContentALG> > tree_l;
+    TreeALG< TreeArenaImplALG<NodeContentALG> > tree_l;
     mcts_l.setpTree(&tree_l);
     mcts_l.setpInitialSpace(pInitialSpace_l);
+
+    string policy_l = argv_p.count("mctsPolicy") ? argv_p["mctsPolicy"].as<string>() : "ucb1";
+    double constant_l = argv_p.count("mctsConstant") ? argv_p["mctsConstant"].as<double>() : 0.1;
+    boost::scoped_ptr<BanditPolicyALG> pPolicy_l(BanditPolicyALG::build(policy_l, constant_l));
+    mcts_l.setpPolicy(pPolicy_l.get());
+    int maxNodes_l = argv_p.count("mctsMaxNodes") ? argv_p["mctsMaxNodes"].as<int>() : 0;
+    mcts_l.setMaxNodes(max(0, maxNodes_l));
+    LOG(INFO) << "Politique de descente : " << policy_l << ", C = " << constant_l << endl;
     
     LOG(INFO) << "Lauching MCTS" << endl;
     mcts_l.search();
 
     /* On souhaite que la prochaine strategie (s'il y en a une) considere comme
      * solution courante la derniere qu'on a considere (cette strategie pourra,
-     * si elle le desire, ignorer cette solution initial qu'on lui fourni)
+     * si elle le desire, ignorer cette solution initial qu'on lui fourni).
+     * La copie est evitee si la meilleure est encore la solution courante, publiee a l'entree
+     * (meme version) : les versions suffisent, sans comparer les solutions
      */
-
-    contextAlg_p.setCurrentSol(SolutionDtoout::getBestSol());
-    return contextAlg_p;
+    const MeilleureSolution::InstantanePtr pBest_l = MeilleureSolution::getInstantane();
+    if ( pBest_l && ! ( solPubliee_l && pBest_l->version == versionDebut_l ) ){
+        contextAlg_p.setCurrentSol(pBest_l->sol);
+    }
 }
@@ -22,10 +22,11 @@
  */
 
 #include "MonteCarloTreeSearchALG.hh"
+#include "BanditPolicyALG.hh"
 #include "ConstraintSystemALG.hh"
 #include "EvaluationSystemALG.hh"
 #include "TreeALGDefs.hh"
-#include "TreeSimpleImplALGDefs.hh"
+#include "TreeArenaImplALGDefs.hh"
 #include "SolutionALG.hh"
 #include "SpaceALG.hh"
 
@@ -35,6 +36,7 @@
 #include <cmath>
 #include <algorithm>
 #include "tools/Log.hh"
+#include "tools/MeilleureSolution.hh"
 
 #include <boost/tuple/tuple.hpp>
 #include <boost/thread/thread.hpp>
@@ -45,7 +47,6 @@ using boost::bind;
 using boost::thread_group;
 using boost::tuple;
 
-typedef MonteCarloTreeSearchALG::Tree::ChildrenPool ChildrenPool;
 typedef MonteCarloTreeSearchALG::Tree::iterator iterator; 
 
 /** Externalisation du choix dans le cc pour rendre le code lisible
@@ -55,56 +56,42 @@ typedef MonteCarloTreeSearchALG::Tree::iterator iterator;
 */
 
 // voir http://arxiv.org/abs/cs/0703062v1 pour pleins de formules cools
-double uct(const iterator &it_p)
-{
-    if (it_p->nbSimu_m == 0 || it_p.isRoot())
-        return std::numeric_limits<double>::infinity();
-
-    double p_l = it_p.father()->nbSimu_m;
-    double ni_l = it_p->nbSimu_m;
-    double mean_l = it_p->sumEval_m / ni_l;
-    double ci_l = sqrt(2. * log(p_l) / ni_l);
-
-    return mean_l + 0.1 * ci_l;
-}
-
+// la politique parcourt les contenus contigus des fils : la descente n'alloue rien
 iterator
-chooseNextChildren(MonteCarloTreeSearchALG::Tree *pTree_p, const iterator &it_p)
-{
-    ChildrenPool children_l = pTree_p->children(it_p);
-    ChildrenPool::const_iterator itPool_l = children_l.begin();
-    iterator res_l = *itPool_l;
-    double maxValue_l = uct(*itPool_l);
-
-    for (++itPool_l; itPool_l != children_l.end(); ++itPool_l) {
-        double value_l = uct(*itPool_l);
-        if (value_l > maxValue_l) {
-            maxValue_l = value_l;
-            res_l = *itPool_l;
-        }
-    }
-    return res_l;
+chooseNextChildren(MonteCarloTreeSearchALG::Tree *pTree_p, BanditPolicyALG *pPolicy_p,
+                   const iterator &it_p)
+{
+    size_t idx_l = pPolicy_p->choose(pTree_p->childrenContents(it_p),
+                                     pTree_p->nbChildren(it_p), it_p->nbSimu_m);
+    return pTree_p->child(it_p, idx_l);
 }
 
-void updateNode(iterator &it_p, int nb_p, double sum_p)
+void updateNode(iterator &it_p, int nb_p, double sum_p, double sum2_p)
 {
     it_p->nbSimu_m += nb_p;
     it_p->sumEval_m += sum_p;
+    it_p->sumEval2_m += sum2_p;
     // for rounding errors
     it_p->sumEval_m = std::max<float>(0, it_p->sumEval_m);
+    it_p->sumEval2_m = std::max<float>(0, it_p->sumEval2_m);
 }
 
-void updatePath(iterator it_p, int nb_p, double sum_p)
+void updatePath(iterator it_p, int nb_p, double sum_p, double sum2_p)
 {
     while (! it_p.isRoot()) {
-        updateNode(it_p, nb_p, sum_p);
+        updateNode(it_p, nb_p, sum_p, sum2_p);
         it_p = it_p.father();
     }
-    updateNode(it_p, nb_p, sum_p);
+    updateNode(it_p, nb_p, sum_p, sum2_p);
 }
 
 MonteCarloTreeSearchALG::MonteCarloTreeSearchALG() :
-    pTree_m(0)
+    pTree_m(0),
+    pInitialSpace_m(0),
+    pPolicy_m(0),
+    maxNodes_m(0),
+    nbEvictions_m(0),
+    borne_m(std::numeric_limits<uint64_t>::max())
 {
 }
 
@@ -125,18 +112,64 @@ void MonteCarloTreeSearchALG::search()
 {
     LOG(INFO) << "Lancement de MCTS" << std::endl;
     int i_l = 0, nbSimu_l = 0;
+    // les evaluations publient leurs ameliorations : on les suit sans relire
+    // le fichier, pour elaguer les branches qui ne peuvent plus faire mieux
+    MeilleureSolution::Abonnement abonnement_l;
+    borne_m = MeilleureSolution::getScore();
     
     do {
         ++i_l;
+        if (abonnement_l.isNouvelle()) {
+            MeilleureSolution::InstantanePtr pBest_l = abonnement_l.prends();
+            if (pBest_l) {
+                borne_m = std::min(borne_m, pBest_l->score);
+                LOG(DEBUG) << "nouvelle meilleure solution a l'iter " << i_l
+                           << " : " << pBest_l->score << std::endl;
+            }
+        }
         nbSimu_l += performDescent();
+        enforceMaxNodes();
         if (isPowerOf10(i_l)) {
             LOG(INFO) << "nb iter = " << i_l << ", nbSimu = " << nbSimu_l
+                      << ", nbNodes = " << pTree_m->getNbNodes()
+                      << ", octets/noeud = " << octetsParNoeud()
+                      << ", evictions = " << nbEvictions_m
                       << ", tree = " << pTree_m->toString(2) << std::endl;;
         }
     } while (pTree_m->hasChildren(pTree_m->root()));
 
     LOG(INFO) << "End MCTS: nb iter = " << i_l << ", nbSimu = " << nbSimu_l
-              << std::endl;
+              << ", nbNodes = " << pTree_m->getNbNodes()
+              << ", octets/noeud = " << octetsParNoeud()
+              << ", evictions = " << nbEvictions_m << std::endl;
+}
+
+size_t MonteCarloTreeSearchALG::octetsParNoeud() const
+{
+    return pTree_m->getTailleOctets() / std::max<size_t>(1, pTree_m->getNbNodes());
+}
+
+void MonteCarloTreeSearchALG::enforceMaxNodes()
+{
+    if (maxNodes_m == 0 || pTree_m->getNbNodes() <= maxNodes_m) {
+        return;
+    }
+    size_t nbNodes_l = pTree_m->getNbNodes();
+    size_t nbCollapsed_l = pTree_m->shrink(maxNodes_m / 4 * 3);
+    nbEvictions_m += nbCollapsed_l;
+    LOG(DEBUG) << "budget de " << maxNodes_m << " noeuds atteint : "
+               << nbCollapsed_l << " sous arbres replies, " << nbNodes_l
+               << " -> " << pTree_m->getNbNodes() << " noeuds" << std::endl;
+}
+
+void MonteCarloTreeSearchALG::setMaxNodes(size_t maxNodes_p)
+{
+    maxNodes_m = maxNodes_p;
+}
+
+size_t MonteCarloTreeSearchALG::getNbEvictions() const
+{
+    return nbEvictions_m;
 }
 
 void MonteCarloTreeSearchALG::setpTree(Tree * pTree_p)
@@ -154,6 +187,11 @@ void MonteCarloTreeSearchALG::setpInitialSpace(SpaceALG * pSpace_p)
     pInitialSpace_m = pSpace_p;
 }
 
+void MonteCarloTreeSearchALG::setpPolicy(BanditPolicyALG * pPolicy_p)
+{
+    pPolicy_m = pPolicy_p;
+}
+
 SpaceALG * MonteCarloTreeSearchALG::initNewSpace()
 {
     return pInitialSpace_m->clone();
@@ -171,20 +209,28 @@ int MonteCarloTreeSearchALG::performDescent()
 
     //On descent jusqu'une feuille
     while (pTree_m->hasChildren(current_l)) {
-        current_l = chooseNextChildren(pTree_m, current_l);
-        pSpace_l->addDecision(current_l->pDecision_m);
+        current_l = chooseNextChildren(pTree_m, pPolicy_m, current_l);
+        pSpace_l->addDecision(current_l->decision_m);
     }
     
     // Maintenant qu'on est sur une feuille on va brancher selon l'espace des
-    // solutions
+    // solutions. Une feuille repliee (cf TreeALG::shrink) retrouve ses fils,
+    // sauf ceux des branches epuisees avant le repli
+    // Une feuille dont la borne atteint deja la meilleure solution connue ne
+    // peut plus l'ameliorer : sans fils, elle est effacee comme une branche
+    // epuisee
     typedef SpaceALG::DecisionsPool DecisionsPool;
-    DecisionsPool decisions_l = pSpace_l->generateDecisions();
+    DecisionsPool decisions_l;
+    if (pSpace_l->bound() < borne_m) {
+        decisions_l = pSpace_l->generateDecisions();
+    }
 
     // On va retenir les évaluations à faire remonter
     int nbSimu_l = 0;
     double sumEval_l = 0;
+    double sumEval2_l = 0;
 
-    typedef tuple<SpaceALG *,DecisionALG *,double> Eval;
+    typedef tuple<SpaceALG *,DecisionALG,double> Eval;
     typedef std::list<Eval> EvalPool;
     EvalPool pool_l;
 
@@ -192,8 +238,15 @@ int MonteCarloTreeSearchALG::performDescent()
 
     for (DecisionsPool::iterator it_l = decisions_l.begin();
          it_l != decisions_l.end(); ++it_l) {
+        if (pTree_m->isExhausted(current_l, *it_l)) {
+            continue;
+        }
         SpaceALG * pChildSpace_l = pSpace_l->clone();
         pChildSpace_l->addDecision(*it_l);
+        if (pChildSpace_l->bound() >= borne_m) {
+            delete pChildSpace_l;
+            continue;
+        }
         pool_l.push_back(Eval(pChildSpace_l,*it_l,0.0));
         group_l.create_thread( bind(callable_evaluate,
                                     ref(pool_l.back().get<0>()),
@@ -207,37 +260,38 @@ int MonteCarloTreeSearchALG::performDescent()
         SpaceALG * pChildSpace_l = it_l->get<0>();
         double eval_l = it_l->get<2>();
 
-        if (pChildSpace_l->isSolution()) {
-            // on delete la decision car on ne l'ajoute pas à l'arbre
-            delete it_l->get<1>();
-        } else {
+        if (! pChildSpace_l->isSolution()) {
             // si c'est pas une solution, on l'ajoute à l'arbre
             NodeContentALG newNC_l(it_l->get<1>());
             iterator newNode_l = pTree_m->addChildren(current_l, newNC_l);
 
             // on met à jour les évaluations
-            updateNode(newNode_l, 1, eval_l);
+            updateNode(newNode_l, 1, eval_l, eval_l * eval_l);
             ++nbSimu_l;
             sumEval_l += eval_l;
+            sumEval2_l += eval_l * eval_l;
         }
         delete pChildSpace_l;
     }
 
     if (nbSimu_l == 0) {
-        // pas de fils généré, on efface le noeud et ses pères vides en cascade
+        // pas de fils généré, on efface le noeud et ses pères vides en cascade,
+        // chaque père retenant la décision du fils épuisé
         while (! pTree_m->hasChildren(current_l) && ! current_l.isRoot()) {
             iterator father_l = current_l.father();
             // on sauve les données à effacer
             nbSimu_l = - current_l->nbSimu_m;
             sumEval_l = - current_l->sumEval_m;
+            sumEval2_l = - current_l->sumEval2_m;
             // on delete
-            pTree_m->deleteNode(current_l);
+            pTree_m->deleteExhausted(current_l);
             current_l = father_l;
         }
     }
 
-    // On remonte l'information
-    updatePath(current_l, nbSimu_l, sumEval_l);
+    // On remonte l'information. Pour une feuille repliee, les nouvelles
+    // simulations s'ajoutent a celles de l'ancien sous arbre
+    updatePath(current_l, nbSimu_l, sumEval_l, sumEval2_l);
 
     delete pSpace_l;
     return std::max(0, nbSimu_l);
@@ -33,15 +33,18 @@
  */
 
 #include "TreeALG.hh"
-#include "TreeSimpleImplALG.hh"
+#include "TreeArenaImplALG.hh"
 
+#include <stdint.h>
+
+class BanditPolicyALG;
 class SolutionALG;
 class SpaceALG;
 
 class MonteCarloTreeSearchALG
 {
     public:
-        typedef TreeALG< TreeSimpleImplALG<NodeContentALG> > Tree;
+        typedef TreeALG< TreeArenaImplALG<NodeContentALG> > Tree;
         
         MonteCarloTreeSearchALG();
         ~MonteCarloTreeSearchALG();
@@ -52,13 +55,33 @@ class MonteCarloTreeSearchALG
         Tree * getpTree() const;
 
         void setpInitialSpace(SpaceALG *); 
+
+        // politique de choix du fils lors de la descente (non possedee)
+        void setpPolicy(BanditPolicyALG *);
+
+        /* Budget de noeuds de l'arbre (0 : pas de limite). Quand il est
+         * depasse, les sous arbres les moins visites sont replies en
+         * feuilles jusqu'a redescendre aux trois quarts du budget.
+         */
+        void setMaxNodes(size_t);
+        size_t getNbEvictions() const;
         
     private:
         SpaceALG * initNewSpace();
         int performDescent();
+        void enforceMaxNodes();
+        // octets reserves par l'arene, rapportes au nombre de noeuds vivants
+        size_t octetsParNoeud() const;
         
         Tree * pTree_m;
         SpaceALG * pInitialSpace_m;
+        BanditPolicyALG * pPolicy_m;
+        size_t maxNodes_m;
+        // nombre de sous arbres replies depuis le debut de la recherche
+        size_t nbEvictions_m;
+        // score de la meilleure solution connue, suivi par abonnement : les
+        // espaces dont la borne l'atteint ne sont plus developpes
+        uint64_t borne_m;
 };
 
 #endif
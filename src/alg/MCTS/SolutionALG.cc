@@ -22,10 +22,11 @@
  */
 
 #include "SolutionALG.hh"
-#include "RestrictionALG.hh"
 #include "ConstraintSystemALG.hh"
 #include "EvaluationSystemALG.hh"
 
+#include <algorithm>
+#include <limits>
 #include <list>
 
 const SolutionALG::MachineId SolutionALG::unassigned = -1;
@@ -36,26 +37,36 @@ SolutionALG::SolutionALG(size_t nbProcesses_p)
 {
 }
 
-SolutionALG::~SolutionALG()
+void SolutionALG::addDecision(const DecisionALG & decision_p)
 {
-    for (RestrictionPool::const_iterator it_l = restrictions_m.begin(); 
-         it_l != restrictions_m.end(); ++it_l) {
-        RestrictionALG * pRestriction_l = *it_l;
-        if (pRestriction_l != pConstraintSystem_m)
-            delete pRestriction_l;
+    if (minMachine_m.empty()) {
+        minMachine_m.assign(assignment_m.size(), 0);
+        maxMachine_m.assign(assignment_m.size(), std::numeric_limits<MachineId>::max());
     }
+    ProcessId process_l = decision_p.target_m;
+    minMachine_m[process_l] = std::max(minMachine_m[process_l], decision_p.min_m);
+    maxMachine_m[process_l] = std::min(maxMachine_m[process_l], decision_p.max_m);
+}
+
+SolutionALG::~SolutionALG()
+{
 }
 
 void SolutionALG::unassign(ProcessId process_p)
 {
-    pConstraintSystem_m->unassign(process_p, assignment_m[process_p]);
+    MachineId machine_l = assignment_m[process_p];
+    if (machine_l >= 0) {
+        pConstraintSystem_m->unassign(usage_m, process_p, machine_l);
+    }
     assignment_m[process_p] = unassigned;
 }
 
 void SolutionALG::assign(ProcessId process_p, MachineId machine_p)
 {
    assignment_m[process_p] = machine_p;
-   pConstraintSystem_m->assign(process_p, machine_p);
+   if (machine_p >= 0) {
+       pConstraintSystem_m->assign(usage_m, process_p, machine_p);
+   }
 }
 
 double SolutionALG::evaluate()
@@ -67,27 +78,16 @@ std::vector<SolutionALG::ProcessId> SolutionALG::getAvaiableProcesses() const
 {
     std::vector<SolutionALG::ProcessId> return_l;
     
-    std::vector<ProcessId> unassigned_l;
     ProcessId current_l = 0;
     ProcessId end_l = assignment_m.size();
     for( ; current_l < end_l; ++current_l)
     {
         if (assignment_m[current_l] == unassigned)
         {
-            unassigned_l.push_back(current_l);
+            return_l.push_back(current_l);
         }
     }
     
-    for (RestrictionPool::const_iterator it_l = restrictions_m.begin(); 
-                                         it_l != restrictions_m.end();
-                                         ++it_l)
-    {
-        RestrictionALG * pRestriction_l = *it_l;
-        pRestriction_l->filter(unassigned_l);
-    }
-    
-    return_l.insert(return_l.begin(), unassigned_l.begin(), unassigned_l.end());
-    
     return return_l;
 }
         
@@ -96,30 +96,33 @@ std::vector<SolutionALG::MachineId>
 {
     std::vector<SolutionALG::MachineId> return_l;
     
-    std::vector<MachineId> possibles_l = pConstraintSystem_m->getLegalMachinePool(process_p);
-     
-    for (RestrictionPool::const_iterator it_l = restrictions_m.begin(); 
-                                         it_l != restrictions_m.end();
-                                         ++it_l)
+    // Un seul balayage, limite a la capacite, donne les machines sur lesquelles le process tient
+    pConstraintSystem_m->sweepFit(process_p, usage_m, fit_m);
+    const std::vector<unsigned char> & possibles_l = fit_m;
+    
+    int nbMachines_l = possibles_l.size();
+    // les decisions bornent directement le parcours du masque
+    MachineId min_l = 0;
+    MachineId max_l = nbMachines_l - 1;
+    if (! minMachine_m.empty()) {
+        min_l = std::max(min_l, minMachine_m[process_p]);
+        max_l = std::min(max_l, maxMachine_m[process_p]);
+    }
+    for (MachineId machine_l = min_l; machine_l <= max_l; ++machine_l)
     {
-        RestrictionALG * pRestriction_l = *it_l;
-        pRestriction_l->filter(process_p,possibles_l);
+        if (possibles_l[machine_l])
+        {
+            return_l.push_back(machine_l);
+        }
     }
     
-    return_l.insert(return_l.begin(), possibles_l.begin(), possibles_l.end());
-    
     return return_l;
 }
 
-void SolutionALG::addRestriction(RestrictionALG * pRestriction_p)
-{
-    restrictions_m.push_back(pRestriction_p);
-}
-
 void SolutionALG::setpConstraintSystem(ConstraintSystemALG * pSystem_p)
 {
     pConstraintSystem_m = pSystem_p;
-    addRestriction(pConstraintSystem_m);
+    pConstraintSystem_m->initUsage(usage_m);
 }
 
 void SolutionALG::setpEvaluationSystem(EvaluationSystemALG * pSystem_p)
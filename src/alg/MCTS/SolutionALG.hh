@@ -26,10 +26,11 @@
 
 #include <vector>
 #include <cstring>
+#include "DecisionALG.hh"
+#include "tools/MachineSweep.hh"
 
 class ConstraintSystemALG;
 class EvaluationSystemALG;
-class RestrictionALG;
 
 class SolutionALG
 {
@@ -43,7 +44,11 @@ class SolutionALG
         static const MachineId unassigned;
         static const MachineId failToAssign;
                 
-        void addRestriction(RestrictionALG *); 
+        /**
+         * Restreint le process de la decision a son intervalle de machines,
+         * intersecte avec les decisions precedentes sur ce process
+         */
+        void addDecision(const DecisionALG &);
         void setpConstraintSystem(ConstraintSystemALG *); 
         void setpEvaluationSystem(EvaluationSystemALG *); 
 
@@ -57,15 +62,29 @@ class SolutionALG
         double evaluate();
         
     private:
-        typedef std::vector<RestrictionALG *> RestrictionPool;
-        RestrictionPool restrictions_m;     
-        
         typedef std::vector<MachineId> ExplicitRepresentation;
         ExplicitRepresentation assignment_m;
 
+        /**
+         * Intervalle de machines autorisees par les decisions, par process
+         * (alloues a la premiere decision ; min > max si elles se contredisent)
+         */
+        std::vector<MachineId> minMachine_m;
+        std::vector<MachineId> maxMachine_m;
+
         ConstraintSystemALG * pConstraintSystem_m;
         EvaluationSystemALG * pEvaluationSystem_m;
         double incrementalValue_m;
+
+        /**
+         * Consommations des machines pour l'affectation partielle courante
+         */
+        MachineSweep::Usage usage_m;
+
+        /**
+         * Masque des machines sur lesquelles le process tient, reutilise d'un appel sur l'autre
+         */
+        mutable std::vector<unsigned char> fit_m;
 };
 
 #endif
@@ -26,14 +26,12 @@
 #include "alg/ContextALG.hh"
 #include "dtoout/SolutionDtoout.hh"
 #include "SolutionALG.hh"
-#include "DecisionALG.hh"
-#include "RestrictionALG.hh"
 #include "MonteCarloSimulationALG.hh"
 
 #include <iostream>
 #include "bo/ContextBO.hh"
 #include "tools/Log.hh"
-#include "tools/Checker.hh"
+#include "tools/FusedChecker.hh"
 
 SpaceALG::SpaceALG() :
     origEval_m(1), pContext_m(0), pEvaluationSystem_m(0), pConstraintSystem_m(0)
@@ -45,7 +43,7 @@ SpaceALG::~SpaceALG()
 }
 
 
-void SpaceALG::addDecision(DecisionALG * decision_p)
+void SpaceALG::addDecision(const DecisionALG & decision_p)
 {
     decisions_m.push_back(decision_p);
 }
@@ -81,9 +79,7 @@ double SpaceALG::evaluate() const
                                        it_l != decisions_m.end(); 
                                        ++it_l)
     {
-        DecisionALG * pDec_l = *it_l;
-        RestrictionALG * pRestriction_l = pDec_l->getRestriction(pSolution_l);
-        pSolution_l->addRestriction(pRestriction_l);        
+        pSolution_l->addDecision(*it_l);
     }
 
     LOG(USELESS) << "On appelle la methode de monte carlo avec " 
@@ -93,9 +89,11 @@ double SpaceALG::evaluate() const
 
     double eval_l = 0;
     const std::vector<int> &sol_l = pSolution_l->getSolution();
-    Checker checker_l(pContext_m->getContextBO(), pSolution_l->getSolution());
-    if (checker_l.isValid()){
-        uint64_t intEval_l = checker_l.computeScore();
+    // Un process qui n'a pu etre place nulle part (failToAssign) rend la solution invalide
+    CheckerResult result_l;
+    pContext_m->getFusedChecker()->evaluate(sol_l, result_l);
+    if (result_l.valid){
+        uint64_t intEval_l = result_l.score;
         eval_l = (double) origEval_m / (origEval_m + intEval_l);
         if (SolutionDtoout::writeSol(sol_l, intEval_l)) {
             LOG(INFO) << "Better solution: " << intEval_l
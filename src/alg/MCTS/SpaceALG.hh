@@ -24,14 +24,14 @@
 #ifndef SPACEALG_HH
 #define SPACEALG_HH
 
+#include "DecisionALG.hh"
+
 #include <vector>
 #include <stdint.h>
 
 class ConstraintSystemALG;
 class ContextALG;
-class DecisionALG;
 class EvaluationSystemALG;
-class RestrictionALG;
 class SolutionALG;
 
 
@@ -47,9 +47,9 @@ class SpaceALG
         virtual ~SpaceALG();
 
         typedef double BoundValue;
-        typedef std::vector<DecisionALG *> DecisionsPool;
+        typedef std::vector<DecisionALG> DecisionsPool;
 
-        virtual void addDecision(DecisionALG *);
+        virtual void addDecision(const DecisionALG &);
         virtual DecisionsPool generateDecisions() const;
         virtual BoundValue bound() const;
         virtual bool isSolution() const;
@@ -35,28 +35,28 @@
 /** Structure contenant l'information utile du noeud d'un point de vue
     recherche de solution. Quelque soit la structure de l'arbre, on en
     aura toujours besoin.
+    La decision menant au noeud y est stockee par valeur : le contenu ne
+    possede aucune memoire et se copie comme un entier.
 */
 
 struct NodeContentALG
 {
     uint32_t nbSimu_m;
     float sumEval_m;
-    DecisionALG * pDecision_m;
-
-    NodeContentALG() : nbSimu_m(0), sumEval_m(0.0), pDecision_m(0) {}
-    NodeContentALG(DecisionALG * pDecision_p) :
-        nbSimu_m(0), sumEval_m(0.0), pDecision_m(pDecision_p)
+    // somme des carres des evaluations : variance empirique (UCB1-Tuned)
+    float sumEval2_m;
+    DecisionALG decision_m;
+    // 1 + indice dans TreeALG de la liste des decisions des fils epuises,
+    // 0 si aucun fils n'a ete epuise
+    uint32_t epuises_m;
+
+    NodeContentALG() : nbSimu_m(0), sumEval_m(0.0), sumEval2_m(0.0), decision_m(), epuises_m(0) {}
+    NodeContentALG(const DecisionALG & decision_p) :
+        nbSimu_m(0), sumEval_m(0.0), sumEval2_m(0.0), decision_m(decision_p), epuises_m(0)
     {}
 
-    ~NodeContentALG()
-    {
-        // faudrait deleter là, mais si on delete, faut faire une copie pour le
-        // move du vector...
-        //delete pDecision_m;
-    }
-
-    // du coup on fait un clear manuel lors de la destruction d'un Node
-    void clear() {delete pDecision_m; pDecision_m = 0; nbSimu_m = 0; sumEval_m = 0;}
+    // remis a zero lors de la destruction d'un Node
+    void clear() {decision_m = DecisionALG(); nbSimu_m = 0; sumEval_m = 0; sumEval2_m = 0; epuises_m = 0;}
 
     std::string toString() const
     {
@@ -89,12 +89,53 @@ public:
     // renvoie vrai si un iterateur a des fils
     bool hasChildren(iterator const &);
 
+    // renvoie le nombre de fils d'un iterateur
+    size_t nbChildren(iterator const &);
+
+    // renvoie le i-eme fils d'un iterateur, sans construire la liste des fils
+    iterator child(iterator const &, size_t);
+
     // renvoie la liste des fils d'un iterateur
     ChildrenPool children(iterator const &);
 
+    // renvoie les contenus des fils d'un iterateur, ranges de facon contigue
+    // (seules les implementations qui rangent ainsi les fils la fournissent)
+    NodeContentALG * childrenContents(iterator const &);
+
     // detruit le noeud de l'iterateur qui devient donc invalide
     void deleteNode(iterator &);
 
+    // detruit une feuille epuisee en retenant sa decision dans son pere :
+    // replie puis redeveloppe, le pere ne regenerera pas ce fils
+    void deleteExhausted(iterator &);
+
+    // vrai si la decision est celle d'un fils epuise du noeud
+    bool isExhausted(iterator const &, DecisionALG const &) const;
+
+    // detruit les descendants du noeud, qui devient une feuille repliee en
+    // gardant ses statistiques ; les autres iterateurs restent valides
+    void deleteChildren(iterator const &);
+
+    // nombre de noeuds de l'arbre, racine comprise
+    size_t getNbNodes() const;
+
+    // octets reserves pour les noeuds (seules les implementations a arene
+    // le fournissent)
+    size_t getTailleOctets() const;
+
+    /* Replie en feuilles les sous arbres les moins visites (hors racine)
+     * jusqu'a ce que l'arbre ne compte plus que maxNodes_p noeuds, ou que
+     * seuls les fils de la racine restent. Renvoie le nombre de sous
+     * arbres replies.
+     * Une feuille repliee est redeveloppee par la prochaine descente qui
+     * l'atteint : ses fils sont regeneres depuis l'espace de recherche, sauf
+     * ceux effaces par deleteExhausted, que la feuille garde en memoire (cf
+     * isExhausted). Les simulations de ces fils s'ajoutent aux statistiques
+     * conservees par le repli. Les fils epuises des noeuds replies sous la
+     * feuille sont en revanche oublies.
+     */
+    size_t shrink(size_t maxNodes_p);
+
     // renvoie un iterateur sur le noeud courant?
     iterator addChildren(iterator &, NodeContentALG &);
 
@@ -102,7 +143,21 @@ public:
     std::string toString(int, iterator const &);
 
 private:
+    // replie les noeuds internes strictement moins visites que threshold_p
+    size_t collapseBelow(uint32_t threshold_p, ChildrenPool &stack_p);
+
+    // rend a la table la liste des fils epuises du noeud
+    void libereEpuises(iterator);
+
+    // idem pour tous les descendants du noeud
+    void libereEpuisesDescendants(iterator const &);
+
     TreeImpl impl_m;
+
+    // listes des decisions des fils epuises, indexees par
+    // NodeContentALG::epuises_m ; les listes rendues sont recyclees
+    std::vector< std::vector<DecisionALG> > epuises_m;
+    std::vector<uint32_t> libres_m;
 };
 
 #endif
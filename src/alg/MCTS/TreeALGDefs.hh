@@ -27,6 +27,8 @@
 #include "TreeALG.hh"
 #include "tools/Log.hh"
 
+#include <algorithm>
+
 template<typename TreeImpl>
 TreeALG<TreeImpl>::TreeALG()
 {
@@ -40,9 +42,159 @@ TreeALG<TreeImpl>::~TreeALG()
 template<typename TreeImpl>
 void TreeALG<TreeImpl>::deleteNode(iterator & it_p)
 {
+    libereEpuisesDescendants(it_p);
+    libereEpuises(it_p);
     impl_m.deleteNode(it_p);
 }
 
+template<typename TreeImpl>
+void TreeALG<TreeImpl>::deleteChildren(iterator const & it_p)
+{
+    libereEpuisesDescendants(it_p);
+    impl_m.deleteChildren(it_p);
+}
+
+template<typename TreeImpl>
+void TreeALG<TreeImpl>::deleteExhausted(iterator & it_p)
+{
+    if (! it_p.isRoot()) {
+        iterator father_l = it_p.father();
+        if (father_l->epuises_m == 0) {
+            if (libres_m.empty()) {
+                epuises_m.push_back(std::vector<DecisionALG>());
+                father_l->epuises_m = epuises_m.size();
+            } else {
+                father_l->epuises_m = libres_m.back() + 1;
+                libres_m.pop_back();
+            }
+        }
+        epuises_m[father_l->epuises_m - 1].push_back(it_p->decision_m);
+    }
+    deleteNode(it_p);
+}
+
+template<typename TreeImpl>
+bool TreeALG<TreeImpl>::isExhausted(iterator const & it_p,
+                                    DecisionALG const & decision_p) const
+{
+    if (it_p->epuises_m == 0) {
+        return false;
+    }
+    const std::vector<DecisionALG> & decisions_l = epuises_m[it_p->epuises_m - 1];
+    return std::find(decisions_l.begin(), decisions_l.end(), decision_p)
+        != decisions_l.end();
+}
+
+template<typename TreeImpl>
+void TreeALG<TreeImpl>::libereEpuises(iterator it_p)
+{
+    if (it_p->epuises_m != 0) {
+        epuises_m[it_p->epuises_m - 1].clear();
+        libres_m.push_back(it_p->epuises_m - 1);
+        it_p->epuises_m = 0;
+    }
+}
+
+template<typename TreeImpl>
+void TreeALG<TreeImpl>::libereEpuisesDescendants(iterator const & it_p)
+{
+    // cas courant : aucune liste en cours, pas de parcours
+    if (libres_m.size() == epuises_m.size()) {
+        return;
+    }
+    ChildrenPool stack_l(1, it_p);
+    while (! stack_l.empty()) {
+        iterator it_l = stack_l.back();
+        stack_l.pop_back();
+        for (size_t i_l = 0; i_l < nbChildren(it_l); ++i_l) {
+            iterator child_l = child(it_l, i_l);
+            libereEpuises(child_l);
+            if (hasChildren(child_l)) {
+                stack_l.push_back(child_l);
+            }
+        }
+    }
+}
+
+template<typename TreeImpl>
+size_t TreeALG<TreeImpl>::getNbNodes() const
+{
+    return impl_m.getNbNodes();
+}
+
+template<typename TreeImpl>
+size_t TreeALG<TreeImpl>::getTailleOctets() const
+{
+    return impl_m.getTailleOctets();
+}
+
+template<typename TreeImpl>
+size_t TreeALG<TreeImpl>::shrink(size_t maxNodes_p)
+{
+    if (getNbNodes() <= maxNodes_p) {
+        return 0;
+    }
+
+    // visites des noeuds internes hors racine
+    std::vector<uint32_t> visits_l;
+    ChildrenPool stack_l(1, root());
+    while (! stack_l.empty()) {
+        iterator it_l = stack_l.back();
+        stack_l.pop_back();
+        for (size_t i_l = 0; i_l < nbChildren(it_l); ++i_l) {
+            iterator child_l = child(it_l, i_l);
+            if (hasChildren(child_l)) {
+                visits_l.push_back(child_l->nbSimu_m);
+                stack_l.push_back(child_l);
+            }
+        }
+    }
+    if (visits_l.empty()) {
+        return 0;
+    }
+    std::sort(visits_l.begin(), visits_l.end());
+
+    /* Un pere est au moins autant visite que chacun de ses fils : replier
+     * les noeuds sous un seuil revient a replier des sous arbres entiers.
+     * On remonte le seuil par seiziemes des visites jusqu'a passer sous le
+     * budget, le dernier seuil repliant tous les fils de la racine.
+     */
+    const size_t nbPas_l = 16;
+    size_t res_l = 0;
+    for (size_t pas_l = 1; pas_l <= nbPas_l && getNbNodes() > maxNodes_p; ++pas_l) {
+        uint32_t threshold_l = visits_l.back() + 1;
+        if (pas_l < nbPas_l) {
+            threshold_l = visits_l[visits_l.size() * pas_l / nbPas_l];
+        }
+        res_l += collapseBelow(threshold_l, stack_l);
+    }
+    return res_l;
+}
+
+template<typename TreeImpl>
+size_t TreeALG<TreeImpl>::collapseBelow(uint32_t threshold_p, ChildrenPool &stack_p)
+{
+    size_t res_l = 0;
+    stack_p.assign(1, root());
+    while (! stack_p.empty()) {
+        iterator it_l = stack_p.back();
+        stack_p.pop_back();
+        for (size_t i_l = 0; i_l < nbChildren(it_l); ++i_l) {
+            iterator child_l = child(it_l, i_l);
+            if (! hasChildren(child_l)) {
+                continue;
+            }
+            if (child_l->nbSimu_m < threshold_p) {
+                deleteChildren(child_l);
+                ++res_l;
+            } else {
+                stack_p.push_back(child_l);
+            }
+        }
+    }
+    return res_l;
+}
+
 template<typename TreeImpl>
 typename TreeALG<TreeImpl>::iterator 
 TreeALG<TreeImpl>::addChildren(iterator &it_p, NodeContentALG &content_p)
@@ -63,6 +215,25 @@ TreeALG<TreeImpl>::children(iterator const & it_p)
     return impl_m.children(it_p);
 }
 
+template<typename TreeImpl>
+size_t TreeALG<TreeImpl>::nbChildren(iterator const & it_p)
+{
+    return impl_m.nbChildren(it_p);
+}
+
+template<typename TreeImpl>
+typename TreeALG<TreeImpl>::iterator
+TreeALG<TreeImpl>::child(iterator const & it_p, size_t idx_p)
+{
+    return impl_m.child(it_p, idx_p);
+}
+
+template<typename TreeImpl>
+NodeContentALG * TreeALG<TreeImpl>::childrenContents(iterator const & it_p)
+{
+    return impl_m.childrenContents(it_p);
+}
+
 template<typename TreeImpl>
 bool TreeALG<TreeImpl>::hasChildren(iterator const & it_p)
 {
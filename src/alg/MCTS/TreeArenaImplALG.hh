@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef TREEARENAIMPLALG_HH
+#define TREEARENAIMPLALG_HH
+
+#include <assert.h>
+#include <vector>
+#include <stdint.h>
+
+/** Iterateur sur un TreeArenaImplALG : un simple couple (arbre, indice).
+  * Contrairement a TreeSimpleIteratorALG, il ne stocke pas le chemin depuis
+  * la racine : le pere est retrouve par le lien stocke dans le noeud, et une
+  * copie ne coute donc aucune allocation.
+  */
+template<class TreeArenaImplALG>
+struct TreeArenaIteratorALG
+{
+    typedef typename TreeArenaImplALG::NodeContent NodeContent;
+
+    TreeArenaIteratorALG(TreeArenaImplALG *pTree_p, uint32_t idx_p) :
+        pTree_m(pTree_p), idx_m(idx_p)
+    {
+    }
+
+    TreeArenaIteratorALG father() const
+    {
+        return TreeArenaIteratorALG(pTree_m, pTree_m->links(idx_m).father_m);
+    }
+    bool isRoot() const {return idx_m == TreeArenaImplALG::ROOT;}
+    NodeContent &operator*() {return pTree_m->content(idx_m);}
+    const NodeContent &operator*() const {return pTree_m->content(idx_m);}
+    NodeContent *operator->() {return &pTree_m->content(idx_m);}
+    const NodeContent *operator->() const {return &pTree_m->content(idx_m);}
+
+    // should be protected
+    TreeArenaImplALG *pTree_m;
+    uint32_t idx_m;
+};
+
+/** Implementation d'arbre dont les noeuds sont ranges dans une arene
+  * decoupee en blocs de taille fixe (les noeuds ne bougent donc jamais en
+  * memoire quand l'arene grossit).
+  * Un noeud est designe par un indice 32 bits (numero de bloc, position dans
+  * le bloc). Il connait son pere, et ses fils occupent une plage contigue
+  * dont la capacite est une puissance de 2 : ajouter un fils a une plage
+  * pleine la demenage dans une plage deux fois plus grande.
+  * Chaque bloc range separement les contenus et les liens des noeuds : les
+  * contenus des fils d'un noeud (visites, evaluations) sont donc contigus
+  * et peuvent etre parcourus d'un trait lors du choix du fils a explorer.
+  * Les plages liberees (sous-arbres effaces, plages demenagees) sont
+  * chainees dans une liste libre par capacite, le chainage etant stocke dans
+  * le premier noeud de la plage : l'arbre ne fait donc d'allocation que
+  * lorsqu'il lui faut un nouveau bloc.
+  */
+template <class T>
+class TreeArenaImplALG
+{
+public:
+    typedef T NodeContent;
+    typedef TreeArenaIteratorALG<TreeArenaImplALG> iterator;
+    typedef std::vector<iterator> ChildrenPool;
+
+    // indice absent (pas de pere, pas de fils, fin de liste libre)
+    static const uint32_t NIL = 0xFFFFFFFFu;
+    static const uint32_t ROOT = 0;
+    // 2^LOG_BLOC noeuds par bloc, c'est aussi le nombre max de fils d'un noeud
+    static const uint32_t LOG_BLOC = 16;
+    static const uint32_t TAILLE_BLOC = 1u << LOG_BLOC;
+
+    TreeArenaImplALG();
+    ~TreeArenaImplALG();
+
+    iterator root();
+    void deleteNode(iterator &);
+    void deleteChildren(iterator const &);
+    iterator addChildren(iterator &, const NodeContent &);
+    bool hasChildren(iterator const &);
+    size_t nbChildren(iterator const &);
+    iterator child(iterator const &, size_t);
+    ChildrenPool children(iterator const &);
+    // contenus contigus des fils (nbChildren elements)
+    NodeContent *childrenContents(iterator const &);
+
+    // nombre de noeuds vivants dans l'arbre (racine comprise)
+    size_t getNbNodes() const;
+    // nombre de noeuds reserves par l'arene (blocs alloues)
+    size_t getCapacity() const;
+    // octets reserves par l'arene (contenus et liens de getCapacity() noeuds)
+    size_t getTailleOctets() const;
+
+    // should be potected
+    struct Links
+    {
+        Links() : father_m(NIL), firstChild_m(NIL), nbChildren_m(0), logCapa_m(0) {}
+        Links(uint32_t father_p) :
+            father_m(father_p), firstChild_m(NIL), nbChildren_m(0), logCapa_m(0)
+        {}
+        // pour une plage libre, father_m chaine vers la plage libre suivante
+        uint32_t father_m;
+        uint32_t firstChild_m;
+        uint32_t nbChildren_m;
+        // log2 de la capacite de la plage des fils (si firstChild_m != NIL)
+        uint8_t logCapa_m;
+    };
+
+    NodeContent &content(uint32_t idx_p);
+    Links &links(uint32_t idx_p);
+    const Links &links(uint32_t idx_p) const;
+
+private:
+    TreeArenaImplALG(const TreeArenaImplALG &);
+    TreeArenaImplALG &operator=(const TreeArenaImplALG &);
+
+    uint32_t allocRange(uint8_t logCapa_p);
+    void freeRange(uint32_t first_p, uint8_t logCapa_p);
+    void freeSubTree(uint32_t idx_p);
+    void moveNode(uint32_t from_p, uint32_t to_p);
+
+    std::vector<NodeContent *> contentBlocs_m;
+    std::vector<Links *> linksBlocs_m;
+    // prochain indice jamais utilise de l'arene
+    uint32_t end_m;
+    // tete des listes libres, indexees par log2 de la capacite
+    uint32_t freeHeads_m[LOG_BLOC + 1];
+    size_t nbNodes_m;
+};
+
+#endif
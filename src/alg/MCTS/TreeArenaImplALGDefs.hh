@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef TREEARENAIMPLALGDEFS_HH_
+#define TREEARENAIMPLALGDEFS_HH_
+
+#include "TreeArenaImplALG.hh"
+#include "tools/Log.hh"
+
+#include <string>
+
+template <class NodeContent> const uint32_t TreeArenaImplALG<NodeContent>::NIL;
+template <class NodeContent> const uint32_t TreeArenaImplALG<NodeContent>::ROOT;
+template <class NodeContent> const uint32_t TreeArenaImplALG<NodeContent>::LOG_BLOC;
+template <class NodeContent> const uint32_t TreeArenaImplALG<NodeContent>::TAILLE_BLOC;
+
+template <class NodeContent>
+TreeArenaImplALG<NodeContent>::TreeArenaImplALG() :
+    end_m(0),
+    nbNodes_m(1)
+{
+    for (uint32_t i_l = 0; i_l <= LOG_BLOC; ++i_l) {
+        freeHeads_m[i_l] = NIL;
+    }
+    // la racine occupe une plage de capacite 1 a l'indice ROOT
+    uint32_t root_l = allocRange(0);
+    assert(root_l == ROOT);
+    content(root_l) = NodeContent();
+    links(root_l) = Links();
+}
+
+template <class NodeContent>
+TreeArenaImplALG<NodeContent>::~TreeArenaImplALG()
+{
+    iterator root_l = root();
+    deleteNode(root_l);
+    for (size_t i_l = 0; i_l < linksBlocs_m.size(); ++i_l) {
+        delete[] contentBlocs_m[i_l];
+        delete[] linksBlocs_m[i_l];
+    }
+}
+
+template <class NodeContent>
+NodeContent & TreeArenaImplALG<NodeContent>::content(uint32_t idx_p)
+{
+    assert(idx_p < end_m);
+    return contentBlocs_m[idx_p >> LOG_BLOC][idx_p & (TAILLE_BLOC - 1)];
+}
+
+template <class NodeContent>
+typename TreeArenaImplALG<NodeContent>::Links &
+TreeArenaImplALG<NodeContent>::links(uint32_t idx_p)
+{
+    assert(idx_p < end_m);
+    return linksBlocs_m[idx_p >> LOG_BLOC][idx_p & (TAILLE_BLOC - 1)];
+}
+
+template <class NodeContent>
+const typename TreeArenaImplALG<NodeContent>::Links &
+TreeArenaImplALG<NodeContent>::links(uint32_t idx_p) const
+{
+    assert(idx_p < end_m);
+    return linksBlocs_m[idx_p >> LOG_BLOC][idx_p & (TAILLE_BLOC - 1)];
+}
+
+template <class NodeContent>
+uint32_t TreeArenaImplALG<NodeContent>::allocRange(uint8_t logCapa_p)
+{
+    assert(logCapa_p <= LOG_BLOC);
+    uint32_t res_l = freeHeads_m[logCapa_p];
+    if (res_l != NIL) {
+        freeHeads_m[logCapa_p] = links(res_l).father_m;
+        return res_l;
+    }
+
+    uint32_t capa_l = 1u << logCapa_p;
+    uint32_t reste_l = linksBlocs_m.size() * TAILLE_BLOC - end_m;
+    if (reste_l < capa_l) {
+        // une plage ne chevauche jamais deux blocs : la fin du bloc courant
+        // est rendue aux listes libres par morceaux de puissances de 2
+        while (reste_l != 0) {
+            uint8_t log_l = 0;
+            while ((2u << log_l) <= reste_l) {
+                ++log_l;
+            }
+            end_m += 1u << log_l;
+            freeRange(end_m - (1u << log_l), log_l);
+            reste_l -= 1u << log_l;
+        }
+        if (linksBlocs_m.size() == (size_t(NIL) >> LOG_BLOC)) {
+            throw std::string("TreeArenaImplALG : nombre maximal de noeuds atteint");
+        }
+        contentBlocs_m.push_back(new NodeContent[TAILLE_BLOC]);
+        linksBlocs_m.push_back(new Links[TAILLE_BLOC]);
+    }
+
+    res_l = end_m;
+    end_m += capa_l;
+    return res_l;
+}
+
+template <class NodeContent>
+void TreeArenaImplALG<NodeContent>::freeRange(uint32_t first_p, uint8_t logCapa_p)
+{
+    links(first_p).father_m = freeHeads_m[logCapa_p];
+    freeHeads_m[logCapa_p] = first_p;
+}
+
+template <class NodeContent>
+void TreeArenaImplALG<NodeContent>::moveNode(uint32_t from_p, uint32_t to_p)
+{
+    content(to_p) = content(from_p);
+    Links &to_l = links(to_p);
+    to_l = links(from_p);
+    for (uint32_t i_l = 0; i_l < to_l.nbChildren_m; ++i_l) {
+        links(to_l.firstChild_m + i_l).father_m = to_p;
+    }
+}
+
+/** Efface le contenu et les descendants du noeud idx_p, sans toucher a la
+ * plage qui le contient. Parcours postfixe iteratif a l'aide des liens vers
+ * le pere, pour ne pas dependre de la profondeur de l'arbre.
+ */
+template <class NodeContent>
+void TreeArenaImplALG<NodeContent>::freeSubTree(uint32_t idx_p)
+{
+    uint32_t current_l = idx_p;
+    while (links(current_l).nbChildren_m != 0) {
+        current_l = links(current_l).firstChild_m;
+    }
+
+    while (true) {
+        // ici, tous les descendants de current_l ont ete effaces
+        Links &node_l = links(current_l);
+        if (node_l.firstChild_m != NIL) {
+            freeRange(node_l.firstChild_m, node_l.logCapa_m);
+            nbNodes_m -= node_l.nbChildren_m;
+            node_l.firstChild_m = NIL;
+            node_l.nbChildren_m = 0;
+        }
+        content(current_l).clear();
+
+        if (current_l == idx_p) {
+            break;
+        }
+        const Links &father_l = links(node_l.father_m);
+        if (current_l + 1 < father_l.firstChild_m + father_l.nbChildren_m) {
+            current_l = current_l + 1;
+            while (links(current_l).nbChildren_m != 0) {
+                current_l = links(current_l).firstChild_m;
+            }
+        } else {
+            current_l = node_l.father_m;
+        }
+    }
+}
+
+template <class NodeContent>
+typename TreeArenaImplALG<NodeContent>::iterator 
+    TreeArenaImplALG<NodeContent>::root()
+{
+    return iterator(this, ROOT);
+}
+
+template <class NodeContent>
+void TreeArenaImplALG<NodeContent>::deleteNode(iterator &it_p)
+{
+    uint32_t idx_l = it_p.idx_m;
+    freeSubTree(idx_l);
+
+    if (idx_l != ROOT) {
+        // on retire le node de la plage de son pere en decalant ses freres
+        // suivants, pour conserver l'ordre des fils
+        Links &father_l = links(links(idx_l).father_m);
+        uint32_t end_l = father_l.firstChild_m + father_l.nbChildren_m;
+        for (uint32_t i_l = idx_l + 1; i_l < end_l; ++i_l) {
+            moveNode(i_l, i_l - 1);
+        }
+        --father_l.nbChildren_m;
+        --nbNodes_m;
+        if (father_l.nbChildren_m == 0) {
+            freeRange(father_l.firstChild_m, father_l.logCapa_m);
+            father_l.firstChild_m = NIL;
+        }
+    }
+
+    // clear the iterator for bug visibility
+    it_p.idx_m = NIL;
+}
+
+template <class NodeContent>
+void TreeArenaImplALG<NodeContent>::deleteChildren(const iterator &it_p)
+{
+    Links &node_l = links(it_p.idx_m);
+    if (node_l.firstChild_m == NIL) {
+        return;
+    }
+    for (uint32_t i_l = 0; i_l < node_l.nbChildren_m; ++i_l) {
+        freeSubTree(node_l.firstChild_m + i_l);
+    }
+    // les fils ne bougent pas : seule leur plage est rendue a l'arene
+    freeRange(node_l.firstChild_m, node_l.logCapa_m);
+    nbNodes_m -= node_l.nbChildren_m;
+    node_l.firstChild_m = NIL;
+    node_l.nbChildren_m = 0;
+}
+
+template <class NodeContent>
+typename TreeArenaImplALG<NodeContent>::iterator
+TreeArenaImplALG<NodeContent>::addChildren(iterator &it_p,
+                                           const NodeContent &content_p)
+{
+    uint32_t idx_l = it_p.idx_m;
+    uint32_t nb_l = links(idx_l).nbChildren_m;
+
+    if (links(idx_l).firstChild_m == NIL) {
+        links(idx_l).firstChild_m = allocRange(0);
+        links(idx_l).logCapa_m = 0;
+    } else if (nb_l == (1u << links(idx_l).logCapa_m)) {
+        // plage pleine : on demenage les fils dans une plage deux fois plus grande
+        uint8_t logCapa_l = links(idx_l).logCapa_m;
+        if (logCapa_l == LOG_BLOC) {
+            throw std::string("TreeArenaImplALG : nombre maximal de fils atteint");
+        }
+        uint32_t newFirst_l = allocRange(logCapa_l + 1);
+        uint32_t oldFirst_l = links(idx_l).firstChild_m;
+        for (uint32_t i_l = 0; i_l < nb_l; ++i_l) {
+            moveNode(oldFirst_l + i_l, newFirst_l + i_l);
+        }
+        freeRange(oldFirst_l, logCapa_l);
+        links(idx_l).firstChild_m = newFirst_l;
+        links(idx_l).logCapa_m = logCapa_l + 1;
+    }
+
+    Links &father_l = links(idx_l);
+    uint32_t child_l = father_l.firstChild_m + nb_l;
+    content(child_l) = content_p;
+    links(child_l) = Links(idx_l);
+    ++father_l.nbChildren_m;
+    ++nbNodes_m;
+
+    return iterator(this, child_l);
+}
+
+template <class NodeContent>
+bool TreeArenaImplALG<NodeContent>::hasChildren(const iterator & it_p)
+{
+    return links(it_p.idx_m).nbChildren_m != 0;
+}
+
+template <class NodeContent>
+size_t TreeArenaImplALG<NodeContent>::nbChildren(const iterator & it_p)
+{
+    return links(it_p.idx_m).nbChildren_m;
+}
+
+template <class NodeContent>
+typename TreeArenaImplALG<NodeContent>::iterator
+    TreeArenaImplALG<NodeContent>::child(const iterator & it_p, size_t idx_p)
+{
+    assert(idx_p < links(it_p.idx_m).nbChildren_m);
+    return iterator(this, links(it_p.idx_m).firstChild_m + idx_p);
+}
+
+template <class NodeContent>
+typename TreeArenaImplALG<NodeContent>::ChildrenPool 
+    TreeArenaImplALG<NodeContent>::children(const iterator & it_p)
+{
+    ChildrenPool pool_l;
+    const Links &node_l = links(it_p.idx_m);
+
+    pool_l.reserve(node_l.nbChildren_m);
+    for (uint32_t i_l = 0; i_l < node_l.nbChildren_m; ++i_l) {
+        pool_l.push_back(iterator(this, node_l.firstChild_m + i_l));
+    }
+    
+    return pool_l;
+}
+
+template <class NodeContent>
+size_t TreeArenaImplALG<NodeContent>::getNbNodes() const
+{
+    return nbNodes_m;
+}
+
+template <class NodeContent>
+size_t TreeArenaImplALG<NodeContent>::getCapacity() const
+{
+    return linksBlocs_m.size() * TAILLE_BLOC;
+}
+
+template <class NodeContent>
+size_t TreeArenaImplALG<NodeContent>::getTailleOctets() const
+{
+    return getCapacity() * (sizeof(NodeContent) + sizeof(Links));
+}
+
+template <class NodeContent>
+NodeContent * TreeArenaImplALG<NodeContent>::childrenContents(const iterator & it_p)
+{
+    const Links &node_l = links(it_p.idx_m);
+    if (node_l.nbChildren_m == 0) {
+        return 0;
+    }
+    return &content(node_l.firstChild_m);
+}
+
+#endif //TREEARENAIMPLALGDEFS_HH_
@@ -81,8 +81,12 @@ public:
 
     iterator root();
     void deleteNode(iterator &);
+    void deleteChildren(iterator const &);
+    size_t getNbNodes() const;
     iterator addChildren(iterator &, const NodeContent &);
     bool hasChildren(iterator const &);
+    size_t nbChildren(iterator const &);
+    iterator child(iterator const &, size_t);
     ChildrenPool children(iterator const &);
     
     // should be potected
@@ -99,6 +103,7 @@ public:
     typedef typename Node::ChildrenList ChildrenList;    
 protected:
     Node root_m;
+    size_t nbNodes_m;
 };
 
 #endif
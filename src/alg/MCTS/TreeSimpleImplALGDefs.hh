@@ -41,7 +41,8 @@ TreeSimpleIteratorALG<TreeSimpleImplALG>::father() const
 
 
 template <class NodeContent>
-TreeSimpleImplALG<NodeContent>::TreeSimpleImplALG()
+TreeSimpleImplALG<NodeContent>::TreeSimpleImplALG() :
+    nbNodes_m(1)
 {
 }
 
@@ -76,6 +77,7 @@ void TreeSimpleImplALG<NodeContent>::deleteNode(iterator &it_p)
         ChildrenList &cl_l = it_p.path_m.back().first->children_m;
         size_t idx_l = it_p.path_m.back().second;
         cl_l.erase(cl_l.begin() + idx_l);
+        --nbNodes_m;
     }
 
     // clear the iterator for bug visibility
@@ -83,11 +85,27 @@ void TreeSimpleImplALG<NodeContent>::deleteNode(iterator &it_p)
     it_p.path_m.clear();
 }
 
+template <class NodeContent>
+void TreeSimpleImplALG<NodeContent>::deleteChildren(const iterator &it_p)
+{
+    while (it_p.pNode_m->children_m.size() != 0) {
+        iterator itChild_l(it_p, 0);
+        deleteNode(itChild_l);
+    }
+}
+
+template <class NodeContent>
+size_t TreeSimpleImplALG<NodeContent>::getNbNodes() const
+{
+    return nbNodes_m;
+}
+
 template <class NodeContent>
 typename TreeSimpleImplALG<NodeContent>::iterator
 TreeSimpleImplALG<NodeContent>::addChildren(iterator &it_p,
                                             const NodeContent &content_p)
 {
+    ++nbNodes_m;
     it_p.pNode_m->children_m.push_back(Node(content_p,ChildrenList()));
     return iterator(it_p, it_p.pNode_m->children_m.size() - 1);
 }
@@ -98,6 +116,19 @@ bool TreeSimpleImplALG<NodeContent>::hasChildren(const iterator & it_p)
 	return (it_p.pNode_m->children_m.size() != 0);
 }
 
+template <class NodeContent>
+size_t TreeSimpleImplALG<NodeContent>::nbChildren(const iterator & it_p)
+{
+    return it_p.pNode_m->children_m.size();
+}
+
+template <class NodeContent>
+typename TreeSimpleImplALG<NodeContent>::iterator
+    TreeSimpleImplALG<NodeContent>::child(const iterator & it_p, size_t idx_p)
+{
+    return iterator(it_p, idx_p);
+}
+
 template <class NodeContent>
 typename TreeSimpleImplALG<NodeContent>::ChildrenPool 
     TreeSimpleImplALG<NodeContent>::children(const iterator & it_p)
@@ -1,43 +0,0 @@
-/*
- * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
- * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
- * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
- * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
- * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
- * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
- * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
- *
- * Permission to use, copy, modify, and/or distribute this software for any
- * purpose with or without fee is hereby granted, provided that the above
- * copyright notice and this permission notice appear in all copies.
- *
- * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
- * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
- * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
- * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
- * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
- * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
- * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
- *
- */
-
-#include "CPDecisionALG.hh"
-
-CPDecisionALG::CPDecisionALG() : target_m(-1), min_m(-1), max_m(-1)
-{
-}
-
-CPDecisionALG::CPDecisionALG(ProcessId target_p, MachineId min_p, MachineId max_p) :
-    target_m(target_p), min_m(min_p), max_m(max_p)
-{
-}
-
-RestrictionALG * CPDecisionALG::getRestriction(SolutionALG *) const
-{
-    return 0;
-}
-
-bool CPDecisionALG::workOnProcess(ProcessId proc_p) const
-{
-    return target_m == proc_p;
-}
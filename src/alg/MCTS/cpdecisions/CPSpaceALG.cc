@@ -26,9 +26,9 @@
 #include "CPSpaceALG.hh"
 #include "alg/ContextALG.hh"
 #include "dtoout/SolutionDtoout.hh"
-#include "bo/ProcessBO.hh"
-#include "bo/MachineBO.hh"
-#include "tools/Checker.hh"
+#include "bo/InstanceCoreBO.hh"
+#include "tools/FusedChecker.hh"
+#include "tools/IncrementalEvaluator.hh"
 #include "tools/Log.hh"
 
 #include <algorithm>
@@ -89,13 +89,10 @@ CPSpaceALG::DecisionsPool CPSpaceALG::generateDecisions() const
         return pGecodeSpace_m->generateDecisions();
 }
 
-void CPSpaceALG::addDecision(DecisionALG *pDecision_p)
+void CPSpaceALG::addDecision(const DecisionALG &decision_p)
 {
-    assert(dynamic_cast<const CPDecisionALG*>(pDecision_p));
-
     if (pGecodeSpace_m) {
-        const CPDecisionALG *pCPD_l = static_cast<const CPDecisionALG*>(pDecision_p);
-        pGecodeSpace_m->addDecision(pCPD_l);
+        pGecodeSpace_m->addDecision(decision_p);
     }
 }
 
@@ -114,17 +111,19 @@ std::vector<int> permutation(const ContextBO *pContext_p)
     vector<double> size_l(nbProc_l);
     vector<int> perm_l(nbProc_l);
 
+    const boost::shared_ptr<InstanceCoreBO const> pCore_l = pContext_p->getInstanceCore();
+    const vector<int> &capas_l = pCore_l->getCapas();
+    const vector<int> &requirements_l = pCore_l->getRequirements();
+
     for (int mach_l = 0; mach_l < nbMach_l; ++mach_l) {
-        MachineBO *pMach_l = pContext_p->getMachine(mach_l);
         for (int res_l = 0; res_l < nbRes_l; ++res_l)
-            resScale_l[res_l] += pMach_l->getCapa(res_l);
+            resScale_l[res_l] += capas_l[mach_l * nbRes_l + res_l];
     }
 
     for (int proc_l = 0; proc_l < nbProc_l; ++proc_l) {
-        ProcessBO *pProc_l = pContext_p->getProcess(proc_l);
         perm_l[proc_l] = proc_l;
         for (int res_l = 0; res_l < nbRes_l; ++res_l)
-            size_l[proc_l] += (double) pProc_l->getRequirement(res_l) / resScale_l[res_l];
+            size_l[proc_l] += (double) requirements_l[proc_l * nbRes_l + res_l] / resScale_l[res_l];
     }
 
     Comp comp_l(size_l);
@@ -183,9 +182,13 @@ uint64_t CPSpaceALG::localsearch(std::vector<int> bestSol_p) const
     int nbProc_l = pContext_m->getContextBO()->getNbProcesses();
     int lastImprovedProc_l = 0;
     int aProc_l = nbProc_l - 1;
-    Checker checker_l(pContext_m->getContextBO(), bestSol_p);
-    assert(checker_l.isValid());
-    uint64_t bestEval_l = checker_l.computeScore();
+    assert(pContext_m->getFusedChecker()->evaluate(bestSol_p).valid);
+    // les voisins ne different de bestSol_p que par les procs liberes : on
+    // les evalue incrementalement plutot que de tout recalculer
+    IncrementalEvaluator evaluator_l(pContext_m->getContextBO(), bestSol_p);
+    uint64_t bestEval_l = evaluator_l.getScore();
+    int nbMachines_l = pContext_m->getContextBO()->getNbMachines();
+    MachineSweep::Result sweep_l;
     Search::MemoryStop stop_l(256 * 1024 * 1024);
     Search::Options options_l;
     options_l.stop = &stop_l;
@@ -203,28 +206,40 @@ uint64_t CPSpaceALG::localsearch(std::vector<int> bestSol_p) const
 
         do {
             int proc_l = perm_m[aProc_l];
-            GecodeSpace *pCurSpace_l = pSpace_l->safeClone();
-            pCurSpace_l->restrictExceptProc(proc_l, bestSol_p, perm_m);
 
-            DFS<GecodeSpace> search_l(pCurSpace_l, options_l);
+            // un seul balayage de toutes les machines : inutile de lancer la
+            // recherche si aucune machine sur laquelle proc_l tient n'ameliore le score
+            evaluator_l.evaluateAllMachines(proc_l, sweep_l);
+            bool improvable_l = false;
+            for (int machine_l = 0; machine_l < nbMachines_l && !improvable_l; ++machine_l) {
+                improvable_l = sweep_l.fit[machine_l] && sweep_l.getDelta(machine_l) < 0;
+            }
 
-            GecodeSpace *pSol_l = 0;
+            if (improvable_l) {
+                GecodeSpace *pCurSpace_l = pSpace_l->safeClone();
+                pCurSpace_l->restrictExceptProc(proc_l, bestSol_p, perm_m);
 
-            while ((pSol_l = search_l.next()) != 0) {
-                std::vector<int> sol_l = pSol_l->solution(perm_m);
+                DFS<GecodeSpace> search_l(pCurSpace_l, options_l);
 
-                delete pSol_l;
-                Checker checker_l(pContext_m->getContextBO(), sol_l);
-                assert(checker_l.isValid());
-                uint64_t eval_l = checker_l.computeScore();
+                GecodeSpace *pSol_l = 0;
 
-                if (eval_l < bestEval_l) {
-                    bestEval_l = eval_l;
-                    bestSol_p = sol_l;
-                    foundBetter_l = true;
-                    lastImprovedProc_l = aProc_l;
-                    if (SolutionDtoout::writeSol(bestSol_p, bestEval_l)) {
-                        LOG(INFO) << "Better solution: " << bestEval_l << endl;
+                while ((pSol_l = search_l.next()) != 0) {
+                    std::vector<int> sol_l = pSol_l->solution(perm_m);
+
+                    delete pSol_l;
+                    // seul proc_l peut avoir bouge par rapport a bestSol_p
+                    int64_t delta_l = evaluator_l.computeDeltaMove(proc_l, sol_l[proc_l]);
+
+                    if (delta_l < 0) {
+                        evaluator_l.applyMove(proc_l, sol_l[proc_l]);
+                        evaluator_l.clearJournal();
+                        bestEval_l = evaluator_l.getScore();
+                        bestSol_p = evaluator_l.getCurrentSol();
+                        foundBetter_l = true;
+                        lastImprovedProc_l = aProc_l;
+                        if (SolutionDtoout::writeSol(bestSol_p, bestEval_l)) {
+                            LOG(INFO) << "Better solution: " << bestEval_l << endl;
+                        }
                     }
                 }
             }
@@ -247,9 +262,11 @@ uint64_t CPSpaceALG::localsearch2(std::vector<int> bestSol_p) const
     int maxIter_l = 100;
     int lastImprovedProc_l = 0;
     int aProc_l = nbProc_l - 1;
-    Checker checker_l(pContext_m->getContextBO(), bestSol_p);
-    assert(checker_l.isValid());
-    uint64_t bestEval_l = checker_l.computeScore();
+    assert(pContext_m->getFusedChecker()->evaluate(bestSol_p).valid);
+    // les voisins ne different de bestSol_p que par les procs liberes : on
+    // les evalue incrementalement plutot que de tout recalculer
+    IncrementalEvaluator evaluator_l(pContext_m->getContextBO(), bestSol_p);
+    uint64_t bestEval_l = evaluator_l.getScore();
     Search::MemoryStop stop_l(256 * 1024 * 1024);
     Search::Options options_l;
     options_l.stop = &stop_l;
@@ -325,13 +342,19 @@ uint64_t CPSpaceALG::localsearch2(std::vector<int> bestSol_p) const
                 std::vector<int> sol_l = pSol_l->solution(perm_m);
 
                 delete pSol_l;
-                Checker checker_l(pContext_m->getContextBO(), sol_l);
-                assert(checker_l.isValid());
-                uint64_t eval_l = checker_l.computeScore();
+                // on joue les mouvements des procs liberes, quitte a les annuler ensuite
+                for (int idxProc=vProcFree_l.size();--idxProc>=0;) {
+                    int proc_l = vProcFree_l[idxProc];
+                    evaluator_l.applyMove(proc_l, sol_l[proc_l]);
+                }
+                uint64_t eval_l = evaluator_l.getScore();
 
-                if (eval_l < bestEval_l) {
+                if (eval_l >= bestEval_l) {
+                    evaluator_l.rollback(0);
+                } else {
+                    evaluator_l.clearJournal();
                     bestEval_l = eval_l;
-                    bestSol_p = sol_l;
+                    bestSol_p = evaluator_l.getCurrentSol();
                     foundBetter_l = true;
                     lastImprovedProc_l = aProc_l;
                     if (SolutionDtoout::writeSol(bestSol_p, bestEval_l)) {
@@ -25,7 +25,7 @@
 #define CPSPACEALG_HH
 
 #include "src/alg/MCTS/SpaceALG.hh"
-#include "CPDecisionALG.hh"
+#include "src/alg/MCTS/DecisionALG.hh"
 #include "GecodeSpace.hh"
 
 class CPSpaceALG : public SpaceALG
@@ -38,7 +38,7 @@ public:
     virtual SpaceALG *clone();
 
     typedef SpaceALG::DecisionsPool DecisionsPool;
-    virtual void addDecision(DecisionALG *);
+    virtual void addDecision(const DecisionALG &);
     virtual DecisionsPool generateDecisions() const;
     virtual bool isSolution() const;
     virtual void setpContext(ContextALG *);
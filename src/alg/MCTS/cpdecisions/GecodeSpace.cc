@@ -24,12 +24,7 @@
 #ifdef USE_GECODE
 
 #include "GecodeSpace.hh"
-#include "bo/LocationBO.hh"
-#include "bo/MachineBO.hh"
-#include "bo/NeighborhoodBO.hh"
-#include "bo/ProcessBO.hh"
-#include "bo/RessourceBO.hh"
-#include "bo/ServiceBO.hh"
+#include "bo/InstanceCoreBO.hh"
 #include "tools/Log.hh"
 
 #include <gecode/minimodel.hh>
@@ -46,7 +41,8 @@ GecodeSpace::GecodeSpace(const ContextBO *pContext_p, const vector<int> &perm_p)
 {
     int nbProc_l = pContext_p->getNbProcesses();
     int nbMach_l = pContext_p->getNbMachines();
-    const Solution &solInit_l = pContext_p->getSolInit();
+    const boost::shared_ptr<InstanceCoreBO const> pCore_l = pContext_p->getInstanceCore();
+    const Solution &solInit_l = pCore_l->getSolInit();
 
     // nbUnmovedProcs_m
     IntArgs solInitArgs_l(nbProc_l);
@@ -110,20 +106,21 @@ void GecodeSpace::capacity(const ContextBO *pContext_p, const vector<int> &perm_
     int nbProc_l = pContext_p->getNbProcesses();
     int nbMach_l = pContext_p->getNbMachines();
     int nbRes_l = pContext_p->getNbRessources();
+    const boost::shared_ptr<InstanceCoreBO const> pCore_l = pContext_p->getInstanceCore();
+    const vector<int> &capas_l = pCore_l->getCapas();
+    const vector<int> &requirements_l = pCore_l->getRequirements();
 
     for (int res_l = 0; res_l < nbRes_l; ++res_l) {
         IntVarArgs load_l(*this, nbMach_l, 0, Int::Limits::max);
         for (int mach_l = 0; mach_l < nbMach_l; ++mach_l) {
-            MachineBO *pMach_l = pContext_p->getMachine(mach_l);
-            int capa_l = pMach_l->getCapa(res_l);
+            int capa_l = capas_l[mach_l * nbRes_l + res_l];
             rel(*this, load_l[mach_l], IRT_LQ, capa_l);
         }
 
         IntArgs sizes_l(nbProc_l);
         int totalSize_l = 0;
         for (int proc_l = 0; proc_l < nbProc_l; ++proc_l) {
-            ProcessBO *pProc_l = pContext_p->getProcess(proc_l);
-            int req_l = pProc_l->getRequirement(res_l);
+            int req_l = requirements_l[proc_l * nbRes_l + res_l];
             sizes_l[perm_p[proc_l]] = req_l;
             totalSize_l += req_l;
         }
@@ -148,21 +145,19 @@ void GecodeSpace::capacity(const ContextBO *pContext_p, const vector<int> &perm_
     // we do an agregated resource on each machine to combine knowledge
     IntVarArgs load_l(*this, nbMach_l, 0, Int::Limits::max);
     for (int mach_l = 0; mach_l < nbMach_l; ++mach_l) {
-        MachineBO *pMach_l = pContext_p->getMachine(mach_l);
         int capa_l = 0;
         for (int res_l = 0; res_l < nbRes_l; ++res_l)
-            capa_l += pMach_l->getCapa(res_l);
+            capa_l += capas_l[mach_l * nbRes_l + res_l];
         rel(*this, load_l[mach_l], IRT_LQ, capa_l);
     }
 
     IntArgs sizes_l(nbProc_l);
     int totalSize_l = 0;
     for (int proc_l = 0; proc_l < nbProc_l; ++proc_l) {
-        ProcessBO *pProc_l = pContext_p->getProcess(proc_l);
         int machSize_l = 0;
 
         for (int res_l = 0; res_l < nbRes_l; ++res_l)
-            machSize_l += pProc_l->getRequirement(res_l);
+            machSize_l += requirements_l[proc_l * nbRes_l + res_l];
 
         totalSize_l += machSize_l;
         sizes_l[perm_p[proc_l]] = machSize_l;
@@ -176,17 +171,17 @@ void GecodeSpace::capacity(const ContextBO *pContext_p, const vector<int> &perm_
 void GecodeSpace::conflict(const ContextBO *pContext_p, const vector<int> &perm_p)
 {
     int nbServ_l = pContext_p->getNbServices();
+    const boost::shared_ptr<InstanceCoreBO const> pCore_l = pContext_p->getInstanceCore();
+    const IndexCSR &processesByService_l = pCore_l->getProcessesByService();
 
     for (int serv_l = 0; serv_l < nbServ_l; ++serv_l) {
-        ServiceBO *pServ_l = pContext_p->getService(serv_l);
-        typedef unordered_set<int> IntSet;
-        IntSet s_l = pServ_l->getProcesses();
+        IndexCSR::Plage s_l = processesByService_l.getLigne(serv_l);
         IntVarArgs machine_l;
 
-        if (s_l.size() < 2)
+        if (s_l.second - s_l.first < 2)
             continue;
 
-        for (IntSet::const_iterator it_l = s_l.begin(); it_l != s_l.end(); ++it_l)
+        for (const int *it_l = s_l.first; it_l != s_l.second; ++it_l)
             machine_l << machine_m[perm_p[*it_l]];
 
         distinct(*this, machine_l);
@@ -205,11 +200,10 @@ void GecodeSpace::spread(const ContextBO *pContext_p, const vector<int> &perm_p)
 
     // creation of location_l[proc] -> location corresponding to the
     // proc
+    const boost::shared_ptr<InstanceCoreBO const> pCore_l = pContext_p->getInstanceCore();
     IntArgs machToLoc_l;
-    for (int mach_l = 0; mach_l < nbMach_l; ++mach_l) {
-        MachineBO *pMach_l = pContext_p->getMachine(mach_l);
-        machToLoc_l <<  pMach_l->getLocation()->getId();
-    }
+    for (int mach_l = 0; mach_l < nbMach_l; ++mach_l)
+        machToLoc_l << pCore_l->getMachineLocation()[mach_l];
     IntSharedArray sMachToLoc_l(machToLoc_l);
     IntVarArgs location_l(*this, nbProc_l, 0, nbLoc_l - 1);
     for (int proc_l = 0; proc_l < nbProc_l; ++proc_l)
@@ -217,16 +211,14 @@ void GecodeSpace::spread(const ContextBO *pContext_p, const vector<int> &perm_p)
 
 
     for (int serv_l = 0; serv_l < nbServ_l; ++serv_l) {
-        ServiceBO *pServ_l = pContext_p->getService(serv_l);
-        int spreadMin_l = pServ_l->getSpreadMin();
+        int spreadMin_l = pCore_l->getSpreadMin()[serv_l];
 
         if (spreadMin_l < 2)
             continue;
 
-        typedef unordered_set<int> IntSet;
-        IntSet s_l = pServ_l->getProcesses();
+        IndexCSR::Plage s_l = pCore_l->getProcessesByService().getLigne(serv_l);
         IntVarArgs servLoc_l;
-        for (IntSet::const_iterator it_l = s_l.begin(); it_l != s_l.end(); ++it_l)
+        for (const int *it_l = s_l.first; it_l != s_l.second; ++it_l)
             servLoc_l << location_l[perm_p[*it_l]];
 
         nvalues(*this, servLoc_l, IRT_GQ,  spreadMin_l);
@@ -242,11 +234,11 @@ void GecodeSpace::dependency(const ContextBO *pContext_p, const vector<int> &per
  
     // creation of neighborhood_l[proc] -> neighborhood corresponding to the
     // proc
+    const boost::shared_ptr<InstanceCoreBO const> pCore_l = pContext_p->getInstanceCore();
+    const vector<int> &machineNeigh_l = pCore_l->getMachineNeighborhood();
     IntArgs machToNeigh_l;
-    for (int mach_l = 0; mach_l < nbMach_l; ++mach_l) {
-        MachineBO *pMach_l = pContext_p->getMachine(mach_l);
-        machToNeigh_l <<  pMach_l->getNeighborhood()->getId();
-    }
+    for (int mach_l = 0; mach_l < nbMach_l; ++mach_l)
+        machToNeigh_l << machineNeigh_l[mach_l];
     IntSharedArray sMachToNeigh_l(machToNeigh_l);
     IntVarArgs neighborhood_l(*this, nbProc_l, 0, nbNeigh_l - 1);
     for (int proc_l = 0; proc_l < nbProc_l; ++proc_l)
@@ -257,20 +249,17 @@ void GecodeSpace::dependency(const ContextBO *pContext_p, const vector<int> &per
     SetVarArray neighborhoods_l(*this, nbServ_l,
                                 IntSet::empty, IntSet(0, nbNeigh_l - 1));
     for (int serv_l = 0; serv_l < nbServ_l; ++serv_l) {
-        ServiceBO *pServ_l = pContext_p->getService(serv_l);
-        typedef unordered_set<int> IntSet;
-        IntSet s_l = pServ_l->getProcesses();
+        IndexCSR::Plage s_l = pCore_l->getProcessesByService().getLigne(serv_l);
         IntVarArgs servNeigh_l;
-        for (IntSet::const_iterator it_l = s_l.begin(); it_l != s_l.end(); ++it_l)
+        for (const int *it_l = s_l.first; it_l != s_l.second; ++it_l)
             servNeigh_l << neighborhood_l[perm_p[*it_l]];
 
         channel(*this, servNeigh_l, neighborhoods_l[serv_l]);
 
         // s1 depends on s2 <=> neighborhoods_l[s1] is included in
         // neighborhoods_l[s2]
-        IntSet depend_l = pServ_l->getServicesIDependOn();
-        for (IntSet::const_iterator it_l = depend_l.begin();
-             it_l != depend_l.end(); ++it_l)
+        IndexCSR::Plage depend_l = pCore_l->getServicesIDependOn().getLigne(serv_l);
+        for (const int *it_l = depend_l.first; it_l != depend_l.second; ++it_l)
             rel(*this, neighborhoods_l[serv_l], SRT_SUB, neighborhoods_l[*it_l]);
     }
 }
@@ -280,11 +269,13 @@ void GecodeSpace::transient(const ContextBO *pContext_p, const vector<int> &perm
     int nbProc_l = pContext_p->getNbProcesses();
     int nbMach_l = pContext_p->getNbMachines();
     int nbRes_l = pContext_p->getNbRessources();
-    const Solution& solInit_l = pContext_p->getSolInit();
+    const boost::shared_ptr<InstanceCoreBO const> pCore_l = pContext_p->getInstanceCore();
+    const Solution& solInit_l = pCore_l->getSolInit();
+    const vector<int> &capas_l = pCore_l->getCapas();
+    const vector<int> &requirements_l = pCore_l->getRequirements();
 
     for (int res_l = 0; res_l < nbRes_l; ++res_l) {
-        RessourceBO *pRes_l = pContext_p->getRessource(res_l);
-        if (! pRes_l->isTransient())
+        if (! pCore_l->getIsTransient()[res_l])
             continue;
 
         /*
@@ -294,15 +285,13 @@ void GecodeSpace::transient(const ContextBO *pContext_p, const vector<int> &perm
         IntVarArgs load_l(*this, nbMach_l, 0, Int::Limits::max);
  
         for (int mach_l = 0; mach_l < nbMach_l; ++mach_l) {
-            MachineBO *pMach_l = pContext_p->getMachine(mach_l);
-            int capa_l = pMach_l->getCapa(res_l);
+            int capa_l = capas_l[mach_l * nbRes_l + res_l];
             IntArgs sizes_l;
             BoolVarArgs otherProc_l;
             int unremovableCapa_l = 0;
 
             for (int proc_l = 0; proc_l < nbProc_l; ++proc_l) {
-                ProcessBO *pProc_l = pContext_p->getProcess(proc_l);
-                int req_l = pProc_l->getRequirement(res_l);
+                int req_l = requirements_l[proc_l * nbRes_l + res_l];
                 if (solInit_l[proc_l] == mach_l)
                     unremovableCapa_l += req_l;
                 else {
@@ -325,9 +314,9 @@ void GecodeSpace::transient(const ContextBO *pContext_p, const vector<int> &perm
 /*
  * Decision management
  */
-void GecodeSpace::addDecision(const CPDecisionALG *pDecision_p)
+void GecodeSpace::addDecision(const DecisionALG &decision_p)
 {
-    dom(*this, machine_m[pDecision_p->target_m], pDecision_p->min_m, pDecision_p->max_m);
+    dom(*this, machine_m[decision_p.target_m], decision_p.min_m, decision_p.max_m);
 }
 
 GecodeSpace::DecisionPool GecodeSpace::generateDecisions()
@@ -346,8 +335,9 @@ GecodeSpace::DecisionPool GecodeSpace::generateDecisions()
     assert(machine_m[target_l].size() > 1);
 
     // for the moment, simple median branching
-    res_l.push_back(new CPDecisionALG(target_l, machine_m[target_l].min(), machine_m[target_l].med()));
-    res_l.push_back(new CPDecisionALG(target_l, machine_m[target_l].med() + 1, machine_m[target_l].max()));
+    res_l.reserve(2);
+    res_l.push_back(DecisionALG(target_l, machine_m[target_l].min(), machine_m[target_l].med()));
+    res_l.push_back(DecisionALG(target_l, machine_m[target_l].med() + 1, machine_m[target_l].max()));
 
     return res_l;
 }
@@ -24,7 +24,7 @@
 #ifndef GECODESPACE_HH_
 #define GECODESPACE_HH_
 
-#include "CPDecisionALG.hh"
+#include "src/alg/MCTS/DecisionALG.hh"
 #include "bo/ContextBO.hh"
 #include <gecode/int.hh>
 #include <gecode/minimodel.hh>
@@ -49,8 +49,8 @@ public:
     void transient(const ContextBO*, const vector<int>&, Gecode::Matrix<Gecode::BoolVarArgs>&);
 
     // Decision management
-    void addDecision(const CPDecisionALG*);
-    typedef std::vector<DecisionALG*> DecisionPool;
+    void addDecision(const DecisionALG&);
+    typedef std::vector<DecisionALG> DecisionPool;
     DecisionPool generateDecisions();
     bool isSolution();
 
@@ -22,18 +22,23 @@
  */
 
 #include "OPPMSpaceALG.hh"
-#include "OPPMDecisionALG.hh"
 
 #include "alg/ContextALG.hh"
 #include "alg/MCTS/DecisionALG.hh"
 #include "bo/ContextBO.hh"
+#include "bo/InstanceCoreBO.hh"
+#include "bo/MMCBO.hh"
 #include "tools/Log.hh"
+#include <cassert>
 #include <list>
 
 #include <iostream>
 using namespace std;
 
-OPPMSpaceALG::OPPMSpaceALG()
+OPPMSpaceALG::OPPMSpaceALG() :
+    nbDecided_m(0),
+    cursor_m(0),
+    coutMouvements_m(0)
 {
 }
 
@@ -43,38 +48,74 @@ OPPMSpaceALG::~OPPMSpaceALG()
 
 SpaceALG * OPPMSpaceALG::clone()
 {
-    OPPMSpaceALG * pClone_l = new OPPMSpaceALG;
+    // copie des decisions et du suivi des process decides (sans masque tant
+    // que les decisions suivent l'ordre des process)
+    OPPMSpaceALG * pClone_l = new OPPMSpaceALG(*this);
     pClone_l->setpContext(getpContext());
-    pClone_l->setpConstraintSystem(pConstraintSystem_m);
-    pClone_l->setpEvaluationSystem(pEvaluationSystem_m);
-    
-    // transmission des decisions, memoire gerer par l'arbre
-    for(DecisionsPool::iterator it_l = decisions_m.begin();
-                                it_l != decisions_m.end();
-                                ++it_l )
-    {
-        pClone_l->decisions_m.push_back(*it_l);
-    }
     return pClone_l;
 }
 
-bool OPPMSpaceALG::isSolution() const
+int OPPMSpaceALG::getNbProcesses() const
 {
-    ContextBO const * pContext_l = getpContext()->getContextBO();
-    int nbProcesses_l = pContext_l->getNbProcesses();
-    for(int process_l = 0; process_l < nbProcesses_l; ++process_l)
-    {
-        bool dontAppearInDecisions_l = true;
-        for (DecisionsPool::const_iterator it_l = decisions_m.begin();
-             it_l != decisions_m.end(); ++it_l) {
-            if ( (*it_l)->workOnProcess(process_l)) {
-                dontAppearInDecisions_l = false;
-                break;
-            }
+    return getpContext()->getContextBO()->getNbProcesses();
+}
+
+void OPPMSpaceALG::addDecision(const DecisionALG & decision_p)
+{
+    SpaceALG::addDecision(decision_p);
+
+    int nbProcesses_l = getNbProcesses();
+    int target_l = decision_p.target_m;
+    assert(0 <= target_l && target_l < nbProcesses_l);
+    if (target_l < cursor_m) {
+        // process deja decide
+        return;
+    }
+    if (target_l > cursor_m) {
+        if (decidedAhead_m.empty()) {
+            decidedAhead_m.resize(nbProcesses_l, false);
         }
-        if (dontAppearInDecisions_l) {
-            return false;
+        if (! decidedAhead_m[target_l]) {
+            decidedAhead_m[target_l] = true;
+            ++nbDecided_m;
+            ajouteCoutMouvement(decision_p);
         }
+        return;
+    }
+
+    ++nbDecided_m;
+    ajouteCoutMouvement(decision_p);
+    ++cursor_m;
+    // le curseur ne recule jamais : O(1) amorti sur une descente
+    while (cursor_m < nbProcesses_l && ! decidedAhead_m.empty()
+           && decidedAhead_m[cursor_m]) {
+        ++cursor_m;
+    }
+}
+
+void OPPMSpaceALG::ajouteCoutMouvement(const DecisionALG & decision_p)
+{
+    InstanceCoreBO const * pCore_l = getpContext()->getInstanceCore().get();
+    int process_l = decision_p.target_m;
+    int machineInit_l = pCore_l->getSolInit()[process_l];
+    // une decision OPPM fixe une seule machine
+    int machine_l = decision_p.min_m;
+    if (machineInit_l < 0 || machine_l == machineInit_l) {
+        return;
+    }
+    coutMouvements_m += (uint64_t) pCore_l->getPoidsPMC() * pCore_l->getPMC()[process_l]
+        + (uint64_t) pCore_l->getPoidsMMC() * pCore_l->getMMCBO()->getCost(machineInit_l, machine_l);
+}
+
+SpaceALG::BoundValue OPPMSpaceALG::bound() const
+{
+    return (BoundValue) coutMouvements_m;
+}
+
+bool OPPMSpaceALG::isSolution() const
+{
+    if (nbDecided_m < getNbProcesses()) {
+        return false;
     }
 
     LOG(DEBUG) << "on a une solution" << std::endl;
@@ -85,41 +126,20 @@ bool OPPMSpaceALG::isSolution() const
 OPPMSpaceALG::DecisionsPool OPPMSpaceALG::generateDecisions() const
 {
     ContextBO const * pContext_l = getpContext()->getContextBO();
-    int target_l = -1;
-    int nbProcesses_l = pContext_l->getNbProcesses();
-    for(int process_l = 0; target_l == -1 && process_l<nbProcesses_l; ++process_l)
-    {
-        bool dontAppearInDecisions_l = true;
-        for (DecisionsPool::const_iterator it_l = decisions_m.begin();
-             dontAppearInDecisions_l && it_l != decisions_m.end();
-             ++it_l)
-        {
-            if ( (*it_l)->workOnProcess(process_l))
-            {
-                dontAppearInDecisions_l = false;
-            }
-        }
-        if (dontAppearInDecisions_l)
-        {
-            target_l = process_l;
-        }
-    }
-
-    if (target_l == -1)
+    // premier process non decide
+    int target_l = cursor_m;
+    if (target_l >= pContext_l->getNbProcesses())
     {
         return DecisionsPool();
     }
 
+    // une decision par machine, en une seule allocation
     DecisionsPool returnedDecisions_l;
     int nbMachines_l = pContext_l->getNbMachines();
+    returnedDecisions_l.reserve(nbMachines_l);
     for (int machine_l = 0; machine_l < nbMachines_l; ++machine_l)
     {
-        OPPMDecisionALG * pDecision_l = new OPPMDecisionALG;
-        OPPMDecisionALG::MachinePool pool_l;
-        pool_l.push_back(machine_l);
-        pDecision_l->setRestrictedSubset(pool_l);
-        pDecision_l->setTarget(target_l);
-        returnedDecisions_l.push_back(pDecision_l);
+        returnedDecisions_l.push_back(DecisionALG(target_l, machine_l, machine_l));
     }
     
     return returnedDecisions_l;
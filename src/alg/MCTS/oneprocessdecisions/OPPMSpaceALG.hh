@@ -26,6 +26,18 @@
 
 #include "src/alg/MCTS/SpaceALG.hh"
 
+#include <vector>
+
+/** Espace ou chaque decision fixe la machine d'un process, les process
+ * etant pris dans l'ordre de leurs indices.
+ * Les process deja decides sont suivis incrementalement (curseur sur le
+ * premier process libre, compteur, et masque des seuls process decides hors
+ * de l'ordre) : isSolution et generateDecisions ne reparcourent plus les
+ * decisions pour chaque process.
+ * Le cout de deplacement (PMC et MMC ponderes) des process decides est lui
+ * aussi cumule a chaque decision : c'est la borne inferieure renvoyee par
+ * bound(), tous les autres termes du score etant positifs.
+ */
 class OPPMSpaceALG : public SpaceALG
 {
 public:
@@ -33,9 +45,25 @@ public:
     virtual ~OPPMSpaceALG();
 
     typedef SpaceALG::DecisionsPool DecisionsPool;
+    virtual void addDecision(const DecisionALG &);
     virtual DecisionsPool generateDecisions() const;
     virtual SpaceALG * clone();
     virtual bool isSolution() const;
+    virtual BoundValue bound() const;
+
+private:
+    int getNbProcesses() const;
+    void ajouteCoutMouvement(const DecisionALG &);
+
+    // process decides au dela du curseur, dimensionne a la premiere decision
+    // hors de l'ordre : vide quand les decisions suivent l'ordre des process
+    // (cas de la MCTS), un clone n'a alors aucun masque a recopier
+    std::vector<bool> decidedAhead_m;
+    int nbDecided_m;
+    // premier process non decide (tous ceux d'avant le sont)
+    int cursor_m;
+    // PMC + MMC ponderes des process decides
+    uint64_t coutMouvements_m;
 };
 
 #endif
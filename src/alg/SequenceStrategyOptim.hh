@@ -31,7 +31,7 @@ class SequenceStrategyOptim : public StrategyOptim {
     public:
         ~SequenceStrategyOptim();
 
-        ContextALG run(ContextALG contextAlg_p, time_t heureFinMaxPreconisee_p, const variables_map& opt_p);
+        void run(ContextALG& contextAlg_p, time_t heureFinMaxPreconisee_p, const variables_map& opt_p);
 
 
 
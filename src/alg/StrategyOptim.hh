@@ -44,14 +44,16 @@ class StrategyOptim {
         /**
          * Effectue une optim en partant d'une solution initiale,
          * se charge d'ecrire la meilleure solution trouvee via le SolutionDtoout,
-         * et renvoie la solution "finale" voulu
-         * @param contextAlg_p La solution initiale
+         * et laisse dans le contexte la solution "finale" voulue.
+         * Le contexte est passe par reference et modifie sur place : enchainer des strategies
+         * ne copie ni le contexte ni sa solution, et une strategie qui ne change pas la solution
+         * courante n'a rien a faire pour la transmettre a la suivante
+         * @param contextAlg_p (in/out) La solution initiale, puis la solution "finale". Il peut s'agir
+         * de la meilleure solution trouvee, de l'etat final, d'autre chose...
          * @param heureFinMaxPreconisee La date de fin a laquelle la strategie devrait retourner au plus tard. La strategie est toutefois libre de respecter ou non cette indication
          * @param opt_p Les options founies a la ligne de commande, afin de permettre aux Strategie de lire leurs propres arguments
-         * @return Une solution "finale". Il peut s'agir de la meilleure solution trouvee,
-         * de l'etat final, d'autre chose...
          */
-        virtual ContextALG run(ContextALG contextAlg_p, time_t heureFinMaxPreconisee_p, const variables_map& opt_p) = 0;
+        virtual void run(ContextALG& contextAlg_p, time_t heureFinMaxPreconisee_p, const variables_map& opt_p) = 0;
 };
 
 #endif
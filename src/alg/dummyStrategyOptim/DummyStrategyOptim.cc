@@ -23,14 +23,17 @@
 
 #include "alg/dummyStrategyOptim/DummyStrategyOptim.hh"
 #include "dtoout/SolutionDtoout.hh"
-#include "tools/Checker.hh"
+#include "tools/FusedChecker.hh"
 #include "tools/Log.hh"
 #include <algorithm>
 #include <cassert>
 using namespace std;
 
-ContextALG DummyStrategyOptim::run(ContextALG contextAlg_p, time_t heureFinMaxPreconisee_p, const variables_map& opt_p){
-    vector<int> sol_l = contextAlg_p.getCurrentSol();
+void DummyStrategyOptim::run(ContextALG& contextAlg_p, time_t heureFinMaxPreconisee_p, const variables_map& opt_p){
+    /* On travaille directement sur la solution courante du contextAlg (sans la copier) :
+     * chaque modification passe par assign(), qui met a jour son cache en O(R)
+     */
+    const vector<int>& sol_l = contextAlg_p.getCurrentSol();
 
     /* "ContextAlg, cette solution est peut etre mieux que ce que tu connais, 
      * mais peut etre pas. Verifie le, et met toi a jour si c'est le cas"
@@ -38,11 +41,16 @@ ContextALG DummyStrategyOptim::run(ContextALG contextAlg_p, time_t heureFinMaxPr
     if ( contextAlg_p.checkCompletAndMajBestSol(sol_l, true) ){
         LOG(USELESS) << "La solution initialement sur le contextALG envoie du pate !" << endl;
     }
+    FusedChecker const * pChecker_l = contextAlg_p.getFusedChecker();
+    CheckerResult resultAvant_l = pChecker_l->evaluate(sol_l);
 
     /* J'echange les machines des deux premiers processes, et rebelote
      */
     if ( sol_l.size() > 1 ){
-        swap(sol_l[0], sol_l[1]);
+        const int machine0_l = sol_l[0];
+        const int machine1_l = sol_l[1];
+        contextAlg_p.assign(0, machine1_l);
+        contextAlg_p.assign(1, machine0_l);
         if ( contextAlg_p.checkCompletAndMajBestSol(sol_l, true) ){
             LOG(USELESS) << "C'etait une bonne idee d'echanger les machines des 2 premiers process" << endl;
         }
@@ -51,12 +59,10 @@ ContextALG DummyStrategyOptim::run(ContextALG contextAlg_p, time_t heureFinMaxPr
     /* Je met arbitraitement le 1er process sur la 1ere machine.
      * Je teste ce que ca donne sans deleguer ces operations au contextAlg.
      */
-    sol_l[0] = 0;
-    Checker checker_l(&contextAlg_p);
-    int scoreAvant_l = checker_l.computeScore();
-    if ( checker_l.isValid() ){
-        Checker checker2_l(contextAlg_p.getContextBO(), sol_l);
-        int scoreApres_l = checker2_l.computeScore();
+    contextAlg_p.assign(0, 0);
+    int scoreAvant_l = resultAvant_l.score;
+    if ( resultAvant_l.valid ){
+        int scoreApres_l = pChecker_l->evaluate(sol_l).score;
         if ( scoreApres_l > scoreAvant_l ){
             bool bestSolMaj_l = SolutionDtoout::writeSol(sol_l, scoreApres_l);
 
@@ -73,10 +79,8 @@ ContextALG DummyStrategyOptim::run(ContextALG contextAlg_p, time_t heureFinMaxPr
         LOG(USELESS) << "En mettant le process 0 sur la machine 0, on a une sol non reglementaire" << endl;
     }
 
-    /* On souhaite que la prochaine strategie (s'il y en a une) considere comme solution courante la derniere qu'on a considere
-     * (cette strategie pourra, si elle le desire, ignorer cette solution initial qu'on lui fourni)
+    /* La prochaine strategie (s'il y en a une) considere comme solution courante la derniere qu'on a consideree
+     * (cette strategie pourra, si elle le desire, ignorer cette solution initial qu'on lui fourni) :
+     * c'est deja la solution courante du contextAlg
      */
-
-    contextAlg_p.setCurrentSol(sol_l);
-    return contextAlg_p;
 }
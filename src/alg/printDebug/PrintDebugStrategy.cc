@@ -26,14 +26,14 @@
 #include <iostream>
 using namespace std;
 
-ContextALG PrintDebugStrategy::run(ContextALG contextAlg_p, time_t heureFinMaxPreconisee_p, const variables_map& opt_p){
+void PrintDebugStrategy::run(ContextALG& contextAlg_p, time_t heureFinMaxPreconisee_p, const variables_map& opt_p){
     Checker checker(&contextAlg_p);
 
 
     clog << "*** Traces de PrintDebugStrategy ***" << endl;
     if ( ! checker.isValid() ){
         clog << "La solution n'est pas valide" << endl;
-        return contextAlg_p;
+        return;
     }
 
     clog << "\tLoad cost : " << checker.computeLoadCost() << endl
@@ -42,7 +42,5 @@ ContextALG PrintDebugStrategy::run(ContextALG contextAlg_p, time_t heureFinMaxPr
         << "\tSMC : " << checker.computeSMC() << endl
         << "\tMMC : " << checker.computeMMC() << endl
         << "Total : " << checker.computeScore() << endl;
-
-    return contextAlg_p;
 }
 
@@ -29,7 +29,7 @@
  * Utile pour du debug : crache des logs decrivant une solution
  */
 class PrintDebugStrategy : public StrategyOptim {
-        virtual ContextALG run(ContextALG contextAlg_p, time_t heureFinMaxPreconisee_p, const variables_map& opt_p);
+        virtual void run(ContextALG& contextAlg_p, time_t heureFinMaxPreconisee_p, const variables_map& opt_p);
 };
 
 
@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "alg/ContextALG.hh"
+#include "bo/BalanceCostBO.hh"
+#include "bo/ContextBO.hh"
+#include "bo/LocationBO.hh"
+#include "bo/MachineBO.hh"
+#include "bo/MMCBO.hh"
+#include "bo/NeighborhoodBO.hh"
+#include "bo/ProcessBO.hh"
+#include "bo/RessourceBO.hh"
+#include "bo/ServiceBO.hh"
+#include "dtoin/InstanceReaderDtoin.hh"
+#include "dtoin/ScannerDtoin.hh"
+#include "dtoin/SolutionDtoin.hh"
+#include "dtoout/TamponSortie.hh"
+#include "tools/Checker.hh"
+#include "tools/FusedChecker.hh"
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/shared_ptr.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace boost::posix_time;
+using namespace std;
+
+/**
+ * Micro-benchmarks des chemins critiques, a lancer a la main sur les instances du challenge
+ * (les temps dependent trop de la machine pour etre verifies par les tests unitaires)
+ */
+
+namespace {
+    void usage(){
+        cerr << "Usage : benchmark checker <instance> <solution> [nbIterations]" << endl
+            << "        benchmark lecture <instance> <solution> [nbIterations]" << endl
+            << "        benchmark synthetique <instance> <solution> [nbMachines] [nbProcess]" << endl
+            << "  checker : evaluation d'une solution par Checker(bo, sol) + isValid() + computeScore()," << endl
+            << "            puis par le FusedChecker (sur un vector, puis sur un tampon emprunte)" << endl
+            << "  lecture : decoupage en entiers des deux fichiers par istream >> int, puis par le ScannerDtoin ;" << endl
+            << "            puis lecture complete (construction des BO et de l'InstanceCoreBO comprise) par un lecteur" << endl
+            << "            de reference sur istream, puis par InstanceReaderDtoin + SolutionDtoin" << endl
+            << "  synthetique : ecrit une instance texte (et sa solution) de grande taille pour le bench lecture," << endl
+            << "            toujours la meme pour les memes parametres (5000 machines et 50000 process par defaut)" << endl;
+    }
+
+    /**
+     * Duree moyenne d'une iteration, en microsecondes
+     */
+    double moyenneUs(const ptime& debut_p, int nbIterations_p){
+        return (double) (microsec_clock::local_time() - debut_p).total_microseconds() / nbIterations_p;
+    }
+
+    /**
+     * Meilleur temps moyen (en microsecondes) sur 3 series de nbIterations_p appels a fonction_p
+     */
+    template <class Fonction> double meilleureMoyenneUs(Fonction fonction_p, int nbIterations_p){
+        double result_l = -1;
+        for ( int serie_l=0 ; serie_l < 3 ; serie_l++ ){
+            const ptime debut_l = microsec_clock::local_time();
+            for ( int idx_l=0 ; idx_l < nbIterations_p ; idx_l++ ){
+                fonction_p();
+            }
+            const double moyenne_l = moyenneUs(debut_l, nbIterations_p);
+            if ( result_l < 0 || moyenne_l < result_l ){
+                result_l = moyenne_l;
+            }
+        }
+        return result_l;
+    }
+
+    struct DecoupageIostream {
+        DecoupageIostream(const string& instance_p, const string& solution_p, int64_t& cumul_p) :
+            instance_m(instance_p), solution_m(solution_p), cumul_m(cumul_p) {}
+        void operator()() const {
+            decoupe(instance_m);
+            decoupe(solution_m);
+        }
+        void decoupe(const string& fichier_p) const {
+            ifstream ifs_l(fichier_p.c_str());
+            int valeur_l;
+            while ( ifs_l >> valeur_l ){
+                cumul_m += valeur_l;
+            }
+        }
+        const string& instance_m;
+        const string& solution_m;
+        int64_t& cumul_m;
+    };
+
+    struct DecoupageScanner {
+        DecoupageScanner(const string& instance_p, const string& solution_p, int64_t& cumul_p) :
+            instance_m(instance_p), solution_m(solution_p), cumul_m(cumul_p) {}
+        void operator()() const {
+            decoupe(instance_m);
+            decoupe(solution_m);
+        }
+        void decoupe(const string& fichier_p) const {
+            ScannerDtoin scanner_l(fichier_p);
+            while ( ! scanner_l.isFini() ){
+                cumul_m += scanner_l.lireEntier("entier");
+            }
+        }
+        const string& instance_m;
+        const string& solution_m;
+        int64_t& cumul_m;
+    };
+
+    /**
+     * Lecteur de reference : la logique des sections *Dtoin (memes BO, memes constructeurs, meme
+     * matrice MMC compressee, meme InstanceCoreBO), mais chaque entier est lu par istream >> int
+     */
+    struct LectureIostream {
+        LectureIostream(const string& instance_p, const string& solution_p) : instance_m(instance_p), solution_m(solution_p) {}
+        void operator()() const {
+            ifstream ifs_l(instance_m.c_str());
+            ContextBO contextBO_l;
+
+            int nbRess_l;
+            ifs_l >> nbRess_l;
+            for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+                int isTransient_l, weightLoadCost_l;
+                ifs_l >> isTransient_l >> weightLoadCost_l;
+                contextBO_l.addRessource(new RessourceBO(idxRess_l, isTransient_l != 0, weightLoadCost_l));
+            }
+
+            int nbMachines_l;
+            ifs_l >> nbMachines_l;
+            vector<LocationBO*> vpLoc_l;
+            vector<NeighborhoodBO*> vpNeigh_l;
+            vector<int> capas_l(nbRess_l);
+            vector<int> safetyCapas_l(nbRess_l);
+            vector<int> mmc_l(static_cast<size_t>(nbMachines_l) * nbMachines_l);
+            for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
+                int idxNeigh_l, idxLoc_l;
+                ifs_l >> idxNeigh_l >> idxLoc_l;
+                while ( static_cast<int>(vpNeigh_l.size()) <= idxNeigh_l ){
+                    vpNeigh_l.push_back(new NeighborhoodBO(vpNeigh_l.size()));
+                }
+                while ( static_cast<int>(vpLoc_l.size()) <= idxLoc_l ){
+                    vpLoc_l.push_back(new LocationBO(vpLoc_l.size()));
+                }
+                for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+                    ifs_l >> capas_l[idxRess_l];
+                }
+                for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+                    ifs_l >> safetyCapas_l[idxRess_l];
+                }
+                int* pLigne_l = mmc_l.data() + static_cast<size_t>(idxMachine_l) * nbMachines_l;
+                for ( int idxAutre_l=0 ; idxAutre_l < nbMachines_l ; idxAutre_l++ ){
+                    ifs_l >> pLigne_l[idxAutre_l];
+                }
+                contextBO_l.addMachine(new MachineBO(idxMachine_l, vpLoc_l[idxLoc_l], vpNeigh_l[idxNeigh_l], capas_l, safetyCapas_l));
+            }
+            contextBO_l.setMMCBO(new MMCBO(nbMachines_l, mmc_l));
+            for ( size_t idx_l=0 ; idx_l < vpLoc_l.size() ; idx_l++ ){
+                contextBO_l.addLocation(vpLoc_l[idx_l]);
+            }
+            for ( size_t idx_l=0 ; idx_l < vpNeigh_l.size() ; idx_l++ ){
+                contextBO_l.addNeighborhood(vpNeigh_l[idx_l]);
+            }
+
+            int nbServices_l;
+            ifs_l >> nbServices_l;
+            for ( int idxService_l=0 ; idxService_l < nbServices_l ; idxService_l++ ){
+                int spreadMin_l, nbDependances_l;
+                ifs_l >> spreadMin_l >> nbDependances_l;
+                vector<int> dependances_l(nbDependances_l);
+                for ( int idxDep_l=0 ; idxDep_l < nbDependances_l ; idxDep_l++ ){
+                    ifs_l >> dependances_l[idxDep_l];
+                }
+                contextBO_l.addService(new ServiceBO(idxService_l, spreadMin_l, dependances_l));
+            }
+
+            int nbProcesses_l;
+            ifs_l >> nbProcesses_l;
+            boost::shared_ptr<vector<int> > pStock_l(new vector<int>(static_cast<size_t>(nbProcesses_l) * nbRess_l));
+            const boost::shared_ptr<const vector<int> > pStockPartage_l(pStock_l);
+            for ( int idxP_l=0 ; idxP_l < nbProcesses_l ; idxP_l++ ){
+                int idxService_l, pmc_l;
+                ifs_l >> idxService_l;
+                int* pRequirements_l = pStock_l->data() + static_cast<size_t>(idxP_l) * nbRess_l;
+                for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+                    ifs_l >> pRequirements_l[idxRess_l];
+                }
+                ifs_l >> pmc_l;
+                contextBO_l.addProcess(new ProcessBO(idxP_l, contextBO_l.getService(idxService_l), pStockPartage_l, idxP_l, nbRess_l, pmc_l));
+            }
+
+            int nbBalanceCosts_l;
+            ifs_l >> nbBalanceCosts_l;
+            for ( int idxBC_l=0 ; idxBC_l < nbBalanceCosts_l ; idxBC_l++ ){
+                int idxRess1_l, idxRess2_l, target_l, poids_l;
+                ifs_l >> idxRess1_l >> idxRess2_l >> target_l >> poids_l;
+                contextBO_l.addBalanceCost(new BalanceCostBO(contextBO_l.getRessource(idxRess1_l),
+                            contextBO_l.getRessource(idxRess2_l), target_l, poids_l));
+            }
+
+            int poidsPMC_l, poidsSMC_l, poidsMMC_l;
+            ifs_l >> poidsPMC_l >> poidsSMC_l >> poidsMMC_l;
+            contextBO_l.setPoidsPMC(poidsPMC_l);
+            contextBO_l.setPoidsSMC(poidsSMC_l);
+            contextBO_l.setPoidsMMC(poidsMMC_l);
+
+            ifstream ifsSol_l(solution_m.c_str());
+            for ( int idxP_l=0 ; idxP_l < nbProcesses_l ; idxP_l++ ){
+                int idxMachine_l;
+                ifsSol_l >> idxMachine_l;
+                contextBO_l.setMachineInit(idxP_l, idxMachine_l);
+            }
+            contextBO_l.buildInstanceCore();
+        }
+        const string& instance_m;
+        const string& solution_m;
+    };
+
+    struct LectureScanner {
+        LectureScanner(const string& instance_p, const string& solution_p) : instance_m(instance_p), solution_m(solution_p) {}
+        void operator()() const {
+            InstanceReaderDtoin reader_l;
+            ContextBO contextBO_l = reader_l.read(instance_m);
+            SolutionDtoin::read(solution_m, &contextBO_l);
+        }
+        const string& instance_m;
+        const string& solution_m;
+    };
+
+    struct ConstructionCore {
+        ConstructionCore(ContextBO* pContextBO_p) : pContextBO_m(pContextBO_p) {}
+        void operator()() const {
+            pContextBO_m->buildInstanceCore();
+        }
+        ContextBO* pContextBO_m;
+    };
+
+    int benchLecture(const string& instance_p, const string& solution_p, int nbIterations_p){
+        int64_t cumulIostream_l = 0;
+        int64_t cumulScanner_l = 0;
+        const double decoupageIostream_l = meilleureMoyenneUs(DecoupageIostream(instance_p, solution_p, cumulIostream_l), nbIterations_p);
+        const double decoupageScanner_l = meilleureMoyenneUs(DecoupageScanner(instance_p, solution_p, cumulScanner_l), nbIterations_p);
+        const double lectureIostream_l = meilleureMoyenneUs(LectureIostream(instance_p, solution_p), nbIterations_p);
+        const double lectureScanner_l = meilleureMoyenneUs(LectureScanner(instance_p, solution_p), nbIterations_p);
+
+        InstanceReaderDtoin reader_l;
+        ContextBO contextBO_l = reader_l.read(instance_p);
+        SolutionDtoin::read(solution_p, &contextBO_l);
+        const double core_l = meilleureMoyenneUs(ConstructionCore(&contextBO_l), nbIterations_p);
+
+        cout << instance_p << " (us par lecture de l'instance et de la solution, meilleure de 3 series de " << nbIterations_p << ")" << endl
+            << "  decoupage istream >> int  : " << decoupageIostream_l << endl
+            << "  decoupage ScannerDtoin    : " << decoupageScanner_l << " (x" << decoupageIostream_l / decoupageScanner_l << ")" << endl
+            << "  lecture complete istream  : " << lectureIostream_l << endl
+            << "  lecture complete scanner  : " << lectureScanner_l << " (x" << lectureIostream_l / lectureScanner_l << ")" << endl
+            << "  dont InstanceCoreBO       : " << core_l << endl
+            << "  dont BO (reste)           : " << lectureScanner_l - decoupageScanner_l - core_l << endl
+            << "  (controle : " << (cumulIostream_l == cumulScanner_l ? "ok" : "DIFFERENT") << ")" << endl;
+        return 0;
+    }
+
+    /**
+     * Generateur congruentiel : l'instance synthetique ne depend ni de la plateforme ni de la libc
+     */
+    class Alea {
+        public:
+            Alea() : etat_m(1) {}
+            int entre(int min_p, int max_p){
+                etat_m = etat_m * 6364136223846793005ULL + 1442695040888963407ULL;
+                return min_p + (int) ((etat_m >> 33) % (uint64_t) (max_p - min_p + 1));
+            }
+        private:
+            uint64_t etat_m;
+    };
+
+    /**
+     * Instance au format du challenge, dimensionnee comme les plus grosses instances B :
+     * l'essentiel du texte est la matrice MMC (nbMachines^2 entiers d'un chiffre)
+     */
+    int ecrisSynthetique(const string& instance_p, const string& solution_p, int nbMachines_p, int nbProcess_p){
+        const int nbRess_l = 12;
+        const int nbServices_l = 2000;
+        const int nbLocations_l = 25;
+        const int nbNeighs_l = 5;
+        Alea alea_l;
+
+        TamponSortie instance_l(instance_p);
+        instance_l << nbRess_l << '\n';
+        for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+            instance_l << (idxRess_l < 4 ? 1 : 0) << ' ' << alea_l.entre(1, 20) << '\n';
+        }
+        instance_l << nbMachines_p << '\n';
+        vector<int> capas_l(nbRess_l);
+        for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_p ; idxMachine_l++ ){
+            instance_l << idxMachine_l % nbNeighs_l << ' ' << idxMachine_l % nbLocations_l;
+            for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+                capas_l[idxRess_l] = alea_l.entre(500000, 1000000);
+                instance_l << ' ' << capas_l[idxRess_l];
+            }
+            for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+                instance_l << ' ' << capas_l[idxRess_l] / 2;
+            }
+            for ( int idxAutre_l=0 ; idxAutre_l < nbMachines_p ; idxAutre_l++ ){
+                instance_l << ' ' << (idxAutre_l == idxMachine_l ? 0 : alea_l.entre(1, 9));
+            }
+            instance_l << '\n';
+        }
+        instance_l << nbServices_l << '\n';
+        for ( int idxService_l=0 ; idxService_l < nbServices_l ; idxService_l++ ){
+            instance_l << "1 0\n";
+        }
+        instance_l << nbProcess_p << '\n';
+        for ( int idxP_l=0 ; idxP_l < nbProcess_p ; idxP_l++ ){
+            instance_l << idxP_l % nbServices_l;
+            for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+                instance_l << ' ' << alea_l.entre(0, 5000);
+            }
+            instance_l << ' ' << alea_l.entre(1, 100) << '\n';
+        }
+        instance_l << "1\n0 1 10\n10\n1 10 100\n";
+        instance_l.termine();
+
+        TamponSortie solution_l(solution_p);
+        for ( int idxP_l=0 ; idxP_l < nbProcess_p ; idxP_l++ ){
+            solution_l << idxP_l % nbMachines_p << ' ';
+        }
+        solution_l << '\n';
+        solution_l.termine();
+        return 0;
+    }
+
+    int benchChecker(const string& instance_p, const string& solution_p, int nbIterations_p){
+        InstanceReaderDtoin reader_l;
+        ContextBO contextBO_l = reader_l.read(instance_p);
+        SolutionDtoin::read(solution_p, &contextBO_l);
+        const vector<int> sol_l = contextBO_l.getSolInit();
+        const FusedChecker fusedChecker_l(&contextBO_l);
+
+        //Le cumul des scores evite que le compilateur n'elimine les boucles
+        uint64_t cumul_l = 0;
+        ptime debut_l = microsec_clock::local_time();
+        for ( int idx_l=0 ; idx_l < nbIterations_p ; idx_l++ ){
+            Checker checker_l(&contextBO_l, sol_l);
+            cumul_l += checker_l.isValid();
+            cumul_l += checker_l.computeScore();
+        }
+        const double checker_l = moyenneUs(debut_l, nbIterations_p);
+
+        //Reference sans la construction du ContextALG : isValid() puis computeScore() seuls
+        const ContextALG contextALG_l(&contextBO_l, sol_l, false);
+        debut_l = microsec_clock::local_time();
+        for ( int idx_l=0 ; idx_l < nbIterations_p ; idx_l++ ){
+            Checker checkerALG_l(&contextALG_l);
+            cumul_l += checkerALG_l.isValid();
+            cumul_l += checkerALG_l.computeScore();
+        }
+        const double checkerALG_l = moyenneUs(debut_l, nbIterations_p);
+
+        debut_l = microsec_clock::local_time();
+        for ( int idx_l=0 ; idx_l < nbIterations_p ; idx_l++ ){
+            cumul_l += fusedChecker_l.evaluate(sol_l).score;
+        }
+        const double fusedVector_l = moyenneUs(debut_l, nbIterations_p);
+
+        FusedCheckerBuffers buffers_l;
+        CheckerResult result_l;
+        debut_l = microsec_clock::local_time();
+        for ( int idx_l=0 ; idx_l < nbIterations_p ; idx_l++ ){
+            fusedChecker_l.evaluate(&sol_l[0], sol_l.size(), result_l, buffers_l);
+            cumul_l += result_l.score;
+        }
+        const double fusedTampon_l = moyenneUs(debut_l, nbIterations_p);
+
+        cout << instance_p << " (us par evaluation, " << nbIterations_p << " iterations)" << endl
+            << "  Checker(bo, sol)          : " << checker_l << endl
+            << "  isValid() + computeScore(): " << checkerALG_l << endl
+            << "  FusedChecker (vector)     : " << fusedVector_l << endl
+            << "  FusedChecker (tampon)     : " << fusedTampon_l << endl
+            << "  (controle : " << cumul_l << ")" << endl;
+        return 0;
+    }
+}
+
+int main(int argc, char** argv){
+    if ( argc < 2 ){
+        usage();
+        return 1;
+    }
+    const string bench_l = argv[1];
+    try {
+        if ( bench_l == "checker" && argc >= 4 ){
+            return benchChecker(argv[2], argv[3], argc >= 5 ? atoi(argv[4]) : 1000);
+        }
+        if ( bench_l == "lecture" && argc >= 4 ){
+            return benchLecture(argv[2], argv[3], argc >= 5 ? atoi(argv[4]) : 100);
+        }
+        if ( bench_l == "synthetique" && argc >= 4 ){
+            return ecrisSynthetique(argv[2], argv[3], argc >= 5 ? atoi(argv[4]) : 5000, argc >= 6 ? atoi(argv[5]) : 50000);
+        }
+    } catch (string& s_l){
+        cerr << "Exception catchee : " << s_l << endl;
+        return 1;
+    }
+    usage();
+    return 1;
+}
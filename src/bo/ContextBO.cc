@@ -23,6 +23,7 @@
 
 #include "bo/BalanceCostBO.hh"
 #include "bo/ContextBO.hh"
+#include "bo/InstanceCoreBO.hh"
 #include "bo/LocationBO.hh"
 #include "bo/MachineBO.hh"
 #include "bo/MMCBO.hh"
@@ -31,16 +32,23 @@
 #include "bo/RessourceBO.hh"
 #include "bo/ServiceBO.hh"
 #include "dtoout/InstanceWriterHumanReadable.hh"
+#include "tools/FusedChecker.hh"
 #include <boost/foreach.hpp>
 #include <algorithm>
 using namespace std;
 
-ContextBO::ContextBO() :
-    pMMCBO_m(0),
-    pSolInit_m(new vector<int>())
+ContextBO::ContextBO()
 {}
 
-ContextBO::ContextBO(const ContextBO& contextBO_p){
+ContextBO::ContextBO(const ContextBO& contextBO_p) :
+    pMMCBO_m(contextBO_p.pMMCBO_m)
+{
+    {
+        //Le core de l'original peut etre en cours de construction par un autre thread
+        boost::recursive_mutex::scoped_lock lock_l(contextBO_p.mutexCore_m);
+        pInstanceCore_m = contextBO_p.pInstanceCore_m;
+        pFusedChecker_m = contextBO_p.pFusedChecker_m;
+    }
     BOOST_FOREACH(RessourceBO* pRess_l, contextBO_p.vpRessources_m){
         vpRessources_m.push_back(new RessourceBO(*pRess_l));
     }
@@ -60,7 +68,7 @@ ContextBO::ContextBO(const ContextBO& contextBO_p){
     }
     BOOST_FOREACH(ProcessBO* pProcess_l, contextBO_p.vpProcesses_m){
         ServiceBO* pService_l = vpServices_m[pProcess_l->getService()->getId()];
-        vpProcesses_m.push_back(new ProcessBO(pProcess_l->getId(), pService_l, pProcess_l->getRequirements(), pProcess_l->getPMC()));
+        vpProcesses_m.push_back(new ProcessBO(*pProcess_l, pService_l));
         vpProcesses_m.back()->setMachineInit(vpMachines_m[pProcess_l->getMachineInit()->getId()]);
     }
     BOOST_FOREACH(BalanceCostBO* pBC_l, contextBO_p.vpBalanceCosts_m){
@@ -68,13 +76,9 @@ ContextBO::ContextBO(const ContextBO& contextBO_p){
         RessourceBO* pRess2_l = vpRessources_m[pBC_l->getRessource2()->getId()];
         vpBalanceCosts_m.push_back(new BalanceCostBO(pRess1_l, pRess2_l, pBC_l->getTarget(), pBC_l->getPoids()));
     }
-    pMMCBO_m = new MMCBO(*(contextBO_p.pMMCBO_m));
-
     poidsPMC_m = contextBO_p.poidsPMC_m;
     poidsSMC_m = contextBO_p.poidsSMC_m;
     poidsMMC_m = contextBO_p.poidsMMC_m;
-
-    pSolInit_m = new vector<int>(*(contextBO_p.pSolInit_m));
 }
 
 ContextBO::~ContextBO(){
@@ -105,21 +109,19 @@ ContextBO::~ContextBO(){
     for ( vector<BalanceCostBO*>::iterator it_l = vpBalanceCosts_m.begin() ; it_l != vpBalanceCosts_m.end() ; it_l++ ){
         delete *it_l;
     }
-
-    delete pMMCBO_m;
-    delete pSolInit_m;
 }
 
 void ContextBO::setMMCBO(MMCBO* pMMC_p){
-    delete pMMCBO_m;
-    pMMCBO_m = pMMC_p;
+    invalidateInstanceCore();
+    pMMCBO_m.reset(pMMC_p);
 }
 
-MMCBO* ContextBO::getMMCBO() const{
-    return pMMCBO_m;
+MMCBO const * ContextBO::getMMCBO() const{
+    return pMMCBO_m.get();
 }
 
 void ContextBO::addRessource(RessourceBO* pRess_p){
+    invalidateInstanceCore();
    vpRessources_m.push_back(pRess_p);
 }
 
@@ -132,6 +134,7 @@ RessourceBO* ContextBO::getRessource(int id_p) const{
 }
 
 void ContextBO::addLocation(LocationBO* pLoc_p){
+    invalidateInstanceCore();
     vpLocations_m.push_back(pLoc_p);
 }
 
@@ -144,6 +147,7 @@ LocationBO* ContextBO::getLocation(int idx_p) const{
 }
 
 void ContextBO::addNeighborhood(NeighborhoodBO* pNeigh_p){
+    invalidateInstanceCore();
     vpNeighborhoods_m.push_back(pNeigh_p);
 }
 
@@ -156,6 +160,7 @@ NeighborhoodBO* ContextBO::getNeighborhood(int idx_p) const{
 }
 
 void ContextBO::addMachine(MachineBO* pMachine_p){
+    invalidateInstanceCore();
     vpMachines_m.push_back(pMachine_p);
 }
 
@@ -168,6 +173,7 @@ MachineBO* ContextBO::getMachine(int idx_p) const{
 }
 
 void ContextBO::addService(ServiceBO* pService_p){
+    invalidateInstanceCore();
     vpServices_m.push_back(pService_p);
 }
 
@@ -180,6 +186,7 @@ ServiceBO* ContextBO::getService(int idx_p) const{
 }
 
 void ContextBO::addProcess(ProcessBO* pProcess_p){
+    invalidateInstanceCore();
     vpProcesses_m.push_back(pProcess_p);
 }
 
@@ -191,7 +198,13 @@ ProcessBO* ContextBO::getProcess(int idx_p) const{
     return vpProcesses_m[idx_p];
 }
 
+void ContextBO::setMachineInit(int idxProcess_p, int idxMachine_p){
+    invalidateInstanceCore();
+    vpProcesses_m[idxProcess_p]->setMachineInit(vpMachines_m[idxMachine_p]);
+}
+
 void ContextBO::addBalanceCost(BalanceCostBO* pBalanceCost_p){
+    invalidateInstanceCore();
     vpBalanceCosts_m.push_back(pBalanceCost_p);
 }
 
@@ -204,6 +217,7 @@ BalanceCostBO* ContextBO::getBalanceCost(int idx_p) const{
 }
 
 void ContextBO::setPoidsPMC(int poids_p){
+    invalidateInstanceCore();
     poidsPMC_m = poids_p;
 }
 
@@ -212,6 +226,7 @@ int ContextBO::getPoidsPMC() const{
 }
 
 void ContextBO::setPoidsSMC(int poids_p){
+    invalidateInstanceCore();
     poidsSMC_m = poids_p;
 }
 
@@ -220,6 +235,7 @@ int ContextBO::getPoidsSMC() const{
 }
 
 void ContextBO::setPoidsMMC(int poids_p){
+    invalidateInstanceCore();
     poidsMMC_m = poids_p;
 }
 
@@ -323,7 +339,11 @@ ContextBO& ContextBO::operator=(const ContextBO& context_p){
     poidsPMC_m = context_l.poidsPMC_m;
     poidsSMC_m = context_l.poidsSMC_m;
     poidsMMC_m = context_l.poidsMMC_m;
-    swap(pSolInit_m, context_l.pSolInit_m);
+    {
+        boost::recursive_mutex::scoped_lock lock_l(mutexCore_m);
+        swap(pInstanceCore_m, context_l.pInstanceCore_m);
+        swap(pFusedChecker_m, context_l.pFusedChecker_m);
+    }
     return *this;
 }
 
@@ -333,13 +353,54 @@ ostream& operator<<(ostream& os_p, const ContextBO& context_p){
     return os_p;
 }
 
-const vector<int>& ContextBO::getSolInit() const{
-    if ( pSolInit_m->empty() ){
-        int nbProcesses_l = vpProcesses_m.size();
-        pSolInit_m->reserve(nbProcesses_l);
-        for ( int idxP_l=0 ; idxP_l < nbProcesses_l ; idxP_l++ ){
-            pSolInit_m->push_back(vpProcesses_m[idxP_l]->getMachineInit()->getId());
+vector<int> ContextBO::getSolInit() const{
+    vector<int> result_l(vpProcesses_m.size(), -1);
+    for ( size_t idxP_l=0 ; idxP_l < vpProcesses_m.size() ; idxP_l++ ){
+        MachineBO* pMachineInit_l = vpProcesses_m[idxP_l]->getMachineInit();
+        if ( pMachineInit_l ){
+            result_l[idxP_l] = pMachineInit_l->getId();
         }
     }
-    return *pSolInit_m;
+    return result_l;
+}
+
+void ContextBO::buildInstanceCore(){
+    boost::recursive_mutex::scoped_lock lock_l(mutexCore_m);
+    buildInstanceCoreLocked();
+}
+
+void ContextBO::buildInstanceCoreLocked() const{
+    pFusedChecker_m.reset();
+    pInstanceCore_m.reset(new InstanceCoreBO(this, pMMCBO_m));
+    //Le FusedChecker relit l'InstanceCoreBO tout juste publie (mutex recursif)
+    pFusedChecker_m.reset(new FusedChecker(this));
+}
+
+boost::shared_ptr<InstanceCoreBO const> ContextBO::getInstanceCore() const{
+    boost::recursive_mutex::scoped_lock lock_l(mutexCore_m);
+    if ( !pInstanceCore_m ){
+        buildInstanceCoreLocked();
+    }
+    return pInstanceCore_m;
+}
+
+boost::shared_ptr<FusedChecker const> ContextBO::getFusedChecker() const{
+    boost::recursive_mutex::scoped_lock lock_l(mutexCore_m);
+    if ( !pFusedChecker_m ){
+        buildInstanceCoreLocked();
+    }
+    return pFusedChecker_m;
+}
+
+void ContextBO::invalidateInstanceCore(){
+    /* Les modifications de l'instance ne sont de toute facon pas concurrentes de ses lectures (les
+     * vecteurs de BO ne sont pas proteges) : tant qu'aucun core n'a ete construit, les lecteurs
+     * d'instance n'ont pas a payer le verrou a chaque ajout
+     */
+    if ( ! pInstanceCore_m && ! pFusedChecker_m ){
+        return;
+    }
+    boost::recursive_mutex::scoped_lock lock_l(mutexCore_m);
+    pInstanceCore_m.reset();
+    pFusedChecker_m.reset();
 }
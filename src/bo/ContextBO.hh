@@ -25,8 +25,12 @@
 #define CONTEXTBO_HH
 #include <iostream>
 #include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/recursive_mutex.hpp>
 using namespace std;
 
+class FusedChecker;
+class InstanceCoreBO;
 class RessourceBO;
 class MachineBO;
 class LocationBO;
@@ -52,7 +56,7 @@ class ContextBO {
         ContextBO& operator=(const ContextBO& contextBO_p);
 
         void setMMCBO(MMCBO* pMMC_p);
-        MMCBO* getMMCBO() const;
+        MMCBO const * getMMCBO() const;
 
         void addRessource(RessourceBO* pRess_p);
         int getNbRessources() const;
@@ -77,6 +81,11 @@ class ContextBO {
         void addProcess(ProcessBO* pProcess_p);
         int getNbProcesses() const;
         ProcessBO* getProcess(int idx_p) const;
+
+        /**
+         * Fixe la machine initiale d'un process du contexte (ce qui invalide l'#InstanceCoreBO)
+         */
+        void setMachineInit(int idxProcess_p, int idxMachine_p);
         
         void addBalanceCost(BalanceCostBO* pBalanceCost_p);
         int getNbBalanceCosts() const;
@@ -91,9 +100,41 @@ class ContextBO {
         void setPoidsMMC(int poids_p);
         int getPoidsMMC() const;
 
-        const vector<int>& getSolInit() const;
+        /**
+         * Solution initiale (machine initiale de chaque process, -1 si elle n'est pas fixee).
+         * Relue sur les process et renvoyee par copie : elle reste valide si le contexte est modifie
+         */
+        vector<int> getSolInit() const;
+
+        /**
+         * (Re)construit la representation a plat de l'instance et le #FusedChecker associe.
+         * Facultatif : les accesseurs les construisent a la demande. Appele a la fin de la lecture
+         * de la solution initiale pour ne pas payer la construction dans le premier thread venu
+         */
+        void buildInstanceCore();
+
+        /**
+         * Representation a plat de l'instance, a utiliser dans les boucles critiques.
+         * Elle est immuable et partagee : une classe cliente qui la garde continue de travailler
+         * sur l'instance telle qu'elle etait, meme si le ContextBO est modifie (ou detruit) ensuite.
+         * Construit a la premiere demande (sous verrou) puis apres chaque modification de l'instance
+         */
+        boost::shared_ptr<InstanceCoreBO const> getInstanceCore() const;
+
+        /**
+         * Checker rapide sur l'#InstanceCoreBO courant, partage par tous ceux qui evaluent cette
+         * instance (ContextALG et leurs copies, verification finale...).
+         * Construit et invalide avec l'#InstanceCoreBO
+         */
+        boost::shared_ptr<FusedChecker const> getFusedChecker() const;
 
     private:
+        /**
+         * Oublie l'#InstanceCoreBO, devenu obsolete suite a une modification de l'instance
+         * (ceux qui le partagent encore le gardent)
+         */
+        void invalidateInstanceCore();
+
         vector<RessourceBO*> vpRessources_m;
         vector<MachineBO*> vpMachines_m;
         vector<LocationBO*> vpLocations_m;
@@ -101,7 +142,12 @@ class ContextBO {
         vector<ServiceBO*> vpServices_m;
         vector<ProcessBO*> vpProcesses_m;
         vector<BalanceCostBO*> vpBalanceCosts_m;
-        MMCBO* pMMCBO_m;
+
+        /**
+         * Immuable une fois construit : les copies du contexte partagent la meme matrice M x M
+         * plutot que de la dupliquer
+         */
+        boost::shared_ptr<MMCBO const> pMMCBO_m;
 
         /**
          * Poids du critere Process Move Cost
@@ -119,9 +165,22 @@ class ContextBO {
         int poidsMMC_m;
 
         /**
-         * Utilisation d'un vecteur afin de pouvoir maj ce cache dans une mth const
+         * Construit l'#InstanceCoreBO et le #FusedChecker, mutexCore_m tenu
+         */
+        void buildInstanceCoreLocked() const;
+
+        /**
+         * Partages par les copies du contexte tant qu'elles ne sont pas modifiees.
+         * Construits a la demande, d'ou mutable
+         */
+        mutable boost::shared_ptr<InstanceCoreBO const> pInstanceCore_m;
+        mutable boost::shared_ptr<FusedChecker const> pFusedChecker_m;
+
+        /**
+         * Protege la construction paresseuse du core. Recursif : le constructeur du
+         * #FusedChecker relit getInstanceCore(). Jamais copie
          */
-        vector<int>* pSolInit_m;
+        mutable boost::recursive_mutex mutexCore_m;
 
 };
 
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+#include "bo/InstanceCoreBO.hh"
+#include "bo/BalanceCostBO.hh"
+#include "bo/ContextBO.hh"
+#include "bo/LocationBO.hh"
+#include "bo/MachineBO.hh"
+#include "bo/NeighborhoodBO.hh"
+#include "bo/ProcessBO.hh"
+#include "bo/RessourceBO.hh"
+#include "bo/ServiceBO.hh"
+#include <boost/foreach.hpp>
+#include <algorithm>
+using namespace std;
+
+InstanceCoreBO::InstanceCoreBO(ContextBO const * pContextBO_p, boost::shared_ptr<MMCBO const> pMMCBO_p) :
+    nbProcesses_m(pContextBO_p->getNbProcesses()),
+    nbRess_m(pContextBO_p->getNbRessources()),
+    nbMachines_m(pContextBO_p->getNbMachines()),
+    nbServices_m(pContextBO_p->getNbServices()),
+    nbLocations_m(pContextBO_p->getNbLocations()),
+    nbNeighs_m(pContextBO_p->getNbNeighborhoods()),
+    nbBC_m(pContextBO_p->getNbBalanceCosts()),
+    poidsPMC_m(pContextBO_p->getPoidsPMC()),
+    poidsSMC_m(pContextBO_p->getPoidsSMC()),
+    poidsMMC_m(pContextBO_p->getPoidsMMC()),
+    pMMCBO_m(pMMCBO_p),
+    serviceOfProcess_m(nbProcesses_m),
+    pmc_m(nbProcesses_m),
+    solInit_m(nbProcesses_m),
+    weightLoadCost_m(nbRess_m),
+    isTransient_m(nbRess_m),
+    capa_m(nbMachines_m * nbRess_m),
+    safetyCapa_m(nbMachines_m * nbRess_m),
+    capaByRess_m(nbMachines_m * nbRess_m),
+    safetyCapaByRess_m(nbMachines_m * nbRess_m),
+    machineLocation_m(nbMachines_m),
+    machineNeigh_m(nbMachines_m),
+    spreadMin_m(nbServices_m),
+    nbMaxProcessesByService_m(0),
+    bcRess1_m(nbBC_m),
+    bcRess2_m(nbBC_m),
+    bcTarget_m(nbBC_m),
+    bcPoids_m(nbBC_m)
+{
+    //Les process lus ensemble sont, dans l'ordre, les lignes d'une meme matrice : elle est reprise telle quelle
+    boost::shared_ptr<const vector<int> > pStock_l = nbProcesses_m > 0 ? pContextBO_p->getProcess(0)->getStockRequirements()
+        : boost::shared_ptr<const vector<int> >();
+    bool isStockCommun_l = pStock_l && pStock_l->size() == static_cast<size_t>(nbProcesses_m) * nbRess_m;
+    for ( int idxP_l=0 ; isStockCommun_l && idxP_l < nbProcesses_m ; idxP_l++ ){
+        ProcessBO const * pProcess_l = pContextBO_p->getProcess(idxP_l);
+        isStockCommun_l = pProcess_l->getStockRequirements() == pStock_l && pProcess_l->getLigneRequirements() == idxP_l;
+    }
+    if ( isStockCommun_l ){
+        pRequirements_m = pStock_l;
+    } else {
+        boost::shared_ptr<vector<int> > pRequirements_l(new vector<int>(static_cast<size_t>(nbProcesses_m) * nbRess_m));
+        for ( int idxP_l=0 ; idxP_l < nbProcesses_m ; idxP_l++ ){
+            ProcessBO const * pProcess_l = pContextBO_p->getProcess(idxP_l);
+            for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+                (*pRequirements_l)[idxP_l*nbRess_m + idxRess_l] = pProcess_l->getRequirement(idxRess_l);
+            }
+        }
+        pRequirements_m = pRequirements_l;
+    }
+
+    for ( int idxP_l=0 ; idxP_l < nbProcesses_m ; idxP_l++ ){
+        ProcessBO const * pProcess_l = pContextBO_p->getProcess(idxP_l);
+        serviceOfProcess_m[idxP_l] = pProcess_l->getService()->getId();
+        pmc_m[idxP_l] = pProcess_l->getPMC();
+        solInit_m[idxP_l] = pProcess_l->getMachineInit() ? pProcess_l->getMachineInit()->getId() : -1;
+    }
+
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+        RessourceBO const * pRess_l = pContextBO_p->getRessource(idxRess_l);
+        weightLoadCost_m[idxRess_l] = pRess_l->getWeightLoadCost();
+        isTransient_m[idxRess_l] = pRess_l->isTransient();
+        if ( pRess_l->isTransient() ){
+            transientRess_m.push_back(idxRess_l);
+        }
+    }
+
+    for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_m ; idxMachine_l++ ){
+        MachineBO const * pMachine_l = pContextBO_p->getMachine(idxMachine_l);
+        machineLocation_m[idxMachine_l] = pMachine_l->getLocation()->getId();
+        machineNeigh_m[idxMachine_l] = pMachine_l->getNeighborhood()->getId();
+        for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+            capa_m[idxMachine_l*nbRess_m + idxRess_l] = pMachine_l->getCapa(idxRess_l);
+            safetyCapa_m[idxMachine_l*nbRess_m + idxRess_l] = pMachine_l->getSafetyCapa(idxRess_l);
+            capaByRess_m[idxRess_l*nbMachines_m + idxMachine_l] = pMachine_l->getCapa(idxRess_l);
+            safetyCapaByRess_m[idxRess_l*nbMachines_m + idxMachine_l] = pMachine_l->getSafetyCapa(idxRess_l);
+        }
+    }
+
+    vector<pair<int, int> > processesByService_l, dependances_l;
+    processesByService_l.reserve(nbProcesses_m);
+    for ( int idxP_l=0 ; idxP_l < nbProcesses_m ; idxP_l++ ){
+        processesByService_l.push_back(make_pair(serviceOfProcess_m[idxP_l], idxP_l));
+    }
+    for ( int idxS_l=0 ; idxS_l < nbServices_m ; idxS_l++ ){
+        ServiceBO const * pService_l = pContextBO_p->getService(idxS_l);
+        spreadMin_m[idxS_l] = pService_l->getSpreadMin();
+        nbMaxProcessesByService_m = max(nbMaxProcessesByService_m, pService_l->getNbProcesses());
+        BOOST_FOREACH(int idxS2_l, pService_l->getServicesIDependOn()){
+            dependances_l.push_back(make_pair(idxS_l, idxS2_l));
+        }
+    }
+    processesByService_m = IndexCSR(nbServices_m, processesByService_l);
+    servicesIDependOn_m = IndexCSR(nbServices_m, dependances_l);
+    servicesDependingOnMe_m = servicesIDependOn_m.transpose(nbServices_m);
+
+    for ( int idxBC_l=0 ; idxBC_l < nbBC_m ; idxBC_l++ ){
+        BalanceCostBO const * pBC_l = pContextBO_p->getBalanceCost(idxBC_l);
+        bcRess1_m[idxBC_l] = pBC_l->getRessource1()->getId();
+        bcRess2_m[idxBC_l] = pBC_l->getRessource2()->getId();
+        bcTarget_m[idxBC_l] = pBC_l->getTarget();
+        bcPoids_m[idxBC_l] = pBC_l->getPoids();
+    }
+}
+
+int InstanceCoreBO::getNbProcesses() const {
+    return nbProcesses_m;
+}
+
+int InstanceCoreBO::getNbRessources() const {
+    return nbRess_m;
+}
+
+int InstanceCoreBO::getNbMachines() const {
+    return nbMachines_m;
+}
+
+int InstanceCoreBO::getNbServices() const {
+    return nbServices_m;
+}
+
+int InstanceCoreBO::getNbLocations() const {
+    return nbLocations_m;
+}
+
+int InstanceCoreBO::getNbNeighborhoods() const {
+    return nbNeighs_m;
+}
+
+int InstanceCoreBO::getNbBalanceCosts() const {
+    return nbBC_m;
+}
+
+int InstanceCoreBO::getPoidsPMC() const {
+    return poidsPMC_m;
+}
+
+int InstanceCoreBO::getPoidsSMC() const {
+    return poidsSMC_m;
+}
+
+int InstanceCoreBO::getPoidsMMC() const {
+    return poidsMMC_m;
+}
+
+MMCBO const * InstanceCoreBO::getMMCBO() const {
+    return pMMCBO_m.get();
+}
+
+const vector<int>& InstanceCoreBO::getRequirements() const {
+    return *pRequirements_m;
+}
+
+const vector<int>& InstanceCoreBO::getServiceOfProcess() const {
+    return serviceOfProcess_m;
+}
+
+const vector<int>& InstanceCoreBO::getPMC() const {
+    return pmc_m;
+}
+
+const vector<int>& InstanceCoreBO::getSolInit() const {
+    return solInit_m;
+}
+
+const vector<int>& InstanceCoreBO::getWeightLoadCost() const {
+    return weightLoadCost_m;
+}
+
+const vector<char>& InstanceCoreBO::getIsTransient() const {
+    return isTransient_m;
+}
+
+const vector<int>& InstanceCoreBO::getTransientRessources() const {
+    return transientRess_m;
+}
+
+const vector<int>& InstanceCoreBO::getCapas() const {
+    return capa_m;
+}
+
+const vector<int>& InstanceCoreBO::getSafetyCapas() const {
+    return safetyCapa_m;
+}
+
+const vector<int>& InstanceCoreBO::getCapasByRess() const {
+    return capaByRess_m;
+}
+
+const vector<int>& InstanceCoreBO::getSafetyCapasByRess() const {
+    return safetyCapaByRess_m;
+}
+
+const vector<int>& InstanceCoreBO::getMachineLocation() const {
+    return machineLocation_m;
+}
+
+const vector<int>& InstanceCoreBO::getMachineNeighborhood() const {
+    return machineNeigh_m;
+}
+
+const vector<int>& InstanceCoreBO::getSpreadMin() const {
+    return spreadMin_m;
+}
+
+int InstanceCoreBO::getNbMaxProcessesByService() const {
+    return nbMaxProcessesByService_m;
+}
+
+const IndexCSR& InstanceCoreBO::getProcessesByService() const {
+    return processesByService_m;
+}
+
+const IndexCSR& InstanceCoreBO::getServicesIDependOn() const {
+    return servicesIDependOn_m;
+}
+
+const IndexCSR& InstanceCoreBO::getServicesDependingOnMe() const {
+    return servicesDependingOnMe_m;
+}
+
+const vector<int>& InstanceCoreBO::getBCRess1() const {
+    return bcRess1_m;
+}
+
+const vector<int>& InstanceCoreBO::getBCRess2() const {
+    return bcRess2_m;
+}
+
+const vector<int>& InstanceCoreBO::getBCTarget() const {
+    return bcTarget_m;
+}
+
+const vector<int>& InstanceCoreBO::getBCPoids() const {
+    return bcPoids_m;
+}
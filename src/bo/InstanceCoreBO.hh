@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+#ifndef INSTANCECOREBO_HH
+#define INSTANCECOREBO_HH
+#include "tools/IndexCSR.hh"
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+class ContextBO;
+class MMCBO;
+
+/**
+ * Donnees d'une instance stockees a plat, dans des tableaux contigus, pour les boucles critiques
+ * (checkers, evaluateurs incrementaux, simulations) : lire getProcess(idxP)->getRequirement(idxRess)
+ * demande de suivre un pointeur vers un objet qui possede lui-meme son vecteur, soit un defaut
+ * de cache par acces.
+ *
+ * Il est construit une fois l'instance completement chargee (cf ContextBO::getInstanceCore)
+ * et n'est plus modifie ensuite : il peut donc etre partage sans precaution entre threads.
+ * Il ne pointe sur aucun BO du contexte (la MMC et la matrice des requirements, immuables,
+ * sont partagees) : il peut lui survivre.
+ *
+ * Les matrices sont stockees ligne par ligne : requirements[idxP * nbRess + idxRess],
+ * capa[idxMachine * nbRess + idxRess]. Les capas sont aussi fournies ressource par ressource
+ * (capaByRess[idxRess * nbMachines + idxMachine]) pour les boucles qui balayent les machines.
+ */
+class InstanceCoreBO {
+    public:
+        /**
+         * @param pMMCBO_p la MMC du contexte, partagee plutot que recopiee
+         */
+        InstanceCoreBO(ContextBO const * pContextBO_p, boost::shared_ptr<MMCBO const> pMMCBO_p);
+
+        int getNbProcesses() const;
+        int getNbRessources() const;
+        int getNbMachines() const;
+        int getNbServices() const;
+        int getNbLocations() const;
+        int getNbNeighborhoods() const;
+        int getNbBalanceCosts() const;
+
+        int getPoidsPMC() const;
+        int getPoidsSMC() const;
+        int getPoidsMMC() const;
+        MMCBO const * getMMCBO() const;
+
+        /**
+         * Process
+         */
+        const std::vector<int>& getRequirements() const;
+        const std::vector<int>& getServiceOfProcess() const;
+        const std::vector<int>& getPMC() const;
+
+        /**
+         * Machine initiale de chaque process, c'est-a-dire la solution initiale
+         */
+        const std::vector<int>& getSolInit() const;
+
+        /**
+         * Ressources : isTransient[idxRess] vaut 1 si la ressource est transient,
+         * getTransientRessources() en donne la liste
+         */
+        const std::vector<int>& getWeightLoadCost() const;
+        const std::vector<char>& getIsTransient() const;
+        const std::vector<int>& getTransientRessources() const;
+
+        /**
+         * Machines
+         */
+        const std::vector<int>& getCapas() const;
+        const std::vector<int>& getSafetyCapas() const;
+        const std::vector<int>& getCapasByRess() const;
+        const std::vector<int>& getSafetyCapasByRess() const;
+        const std::vector<int>& getMachineLocation() const;
+        const std::vector<int>& getMachineNeighborhood() const;
+
+        /**
+         * Services
+         */
+        const std::vector<int>& getSpreadMin() const;
+        int getNbMaxProcessesByService() const;
+
+        /**
+         * Index CSR, indexes par service : ses process, les services dont il depend,
+         * et les services qui dependent de lui (pour retrouver, apres le deplacement d'un process,
+         * les services dont la contrainte de dependance est a reverifier)
+         */
+        const IndexCSR& getProcessesByService() const;
+        const IndexCSR& getServicesIDependOn() const;
+        const IndexCSR& getServicesDependingOnMe() const;
+
+        /**
+         * Balance costs
+         */
+        const std::vector<int>& getBCRess1() const;
+        const std::vector<int>& getBCRess2() const;
+        const std::vector<int>& getBCTarget() const;
+        const std::vector<int>& getBCPoids() const;
+
+    private:
+        const int nbProcesses_m;
+        const int nbRess_m;
+        const int nbMachines_m;
+        const int nbServices_m;
+        const int nbLocations_m;
+        const int nbNeighs_m;
+        const int nbBC_m;
+
+        const int poidsPMC_m;
+        const int poidsSMC_m;
+        const int poidsMMC_m;
+        boost::shared_ptr<MMCBO const> pMMCBO_m;
+
+        /**
+         * Partagee avec les ProcessBO quand ils sont les lignes, dans l'ordre, d'une meme matrice
+         * (cas des instances lues) : elle n'est alors pas dupliquee
+         */
+        boost::shared_ptr<const std::vector<int> > pRequirements_m;
+        std::vector<int> serviceOfProcess_m;
+        std::vector<int> pmc_m;
+        std::vector<int> solInit_m;
+
+        std::vector<int> weightLoadCost_m;
+        std::vector<char> isTransient_m;
+        std::vector<int> transientRess_m;
+
+        std::vector<int> capa_m;
+        std::vector<int> safetyCapa_m;
+        std::vector<int> capaByRess_m;
+        std::vector<int> safetyCapaByRess_m;
+        std::vector<int> machineLocation_m;
+        std::vector<int> machineNeigh_m;
+
+        std::vector<int> spreadMin_m;
+        int nbMaxProcessesByService_m;
+        IndexCSR processesByService_m;
+        IndexCSR servicesIDependOn_m;
+        IndexCSR servicesDependingOnMe_m;
+
+        std::vector<int> bcRess1_m;
+        std::vector<int> bcRess2_m;
+        std::vector<int> bcTarget_m;
+        std::vector<int> bcPoids_m;
+};
+
+#endif
@@ -24,40 +24,30 @@
 #include "bo/LocationBO.hh"
 #include "bo/MachineBO.hh"
 #include "bo/ServiceBO.hh"
-#include <boost/foreach.hpp>
+#include "tools/VecteurTrie.hh"
 
 LocationBO::LocationBO(int id_p) :
     id_m(id_p)
 {}
 
 void LocationBO::addMachine(MachineBO* machine_p){
-    machines_m.insert(machine_p->getId());
+    VecteurTrie::insere(machines_m, machine_p->getId());
 }
 
 void LocationBO::addMachine(int idxMachine_p){
-    machines_m.insert(idxMachine_p);
+    VecteurTrie::insere(machines_m, idxMachine_p);
 }
 
 int LocationBO::getId() const{
     return id_m;
 }
 
-unordered_set<int> LocationBO::getMachines() const {
+const vector<int>& LocationBO::getMachines() const {
 	return machines_m;
 }
 
 bool LocationBO::operator==(const LocationBO& loc_p) const {
-    if ( id_m != loc_p.id_m || machines_m.size() != loc_p.machines_m.size()){
-        return false;
-    }
-
-    BOOST_FOREACH(int idxMachine_l, machines_m){
-        if ( loc_p.machines_m.find(idxMachine_l) == loc_p.machines_m.end() ){
-            return false;
-        }
-    }
-
-    return true;
+    return id_m == loc_p.id_m && machines_m == loc_p.machines_m;
 }
 
 bool LocationBO::operator!=(const LocationBO& loc_p) const{
@@ -23,8 +23,8 @@
 
 #ifndef LOCATIONBO_HH
 #define LOCATIONBO_HH
-#include <tr1/unordered_set>
-using namespace std::tr1;
+#include <vector>
+using namespace std;
 
 class ServiceBO;
 class MachineBO;
@@ -36,7 +36,10 @@ class LocationBO {
         void addMachine(int idxMachine_p);
         int getId() const;
 
-        unordered_set<int> getMachines() const;
+        /**
+         * Indices des machines, tries par ordre croissant
+         */
+        const vector<int>& getMachines() const;
 
         bool operator==(const LocationBO& loc_p) const;
         bool operator!=(const LocationBO& loc_p) const;
@@ -47,7 +50,7 @@ class LocationBO {
         /**
          * Ensemble des id des machines de la Location
          */
-        unordered_set<int> machines_m;
+        vector<int> machines_m;
 };
 
 #endif
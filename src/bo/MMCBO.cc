@@ -20,28 +20,318 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  *
  */
-
 #include "bo/MMCBO.hh"
 #include "bo/MachineBO.hh"
+#include "tools/Log.hh"
+#include <algorithm>
+#include <tr1/unordered_map>
+using namespace std;
+using namespace std::tr1;
+
+static const uint64_t HACHE_INIT = 14695981039346656037ULL;
+
+static uint64_t hacheCout(uint64_t hache_p, int cout_p){
+    return (hache_p ^ (uint32_t) cout_p) * 1099511628211ULL;
+}
+
+static bool memesCouts(const int* pA_p, const int* pB_p, int nb_p, int pas_p){
+    for ( int idx_l=0 ; idx_l < nb_p ; idx_l++ ){
+        if ( pA_p[idx_l * pas_p] != pB_p[idx_l * pas_p] ){
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Regroupe les suites de couts identiques
+ * @param Premier element de la suite numero 0
+ * @param Nombre de suites
+ * @param Ecart entre le debut de deux suites consecutives
+ * @param Nombre d'elements par suite
+ * @param Ecart entre deux elements d'une meme suite
+ * @param Hache de chaque suite, pour ne comparer exactement que les candidates
+ * @param (out) Classe de chaque suite
+ * @param (out) Suite representant chaque classe
+ */
+static void regroupe(const int* pDebut_p, int nbSuites_p, int pasSuites_p, int nbElements_p, int pasElements_p,
+        const vector<uint64_t>& haches_p, vector<int>& classes_p, vector<int>& representants_p){
+    classes_p.assign(nbSuites_p, 0);
+    representants_p.clear();
+    unordered_map<uint64_t, vector<int> > classesParHache_l;
+    for ( int idxSuite_l=0 ; idxSuite_l < nbSuites_p ; idxSuite_l++ ){
+        const int* pSuite_l = pDebut_p + idxSuite_l * pasSuites_p;
+        vector<int>& candidates_l = classesParHache_l[haches_p[idxSuite_l]];
+        int classe_l = -1;
+        for ( vector<int>::const_iterator it_l=candidates_l.begin() ; it_l != candidates_l.end() && classe_l == -1 ; it_l++ ){
+            if ( memesCouts(pSuite_l, pDebut_p + representants_p[*it_l] * pasSuites_p, nbElements_p, pasElements_p) ){
+                classe_l = *it_l;
+            }
+        }
+        if ( classe_l == -1 ){
+            classe_l = representants_p.size();
+            representants_p.push_back(idxSuite_l);
+            candidates_l.push_back(classe_l);
+        }
+        classes_p[idxSuite_l] = classe_l;
+    }
+}
 
 MMCBO::MMCBO(const vector<vector<int> >& costs_p) :
-    costs_m(costs_p)
-{}
+    nbMachines_m(costs_p.size())
+{
+    vector<int> costs_l;
+    costs_l.reserve(nbMachines_m * nbMachines_m);
+    for ( int idxFrom_l=0 ; idxFrom_l < nbMachines_m ; idxFrom_l++ ){
+        costs_l.insert(costs_l.end(), costs_p[idxFrom_l].begin(), costs_p[idxFrom_l].end());
+    }
+    compresse(costs_l);
+}
+
+MMCBO::MMCBO(int nbMachines_p, vector<int>& costs_p) :
+    nbMachines_m(nbMachines_p)
+{
+    compresse(costs_p);
+}
+
+/**
+ * Les blocs ne valent le coup que s'ils divisent au moins par 2 le nombre de cellules
+ */
+static bool blocsRentables(int nbClassesLignes_p, int nbClassesColonnes_p, int nbMachines_p){
+    const size_t nbCellulesBlocs_l = (size_t) nbClassesLignes_p * nbClassesColonnes_p + 2 * (size_t) nbMachines_p;
+    return 2 * nbCellulesBlocs_l <= (size_t) nbMachines_p * nbMachines_p;
+}
+
+void MMCBO::compresse(vector<int>& costs_p){
+    vector<int> costs_l;
+    costs_l.swap(costs_p);
+    int* pCosts_l = nbMachines_m > 0 ? &costs_l[0] : 0;
+
+    /* Minorants bon marche des nombres de classes : lignes distinctes sur les premieres colonnes,
+     * colonnes distinctes sur les premieres lignes. S'ils excluent deja les blocs (matrice aleatoire),
+     * la matrice reste a plat sans hacher ni regrouper toutes ses cellules
+     */
+    const int nbEchantillons_l = min(nbMachines_m, 16);
+    vector<int> lignesRepresentantes_l, colonnesRepresentantes_l;
+    vector<uint64_t> haches_l(nbMachines_m, HACHE_INIT);
+    for ( int idxFrom_l=0 ; idxFrom_l < nbMachines_m ; idxFrom_l++ ){
+        const int* pLigne_l = pCosts_l + idxFrom_l * nbMachines_m;
+        for ( int idxTo_l=0 ; idxTo_l < nbEchantillons_l ; idxTo_l++ ){
+            haches_l[idxFrom_l] = hacheCout(haches_l[idxFrom_l], pLigne_l[idxTo_l]);
+        }
+    }
+    regroupe(pCosts_l, nbMachines_m, nbMachines_m, nbEchantillons_l, 1, haches_l, classeLigne_m, lignesRepresentantes_l);
+    nbClassesLignes_m = lignesRepresentantes_l.size();
+    haches_l.assign(nbMachines_m, HACHE_INIT);
+    for ( int idxFrom_l=0 ; idxFrom_l < nbEchantillons_l ; idxFrom_l++ ){
+        const int* pLigne_l = pCosts_l + idxFrom_l * nbMachines_m;
+        for ( int idxTo_l=0 ; idxTo_l < nbMachines_m ; idxTo_l++ ){
+            haches_l[idxTo_l] = hacheCout(haches_l[idxTo_l], pLigne_l[idxTo_l]);
+        }
+    }
+    regroupe(pCosts_l, nbMachines_m, 1, nbEchantillons_l, nbMachines_m, haches_l, classeColonne_m, colonnesRepresentantes_l);
+    nbClassesColonnes_m = colonnesRepresentantes_l.size();
+    if ( ! blocsRentables(nbClassesLignes_m, nbClassesColonnes_m, nbMachines_m) ){
+        blocs_m = false;
+        vector<int>().swap(classeLigne_m);
+        vector<int>().swap(classeColonne_m);
+        code(costs_l);
+        LOG(DEBUG) << "MMC : au moins " << nbClassesLignes_m << " x " << nbClassesColonnes_m << " classes, a plat, "
+            << getTailleOctets() << " octets au lieu de " << costs_l.size() * sizeof(int) << endl;
+        return;
+    }
+
+    //Lignes identiques, puis colonnes identiques (restreintes aux lignes representantes, qui suffisent)
+    //Les haches sont calcules en parcourant les cellules ligne par ligne, y compris pour les colonnes
+    haches_l.assign(nbMachines_m, HACHE_INIT);
+    for ( int idxFrom_l=0 ; idxFrom_l < nbMachines_m ; idxFrom_l++ ){
+        const int* pLigne_l = pCosts_l + idxFrom_l * nbMachines_m;
+        for ( int idxTo_l=0 ; idxTo_l < nbMachines_m ; idxTo_l++ ){
+            haches_l[idxFrom_l] = hacheCout(haches_l[idxFrom_l], pLigne_l[idxTo_l]);
+        }
+    }
+    regroupe(pCosts_l, nbMachines_m, nbMachines_m, nbMachines_m, 1, haches_l, classeLigne_m, lignesRepresentantes_l);
+    nbClassesLignes_m = lignesRepresentantes_l.size();
+
+    /* Les lignes representantes sont tassees en tete de la matrice, sur place pour ne pas doubler
+     * la memoire (le representant de la classe k est une ligne d'indice >= k)
+     */
+    for ( int idxClasse_l=0 ; idxClasse_l < nbClassesLignes_m ; idxClasse_l++ ){
+        if ( lignesRepresentantes_l[idxClasse_l] != idxClasse_l ){
+            const int* pLigne_l = pCosts_l + lignesRepresentantes_l[idxClasse_l] * nbMachines_m;
+            copy(pLigne_l, pLigne_l + nbMachines_m, pCosts_l + idxClasse_l * nbMachines_m);
+        }
+    }
+    haches_l.assign(nbMachines_m, HACHE_INIT);
+    for ( int idxClasse_l=0 ; idxClasse_l < nbClassesLignes_m ; idxClasse_l++ ){
+        const int* pLigne_l = pCosts_l + idxClasse_l * nbMachines_m;
+        for ( int idxTo_l=0 ; idxTo_l < nbMachines_m ; idxTo_l++ ){
+            haches_l[idxTo_l] = hacheCout(haches_l[idxTo_l], pLigne_l[idxTo_l]);
+        }
+    }
+    regroupe(pCosts_l, nbMachines_m, 1, nbClassesLignes_m, nbMachines_m,
+            haches_l, classeColonne_m, colonnesRepresentantes_l);
+    nbClassesColonnes_m = colonnesRepresentantes_l.size();
+
+    blocs_m = blocsRentables(nbClassesLignes_m, nbClassesColonnes_m, nbMachines_m);
+
+    if ( blocs_m ){
+        vector<int> table_l(nbClassesLignes_m * nbClassesColonnes_m);
+        for ( int idxL_l=0 ; idxL_l < nbClassesLignes_m ; idxL_l++ ){
+            for ( int idxC_l=0 ; idxC_l < nbClassesColonnes_m ; idxC_l++ ){
+                table_l[idxL_l * nbClassesColonnes_m + idxC_l] = pCosts_l[idxL_l * nbMachines_m + colonnesRepresentantes_l[idxC_l]];
+            }
+        }
+        code(table_l);
+    } else {
+        //Retour a la matrice complete, en partant de la fin pour ne pas ecraser les lignes tassees
+        for ( int idxFrom_l=nbMachines_m-1 ; idxFrom_l >= 0 ; idxFrom_l-- ){
+            if ( classeLigne_m[idxFrom_l] != idxFrom_l ){
+                const int* pLigne_l = pCosts_l + classeLigne_m[idxFrom_l] * nbMachines_m;
+                copy(pLigne_l, pLigne_l + nbMachines_m, pCosts_l + idxFrom_l * nbMachines_m);
+            }
+        }
+        vector<int>().swap(classeLigne_m);
+        vector<int>().swap(classeColonne_m);
+        code(costs_l);
+    }
+
+    LOG(DEBUG) << "MMC : " << nbClassesLignes_m << " x " << nbClassesColonnes_m << " classes, "
+        << (blocs_m ? "par blocs" : "a plat") << ", " << getTailleOctets() << " octets au lieu de "
+        << costs_l.size() * sizeof(int) << endl;
+}
+
+void MMCBO::code(const vector<int>& valeurs_p){
+    /* Code de chaque valeur distincte. Les couts du challenge sont de petits entiers positifs :
+     * on indexe alors directement par la valeur plutot que de passer par une table de hachage
+     */
+    int min_l = 0, max_l = -1;
+    if ( ! valeurs_p.empty() ){
+        min_l = max_l = valeurs_p[0];
+        for ( vector<int>::const_iterator it_l=valeurs_p.begin() ; it_l != valeurs_p.end() ; it_l++ ){
+            min_l = min(min_l, *it_l);
+            max_l = max(max_l, *it_l);
+        }
+    }
+    if ( (int64_t) max_l - min_l < 65536 ){
+        /* Les codes sont ecrits sur 8 bits au fil de la decouverte des valeurs, sans seconde passe
+         * sur la matrice : c'est le cas courant. Ils ne sont recalcules sur 16 bits que si la palette deborde
+         */
+        vector<int> codes_l(max_l - min_l + 1, -1);
+        codes8_m.resize(valeurs_p.size());
+        for ( size_t idx_l=0 ; idx_l < valeurs_p.size() ; idx_l++ ){
+            int& code_l = codes_l[valeurs_p[idx_l] - min_l];
+            if ( code_l == -1 ){
+                code_l = palette_m.size();
+                palette_m.push_back(valeurs_p[idx_l]);
+            }
+            codes8_m[idx_l] = code_l;
+        }
+        if ( palette_m.size() <= 256 ){
+            codage_m = CODE_8;
+            return;
+        }
+
+        vector<uint8_t>().swap(codes8_m);
+        codage_m = CODE_16;
+        codes16_m.resize(valeurs_p.size());
+        for ( size_t idx_l=0 ; idx_l < valeurs_p.size() ; idx_l++ ){
+            codes16_m[idx_l] = codes_l[valeurs_p[idx_l] - min_l];
+        }
+        return;
+    }
+
+    //Plus de 65536 valeurs possibles : on regarde s'il y a au plus 65536 valeurs distinctes
+    unordered_map<int, int> codesHaches_l;
+    for ( vector<int>::const_iterator it_l=valeurs_p.begin() ; it_l != valeurs_p.end() && palette_m.size() <= 65536 ; it_l++ ){
+        if ( codesHaches_l.insert(make_pair(*it_l, (int) palette_m.size())).second ){
+            palette_m.push_back(*it_l);
+        }
+    }
+
+    if ( palette_m.size() <= 256 ){
+        codage_m = CODE_8;
+        codes8_m.resize(valeurs_p.size());
+        for ( size_t idx_l=0 ; idx_l < valeurs_p.size() ; idx_l++ ){
+            codes8_m[idx_l] = codesHaches_l[valeurs_p[idx_l]];
+        }
+    } else if ( palette_m.size() <= 65536 ){
+        codage_m = CODE_16;
+        codes16_m.resize(valeurs_p.size());
+        for ( size_t idx_l=0 ; idx_l < valeurs_p.size() ; idx_l++ ){
+            codes16_m[idx_l] = codesHaches_l[valeurs_p[idx_l]];
+        }
+    } else {
+        codage_m = BRUT_32;
+        vector<int>().swap(palette_m);
+        brut_m = valeurs_p;
+    }
+}
+
+int MMCBO::decode(size_t idx_p) const{
+    switch ( codage_m ){
+        case CODE_8:
+            return palette_m[codes8_m[idx_p]];
+        case CODE_16:
+            return palette_m[codes16_m[idx_p]];
+        default:
+            return brut_m[idx_p];
+    }
+}
 
 int MMCBO::getCost(MachineBO* from_p, MachineBO* to_p) const {
-    return costs_m[from_p->getId()][to_p->getId()];
+    return getCost(from_p->getId(), to_p->getId());
 }
 
 int MMCBO::getCost(int idxMachineFrom_p, int idxMachineTo_p) const{
-    return costs_m[idxMachineFrom_p][idxMachineTo_p];
+    if ( blocs_m ){
+        return decode(classeLigne_m[idxMachineFrom_p] * nbClassesColonnes_m + classeColonne_m[idxMachineTo_p]);
+    }
+    return decode((size_t) idxMachineFrom_p * nbMachines_m + idxMachineTo_p);
 }
 
 vector<int> MMCBO::getCosts(MachineBO* from_p) const{
-    return costs_m[from_p->getId()];
+    vector<int> result_l(nbMachines_m);
+    for ( int idxTo_l=0 ; idxTo_l < nbMachines_m ; idxTo_l++ ){
+        result_l[idxTo_l] = getCost(from_p->getId(), idxTo_l);
+    }
+    return result_l;
+}
+
+int MMCBO::getNbMachines() const{
+    return nbMachines_m;
+}
+
+bool MMCBO::isBlocs() const{
+    return blocs_m;
+}
+
+int MMCBO::getNbClassesLignes() const{
+    return nbClassesLignes_m;
+}
+
+int MMCBO::getNbClassesColonnes() const{
+    return nbClassesColonnes_m;
+}
+
+size_t MMCBO::getTailleOctets() const{
+    return (classeLigne_m.size() + classeColonne_m.size() + palette_m.size() + brut_m.size()) * sizeof(int)
+        + codes8_m.size() * sizeof(uint8_t)
+        + codes16_m.size() * sizeof(uint16_t);
 }
 
 bool MMCBO::operator==(const MMCBO& mmc_p) const{
-    return costs_m == mmc_p.costs_m;
+    if ( nbMachines_m != mmc_p.nbMachines_m ){
+        return false;
+    }
+    for ( int idxFrom_l=0 ; idxFrom_l < nbMachines_m ; idxFrom_l++ ){
+        for ( int idxTo_l=0 ; idxTo_l < nbMachines_m ; idxTo_l++ ){
+            if ( getCost(idxFrom_l, idxTo_l) != mmc_p.getCost(idxFrom_l, idxTo_l) ){
+                return false;
+            }
+        }
+    }
+    return true;
 }
 
 bool MMCBO::operator!=(const MMCBO& mmc_p) const{
@@ -20,27 +20,110 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  *
  */
-
 #ifndef MMCBO_HH
 #define MMCBO_HH
 #include <vector>
+#include <stddef.h>
+#include <stdint.h>
 using namespace std;
 
 class MachineBO;
 
+/**
+ * Matrice des Machine Move Costs, compressee a la construction.
+ *
+ * Dans les instances du challenge, les couts dependent essentiellement des locations :
+ * beaucoup de machines ont exactement la meme ligne (et la meme colonne) de couts.
+ * On regroupe donc les lignes identiques en classes de lignes, les colonnes identiques en classes
+ * de colonnes, et on ne stocke que la table classes de lignes x classes de colonnes.
+ * Si ce decoupage en blocs ne fait pas gagner au moins un facteur 2, on garde la matrice
+ * M x M complete, stockee a plat ligne par ligne.
+ *
+ * Dans les deux cas, les valeurs sont codees sur le type le plus etroit possible :
+ * un indice dans une palette des valeurs distinctes sur 8 ou 16 bits si elles sont peu nombreuses,
+ * la valeur brute sur 32 bits sinon. Une lecture coute ainsi au plus trois acces en memoire contigue,
+ * sans indirection par ligne.
+ */
 class MMCBO {
     public:
         MMCBO(const vector<vector<int> >& costs_p);
+
+        /**
+         * @param Nombre de machines
+         * @param Couts a plat : costs_p[from * nbMachines + to]. Le contenu du vecteur est transfere
+         * au MMCBO (le vecteur est vide au retour), pour ne pas dupliquer une matrice M x M au chargement
+         */
+        MMCBO(int nbMachines_p, vector<int>& costs_p);
         int getCost(MachineBO* from_p, MachineBO* to_p) const;
         int getCost(int idxMachineFrom_p, int idxMachineTo_p) const;
 
         vector<int> getCosts(MachineBO* from_p) const;
 
+        int getNbMachines() const;
+
+        /**
+         * @return TRUE si la matrice est stockee par blocs (classes de lignes x classes de colonnes)
+         */
+        bool isBlocs() const;
+
+        /**
+         * Nombres de classes de lignes et de colonnes. Quand la matrice est a plat, ce peuvent n'etre que
+         * des minorants (calcules sur les premieres colonnes et lignes), qui ont suffi a ecarter les blocs
+         */
+        int getNbClassesLignes() const;
+        int getNbClassesColonnes() const;
+
+        /**
+         * @return Taille du stockage, en octets (hors en-tetes des vecteurs)
+         */
+        size_t getTailleOctets() const;
+
         bool operator==(const MMCBO& mmc_p) const;
         bool operator!=(const MMCBO& mmc_p) const;
 
     private:
-        vector<vector<int> > costs_m; // tq cost_m[from][to]
+        enum Codage {
+            CODE_8,
+            CODE_16,
+            BRUT_32
+        };
+
+        /**
+         * Calcule la representation compressee de la matrice a plat (qui est liberee au retour)
+         */
+        void compresse(vector<int>& costs_p);
+
+        /**
+         * Code les valeurs sur le type le plus etroit possible
+         */
+        void code(const vector<int>& valeurs_p);
+
+        /**
+         * @return La valeur de la cellule idx_p de la table (codes8_m, codes16_m ou brut_m)
+         */
+        int decode(size_t idx_p) const;
+
+        int nbMachines_m;
+
+        /**
+         * Si blocs_m, la cellule (from, to) est a l'indice classeLigne_m[from] * nbClassesColonnes_m + classeColonne_m[to]
+         * Sinon elle est a l'indice from * nbMachines + to, et les classes ne sont pas stockees
+         */
+        bool blocs_m;
+        int nbClassesLignes_m;
+        int nbClassesColonnes_m;
+        vector<int> classeLigne_m;
+        vector<int> classeColonne_m;
+
+        Codage codage_m;
+        vector<uint8_t> codes8_m;
+        vector<uint16_t> codes16_m;
+        vector<int> brut_m;
+
+        /**
+         * Valeurs distinctes, indexees par les codes 8 ou 16 bits
+         */
+        vector<int> palette_m;
 };
 
 #endif
@@ -24,18 +24,18 @@
 #include "bo/NeighborhoodBO.hh"
 #include "bo/MachineBO.hh"
 #include "bo/ServiceBO.hh"
-#include <boost/foreach.hpp>
+#include "tools/VecteurTrie.hh"
 
 NeighborhoodBO::NeighborhoodBO(int id_p) :
     id_m(id_p)
 {}
 
 void NeighborhoodBO::addMachine(MachineBO* machine_p){
-    machines_m.insert(machine_p->getId());
+    VecteurTrie::insere(machines_m, machine_p->getId());
 }
 
 void NeighborhoodBO::addMachine(int idxMachine_p){
-    machines_m.insert(idxMachine_p);
+    VecteurTrie::insere(machines_m, idxMachine_p);
 }
 
 int NeighborhoodBO::getId() const{
@@ -43,20 +43,10 @@ int NeighborhoodBO::getId() const{
 }
 
 bool NeighborhoodBO::operator==(const NeighborhoodBO& neigh_p) const{
-    if ( id_m != neigh_p.id_m || machines_m.size() != neigh_p.machines_m.size() ){
-        return false;
-    }
-
-    BOOST_FOREACH(int idxMachines_l, machines_m){
-        if ( neigh_p.machines_m.find(idxMachines_l) == neigh_p.machines_m.end() ){
-            return false;
-        }
-    }
-
-    return true;
+    return id_m == neigh_p.id_m && machines_m == neigh_p.machines_m;
 }
 
-unordered_set<int> NeighborhoodBO::getMachines() const{
+const vector<int>& NeighborhoodBO::getMachines() const{
 	return machines_m;
 }
 
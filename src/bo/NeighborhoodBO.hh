@@ -23,8 +23,8 @@
 
 #ifndef NEIGHBORHOODBO_HH
 #define NEIGHBORHOODBO_HH
-#include <tr1/unordered_set>
-using namespace std::tr1;
+#include <vector>
+using namespace std;
 
 class MachineBO;
 class ServiceBO;
@@ -35,7 +35,10 @@ class NeighborhoodBO {
         void addMachine(MachineBO* machine_p);
         void addMachine(int idxMachine_p);
         int getId() const;
-        unordered_set<int> getMachines() const;
+        /**
+         * Indices des machines, tries par ordre croissant
+         */
+        const vector<int>& getMachines() const;
 
         bool operator==(const NeighborhoodBO& neigh_p) const;
         bool operator!=(const NeighborhoodBO& neigh_p) const;
@@ -46,7 +49,7 @@ class NeighborhoodBO {
         /**
          * Ensemble des id des machines du neighborhood
          */
-        unordered_set<int> machines_m;
+        vector<int> machines_m;
 };
 
 #endif
@@ -25,17 +25,47 @@
 #include "bo/MachineBO.hh"
 #include "bo/RessourceBO.hh"
 #include "bo/ServiceBO.hh"
+#include <algorithm>
 
 ProcessBO::ProcessBO(int id_p, ServiceBO* pService_p, const vector<int>& vRequirements_p,  int pmc_p) :
     id_m(id_p),
     pService_m(pService_p),
-    vRequirements_m(vRequirements_p),
+    pStockRequirements_m(new vector<int>(vRequirements_p)),
+    idxLigne_m(0),
+    nbRess_m(vRequirements_p.size()),
+    pRequirements_m(pStockRequirements_m->empty() ? 0 : &(*pStockRequirements_m)[0]),
     pMachineInit_m(0),
     pmc_m(pmc_p)
 {
     pService_m->addProcess(this);
 }
 
+ProcessBO::ProcessBO(int id_p, ServiceBO* pService_p, const boost::shared_ptr<const vector<int> >& pStock_p, int idxLigne_p, int nbRess_p, int pmc_p) :
+    id_m(id_p),
+    pService_m(pService_p),
+    pStockRequirements_m(pStock_p),
+    idxLigne_m(idxLigne_p),
+    nbRess_m(nbRess_p),
+    pRequirements_m(pStockRequirements_m->empty() ? 0 : &(*pStockRequirements_m)[0] + static_cast<size_t>(idxLigne_p) * nbRess_p),
+    pMachineInit_m(0),
+    pmc_m(pmc_p)
+{
+    pService_m->addProcess(this);
+}
+
+ProcessBO::ProcessBO(const ProcessBO& process_p, ServiceBO* pService_p) :
+    id_m(process_p.id_m),
+    pService_m(pService_p),
+    pStockRequirements_m(process_p.pStockRequirements_m),
+    idxLigne_m(process_p.idxLigne_m),
+    nbRess_m(process_p.nbRess_m),
+    pRequirements_m(process_p.pRequirements_m),
+    pMachineInit_m(0),
+    pmc_m(process_p.pmc_m)
+{
+    pService_m->addProcess(this);
+}
+
 int ProcessBO::getId() const{
     return id_m;
 }
@@ -45,15 +75,23 @@ ServiceBO* ProcessBO::getService() const{
 }
 
 int ProcessBO::getRequirement(int idxRess_p) const{
-    return vRequirements_m[idxRess_p];
+    return pRequirements_m[idxRess_p];
 }
 
 int ProcessBO::getRequirement(RessourceBO const * pRess_p) const{
-    return vRequirements_m[pRess_p->getId()];
+    return pRequirements_m[pRess_p->getId()];
 }
 
 vector<int> ProcessBO::getRequirements() const{
-    return vRequirements_m;
+    return vector<int>(pRequirements_m, pRequirements_m + nbRess_m);
+}
+
+const boost::shared_ptr<const vector<int> >& ProcessBO::getStockRequirements() const{
+    return pStockRequirements_m;
+}
+
+int ProcessBO::getLigneRequirements() const{
+    return idxLigne_m;
 }
 
 void ProcessBO::setMachineInit(MachineBO* pMachine_p){
@@ -71,7 +109,8 @@ int ProcessBO::getPMC() const{
 bool ProcessBO::operator==(const ProcessBO& process_p) const {
     return id_m == process_p.id_m
         && pService_m->getId() == process_p.pService_m->getId()
-        && vRequirements_m == process_p.vRequirements_m
+        && nbRess_m == process_p.nbRess_m
+        && equal(pRequirements_m, pRequirements_m + nbRess_m, process_p.pRequirements_m)
         && pMachineInit_m->getId() == process_p.pMachineInit_m->getId()
         && pmc_m == process_p.pmc_m;
 }
@@ -24,6 +24,7 @@
 #ifndef PROCESSBO_HH
 #define PROCESSBO_HH
 #include <vector>
+#include <boost/shared_ptr.hpp>
 using namespace std;
 
 class MachineBO;
@@ -34,11 +35,39 @@ class ProcessBO {
     public:
         ProcessBO(int id_p, ServiceBO* pService_p, const vector<int>& vRequirements_p,  int pmc_p);
 
+        /**
+         * Process dont les requirements sont la ligne idxLigne_p de la matrice P x R pStock_p
+         * (stockee a plat), partagee avec les autres process lus en meme temps
+         */
+        ProcessBO(int id_p, ServiceBO* pService_p, const boost::shared_ptr<const vector<int> >& pStock_p, int idxLigne_p, int nbRess_p, int pmc_p);
+
+        /**
+         * Copie du process, rattachee a un autre service (celui d'une copie du contexte) :
+         * la matrice des requirements est partagee, pas recopiee
+         */
+        ProcessBO(const ProcessBO& process_p, ServiceBO* pService_p);
+
         int getId() const;
         ServiceBO* getService() const;
         int getRequirement(int idxRess_p) const;
         int getRequirement(RessourceBO const * pRess_p) const;
+
+        /**
+         * Copie des requirements (pour les ecritures et les tests : les boucles critiques
+         * passent par l'#InstanceCoreBO)
+         */
         vector<int> getRequirements() const;
+
+        /**
+         * Matrice dont les requirements du process sont une ligne (cf ctor), et rang de cette ligne
+         */
+        const boost::shared_ptr<const vector<int> >& getStockRequirements() const;
+        int getLigneRequirements() const;
+
+        /**
+         * Pour un process deja ajoute a un contexte, passer par ContextBO::setMachineInit
+         * (l'#InstanceCoreBO du contexte doit etre invalide)
+         */
         void setMachineInit(MachineBO* pMachine_p);
         MachineBO* getMachineInit() const;
         int getPMC() const;
@@ -55,10 +84,16 @@ class ProcessBO {
         ServiceBO* const pService_m;
 
         /**
-         * Ressources necessaires au process
-         * requirements[pRess_l->getId()] => quantite necessaire de ressources du type donne
+         * Ressources necessaires au process : pRequirements_m[pRess_l->getId()] => quantite necessaire
+         * de ressources du type donne.
+         * C'est une vue sur la ligne idxLigne_m d'une matrice P x R partagee par les process lus ensemble,
+         * par les copies du contexte et par l'#InstanceCoreBO (comme la MMC) : les requirements ne sont
+         * stockes qu'une fois, sans vecteur par process
          */
-        const vector<int> vRequirements_m;
+        const boost::shared_ptr<const vector<int> > pStockRequirements_m;
+        const int idxLigne_m;
+        const int nbRess_m;
+        const int* const pRequirements_m;
 
         /**
          * Machine sur laquel le process est place initialement
@@ -23,14 +23,26 @@
 
 #include "bo/ServiceBO.hh"
 #include "bo/ProcessBO.hh"
-#include <boost/foreach.hpp>
+#include "tools/VecteurTrie.hh"
+#include <algorithm>
 
 
 ServiceBO::ServiceBO(int id_p, int spreadMin_p, const unordered_set<int>& sDependances_p) :
     id_m(id_p),
     spreadMin_m(spreadMin_p),
-    sIDependOnThem_m(sDependances_p)
-{}
+    vIDependOnThem_m(sDependances_p.begin(), sDependances_p.end())
+{
+    sort(vIDependOnThem_m.begin(), vIDependOnThem_m.end());
+}
+
+ServiceBO::ServiceBO(int id_p, int spreadMin_p, vector<int>& vDependances_p) :
+    id_m(id_p),
+    spreadMin_m(spreadMin_p)
+{
+    sort(vDependances_p.begin(), vDependances_p.end());
+    vDependances_p.erase(unique(vDependances_p.begin(), vDependances_p.end()), vDependances_p.end());
+    vIDependOnThem_m.swap(vDependances_p);
+}
 
 int ServiceBO::getId() const{
     return id_m;
@@ -41,54 +53,38 @@ int ServiceBO::getSpreadMin() const {
 }
 
 int ServiceBO::getNbServicesIDependOn() const{
-    return sIDependOnThem_m.size();
+    return vIDependOnThem_m.size();
 }
 
 bool ServiceBO::iDependOn(int idx_p) const{
-    return sIDependOnThem_m.find(idx_p) != sIDependOnThem_m.end();
+    return VecteurTrie::contient(vIDependOnThem_m, idx_p);
 }
 
 void ServiceBO::addProcess(ProcessBO* pProcess_p){
-    sProcess_m.insert(pProcess_p->getId());
+    VecteurTrie::insere(vProcess_m, pProcess_p->getId());
 }
 
 int ServiceBO::getNbProcesses() const{
-    return sProcess_m.size();
+    return vProcess_m.size();
 }
 
 bool ServiceBO::containsProcess(int idxProcess_p) const{
-    return sProcess_m.find(idxProcess_p) != sProcess_m.end();
+    return VecteurTrie::contient(vProcess_m, idxProcess_p);
 }
 
-unordered_set<int> ServiceBO::getProcesses() const{
-    return sProcess_m;
+const vector<int>& ServiceBO::getProcesses() const{
+    return vProcess_m;
 }
 
-unordered_set<int> ServiceBO::getServicesIDependOn() const{
-    return sIDependOnThem_m;
+const vector<int>& ServiceBO::getServicesIDependOn() const{
+    return vIDependOnThem_m;
 }
 
 bool ServiceBO::operator==(const ServiceBO& service_p) const {
-    if ( id_m != service_p.id_m
-        || sProcess_m.size() != service_p.sProcess_m.size()
-        || spreadMin_m != service_p.spreadMin_m
-        || sIDependOnThem_m.size() != service_p.sIDependOnThem_m.size()){
-        return false;
-    }
-
-    BOOST_FOREACH(int idxP_l, sProcess_m){
-        if ( service_p.sProcess_m.find(idxP_l) == service_p.sProcess_m.end() ){
-            return false;
-        }
-    }
-
-    BOOST_FOREACH(int idxDep_l, sIDependOnThem_m){
-        if ( ! service_p.iDependOn(idxDep_l) ){
-            return false;
-        }
-    }
-
-    return true;
+    return id_m == service_p.id_m
+        && spreadMin_m == service_p.spreadMin_m
+        && vProcess_m == service_p.vProcess_m
+        && vIDependOnThem_m == service_p.vIDependOnThem_m;
 }
 
 bool ServiceBO::operator!=(const ServiceBO& service_p) const{
@@ -25,6 +25,8 @@
 #define SERVICEBO_HH
 #include <tr1/unordered_set>
 #include <tr1/unordered_map>
+#include <vector>
+using namespace std;
 using namespace std::tr1;
 
 class ProcessBO;
@@ -34,6 +36,12 @@ class ServiceBO {
     public:
         ServiceBO(int id_p, int spreadMin_p, const unordered_set<int>& sDependances_p);
 
+        /**
+         * Variante utilisee par les lecteurs : les dependances sont triees,
+         * dedoublonnees puis echangees dans le service (vDependances_p est vide au retour)
+         */
+        ServiceBO(int id_p, int spreadMin_p, vector<int>& vDependances_p);
+
         int getId() const;
         int getSpreadMin() const;
 
@@ -47,12 +55,18 @@ class ServiceBO {
          */
         bool iDependOn(int idxService_p) const;
 
-        unordered_set<int> getServicesIDependOn() const;
+        /**
+         * Indices des services dont "this" depend, tries par ordre croissant
+         */
+        const vector<int>& getServicesIDependOn() const;
 
         void addProcess(ProcessBO* pProcess_p);
         int getNbProcesses() const;
         bool containsProcess(int idxProcess_p) const;
-        unordered_set<int> getProcesses() const;
+        /**
+         * Indices des processes du service, tries par ordre croissant
+         */
+        const vector<int>& getProcesses() const;
 
         bool operator==(const ServiceBO& service_p) const;
         bool operator!=(const ServiceBO& service_p) const;
@@ -62,9 +76,11 @@ class ServiceBO {
         const int id_m;
 
         /**
-         * Liste des indices de processes appartenant au service
+         * Liste triee des indices de processes appartenant au service.
+         * Les lecteurs ajoutent les processes par indice croissant : l'ajout
+         * est alors un simple push_back
          */
-        unordered_set<int> sProcess_m;
+        vector<int> vProcess_m;
 
         /**
          * Nombre minimum de locations sur lesquels les processes du services
@@ -73,9 +89,9 @@ class ServiceBO {
         const int spreadMin_m;
 
         /**
-         * Contient les indices des services dont "this" depend
+         * Contient les indices (tries, sans doublon) des services dont "this" depend
          */
-        const unordered_set<int> sIDependOnThem_m;
+        vector<int> vIDependOnThem_m;
 };
 
 
@@ -24,18 +24,25 @@
 #include "dtoin/BalanceCostDtoin.hh"
 #include "bo/BalanceCostBO.hh"
 #include "bo/ContextBO.hh"
+#include "dtoin/ScannerDtoin.hh"
 #include "tools/Log.hh"
-#include <cassert>
+#include <climits>
 
 void BalanceCostDtoin::read(istream& is_p, ContextBO* pContextBO_p){
-    int nbBalanceCosts_l;
-    is_p >> nbBalanceCosts_l;
+    ScannerDtoin scanner_l(is_p, "section balance costs");
+    read(scanner_l, pContextBO_p);
+}
+
+void BalanceCostDtoin::read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p){
+    const int nbRess_l = pContextBO_p->getNbRessources();
+    const int nbBalanceCosts_l = scanner_p.lireEntier("nombre de balance costs", 0, INT_MAX);
     LOG(DEBUG) << nbBalanceCosts_l << " balance costs" << endl;
-    assert(nbBalanceCosts_l >= 0);
 
     for ( int idxBC_l=0 ; idxBC_l < nbBalanceCosts_l ; idxBC_l++ ){
-        int idxRess1_l, idxRess2_l, target_l, poids_l;
-        is_p >> idxRess1_l >> idxRess2_l >> target_l >> poids_l;
+        const int idxRess1_l = scanner_p.lireEntier("premiere ressource du balance cost", 0, nbRess_l - 1);
+        const int idxRess2_l = scanner_p.lireEntier("seconde ressource du balance cost", 0, nbRess_l - 1);
+        const int target_l = scanner_p.lireEntier("target du balance cost");
+        const int poids_l = scanner_p.lireEntier("poids du balance cost");
         LOG(DEBUG) << "\tBC " << idxBC_l << " : r1=" << idxRess1_l << ", r2=" << idxRess2_l << ", target=" << target_l << ", poids=" << poids_l << endl;
 
 
@@ -27,6 +27,7 @@
 using namespace std;
 
 class ContextBO;
+class ScannerDtoin;
 
 /**
  * Classe en charge de lire la section BalanceCost du fichier d'instance.
@@ -34,7 +35,11 @@ class ContextBO;
  */
 class BalanceCostDtoin {
     public:
+        /**
+         * Lit la section sur un flux (qui est consomme jusqu'au bout)
+         */
         void read(istream& is_p, ContextBO* pContextBO_p);
+        void read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p);
 };
 
 #endif
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "dtoin/InstanceReaderBinaire.hh"
+#include "bo/BalanceCostBO.hh"
+#include "bo/LocationBO.hh"
+#include "bo/MachineBO.hh"
+#include "bo/MMCBO.hh"
+#include "bo/NeighborhoodBO.hh"
+#include "bo/ProcessBO.hh"
+#include "bo/RessourceBO.hh"
+#include "bo/ServiceBO.hh"
+#include "tools/InstanceBinaire.hh"
+#include "tools/Log.hh"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+using namespace std::tr1;
+
+namespace {
+    /**
+     * Libere un fichier mappe en memoire a la destruction
+     */
+    class MappingFichier {
+        public:
+            MappingFichier(void* pDebut_p, size_t taille_p, bool& estMappe_p) :
+                pDebut_m(pDebut_p), taille_m(taille_p), estMappe_m(estMappe_p)
+            {
+                estMappe_m = true;
+            }
+            ~MappingFichier(){
+                estMappe_m = false;
+                munmap(pDebut_m, taille_m);
+            }
+        private:
+            void* pDebut_m;
+            size_t taille_m;
+            bool& estMappe_m;
+    };
+}
+
+InstanceReaderBinaire::InstanceReaderBinaire() :
+    libereMapping_m(false)
+{}
+
+ContextBO InstanceReaderBinaire::read(const string& instance_filename_p){
+    const int fd_l = open(instance_filename_p.c_str(), O_RDONLY);
+    struct stat stat_l;
+    if ( fd_l < 0 || fstat(fd_l, &stat_l) != 0 ){
+        if ( fd_l >= 0 ){
+            close(fd_l);
+        }
+        ostringstream oss_l;
+        oss_l << "Impossible d'ouvrir le fichier d'instance " << instance_filename_p << endl;
+        throw oss_l.str();
+    }
+
+    const size_t taille_l = stat_l.st_size;
+    void* pMap_l = taille_l > 0 ? mmap(0, taille_l, PROT_READ, MAP_PRIVATE, fd_l, 0) : MAP_FAILED;
+    close(fd_l);
+    if ( pMap_l == MAP_FAILED ){
+        ostringstream oss_l;
+        oss_l << "Impossible de mapper le fichier d'instance " << instance_filename_p << endl;
+        throw oss_l.str();
+    }
+    madvise(pMap_l, taille_l, MADV_SEQUENTIAL);
+
+    //Le mapping est libere a la sortie, y compris sur exception. Le contexte est retourne
+    //directement (pas de copie : le constructeur par copie de ContextBO exige une solution initiale)
+    const MappingFichier mapping_l(pMap_l, taille_l, libereMapping_m);
+    LOG(INFO) << "Lecture du fichier d'instance (binaire)" << endl;
+    return readBuffer(static_cast<const char*>(pMap_l), taille_l);
+}
+
+ContextBO InstanceReaderBinaire::readBuffer(const char* pDonnees_p, size_t taille_p){
+    InstanceBinaire::Entete entete_l;
+    if ( taille_p < sizeof(entete_l) ){
+        throw string("Instance binaire tronquee : entete incomplete");
+    }
+    memcpy(&entete_l, pDonnees_p, sizeof(entete_l));
+    if ( memcmp(entete_l.magic, InstanceBinaire::MAGIC, sizeof(entete_l.magic)) != 0 ){
+        throw string("Instance binaire : magic invalide");
+    }
+    if ( entete_l.version != InstanceBinaire::VERSION ){
+        ostringstream oss_l;
+        oss_l << "Instance binaire : version " << entete_l.version << " non supportee (attendue : " << InstanceBinaire::VERSION << ")";
+        throw oss_l.str();
+    }
+    if ( entete_l.marqueurEndian != InstanceBinaire::MARQUEUR_ENDIAN ){
+        throw string("Instance binaire ecrite sur une machine d'endianness differente");
+    }
+    if ( entete_l.nbRessources <= 0 || entete_l.nbMachines <= 0 || entete_l.nbServices < 0 || entete_l.nbProcesses <= 0
+            || entete_l.nbBalanceCosts < 0 || entete_l.nbDependances < 0 || entete_l.nbLocations < 0 || entete_l.nbNeighborhoods < 0 ){
+        throw string("Instance binaire : entete incoherente");
+    }
+    if ( entete_l.tailleCorps != InstanceBinaire::tailleCorps(entete_l) || taille_p != sizeof(entete_l) + entete_l.tailleCorps + sizeof(uint64_t) ){
+        ostringstream oss_l;
+        oss_l << "Instance binaire tronquee ou incoherente : " << taille_p << " octets pour " << entete_l.tailleCorps << " octets de corps annonces";
+        throw oss_l.str();
+    }
+    if ( reinterpret_cast<uintptr_t>(pDonnees_p) % sizeof(uint64_t) != 0 ){
+        throw string("Instance binaire : buffer non aligne");
+    }
+    uint64_t checksum_l;
+    memcpy(&checksum_l, pDonnees_p + sizeof(entete_l) + entete_l.tailleCorps, sizeof(checksum_l));
+    if ( InstanceBinaire::checksum(pDonnees_p + sizeof(entete_l), entete_l.tailleCorps) != checksum_l ){
+        throw string("Instance binaire corrompue : checksum invalide");
+    }
+    if ( libereMapping_m ){
+        //Le checksum a parcouru tout le fichier : on rend ces pages, relues a la demande ensuite
+        madvise(const_cast<char*>(pDonnees_p), taille_p, MADV_DONTNEED);
+    }
+
+    const int nbRess_l = entete_l.nbRessources;
+    const int nbMachines_l = entete_l.nbMachines;
+    const int nbServices_l = entete_l.nbServices;
+    const int nbProcesses_l = entete_l.nbProcesses;
+    const int nbBC_l = entete_l.nbBalanceCosts;
+    size_t pos_l = sizeof(entete_l);
+    ContextBO result_l;
+
+    //Ressources
+    const int32_t* pTransient_l = readTableau(pDonnees_p, pos_l, nbRess_l);
+    const int32_t* pWeightLoadCost_l = readTableau(pDonnees_p, pos_l, nbRess_l);
+    for ( int idxR_l=0 ; idxR_l < nbRess_l ; idxR_l++ ){
+        result_l.addRessource(new RessourceBO(idxR_l, pTransient_l[idxR_l] != 0, pWeightLoadCost_l[idxR_l]));
+    }
+
+    //Machines
+    for ( int idx_l=0 ; idx_l < entete_l.nbLocations ; idx_l++ ){
+        result_l.addLocation(new LocationBO(idx_l));
+    }
+    for ( int idx_l=0 ; idx_l < entete_l.nbNeighborhoods ; idx_l++ ){
+        result_l.addNeighborhood(new NeighborhoodBO(idx_l));
+    }
+    const int32_t* pNeigh_l = readTableau(pDonnees_p, pos_l, nbMachines_l);
+    const int32_t* pLoc_l = readTableau(pDonnees_p, pos_l, nbMachines_l);
+    const int32_t* pCapa_l = readTableau(pDonnees_p, pos_l, static_cast<size_t>(nbMachines_l) * nbRess_l);
+    const int32_t* pSafety_l = readTableau(pDonnees_p, pos_l, static_cast<size_t>(nbMachines_l) * nbRess_l);
+    for ( int idxM_l=0 ; idxM_l < nbMachines_l ; idxM_l++ ){
+        if ( pLoc_l[idxM_l] < 0 || pLoc_l[idxM_l] >= entete_l.nbLocations
+                || pNeigh_l[idxM_l] < 0 || pNeigh_l[idxM_l] >= entete_l.nbNeighborhoods ){
+            throw string("Instance binaire : location ou neighborhood hors bornes");
+        }
+        const vector<int> capas_l(pCapa_l + idxM_l*nbRess_l, pCapa_l + (idxM_l+1)*nbRess_l);
+        const vector<int> safetyCapas_l(pSafety_l + idxM_l*nbRess_l, pSafety_l + (idxM_l+1)*nbRess_l);
+        result_l.addMachine(new MachineBO(idxM_l, result_l.getLocation(pLoc_l[idxM_l]), result_l.getNeighborhood(pNeigh_l[idxM_l]), capas_l, safetyCapas_l));
+    }
+    const size_t nbCasesMMC_l = static_cast<size_t>(nbMachines_l) * nbMachines_l;
+    const int32_t* pMMC_l = readTableau(pDonnees_p, pos_l, nbCasesMMC_l);
+    vector<int> mmc_l(nbCasesMMC_l);
+    copieEtLibere(pMMC_l, nbCasesMMC_l, mmc_l.empty() ? 0 : &mmc_l[0]);
+    result_l.setMMCBO(new MMCBO(nbMachines_l, mmc_l));
+
+    //Services
+    const int32_t* pSpreadMin_l = readTableau(pDonnees_p, pos_l, nbServices_l);
+    const int32_t* pDebutsDep_l = readTableau(pDonnees_p, pos_l, nbServices_l + 1);
+    const int32_t* pDep_l = readTableau(pDonnees_p, pos_l, entete_l.nbDependances);
+    //Index croissants de 0 a nbDependances : chaque dependance appartient a un et un seul service
+    if ( pDebutsDep_l[0] != 0 || pDebutsDep_l[nbServices_l] != entete_l.nbDependances ){
+        throw string("Instance binaire : index des dependances incoherent");
+    }
+    for ( int idxS_l=0 ; idxS_l < nbServices_l ; idxS_l++ ){
+        if ( pDebutsDep_l[idxS_l] > pDebutsDep_l[idxS_l+1] ){
+            throw string("Instance binaire : index des dependances incoherent");
+        }
+        if ( pSpreadMin_l[idxS_l] < 0 || pSpreadMin_l[idxS_l] > entete_l.nbLocations ){
+            throw string("Instance binaire : spreadMin hors bornes");
+        }
+        for ( int idxDep_l=pDebutsDep_l[idxS_l] ; idxDep_l < pDebutsDep_l[idxS_l+1] ; idxDep_l++ ){
+            if ( pDep_l[idxDep_l] < 0 || pDep_l[idxDep_l] >= nbServices_l ){
+                throw string("Instance binaire : dependance vers un service hors bornes");
+            }
+        }
+        vector<int> dependances_l(pDep_l + pDebutsDep_l[idxS_l], pDep_l + pDebutsDep_l[idxS_l+1]);
+        result_l.addService(new ServiceBO(idxS_l, pSpreadMin_l[idxS_l], dependances_l));
+    }
+
+    //Processes
+    const int32_t* pService_l = readTableau(pDonnees_p, pos_l, nbProcesses_l);
+    const int32_t* pReq_l = readTableau(pDonnees_p, pos_l, static_cast<size_t>(nbProcesses_l) * nbRess_l);
+    const int32_t* pPMC_l = readTableau(pDonnees_p, pos_l, nbProcesses_l);
+    const boost::shared_ptr<const vector<int> > pStockReq_l(new vector<int>(pReq_l, pReq_l + static_cast<size_t>(nbProcesses_l) * nbRess_l));
+    for ( int idxP_l=0 ; idxP_l < nbProcesses_l ; idxP_l++ ){
+        if ( pService_l[idxP_l] < 0 || pService_l[idxP_l] >= nbServices_l ){
+            throw string("Instance binaire : service hors bornes");
+        }
+        result_l.addProcess(new ProcessBO(idxP_l, result_l.getService(pService_l[idxP_l]), pStockReq_l, idxP_l, nbRess_l, pPMC_l[idxP_l]));
+    }
+
+    //Balance costs
+    const int32_t* pRess1_l = readTableau(pDonnees_p, pos_l, nbBC_l);
+    const int32_t* pRess2_l = readTableau(pDonnees_p, pos_l, nbBC_l);
+    const int32_t* pTarget_l = readTableau(pDonnees_p, pos_l, nbBC_l);
+    const int32_t* pPoids_l = readTableau(pDonnees_p, pos_l, nbBC_l);
+    for ( int idxBC_l=0 ; idxBC_l < nbBC_l ; idxBC_l++ ){
+        if ( pRess1_l[idxBC_l] < 0 || pRess1_l[idxBC_l] >= nbRess_l || pRess2_l[idxBC_l] < 0 || pRess2_l[idxBC_l] >= nbRess_l ){
+            throw string("Instance binaire : ressource de balance cost hors bornes");
+        }
+        result_l.addBalanceCost(new BalanceCostBO(result_l.getRessource(pRess1_l[idxBC_l]),
+                    result_l.getRessource(pRess2_l[idxBC_l]),
+                    pTarget_l[idxBC_l],
+                    pPoids_l[idxBC_l]));
+    }
+
+    //Poids
+    const int32_t* pPoidsGlobaux_l = readTableau(pDonnees_p, pos_l, 3);
+    result_l.setPoidsPMC(pPoidsGlobaux_l[0]);
+    result_l.setPoidsSMC(pPoidsGlobaux_l[1]);
+    result_l.setPoidsMMC(pPoidsGlobaux_l[2]);
+
+    LOG(DEBUG) << "Instance binaire lue : " << nbRess_l << " ressources, " << nbMachines_l << " machines, "
+        << nbServices_l << " services, " << nbProcesses_l << " processes" << endl;
+    return result_l;
+}
+
+const int32_t* InstanceReaderBinaire::readTableau(const char* pDonnees_p, size_t& pos_p, size_t nbValeurs_p){
+    const int32_t* result_l = reinterpret_cast<const int32_t*>(pDonnees_p + pos_p);
+    pos_p += InstanceBinaire::tailleTableau(nbValeurs_p);
+    return result_l;
+}
+
+void InstanceReaderBinaire::copieEtLibere(const int32_t* pSource_p, size_t nbValeurs_p, int* pDest_p) const{
+    const size_t TAILLE_TRANCHE = 1 << 20;
+    const uintptr_t TAILLE_PAGE = sysconf(_SC_PAGESIZE);
+    for ( size_t debut_l=0 ; debut_l < nbValeurs_p ; debut_l += TAILLE_TRANCHE ){
+        const size_t nb_l = min(TAILLE_TRANCHE, nbValeurs_p - debut_l);
+        memcpy(pDest_p + debut_l, pSource_p + debut_l, nb_l * sizeof(int32_t));
+        if ( libereMapping_m ){
+            //Seules les pages entierement recopiees sont rendues ; elles seraient relues depuis le fichier si besoin
+            const uintptr_t debutPages_l = (reinterpret_cast<uintptr_t>(pSource_p + debut_l) + TAILLE_PAGE - 1) & ~(TAILLE_PAGE - 1);
+            const uintptr_t finPages_l = reinterpret_cast<uintptr_t>(pSource_p + debut_l + nb_l) & ~(TAILLE_PAGE - 1);
+            if ( finPages_l > debutPages_l ){
+                madvise(reinterpret_cast<void*>(debutPages_l), finPages_l - debutPages_l, MADV_DONTNEED);
+            }
+        }
+    }
+}
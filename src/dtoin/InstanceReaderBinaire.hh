@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef INSTANCEREADERBINAIRE_HH
+#define INSTANCEREADERBINAIRE_HH
+#include "dtoin/InstanceReaderInterface.hh"
+#include "bo/ContextBO.hh"
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+using namespace std;
+
+/**
+ * Lit une instance au format binaire decrit dans InstanceBinaire.
+ * Le fichier est mappe en memoire et les objets bo sont construits directement
+ * a partir des tableaux, sans aucun parsing
+ */
+class InstanceReaderBinaire : public InstanceReaderInterface {
+    public:
+        InstanceReaderBinaire();
+
+        virtual ContextBO read(const string& instance_filename_p);
+
+        /**
+         * Construit le contexte a partir d'une instance binaire deja en memoire.
+         * pDonnees_p doit etre aligne sur 8 octets
+         */
+        ContextBO readBuffer(const char* pDonnees_p, size_t taille_p);
+
+    protected:
+        /**
+         * Retourne le tableau de nbValeurs_p int32 situe en pos_p, et avance pos_p (padding compris)
+         */
+        static const int32_t* readTableau(const char* pDonnees_p, size_t& pos_p, size_t nbValeurs_p);
+
+        /**
+         * Recopie nbValeurs_p int32 par tranches. Si la source est le fichier mappe, les pages deja
+         * recopiees sont rendues au systeme au fur et a mesure, pour que la MMC ne soit pas
+         * presente deux fois en memoire
+         */
+        void copieEtLibere(const int32_t* pSource_p, size_t nbValeurs_p, int* pDest_p) const;
+
+        /**
+         * Vrai pendant read() : le buffer lu est un fichier mappe en lecture seule
+         */
+        bool libereMapping_m;
+};
+
+#endif
@@ -31,8 +31,16 @@ using namespace std;
 
 class InstanceReaderDtoin : public InstanceReaderInterface {
     public:
+        /**
+         * @param nbThreads_p nombre de threads pour decoder la section machines (dominee par la MMC).
+         * Le contexte lu est le meme quel que soit le nombre de threads
+         */
+        explicit InstanceReaderDtoin(int nbThreads_p = 1);
+
         virtual ContextBO read(const string& instance_filename_p);
 
+    private:
+        int nbThreads_m;
 };
 
 #endif
@@ -256,8 +256,7 @@ void InstanceReaderHumanReadable::readServices(istream& is_p, ContextBO* pContex
         checkSubTitle(getNextLine(is_p), "Service", idxS_l, nbServices_l);
         int spreadMin_l = readCarac(getNextLine(is_p), "SpreadMin");
         vector<int> vDependances_l = readListe(getNextLine(is_p), "Dependances");
-        unordered_set<int> sDependances_l(vDependances_l.begin(), vDependances_l.end());
-        pContextBO_p->addService(new ServiceBO(idxS_l, spreadMin_l, sDependances_l));
+        pContextBO_p->addService(new ServiceBO(idxS_l, spreadMin_l, vDependances_l));
     }
 }
 
@@ -27,59 +27,131 @@
 #include "bo/MachineBO.hh"
 #include "bo/NeighborhoodBO.hh"
 #include "bo/MMCBO.hh"
+#include "dtoin/ScannerDtoin.hh"
 #include "tools/Log.hh"
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+#include <boost/thread.hpp>
 #include <tr1/unordered_map>
-#include <cassert>
+#include <algorithm>
+#include <climits>
+#include <stdint.h>
 #include <string>
 using namespace std::tr1;
 
-MachineDtoin::MachineDtoin() : alreadyUsed_m (false)
+MachineDtoin::MachineDtoin(int nbThreads_p) :
+    nbThreads_m(max(1, nbThreads_p)),
+    nbMachines_m(0),
+    nbRess_m(0),
+    alreadyUsed_m(false)
 {}
 
 void MachineDtoin::read(istream& is_p, ContextBO* pContextBO_p){
+    ScannerDtoin scanner_l(is_p, "section machines");
+    read(scanner_l, pContextBO_p);
+}
+
+void MachineDtoin::read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p){
     //On s'assure que cette instance n'est pas usagee
     if ( alreadyUsed_m ){
         throw string("Un MachineDtoin est utilise deux fois !");
     }
     alreadyUsed_m = true;
 
-    //Lecture sequentielle des machines
     pContext_m = pContextBO_p;
-    int nbMachines_l;
-    is_p >> nbMachines_l;
-    LOG(DEBUG) << nbMachines_l << " machines" << endl;
-    assert(nbMachines_l > 0);
-    mmcCosts_m = vector<vector<int> >(nbMachines_l, vector<int>(nbMachines_l, 0));
-
-    for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
-        int idxNeighborhood_l, idxLocation_l;
-        is_p >> idxNeighborhood_l >> idxLocation_l;
-        LOG(DEBUG) << "\tNeigh.=" << idxNeighborhood_l << ", Loc.=" << idxLocation_l << endl;
-        assert(idxNeighborhood_l >= 0);
-        assert(idxLocation_l >= 0);
-
-        NeighborhoodBO* const neigh_l = getNeighborhood(idxNeighborhood_l);
-        LocationBO* const loc_l = getLocation(idxLocation_l);
-        const vector<int> capas_l = readQteRess(is_p);
-        const vector<int> safetyCapas_l = readQteRess(is_p);
-
-        //Creation de la machine et insertion dans le contexte
-        pContext_m->addMachine(new MachineBO(idxMachine_l, loc_l, neigh_l, capas_l, safetyCapas_l));
-        readMMCForOneMachine(is_p, idxMachine_l);
+    nbMachines_m = scanner_p.lireEntier("nombre de machines", 1, INT_MAX);
+    nbRess_m = pContext_m->getNbRessources();
+    LOG(DEBUG) << nbMachines_m << " machines" << endl;
+    neighborhoods_m.resize(nbMachines_m);
+    locations_m.resize(nbMachines_m);
+    capas_m.resize(static_cast<size_t>(nbMachines_m) * nbRess_m);
+    safetyCapas_m.resize(static_cast<size_t>(nbMachines_m) * nbRess_m);
+    mmcCosts_m.assign(static_cast<size_t>(nbMachines_m) * nbMachines_m, 0);
+
+    const int nbThreads_l = min(nbThreads_m, nbMachines_m);
+    if ( nbThreads_l == 1 ){
+        readMachines(scanner_p, 0, nbMachines_m);
+    } else {
+        readMachinesParallele(scanner_p, nbThreads_l);
     }
 
+    sendMachines();
     sendMMC();
     sendLocations();
     sendNeighborhoods();
 }
 
-vector<int> MachineDtoin::readQteRess(istream& is_p){
-    int nbRess_l = pContext_m->getNbRessources();
-    vector<int> result_l(nbRess_l);
-    for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
-        is_p >> result_l[idxRess_l];
+void MachineDtoin::readMachinesParallele(ScannerDtoin& scanner_p, int nbThreads_p){
+    //Chaque machine occupe exactement 2 + 2*nbRess + nbMachines tokens : le pre-scan donne donc
+    //la position de la premiere machine de chaque tranche
+    const size_t nbTokensParMachine_l = 2 + 2 * static_cast<size_t>(nbRess_m) + nbMachines_m;
+    vector<Tranche> tranches_l(nbThreads_p);
+    vector<size_t> rangs_l(nbThreads_p);
+    for ( int idxTranche_l=0 ; idxTranche_l < nbThreads_p ; idxTranche_l++ ){
+        Tranche& tranche_l = tranches_l[idxTranche_l];
+        tranche_l.idxPremiereMachine = static_cast<int>(static_cast<int64_t>(nbMachines_m) * idxTranche_l / nbThreads_p);
+        tranche_l.idxFinMachines = static_cast<int>(static_cast<int64_t>(nbMachines_m) * (idxTranche_l + 1) / nbThreads_p);
+        rangs_l[idxTranche_l] = tranche_l.idxPremiereMachine * nbTokensParMachine_l;
+    }
+    const vector<size_t> offsets_l = scanner_p.localiseTokens(rangs_l, nbThreads_p);
+    for ( int idxTranche_l=0 ; idxTranche_l < nbThreads_p ; idxTranche_l++ ){
+        tranches_l[idxTranche_l].offsetDebut = offsets_l[idxTranche_l];
+    }
+    //La premiere tranche part de la position courante (un '\0' parasite doit y etre refuse comme en sequentiel)
+    tranches_l[0].offsetDebut = scanner_p.getOffset();
+
+    boost::thread_group threads_l;
+    for ( int idxTranche_l=1 ; idxTranche_l < nbThreads_p ; idxTranche_l++ ){
+        threads_l.create_thread(boost::bind(&MachineDtoin::readTranche, this, &scanner_p, &tranches_l[idxTranche_l]));
+    }
+    readTranche(&scanner_p, &tranches_l[0]);
+    threads_l.join_all();
+
+    //Les tranches precedentes etant valides, elles se terminent exactement au debut de la suivante :
+    //la premiere erreur est donc celle de la lecture sequentielle
+    BOOST_FOREACH(const Tranche& tranche_l, tranches_l){
+        if ( ! tranche_l.erreur.empty() ){
+            throw tranche_l.erreur;
+        }
+    }
+    scanner_p.setOffset(tranches_l.back().offsetFin);
+}
+
+void MachineDtoin::readTranche(const ScannerDtoin* pParent_p, Tranche* pTranche_p){
+    try {
+        ScannerDtoin scanner_l(*pParent_p, pTranche_p->offsetDebut);
+        readMachines(scanner_l, pTranche_p->idxPremiereMachine, pTranche_p->idxFinMachines);
+        pTranche_p->offsetFin = scanner_l.getOffset();
+    } catch (const string& erreur_l){
+        pTranche_p->erreur = erreur_l;
+    }
+}
+
+void MachineDtoin::readMachines(ScannerDtoin& scanner_p, int idxPremiere_p, int idxFin_p){
+    for ( int idxMachine_l=idxPremiere_p ; idxMachine_l < idxFin_p ; idxMachine_l++ ){
+        //Locations et neighborhoods sont crees a la volee : on borne par le nombre de machines
+        neighborhoods_m[idxMachine_l] = scanner_p.lireEntier("neighborhood de la machine", 0, nbMachines_m - 1);
+        locations_m[idxMachine_l] = scanner_p.lireEntier("location de la machine", 0, nbMachines_m - 1);
+        const size_t idxCapas_l = static_cast<size_t>(idxMachine_l) * nbRess_m;
+        scanner_p.lireEntiers(nbRess_m ? &capas_m[idxCapas_l] : 0, nbRess_m, "capacite de la machine");
+        scanner_p.lireEntiers(nbRess_m ? &safetyCapas_m[idxCapas_l] : 0, nbRess_m, "safety capacite de la machine");
+        readMMCForOneMachine(scanner_p, idxMachine_l);
+    }
+}
+
+void MachineDtoin::sendMachines(){
+    for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_m ; idxMachine_l++ ){
+        LOG(DEBUG) << "\tNeigh.=" << neighborhoods_m[idxMachine_l] << ", Loc.=" << locations_m[idxMachine_l] << endl;
+        NeighborhoodBO* const neigh_l = getNeighborhood(neighborhoods_m[idxMachine_l]);
+        LocationBO* const loc_l = getLocation(locations_m[idxMachine_l]);
+        const vector<int>::const_iterator itCapas_l = capas_m.begin() + static_cast<size_t>(idxMachine_l) * nbRess_m;
+        const vector<int>::const_iterator itSafety_l = safetyCapas_m.begin() + static_cast<size_t>(idxMachine_l) * nbRess_m;
+        const vector<int> capas_l(itCapas_l, itCapas_l + nbRess_m);
+        const vector<int> safetyCapas_l(itSafety_l, itSafety_l + nbRess_m);
+
+        //Creation de la machine et insertion dans le contexte
+        pContext_m->addMachine(new MachineBO(idxMachine_l, loc_l, neigh_l, capas_l, safetyCapas_l));
     }
-    return result_l;
 }
 
 LocationBO* MachineDtoin::getLocation(int idx_p){
@@ -96,15 +168,13 @@ NeighborhoodBO* MachineDtoin::getNeighborhood(int idx_p){
     return pNeigh_m[idx_p];
 }
 
-void MachineDtoin::readMMCForOneMachine(istream& is_p, int idxCurMachine_p){
-    int nbMachines_l = mmcCosts_m.size();
-    for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
-        is_p >> mmcCosts_m[idxCurMachine_p][idxMachine_l];
-    }
+void MachineDtoin::readMMCForOneMachine(ScannerDtoin& scanner_p, int idxCurMachine_p){
+    int* pCosts_l = &mmcCosts_m[static_cast<size_t>(idxCurMachine_p) * nbMachines_m];
+    scanner_p.lireEntiers(pCosts_l, nbMachines_m, "machine move cost");
 }
 
-void MachineDtoin::sendMMC() const{
-    pContext_m->setMMCBO(new MMCBO(mmcCosts_m));
+void MachineDtoin::sendMMC(){
+    pContext_m->setMMCBO(new MMCBO(nbMachines_m, mmcCosts_m));
 }
 
 void MachineDtoin::sendLocations() const{
@@ -24,10 +24,12 @@
 #ifndef MACHINEDTOIN_HH
 #define MACHINEDTOIN_HH
 #include <iostream>
+#include <string>
 #include <vector>
 using namespace std;
 
 class ContextBO;
+class ScannerDtoin;
 class LocationBO;
 class NeighborhoodBO;
 class RessourceBO;
@@ -42,19 +44,55 @@ class RessourceBO;
  */
 class MachineDtoin{
     public:
-        MachineDtoin();
+        /**
+         * @param nbThreads_p nombre de threads pour decoder les machines (et leur ligne de MMC).
+         * Le resultat ne depend pas du nombre de threads : les tranches sont decodees en parallele
+         * dans des tableaux a plat, puis les BO sont crees dans l'ordre des machines
+         */
+        explicit MachineDtoin(int nbThreads_p = 1);
 
         /**
-         * @param is_p Le flux a lire
+         * @param is_p Le flux a lire (consomme jusqu'au bout)
          * @param pContextBO_p Le context a peupler
          */
         void read(istream& is_p, ContextBO* pContextBO_p);
+        void read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p);
 
     private:
-        vector<int> readQteRess(istream& is_p);
-        void readMMCForOneMachine(istream& is_p, int idxCurMachine_p);
+        /**
+         * Tranche de machines decodee par un thread
+         */
+        struct Tranche {
+            size_t offsetDebut;
+            size_t offsetFin;
+            int idxPremiereMachine;
+            int idxFinMachines;
+            string erreur;
+        };
+
+        /**
+         * Decoupe la section en tranches (pre-scan des tokens du scanner) et les decode en parallele.
+         * Une erreur est remontee telle que l'aurait levee la lecture sequentielle : celle de la
+         * premiere tranche en erreur
+         */
+        void readMachinesParallele(ScannerDtoin& scanner_p, int nbThreads_p);
+        void readTranche(const ScannerDtoin* pParent_p, Tranche* pTranche_p);
+
+        /**
+         * Decode les machines [idxPremiere_p, idxFin_p[ dans les tableaux a plat
+         */
+        void readMachines(ScannerDtoin& scanner_p, int idxPremiere_p, int idxFin_p);
+        void readMMCForOneMachine(ScannerDtoin& scanner_p, int idxCurMachine_p);
 
-        void sendMMC() const;
+        /**
+         * Cree les machines, locations et neighborhoods a partir des tableaux lus
+         */
+        void sendMachines();
+
+        /**
+         * Transfere la matrice lue au MMCBO (mmcCosts_m est vide au retour)
+         */
+        void sendMMC();
         void sendLocations() const;
         void sendNeighborhoods() const;
 
@@ -72,8 +110,22 @@ class MachineDtoin{
         vector<NeighborhoodBO*> pNeigh_m;
         ContextBO* pContext_m;
         
-        vector<vector<int> > mmcCosts_m;
+        int nbThreads_m;
+        int nbMachines_m;
+        int nbRess_m;
 
+        /**
+         * Donnees lues, a plat : neighborhoods_m[machine], capas_m[machine * nbRess + ress], etc.
+         */
+        vector<int> neighborhoods_m;
+        vector<int> locations_m;
+        vector<int> capas_m;
+        vector<int> safetyCapas_m;
+
+        /**
+         * Couts lus, a plat : mmcCosts_m[from * nbMachines + to]
+         */
+        vector<int> mmcCosts_m;
 
         bool alreadyUsed_m;
 };
@@ -23,11 +23,18 @@
 
 #include "dtoin/PoidsDtoin.hh"
 #include "bo/ContextBO.hh"
+#include "dtoin/ScannerDtoin.hh"
 #include "tools/Log.hh"
 
 void PoidsDtoin::read(istream& is_p, ContextBO* pContextBO_p){
-    int poidsPMC_l, poidsSMC_l, poidsMMC_l;
-    is_p >> poidsPMC_l >> poidsSMC_l >> poidsMMC_l;
+    ScannerDtoin scanner_l(is_p, "section poids");
+    read(scanner_l, pContextBO_p);
+}
+
+void PoidsDtoin::read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p){
+    const int poidsPMC_l = scanner_p.lireEntier("poids PMC");
+    const int poidsSMC_l = scanner_p.lireEntier("poids SMC");
+    const int poidsMMC_l = scanner_p.lireEntier("poids MMC");
     LOG(DEBUG) << "poids PMC=" << poidsPMC_l << ", poids SMC=" << poidsSMC_l << ", poids MMC=" << poidsMMC_l << endl;
 
 
@@ -24,31 +24,33 @@
 #include "dtoin/ProcessDtoin.hh"
 #include "bo/ContextBO.hh"
 #include "bo/ProcessBO.hh"
+#include "dtoin/ScannerDtoin.hh"
 #include "tools/Log.hh"
-#include <cassert>
+#include <climits>
 #include <vector>
 using namespace std;
 
 void ProcessDtoin::read(istream& is_p, ContextBO* pContextBO_p){
-    int nbProcesses_l, nbRessources_l(pContextBO_p->getNbRessources());
-    is_p >> nbProcesses_l;
+    ScannerDtoin scanner_l(is_p, "section processes");
+    read(scanner_l, pContextBO_p);
+}
+
+void ProcessDtoin::read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p){
+    const int nbRessources_l(pContextBO_p->getNbRessources());
+    const int nbProcesses_l = scanner_p.lireEntier("nombre de processes", 1, INT_MAX);
     LOG(DEBUG) << nbProcesses_l << " processes" << endl;
-    assert(nbProcesses_l > 0);
 
 
+    //Les requirements de tous les process sont lus dans une seule matrice P x R, partagee par les ProcessBO
+    boost::shared_ptr<vector<int> > pStock_l(new vector<int>(static_cast<size_t>(nbProcesses_l) * nbRessources_l, 0));
+    int* const pDebutStock_l = pStock_l->empty() ? 0 : &(*pStock_l)[0];
+    const boost::shared_ptr<const vector<int> > pStockPartage_l(pStock_l);
     for ( int idxP_l=0 ; idxP_l < nbProcesses_l ; idxP_l++ ){
-        int idxService_l, pmc_l;
-        is_p >> idxService_l;
-        assert(idxService_l >= 0);
-        vector<int> vRequirements_l(nbProcesses_l, 0);
-
-        for ( int idxRess_l=0 ; idxRess_l < nbRessources_l ; idxRess_l++ ){
-            is_p >> vRequirements_l[idxRess_l];
-        }
-
-        is_p >> pmc_l;
+        const int idxService_l = scanner_p.lireEntier("service du process", 0, pContextBO_p->getNbServices() - 1);
+        scanner_p.lireEntiers(pDebutStock_l + static_cast<size_t>(idxP_l) * nbRessources_l, nbRessources_l, "requirement du process");
+        const int pmc_l = scanner_p.lireEntier("process move cost");
         LOG(DEBUG) << "\tLe process " << idxP_l << " est dans le service " << idxService_l << " et a un pmc de " << pmc_l << endl;
 
-        pContextBO_p->addProcess(new ProcessBO(idxP_l, pContextBO_p->getService(idxService_l), vRequirements_l, pmc_l));
+        pContextBO_p->addProcess(new ProcessBO(idxP_l, pContextBO_p->getService(idxService_l), pStockPartage_l, idxP_l, nbRessources_l, pmc_l));
     }
 }
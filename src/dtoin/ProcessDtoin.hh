@@ -31,10 +31,15 @@ using namespace std;
  * Cette classe ne devrait pas etre utilisee directement, mais n'etre manipulee qu'a travers l'#InstanceReaderDtoin
  */
 class ContextBO;
+class ScannerDtoin;
 
 class ProcessDtoin {
     public:
+        /**
+         * Lit la section sur un flux (qui est consomme jusqu'au bout)
+         */
         void read(istream& is_p, ContextBO* pContextBO_p);
+        void read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p);
 };
 
 #endif
@@ -24,20 +24,22 @@
 #include "dtoin/RessourceDtoin.hh"
 #include "bo/ContextBO.hh"
 #include "bo/RessourceBO.hh"
+#include "dtoin/ScannerDtoin.hh"
 #include "tools/Log.hh"
-#include <cassert>
+#include <climits>
 
 void RessourceDtoin::read(istream& is_p, ContextBO* pContextBO_p){
-    int nbRess_l;
-    is_p >> nbRess_l;
+    ScannerDtoin scanner_l(is_p, "section ressources");
+    read(scanner_l, pContextBO_p);
+}
+
+void RessourceDtoin::read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p){
+    const int nbRess_l = scanner_p.lireEntier("nombre de ressources", 1, INT_MAX);
     LOG(DEBUG) << nbRess_l << " ressources" << endl;
-    assert(nbRess_l > 0);
 
     for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
-        bool isTransient_l;
-        is_p >> isTransient_l;
-        int weightLoadCost_l;
-        is_p >> weightLoadCost_l;
+        const bool isTransient_l = scanner_p.lireEntier("caractere transient de la ressource", 0, 1);
+        const int weightLoadCost_l = scanner_p.lireEntier("poids du load cost de la ressource");
         LOG(DEBUG) << "\tRessource " << idxRess_l << " : isTransient=" << isTransient_l << ", poids=" << weightLoadCost_l << endl;
 
         pContextBO_p->addRessource(new RessourceBO(idxRess_l, isTransient_l, weightLoadCost_l));
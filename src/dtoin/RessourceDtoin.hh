@@ -27,14 +27,16 @@
 using namespace std;
 
 class ContextBO;
+class ScannerDtoin;
 
 class RessourceDtoin {
     public:
         /**
-         * @param is_p Le flux a lire
+         * @param is_p Le flux a lire (consomme jusqu'au bout)
          * @param pContextBO_p Le context a peupler
          */
         void read(istream& is_p, ContextBO* pContextBO_p);
+        void read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p);
 
 };
 
@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "dtoin/ScannerDtoin.hh"
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <cstdio>
+#include <iterator>
+#include <sstream>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+namespace {
+    /**
+     * Vrai pour les caracteres 1..32 (espaces, tabulations, fins de ligne...) ; faux pour la sentinelle '\0'
+     */
+    inline bool isBlanc(char c_p){
+        return static_cast<unsigned char>(c_p - 1) < ' ';
+    }
+
+    /**
+     * Valeur du chiffre, ou un nombre > 9 si c_p n'est pas un chiffre
+     */
+    inline unsigned int chiffre(char c_p){
+        return static_cast<unsigned char>(c_p) - static_cast<unsigned int>('0');
+    }
+
+    /**
+     * Un int32 s'ecrit avec au plus 10 chiffres
+     */
+    const size_t NB_CHIFFRES_MAX = 10;
+
+    /**
+     * Nombre d'octets de padding a la fin du buffer : permet de charger 8 octets d'un coup
+     * depuis n'importe quelle position du texte
+     */
+    const size_t TAILLE_PADDING = 8;
+
+    const uint64_t OCTETS_0x30 = 0x3030303030303030ULL;
+    const uint64_t OCTETS_0xF0 = 0xF0F0F0F0F0F0F0F0ULL;
+    const uint64_t OCTETS_0x06 = 0x0606060606060606ULL;
+
+    /**
+     * Decode les chiffres d'un entier (sans signe) qui commence en p_p.
+     * Jusqu'a 7 chiffres, sans boucle ni branchement dependant des donnees : les 8 octets sont
+     * charges en un mot, la longueur est donnee par le premier octet qui n'est pas un chiffre,
+     * et la conversion se fait par multiplications SWAR (les chiffres de poids fort sont en tete,
+     * donc dans les octets de poids faible du mot)
+     * @return la position qui suit le dernier chiffre
+     */
+    inline const char* scanneChiffres(const char* p_p, uint64_t& valeur_p){
+        uint64_t octets_l;
+        memcpy(&octets_l, p_p, sizeof(octets_l));
+        //Octet non nul la ou le caractere n'est pas dans '0'..'9'
+        const uint64_t nonChiffres_l = ((octets_l & OCTETS_0xF0) ^ OCTETS_0x30)
+            | (((octets_l + OCTETS_0x06) & OCTETS_0xF0) ^ OCTETS_0x30);
+        if ( nonChiffres_l == 0 ){
+            //8 chiffres ou plus : rare, boucle simple
+            const char* pCourant_l = p_p;
+            valeur_p = 0;
+            for ( unsigned int chiffre_l = chiffre(*pCourant_l) ; chiffre_l <= 9 ; chiffre_l = chiffre(*++pCourant_l) ){
+                valeur_p = valeur_p * 10 + chiffre_l;
+            }
+            return pCourant_l;
+        }
+
+        const unsigned int nbChiffres_l = __builtin_ctzll(nonChiffres_l) >> 3;
+        //Le decalage est fait en deux temps pour rester defini quand nbChiffres_l vaut 0
+        uint64_t chiffres_l = ((octets_l - OCTETS_0x30) << (56 - 8 * nbChiffres_l)) << 8;
+        chiffres_l = ((chiffres_l & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+        chiffres_l = ((chiffres_l & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+        valeur_p = ((chiffres_l & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32;
+        return p_p + nbChiffres_l;
+    }
+
+    /**
+     * Decode l'entier qui commence en p_p (blancs deja sautes).
+     * @return la position qui suit l'entier, ou 0 si le token n'est pas un int32 suivi d'un separateur
+     */
+    inline const char* scanneEntier(const char* p_p, int& valeur_p){
+        //Cas le plus frequent (cellules de la MMC) : un seul chiffre suivi d'un blanc. Ce test tres
+        //bien predit permet au processeur d'enchainer les tokens sans attendre le calcul de leur longueur
+        const unsigned int premier_l = chiffre(p_p[0]);
+        if ( premier_l <= 9 && static_cast<unsigned char>(p_p[1]) <= ' ' ){
+            valeur_p = premier_l;
+            return p_p + 1;
+        }
+
+        const unsigned int isNegatif_l = (*p_p == '-');
+        const char* pChiffres_l = p_p + isNegatif_l;
+        uint64_t valeur_l;
+        const char* pSuite_l = scanneChiffres(pChiffres_l, valeur_l);
+
+        //Un seul branchement dans le cas nominal : au moins un chiffre, pas trop, pas de depassement,
+        //suivi d'un blanc ou de la sentinelle (un '\0' au milieu du fichier sera refuse a la lecture suivante)
+        const size_t nbChiffres_l = pSuite_l - pChiffres_l;
+        const bool isInvalide_l = (nbChiffres_l - 1 >= NB_CHIFFRES_MAX)
+            | (valeur_l > static_cast<uint64_t>(INT_MAX) + isNegatif_l)
+            | (static_cast<unsigned char>(*pSuite_l) > ' ');
+        if ( isInvalide_l ){
+            return 0;
+        }
+        const uint64_t masque_l = -static_cast<uint64_t>(isNegatif_l);
+        valeur_p = static_cast<int>((valeur_l ^ masque_l) + isNegatif_l);
+        return pSuite_l;
+    }
+}
+
+ScannerDtoin::ScannerDtoin(const string& filename_p) :
+    nomSource_m(filename_p),
+    pMapping_m(0),
+    tailleMapping_m(0)
+{
+    const int fd_l = open(filename_p.c_str(), O_RDONLY);
+    struct stat stat_l;
+    if ( fd_l < 0 || fstat(fd_l, &stat_l) != 0 ){
+        if ( fd_l >= 0 ){
+            close(fd_l);
+        }
+        ostringstream oss_l;
+        oss_l << "Impossible d'ouvrir le fichier " << filename_p << endl;
+        throw oss_l.str();
+    }
+    const size_t tailleTexte_l = stat_l.st_size;
+
+    //Si la derniere page n'est pas pleine, le noyau la complete par des zeros : ils servent de
+    //sentinelle et de padding, et le fichier peut etre mappe tel quel
+    const size_t taillePage_l = sysconf(_SC_PAGESIZE);
+    const size_t resteDernierePage_l = taillePage_l - tailleTexte_l % taillePage_l;
+    if ( tailleTexte_l > 0 && resteDernierePage_l >= TAILLE_PADDING && resteDernierePage_l < taillePage_l ){
+        void* pMapping_l = mmap(0, tailleTexte_l, PROT_READ, MAP_PRIVATE, fd_l, 0);
+        if ( pMapping_l != MAP_FAILED ){
+            madvise(pMapping_l, tailleTexte_l, MADV_SEQUENTIAL);
+            pMapping_m = static_cast<const char*>(pMapping_l);
+            tailleMapping_m = tailleTexte_l;
+        }
+    }
+
+    bool isLu_l = true;
+    if ( ! pMapping_m ){
+        buffer_m.resize(tailleTexte_l + TAILLE_PADDING, '\0');
+        for ( size_t lus_l=0 ; isLu_l && lus_l < tailleTexte_l ; ){
+            const ssize_t nb_l = ::read(fd_l, &buffer_m[lus_l], tailleTexte_l - lus_l);
+            isLu_l = nb_l > 0;
+            lus_l += isLu_l ? nb_l : 0;
+        }
+    }
+    close(fd_l);
+    if ( ! isLu_l ){
+        ostringstream oss_l;
+        oss_l << "Erreur de lecture du fichier " << filename_p << endl;
+        throw oss_l.str();
+    }
+    initPointeurs(tailleTexte_l);
+}
+
+ScannerDtoin::ScannerDtoin(istream& is_p, const string& nomSource_p) :
+    nomSource_m(nomSource_p),
+    buffer_m(istreambuf_iterator<char>(is_p), istreambuf_iterator<char>()),
+    pMapping_m(0),
+    tailleMapping_m(0)
+{
+    const size_t tailleTexte_l = buffer_m.size();
+    buffer_m.append(TAILLE_PADDING, '\0');
+    initPointeurs(tailleTexte_l);
+}
+
+ScannerDtoin::ScannerDtoin(const ScannerDtoin& parent_p, size_t offset_p) :
+    nomSource_m(parent_p.nomSource_m),
+    pMapping_m(0),
+    tailleMapping_m(0),
+    pLibere_m(parent_p.pDebut_m + offset_p),
+    pDebut_m(parent_p.pDebut_m),
+    pFin_m(parent_p.pFin_m),
+    pCourant_m(parent_p.pDebut_m + offset_p)
+{}
+
+ScannerDtoin::~ScannerDtoin(){
+    if ( pMapping_m ){
+        munmap(const_cast<char*>(pMapping_m), tailleMapping_m);
+    }
+}
+
+void ScannerDtoin::initPointeurs(size_t tailleTexte_p){
+    //Le premier '\0' du padding sert de sentinelle au scanner
+    pDebut_m = pMapping_m ? pMapping_m : buffer_m.c_str();
+    pFin_m = pDebut_m + tailleTexte_p;
+    pCourant_m = pDebut_m;
+    pLibere_m = pDebut_m;
+}
+
+int ScannerDtoin::lireEntier(const char* description_p){
+    while ( isBlanc(*pCourant_m) ){
+        pCourant_m++;
+    }
+    int result_l;
+    const char* pSuite_l = scanneEntier(pCourant_m, result_l);
+    if ( ! pSuite_l ){
+        erreurEntier(pCourant_m, description_p);
+    }
+    pCourant_m = pSuite_l;
+    return result_l;
+}
+
+int ScannerDtoin::lireEntier(const char* description_p, int min_p, int max_p){
+    const char* pToken_l = pCourant_m;
+    while ( isBlanc(*pToken_l) ){
+        pToken_l++;
+    }
+    const int result_l = lireEntier(description_p);
+    if ( result_l < min_p || result_l > max_p ){
+        pCourant_m = pToken_l;
+        ostringstream oss_l;
+        oss_l << description_p << " (" << result_l << ") hors de l'intervalle [" << min_p << ", " << max_p << "]";
+        erreur(oss_l.str());
+    }
+    return result_l;
+}
+
+void ScannerDtoin::lireEntiers(int* pDest_p, size_t nb_p, const char* description_p){
+    const char* p_l = pCourant_m;
+    for ( size_t idx_l=0 ; idx_l < nb_p ; idx_l++ ){
+        while ( isBlanc(*p_l) ){
+            p_l++;
+        }
+        const char* pSuite_l = scanneEntier(p_l, pDest_p[idx_l]);
+        if ( ! pSuite_l ){
+            erreurEntier(p_l, description_p);
+        }
+        p_l = pSuite_l;
+    }
+    pCourant_m = p_l;
+    libereLu();
+}
+
+void ScannerDtoin::libereLu(){
+    const size_t TAILLE_MIN_LIBERATION = 1 << 22;
+    if ( ! pMapping_m || static_cast<size_t>(pCourant_m - pLibere_m) < TAILLE_MIN_LIBERATION ){
+        return;
+    }
+    //Pages entierement lues : rendues au systeme (relues depuis le fichier si une erreur doit compter les lignes)
+    const uintptr_t taillePage_l = sysconf(_SC_PAGESIZE);
+    const char* pFinPages_l = reinterpret_cast<const char*>(reinterpret_cast<uintptr_t>(pCourant_m) & ~(taillePage_l - 1));
+    madvise(const_cast<char*>(pLibere_m), pFinPages_l - pLibere_m, MADV_DONTNEED);
+    pLibere_m = pFinPages_l;
+}
+
+bool ScannerDtoin::isFini(){
+    while ( isBlanc(*pCourant_m) ){
+        pCourant_m++;
+    }
+    return pCourant_m == pFin_m;
+}
+
+size_t ScannerDtoin::getOffset() const{
+    return pCourant_m - pDebut_m;
+}
+
+void ScannerDtoin::setOffset(size_t offset_p){
+    pCourant_m = pDebut_m + offset_p;
+    libereLu();
+}
+
+vector<size_t> ScannerDtoin::localiseTokens(const vector<size_t>& rangs_p, int nbThreads_p) const{
+    //Decoupage du texte restant en morceaux de meme taille (un par thread)
+    const size_t debut_l = pCourant_m - pDebut_m;
+    const size_t fin_l = pFin_m - pDebut_m;
+    const size_t nbMorceaux_l = max<size_t>(1, min<size_t>(max(1, nbThreads_p), fin_l - debut_l));
+    vector<size_t> bornes_l(nbMorceaux_l + 1);
+    for ( size_t idxMorceau_l=0 ; idxMorceau_l <= nbMorceaux_l ; idxMorceau_l++ ){
+        bornes_l[idxMorceau_l] = debut_l + (fin_l - debut_l) * idxMorceau_l / nbMorceaux_l;
+    }
+
+    //Premiere passe : nombre de tokens qui commencent dans chaque morceau
+    vector<size_t> nbTokens_l(nbMorceaux_l, 0);
+    boost::thread_group threadsComptage_l;
+    for ( size_t idxMorceau_l=1 ; idxMorceau_l < nbMorceaux_l ; idxMorceau_l++ ){
+        threadsComptage_l.create_thread(boost::bind(&ScannerDtoin::compteTokens, this,
+                    bornes_l[idxMorceau_l], bornes_l[idxMorceau_l+1], boost::ref(nbTokens_l[idxMorceau_l])));
+    }
+    compteTokens(bornes_l[0], bornes_l[1], nbTokens_l[0]);
+    threadsComptage_l.join_all();
+
+    //Sommes prefixes : chaque rang demande est attribue au morceau ou commence son token
+    vector<size_t> rangsDebut_l(nbMorceaux_l);
+    vector<size_t> idxPremiers_l(nbMorceaux_l + 1);
+    size_t rangDebut_l = 0;
+    size_t idxRang_l = 0;
+    for ( size_t idxMorceau_l=0 ; idxMorceau_l < nbMorceaux_l ; idxMorceau_l++ ){
+        rangsDebut_l[idxMorceau_l] = rangDebut_l;
+        idxPremiers_l[idxMorceau_l] = idxRang_l;
+        rangDebut_l += nbTokens_l[idxMorceau_l];
+        while ( idxRang_l < rangs_p.size() && rangs_p[idxRang_l] < rangDebut_l ){
+            idxRang_l++;
+        }
+    }
+    idxPremiers_l[nbMorceaux_l] = idxRang_l;
+
+    //Seconde passe : chaque morceau resout les positions des rangs qui lui reviennent
+    vector<size_t> result_l(rangs_p.size(), fin_l);
+    boost::thread_group threadsPositions_l;
+    for ( size_t idxMorceau_l=1 ; idxMorceau_l < nbMorceaux_l ; idxMorceau_l++ ){
+        if ( idxPremiers_l[idxMorceau_l] == idxPremiers_l[idxMorceau_l+1] ){
+            continue;
+        }
+        threadsPositions_l.create_thread(boost::bind(&ScannerDtoin::positionneTokens, this,
+                    bornes_l[idxMorceau_l], bornes_l[idxMorceau_l+1], rangsDebut_l[idxMorceau_l], boost::cref(rangs_p),
+                    idxPremiers_l[idxMorceau_l], idxPremiers_l[idxMorceau_l+1], boost::ref(result_l)));
+    }
+    positionneTokens(bornes_l[0], bornes_l[1], 0, rangs_p, idxPremiers_l[0], idxPremiers_l[1], result_l);
+    threadsPositions_l.join_all();
+    return result_l;
+}
+
+void ScannerDtoin::compteTokens(size_t debut_p, size_t fin_p, size_t& nbTokens_p) const{
+    const char* p_l = pDebut_m + debut_p;
+    const char* const pFin_l = pDebut_m + fin_p;
+    //Un token commence sur un caractere non blanc precede d'un blanc (ou du debut du texte)
+    bool isBlancPrecedent_l = (debut_p == 0) || isBlanc(p_l[-1]);
+    size_t nbTokens_l = 0;
+    for ( ; p_l != pFin_l ; p_l++ ){
+        const bool isBlanc_l = isBlanc(*p_l);
+        nbTokens_l += isBlancPrecedent_l & ! isBlanc_l;
+        isBlancPrecedent_l = isBlanc_l;
+    }
+    nbTokens_p = nbTokens_l;
+}
+
+void ScannerDtoin::positionneTokens(size_t debut_p, size_t fin_p, size_t rangDebut_p, const vector<size_t>& rangs_p,
+        size_t idxPremier_p, size_t idxFin_p, vector<size_t>& offsets_p) const{
+    const char* p_l = pDebut_m + debut_p;
+    const char* const pFin_l = pDebut_m + fin_p;
+    bool isBlancPrecedent_l = (debut_p == 0) || isBlanc(p_l[-1]);
+    size_t rang_l = rangDebut_p;
+    size_t idxRang_l = idxPremier_p;
+    for ( ; p_l != pFin_l && idxRang_l < idxFin_p ; p_l++ ){
+        const bool isBlanc_l = isBlanc(*p_l);
+        if ( isBlancPrecedent_l && ! isBlanc_l ){
+            //Plusieurs rangs egaux designent le meme token
+            while ( idxRang_l < idxFin_p && rangs_p[idxRang_l] == rang_l ){
+                offsets_p[idxRang_l++] = p_l - pDebut_m;
+            }
+            rang_l++;
+        }
+        isBlancPrecedent_l = isBlanc_l;
+    }
+}
+
+void ScannerDtoin::erreurEntier(const char* pToken_p, const char* description_p){
+    pCourant_m = pToken_p;
+    if ( pToken_p == pFin_m ){
+        erreur(string(description_p) + " attendu, fin de fichier atteinte");
+    }
+    const char* pFinToken_l = pToken_p;
+    while ( pFinToken_l != pFin_m && ! isBlanc(*pFinToken_l) && pFinToken_l - pToken_p < 32 ){
+        pFinToken_l++;
+    }
+    erreur(string(description_p) + " attendu (entier 32 bits), trouve '" + string(pToken_p, pFinToken_l) + "'");
+}
+
+void ScannerDtoin::erreur(const string& message_p) const{
+    const int ligne_l = 1 + count(pDebut_m, pCourant_m, '\n');
+    const char* pDebutLigne_l = pCourant_m;
+    while ( pDebutLigne_l != pDebut_m && *(pDebutLigne_l - 1) != '\n' ){
+        pDebutLigne_l--;
+    }
+    ostringstream oss_l;
+    oss_l << nomSource_m << ":" << ligne_l << ":" << (pCourant_m - pDebutLigne_l + 1) << " : " << message_p;
+    throw oss_l.str();
+}
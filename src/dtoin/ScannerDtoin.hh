@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef SCANNERDTOIN_HH
+#define SCANNERDTOIN_HH
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * Lecteur d'entiers pour les fichiers texte du challenge (instance et solution).
+ * Le fichier est mappe en memoire (ou lu d'un bloc), toujours suivi de quelques '\0' qui servent
+ * de sentinelle et de padding, puis decoupe par un scanner a la main : pas de locale ni de
+ * sentry istream par entier.
+ *
+ * Les erreurs sont remontees sous forme de string de la forme
+ *   "fichier:ligne:colonne : <ce qui etait attendu>, trouve '<token>'"
+ * (la ligne et la colonne ne sont calculees qu'en cas d'erreur)
+ */
+class ScannerDtoin {
+    public:
+        /**
+         * Charge le fichier designe par son nom (leve une exception s'il ne peut etre ouvert)
+         */
+        explicit ScannerDtoin(const string& filename_p);
+
+        /**
+         * Charge tout ce qui reste a lire sur le flux
+         * @param nomSource_p nom utilise dans les messages d'erreur
+         */
+        ScannerDtoin(istream& is_p, const string& nomSource_p);
+
+        /**
+         * Vue sur le texte d'un autre scanner, positionnee a offset_p (cf localiseTokens).
+         * Sert a decoder une tranche du fichier dans un thread : la vue ne possede rien, le scanner
+         * parent doit lui survivre et ne pas etre lu pendant ce temps.
+         * Les erreurs sont localisees comme celles du parent (meme nom de source, memes lignes)
+         */
+        ScannerDtoin(const ScannerDtoin& parent_p, size_t offset_p);
+
+        ~ScannerDtoin();
+
+        /**
+         * @param description_p ce que represente l'entier (pour les messages d'erreur)
+         */
+        int lireEntier(const char* description_p);
+
+        /**
+         * Comme lireEntier, mais leve une exception si la valeur n'est pas dans [min_p, max_p]
+         */
+        int lireEntier(const char* description_p, int min_p, int max_p);
+
+        /**
+         * Lit nb_p entiers a la suite dans pDest_p (boucle serree pour les grosses sections, type MMC)
+         */
+        void lireEntiers(int* pDest_p, size_t nb_p, const char* description_p);
+
+        /**
+         * @return true s'il ne reste que des blancs a lire
+         */
+        bool isFini();
+
+        /**
+         * Leve une exception localisee a la position courante
+         */
+        void erreur(const string& message_p) const;
+
+        /**
+         * Pre-scan du texte restant, decoupe en nbThreads_p morceaux comptes en parallele.
+         * Un token est une suite de caracteres non blancs ; le premier token a lire a le rang 0.
+         * @param rangs_p rangs de tokens, croissants
+         * @return la position (offset depuis le debut du texte) de chacun de ces tokens, ou celle
+         * de la fin du texte pour les rangs au dela du dernier token
+         */
+        vector<size_t> localiseTokens(const vector<size_t>& rangs_p, int nbThreads_p) const;
+
+        /**
+         * @return la position courante, comme offset depuis le debut du texte
+         */
+        size_t getOffset() const;
+
+        /**
+         * Reprend la lecture a offset_p (typiquement la ou s'est arretee une vue)
+         */
+        void setOffset(size_t offset_p);
+
+    private:
+        /**
+         * Non copiable : pDebut_m et pCourant_m pointent dans buffer_m
+         */
+        ScannerDtoin(const ScannerDtoin&);
+        ScannerDtoin& operator=(const ScannerDtoin&);
+
+        /**
+         * Compte les debuts de tokens dans [debut_p, fin_p[ (cf localiseTokens)
+         */
+        void compteTokens(size_t debut_p, size_t fin_p, size_t& nbTokens_p) const;
+
+        /**
+         * Resout les positions des rangs_p[idxPremier_p..idxFin_p[, tous dans [debut_p, fin_p[
+         * @param rangDebut_p rang du premier token qui commence dans le morceau
+         */
+        void positionneTokens(size_t debut_p, size_t fin_p, size_t rangDebut_p, const vector<size_t>& rangs_p,
+                size_t idxPremier_p, size_t idxFin_p, vector<size_t>& offsets_p) const;
+
+        /**
+         * Le texte (mappe ou dans buffer_m) doit etre suivi d'au moins 8 '\0'
+         */
+        void initPointeurs(size_t tailleTexte_p);
+
+        /**
+         * Si le fichier est mappe, rend au systeme les pages deja lues (appele apres chaque lecture
+         * en bloc : le texte de la MMC n'occupe ainsi pas la memoire en meme temps que la MMC)
+         */
+        void libereLu();
+
+        /**
+         * Leve l'exception decrivant un entier invalide commencant en pToken_p
+         */
+        void erreurEntier(const char* pToken_p, const char* description_p);
+
+        string nomSource_m;
+        /**
+         * Texte (suivi du padding) quand il n'est pas mappe
+         */
+        string buffer_m;
+        const char* pMapping_m;
+        size_t tailleMapping_m;
+        const char* pLibere_m;
+
+        const char* pDebut_m;
+        const char* pFin_m;
+        const char* pCourant_m;
+};
+
+#endif
@@ -24,26 +24,29 @@
 #include "dtoin/ServiceDtoin.hh"
 #include "bo/ContextBO.hh"
 #include "bo/ServiceBO.hh"
+#include "dtoin/ScannerDtoin.hh"
 #include "tools/Log.hh"
-#include <cassert>
-#include <tr1/unordered_set>
+#include <climits>
+#include <vector>
 using namespace std;
 
 void ServiceDtoin::read(istream& is_p, ContextBO* pContextBO_p){
-    int nbServices_l;
-    is_p >> nbServices_l;
+    ScannerDtoin scanner_l(is_p, "section services");
+    read(scanner_l, pContextBO_p);
+}
+
+void ServiceDtoin::read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p){
+    const int nbServices_l = scanner_p.lireEntier("nombre de services", 0, INT_MAX);
     LOG(DEBUG) << nbServices_l << " services" << endl;
 
     for ( int idxService_l=0 ; idxService_l < nbServices_l ; idxService_l++ ){
-        int spreadMin_l, nbDependances_l;
-        is_p >> spreadMin_l >> nbDependances_l;
+        const int spreadMin_l = scanner_p.lireEntier("spread min du service", 0, INT_MAX);
+        const int nbDependances_l = scanner_p.lireEntier("nombre de dependances du service", 0, nbServices_l);
         LOG(DEBUG) << "\tService " << idxService_l << " : spread min=" << spreadMin_l << ", nb dependances=" << nbDependances_l << endl;
-        unordered_set<int> dependances_l;
+        vector<int> dependances_l(nbDependances_l);
 
         for ( int idxDep_l=0 ; idxDep_l < nbDependances_l ; idxDep_l++ ){
-            int idxServiceDep_l;
-            is_p >> idxServiceDep_l;
-            dependances_l.insert(idxServiceDep_l);
+            dependances_l[idxDep_l] = scanner_p.lireEntier("indice de service dont on depend", 0, nbServices_l - 1);
         }
 
         pContextBO_p->addService(new ServiceBO(idxService_l, spreadMin_l, dependances_l));
@@ -27,10 +27,15 @@
 using namespace std;
 
 class ContextBO;
+class ScannerDtoin;
 
 class ServiceDtoin{
     public:
+        /**
+         * Lit la section sur un flux (qui est consomme jusqu'au bout)
+         */
         void read(istream& is_p, ContextBO* pContextBO_p);
+        void read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p);
 
 };
 
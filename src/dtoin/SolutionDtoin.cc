@@ -23,28 +23,31 @@
 
 #include "dtoin/SolutionDtoin.hh"
 #include "bo/ContextBO.hh"
-#include "bo/ProcessBO.hh"
+#include "dtoin/ScannerDtoin.hh"
 #include "tools/Log.hh"
 #include <fstream>
 #include <sstream>
 
 void SolutionDtoin::read(const string& solFileName_p, ContextBO* pContextBO_p){
-    ifstream ifs_l(solFileName_p.c_str());
-    if ( ! ifs_l ){
-        ostringstream oss_l;
-        oss_l << "Impossible d'ouvrir le fichier de solution a lire " << solFileName_p << endl;
-        throw oss_l.str();
-    }
-    read(ifs_l, pContextBO_p);
+    ScannerDtoin scanner_l(solFileName_p);
+    read(scanner_l, pContextBO_p);
 }
 
 void SolutionDtoin::read(istream& is_p, ContextBO* pContextBO_p){
-    int nbProcesses_l = pContextBO_p->getNbProcesses();
+    ScannerDtoin scanner_l(is_p, "solution initiale");
+    read(scanner_l, pContextBO_p);
+}
+
+void SolutionDtoin::read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p){
+    const int nbProcesses_l = pContextBO_p->getNbProcesses();
+    const int nbMachines_l = pContextBO_p->getNbMachines();
     for ( int idxP_l=0 ; idxP_l < nbProcesses_l ; idxP_l++ ){
-        int idxMachine_l;
-        is_p >> idxMachine_l;
-        MachineBO* pMachine_l = pContextBO_p->getMachine(idxMachine_l);
-        pContextBO_p->getProcess(idxP_l)->setMachineInit(pMachine_l);
+        const int idxMachine_l = scanner_p.lireEntier("machine initiale du process", 0, nbMachines_l - 1);
+        pContextBO_p->setMachineInit(idxP_l, idxMachine_l);
     }
+
+    //L'instance est desormais completement chargee : un nouvel #InstanceCoreBO est publie, ceux
+    //deja distribues restent valides
+    pContextBO_p->buildInstanceCore();
     LOG(INFO) << "Fin de la lecture du fichier de solution initiale" << endl;
 }
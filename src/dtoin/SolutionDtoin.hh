@@ -28,6 +28,7 @@
 using namespace std;
 
 class ContextBO;
+class ScannerDtoin;
 
 /**
  * Classe en charge de la lecture du fichier de solution initial
@@ -40,9 +41,11 @@ class SolutionDtoin {
         static void read(const string& solFileName_p, ContextBO* pContextBO_p);
 
         /**
-         * Lit le flux representant le fichier de solution
+         * Lit le flux representant le fichier de solution.
+         * L'instance etant alors completement chargee, construit son #InstanceCoreBO
          */
         static void read(istream& is_p, ContextBO* pContextBO_p);
+        static void read(ScannerDtoin& scanner_p, ContextBO* pContextBO_p);
 };
 
 #endif
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "dtoout/InstanceWriterBinaire.hh"
+#include "dtoout/TamponSortie.hh"
+#include "bo/BalanceCostBO.hh"
+#include "bo/ContextBO.hh"
+#include "bo/LocationBO.hh"
+#include "bo/MachineBO.hh"
+#include "bo/MMCBO.hh"
+#include "bo/NeighborhoodBO.hh"
+#include "bo/ProcessBO.hh"
+#include "bo/RessourceBO.hh"
+#include "bo/ServiceBO.hh"
+#include <algorithm>
+#include <cstring>
+using namespace std;
+
+void InstanceWriterBinaire::writeOnTampon(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
+    const int nbRess_l = pContextBO_p->getNbRessources();
+    const int nbMachines_l = pContextBO_p->getNbMachines();
+    const int nbServices_l = pContextBO_p->getNbServices();
+    const int nbProcesses_l = pContextBO_p->getNbProcesses();
+    const int nbBC_l = pContextBO_p->getNbBalanceCosts();
+
+    InstanceBinaire::Entete entete_l;
+    memset(&entete_l, 0, sizeof(entete_l));
+    memcpy(entete_l.magic, InstanceBinaire::MAGIC, sizeof(entete_l.magic));
+    entete_l.version = InstanceBinaire::VERSION;
+    entete_l.marqueurEndian = InstanceBinaire::MARQUEUR_ENDIAN;
+    entete_l.nbRessources = nbRess_l;
+    entete_l.nbMachines = nbMachines_l;
+    entete_l.nbLocations = pContextBO_p->getNbLocations();
+    entete_l.nbNeighborhoods = pContextBO_p->getNbNeighborhoods();
+    entete_l.nbServices = nbServices_l;
+    entete_l.nbProcesses = nbProcesses_l;
+    entete_l.nbBalanceCosts = nbBC_l;
+
+    //Les dependances sont triees (par le service) afin que deux ecritures d'une meme instance soient identiques
+    vector<int32_t> debutsDep_l(nbServices_l + 1, 0);
+    vector<int32_t> dependances_l;
+    for ( int idxS_l=0 ; idxS_l < nbServices_l ; idxS_l++ ){
+        const vector<int>& dependancesS_l = pContextBO_p->getService(idxS_l)->getServicesIDependOn();
+        dependances_l.insert(dependances_l.end(), dependancesS_l.begin(), dependancesS_l.end());
+        debutsDep_l[idxS_l+1] = dependances_l.size();
+    }
+    entete_l.nbDependances = dependances_l.size();
+    entete_l.tailleCorps = InstanceBinaire::tailleCorps(entete_l);
+
+    tampon_p.ajoute(reinterpret_cast<const char*>(&entete_l), sizeof(entete_l));
+    uint64_t checksum_l = InstanceBinaire::CHECKSUM_INITIAL;
+    vector<int32_t> tab_l;
+
+    //Ressources
+    tab_l.resize(nbRess_l);
+    for ( int idxR_l=0 ; idxR_l < nbRess_l ; idxR_l++ ){
+        tab_l[idxR_l] = pContextBO_p->getRessource(idxR_l)->isTransient();
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+    for ( int idxR_l=0 ; idxR_l < nbRess_l ; idxR_l++ ){
+        tab_l[idxR_l] = pContextBO_p->getRessource(idxR_l)->getWeightLoadCost();
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+
+    //Machines
+    tab_l.resize(nbMachines_l);
+    for ( int idxM_l=0 ; idxM_l < nbMachines_l ; idxM_l++ ){
+        tab_l[idxM_l] = pContextBO_p->getMachine(idxM_l)->getNeighborhood()->getId();
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+    for ( int idxM_l=0 ; idxM_l < nbMachines_l ; idxM_l++ ){
+        tab_l[idxM_l] = pContextBO_p->getMachine(idxM_l)->getLocation()->getId();
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+    tab_l.resize(nbMachines_l * nbRess_l);
+    for ( int idxM_l=0 ; idxM_l < nbMachines_l ; idxM_l++ ){
+        for ( int idxR_l=0 ; idxR_l < nbRess_l ; idxR_l++ ){
+            tab_l[idxM_l*nbRess_l + idxR_l] = pContextBO_p->getMachine(idxM_l)->getCapa(idxR_l);
+        }
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+    for ( int idxM_l=0 ; idxM_l < nbMachines_l ; idxM_l++ ){
+        for ( int idxR_l=0 ; idxR_l < nbRess_l ; idxR_l++ ){
+            tab_l[idxM_l*nbRess_l + idxR_l] = pContextBO_p->getMachine(idxM_l)->getSafetyCapa(idxR_l);
+        }
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+
+    //MMC : ecrite deux lignes a la fois (un multiple de 8 octets, cf checksum) pour ne pas materialiser
+    //la matrice decompressee une deuxieme fois ; le padding suit la derniere ligne si M est impair
+    MMCBO const * pMMC_l = pContextBO_p->getMMCBO();
+    tab_l.resize(2 * nbMachines_l);
+    for ( int idxM_l=0 ; idxM_l < nbMachines_l ; idxM_l += 2 ){
+        const int nbLignes_l = min(2, nbMachines_l - idxM_l);
+        for ( int idxLigne_l=0 ; idxLigne_l < nbLignes_l ; idxLigne_l++ ){
+            for ( int idxTo_l=0 ; idxTo_l < nbMachines_l ; idxTo_l++ ){
+                tab_l[idxLigne_l*nbMachines_l + idxTo_l] = pMMC_l->getCost(idxM_l + idxLigne_l, idxTo_l);
+            }
+        }
+        writeTableau(&tab_l[0], nbLignes_l * nbMachines_l, tampon_p, checksum_l);
+    }
+
+    //Services
+    tab_l.resize(nbServices_l);
+    for ( int idxS_l=0 ; idxS_l < nbServices_l ; idxS_l++ ){
+        tab_l[idxS_l] = pContextBO_p->getService(idxS_l)->getSpreadMin();
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+    writeTableau(debutsDep_l, tampon_p, checksum_l);
+    writeTableau(dependances_l, tampon_p, checksum_l);
+
+    //Processes
+    tab_l.resize(nbProcesses_l);
+    for ( int idxP_l=0 ; idxP_l < nbProcesses_l ; idxP_l++ ){
+        tab_l[idxP_l] = pContextBO_p->getProcess(idxP_l)->getService()->getId();
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+    tab_l.resize(nbProcesses_l * nbRess_l);
+    for ( int idxP_l=0 ; idxP_l < nbProcesses_l ; idxP_l++ ){
+        for ( int idxR_l=0 ; idxR_l < nbRess_l ; idxR_l++ ){
+            tab_l[idxP_l*nbRess_l + idxR_l] = pContextBO_p->getProcess(idxP_l)->getRequirement(idxR_l);
+        }
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+    tab_l.resize(nbProcesses_l);
+    for ( int idxP_l=0 ; idxP_l < nbProcesses_l ; idxP_l++ ){
+        tab_l[idxP_l] = pContextBO_p->getProcess(idxP_l)->getPMC();
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+
+    //Balance costs
+    tab_l.resize(nbBC_l);
+    for ( int idxBC_l=0 ; idxBC_l < nbBC_l ; idxBC_l++ ){
+        tab_l[idxBC_l] = pContextBO_p->getBalanceCost(idxBC_l)->getRessource1()->getId();
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+    for ( int idxBC_l=0 ; idxBC_l < nbBC_l ; idxBC_l++ ){
+        tab_l[idxBC_l] = pContextBO_p->getBalanceCost(idxBC_l)->getRessource2()->getId();
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+    for ( int idxBC_l=0 ; idxBC_l < nbBC_l ; idxBC_l++ ){
+        tab_l[idxBC_l] = pContextBO_p->getBalanceCost(idxBC_l)->getTarget();
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+    for ( int idxBC_l=0 ; idxBC_l < nbBC_l ; idxBC_l++ ){
+        tab_l[idxBC_l] = pContextBO_p->getBalanceCost(idxBC_l)->getPoids();
+    }
+    writeTableau(tab_l, tampon_p, checksum_l);
+
+    //Poids
+    tab_l.resize(3);
+    tab_l[0] = pContextBO_p->getPoidsPMC();
+    tab_l[1] = pContextBO_p->getPoidsSMC();
+    tab_l[2] = pContextBO_p->getPoidsMMC();
+    writeTableau(tab_l, tampon_p, checksum_l);
+
+    tampon_p.ajoute(reinterpret_cast<const char*>(&checksum_l), sizeof(checksum_l));
+}
+
+void InstanceWriterBinaire::writeTableau(const int32_t* pValeurs_p, size_t nbValeurs_p, TamponSortie& tampon_p, uint64_t& checksum_p){
+    const size_t taille_l = nbValeurs_p * sizeof(int32_t);
+    const size_t tailleComplete_l = InstanceBinaire::tailleTableau(nbValeurs_p);
+    const size_t tailleAlignee_l = taille_l & ~static_cast<size_t>(7);
+    const char* pOctets_l = reinterpret_cast<const char*>(pValeurs_p);
+    tampon_p.ajoute(pOctets_l, taille_l);
+    checksum_p = InstanceBinaire::checksum(pOctets_l, tailleAlignee_l, checksum_p);
+
+    //Dernier mot : fin du tableau et padding a zero
+    if ( tailleComplete_l != tailleAlignee_l ){
+        char dernierMot_l[sizeof(uint64_t)] = {0};
+        memcpy(dernierMot_l, pOctets_l + tailleAlignee_l, taille_l - tailleAlignee_l);
+        tampon_p.ajoute(dernierMot_l + taille_l - tailleAlignee_l, tailleComplete_l - taille_l);
+        checksum_p = InstanceBinaire::checksum(dernierMot_l, sizeof(dernierMot_l), checksum_p);
+    }
+}
+
+void InstanceWriterBinaire::writeTableau(const vector<int32_t>& valeurs_p, TamponSortie& tampon_p, uint64_t& checksum_p){
+    writeTableau(valeurs_p.empty() ? 0 : &valeurs_p[0], valeurs_p.size(), tampon_p, checksum_p);
+}
@@ -21,26 +21,33 @@
  *
  */
 
-#ifndef RESTRICTIONALG_HH
-#define RESTRICTIONALG_HH
-
-#include "SolutionALG.hh"
+#ifndef INSTANCEWRITERBINAIRE_HH
+#define INSTANCEWRITERBINAIRE_HH
+#include "dtoout/InstanceWriterInterface.hh"
+#include "tools/InstanceBinaire.hh"
+#include <string>
 #include <vector>
+using namespace std;
+
+class ContextBO;
+
+/**
+ * Ecrit un ContextBO au format binaire decrit dans InstanceBinaire.
+ * Sert a convertir une fois pour toutes les instances du challenge (via le generateur,
+ * option --writer binaire) afin que le main les recharge sans parsing
+ */
+class InstanceWriterBinaire : public InstanceWriterInterface {
+    protected:
+        /**
+         * Le corps est ecrit au fil de l'eau dans le tampon, le checksum calcule au passage est ecrit a la fin
+         */
+        virtual void writeOnTampon(ContextBO const * pContextBO_p, TamponSortie& tampon_p);
 
-class RestrictionALG
-{
-    public:
-        RestrictionALG() {}
-        virtual ~RestrictionALG() {}
-        
-        typedef SolutionALG::ProcessId ProcessId;
-        typedef std::vector<ProcessId> ProcessPool;
-        
-        typedef SolutionALG::MachineId MachineId;
-        typedef std::vector<MachineId> MachinePool;
-    
-        virtual void filter(ProcessPool &) const = 0;
-        virtual void filter(ProcessId const &, MachinePool &) const = 0;
+        /**
+         * Ecrit les nbValeurs_p valeurs et le padding du tableau, et les ajoute au checksum
+         */
+        static void writeTableau(const int32_t* pValeurs_p, size_t nbValeurs_p, TamponSortie& tampon_p, uint64_t& checksum_p);
+        static void writeTableau(const vector<int32_t>& valeurs_p, TamponSortie& tampon_p, uint64_t& checksum_p);
 };
 
 #endif
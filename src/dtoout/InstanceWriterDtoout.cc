@@ -22,6 +22,7 @@
  */
 
 #include "dtoout/InstanceWriterDtoout.hh"
+#include "dtoout/TamponSortie.hh"
 #include "bo/BalanceCostBO.hh"
 #include "bo/ContextBO.hh"
 #include "bo/LocationBO.hh"
@@ -31,177 +32,151 @@
 #include "bo/ProcessBO.hh"
 #include "bo/RessourceBO.hh"
 #include "bo/ServiceBO.hh"
-#include <iostream>
-#include <sstream>
+#include <vector>
 using namespace std;
 
-string InstanceWriterDtoout::writeOnString(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
-    oss_l << writeRessources(pContextBO_p)
-        << writeMachines(pContextBO_p)
-        << writeServices(pContextBO_p)
-        << writeProcesses(pContextBO_p)
-        << writeBalanceCost(pContextBO_p)
-        << writePoids(pContextBO_p);
-    return oss_l.str();
+void InstanceWriterDtoout::writeOnTampon(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
+    writeRessources(pContextBO_p, tampon_p);
+    writeMachines(pContextBO_p, tampon_p);
+    writeServices(pContextBO_p, tampon_p);
+    writeProcesses(pContextBO_p, tampon_p);
+    writeBalanceCost(pContextBO_p, tampon_p);
+    writePoids(pContextBO_p, tampon_p);
 }
 
-string InstanceWriterDtoout::writeRessources(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
+void InstanceWriterDtoout::writeRessources(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
     int nbRess_l = pContextBO_p->getNbRessources();
-    oss_l << nbRess_l << endl;
+    tampon_p << nbRess_l << '\n';
 
     for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
         RessourceBO* pRess_l = pContextBO_p->getRessource(idxRess_l);
-        oss_l << endl
-            << pRess_l->isTransient() << endl
-            << pRess_l->getWeightLoadCost() << endl;
+        tampon_p << '\n'
+            << pRess_l->isTransient() << '\n'
+            << pRess_l->getWeightLoadCost() << '\n';
     }
-    return oss_l.str();
 }
 
-string InstanceWriterDtoout::writeMachines(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
+void InstanceWriterDtoout::writeMachines(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
     int nbMachines_l = pContextBO_p->getNbMachines();
-    oss_l << nbMachines_l << endl;
+    tampon_p << nbMachines_l << '\n';
 
     for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
         MachineBO* pMachine_l = pContextBO_p->getMachine(idxMachine_l);
-        oss_l << endl
-            << pMachine_l->getNeighborhood()->getId() << endl
-            << pMachine_l->getLocation()->getId() << endl
-            << writeMachineCapa(pContextBO_p, pMachine_l, false) << endl
-            << writeMachineCapa(pContextBO_p, pMachine_l, true) << endl
-            << writeMachineMMC(pContextBO_p, pMachine_l) << endl;
+        tampon_p << '\n'
+            << pMachine_l->getNeighborhood()->getId() << '\n'
+            << pMachine_l->getLocation()->getId() << '\n';
+        writeMachineCapa(pContextBO_p, pMachine_l, false, tampon_p);
+        tampon_p << '\n';
+        writeMachineCapa(pContextBO_p, pMachine_l, true, tampon_p);
+        tampon_p << '\n';
+        writeMachineMMC(pContextBO_p, pMachine_l, tampon_p);
+        tampon_p << '\n';
     }
-
-    return oss_l.str();
 }
 
-string InstanceWriterDtoout::writeMachineCapa(ContextBO const * pContextBO_p, MachineBO* pMachine_p, bool useSafetyCapa_p){
-    ostringstream oss_l;
+void InstanceWriterDtoout::writeMachineCapa(ContextBO const * pContextBO_p, MachineBO* pMachine_p, bool useSafetyCapa_p, TamponSortie& tampon_p){
     int nbRess_l = pContextBO_p->getNbRessources();
 
     for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
         if ( useSafetyCapa_p ){
-            oss_l << pMachine_p->getSafetyCapa(idxRess_l);
+            tampon_p << pMachine_p->getSafetyCapa(idxRess_l);
         } else {
-            oss_l << pMachine_p->getCapa(idxRess_l);
+            tampon_p << pMachine_p->getCapa(idxRess_l);
         }
 
         if ( idxRess_l != nbRess_l -1 ){
-            oss_l << " ";
+            tampon_p << ' ';
         }
     }
-
-    return oss_l.str();
 }
 
-string InstanceWriterDtoout::writeMachineMMC(ContextBO const * pContextBO_p, MachineBO* pMachine_p){
-    ostringstream oss_l;
-    MMCBO* pMMC_l = pContextBO_p->getMMCBO();
+void InstanceWriterDtoout::writeMachineMMC(ContextBO const * pContextBO_p, MachineBO* pMachine_p, TamponSortie& tampon_p){
+    MMCBO const * pMMC_l = pContextBO_p->getMMCBO();
     int nbMachines_l = pContextBO_p->getNbMachines();
     for (int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
-        oss_l << pMMC_l->getCost(pMachine_p->getId(), idxMachine_l);
+        tampon_p << pMMC_l->getCost(pMachine_p->getId(), idxMachine_l);
         if ( idxMachine_l != nbMachines_l -1 ){
-            oss_l << " ";
+            tampon_p << ' ';
         }
     }
-
-    return oss_l.str();
 }
 
-string InstanceWriterDtoout::writeServices(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
+void InstanceWriterDtoout::writeServices(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
     int nbServices_l = pContextBO_p->getNbServices();
-    oss_l << nbServices_l << endl;
+    tampon_p << nbServices_l << '\n';
 
     for ( int idxService_l=0 ; idxService_l < nbServices_l ; idxService_l++ ){
         ServiceBO* pService_l = pContextBO_p->getService(idxService_l);
 
-        oss_l << endl
-            << pService_l->getSpreadMin() << endl
-            << writeServiceDependances(pContextBO_p, pService_l) << endl;
+        tampon_p << '\n'
+            << pService_l->getSpreadMin() << '\n';
+        writeServiceDependances(pService_l, tampon_p);
+        tampon_p << '\n';
     }
-    return oss_l.str();
 }
 
-string InstanceWriterDtoout::writeServiceDependances(ContextBO const * pContextBO_p, ServiceBO* pService_p){
-    int nbServices_l = pContextBO_p->getNbServices();
-    ostringstream oss_l;
-    oss_l << pService_p->getNbServicesIDependOn();
+void InstanceWriterDtoout::writeServiceDependances(ServiceBO* pService_p, TamponSortie& tampon_p){
+    tampon_p << pService_p->getNbServicesIDependOn();
     if ( pService_p->getNbServicesIDependOn() == 0 ){
-        //Permet de ne pas se prendre la tete avec le endl qui risque de faire un double saut de ligne sinon
-        return oss_l.str();
+        //Permet de ne pas se prendre la tete avec le '\n' qui risque de faire un double saut de ligne sinon
+        return;
     }
-    
-    oss_l << endl;
 
-    bool premiereDepTrouvee_l(false);
-    for ( int idxService_l=0 ; idxService_l < nbServices_l ; idxService_l++ ){
-        if ( pService_p->iDependOn(idxService_l) ){
-            if ( premiereDepTrouvee_l ){
-                oss_l << " ";
-            }
-            premiereDepTrouvee_l = true;
-            oss_l << idxService_l;
+    tampon_p << '\n';
+
+    //Dependances ecrites dans l'ordre croissant (le service les stocke triees)
+    const vector<int>& dependances_l = pService_p->getServicesIDependOn();
+    for ( vector<int>::const_iterator it_l=dependances_l.begin() ; it_l != dependances_l.end() ; it_l++ ){
+        if ( it_l != dependances_l.begin() ){
+            tampon_p << ' ';
         }
+        tampon_p << *it_l;
     }
-    return oss_l.str();
 }
 
-string InstanceWriterDtoout::writeProcesses(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
+void InstanceWriterDtoout::writeProcesses(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
     int nbProcesses_l = pContextBO_p->getNbProcesses();
-    oss_l << nbProcesses_l;
+    tampon_p << nbProcesses_l;
 
     for ( int idxP_l=0 ; idxP_l < nbProcesses_l ; idxP_l++ ){
         ProcessBO* pProcess_l = pContextBO_p->getProcess(idxP_l);
-        oss_l << endl
-            << pProcess_l->getService()->getId() << endl
-            << writeProcessRequirements(pContextBO_p, pProcess_l) << endl
-            << pProcess_l->getPMC() << endl;
+        tampon_p << '\n'
+            << pProcess_l->getService()->getId() << '\n';
+        writeProcessRequirements(pContextBO_p, pProcess_l, tampon_p);
+        tampon_p << '\n'
+            << pProcess_l->getPMC() << '\n';
     }
-
-    return oss_l.str();
 }
 
-string InstanceWriterDtoout::writeProcessRequirements(ContextBO const * pContextBO_p, ProcessBO* pProcess_p){
-    ostringstream oss_l;
+void InstanceWriterDtoout::writeProcessRequirements(ContextBO const * pContextBO_p, ProcessBO* pProcess_p, TamponSortie& tampon_p){
     int nbRess_l = pContextBO_p->getNbRessources();
     for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
-        oss_l << pProcess_p->getRequirement(idxRess_l);
+        tampon_p << pProcess_p->getRequirement(idxRess_l);
         if ( idxRess_l != nbRess_l - 1 ){
-            oss_l << " ";
+            tampon_p << ' ';
         }
     }
-    return oss_l.str();
 }
 
-string InstanceWriterDtoout::writeBalanceCost(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
+void InstanceWriterDtoout::writeBalanceCost(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
     int nbBC_l = pContextBO_p->getNbBalanceCosts();
-    oss_l << nbBC_l;
+    tampon_p << nbBC_l;
     if ( nbBC_l == 0 ){
-        oss_l << endl;
+        tampon_p << '\n';
     }
 
     for ( int idxBC_l=0 ; idxBC_l < nbBC_l ; idxBC_l++ ){
         BalanceCostBO* pBC_l = pContextBO_p->getBalanceCost(idxBC_l);
-        oss_l << endl
-            << pBC_l->getRessource1()->getId() << " "
-            << pBC_l->getRessource2()->getId() << " "
-            << pBC_l->getTarget() << endl
-            << pBC_l->getPoids() << endl;
+        tampon_p << '\n'
+            << pBC_l->getRessource1()->getId() << ' '
+            << pBC_l->getRessource2()->getId() << ' '
+            << pBC_l->getTarget() << '\n'
+            << pBC_l->getPoids() << '\n';
     }
-
-    return oss_l.str();
 }
 
-string InstanceWriterDtoout::writePoids(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
-    oss_l << pContextBO_p->getPoidsPMC() << endl
-        << pContextBO_p->getPoidsSMC() << endl
-        << pContextBO_p->getPoidsMMC() << endl;
-    return oss_l.str();
+void InstanceWriterDtoout::writePoids(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
+    tampon_p << pContextBO_p->getPoidsPMC() << '\n'
+        << pContextBO_p->getPoidsSMC() << '\n'
+        << pContextBO_p->getPoidsMMC() << '\n';
 }
@@ -38,28 +38,26 @@ class ServiceBO;
  * - a des fins de test
  * - par le generateur d'instances
  *
- * Nb : cette classe n'ayant pas vocation a etre utilisee durant l'optim, la clarte du code
- * est clairement privilegiee par rapport au perf (ce qui explique les multiples 
- * conversions string <-> ostringstream dans les deux sens)
+ * Nb : le texte est produit au fil de l'eau dans le tampon, section par section : ecrire une grosse
+ * instance (MMC de plusieurs centaines de Mo) ne coute pas plus de memoire qu'une petite
  */
 class InstanceWriterDtoout : public InstanceWriterInterface {
     public:
 
     protected:
-        virtual string writeOnString(ContextBO const * pContextBO_p);
-        static string writeRessources(ContextBO const * pContextBO_p);
-        static string writeMachines(ContextBO const * pContextBO_p);
-        static string writeServices(ContextBO const * pContextBO_p);
-        static string writeProcesses(ContextBO const * pContextBO_p);
-        static string writeBalanceCost(ContextBO const * pContextBO_p);
-        static string writePoids(ContextBO const * pContextBO_p);
+        virtual void writeOnTampon(ContextBO const * pContextBO_p, TamponSortie& tampon_p);
+        static void writeRessources(ContextBO const * pContextBO_p, TamponSortie& tampon_p);
+        static void writeMachines(ContextBO const * pContextBO_p, TamponSortie& tampon_p);
+        static void writeServices(ContextBO const * pContextBO_p, TamponSortie& tampon_p);
+        static void writeProcesses(ContextBO const * pContextBO_p, TamponSortie& tampon_p);
+        static void writeBalanceCost(ContextBO const * pContextBO_p, TamponSortie& tampon_p);
+        static void writePoids(ContextBO const * pContextBO_p, TamponSortie& tampon_p);
 
-        static string writeMachineCapa(ContextBO const * pContextBO_p, MachineBO* pMachine_p, bool useSafetyCapa_p);
-        static string writeMachineSafetyCapa(MachineBO* pMachine_p);
-        static string writeMachineMMC(ContextBO const * pContextBO_p, MachineBO* pMachine_p);
+        static void writeMachineCapa(ContextBO const * pContextBO_p, MachineBO* pMachine_p, bool useSafetyCapa_p, TamponSortie& tampon_p);
+        static void writeMachineMMC(ContextBO const * pContextBO_p, MachineBO* pMachine_p, TamponSortie& tampon_p);
 
-        static string writeServiceDependances(ContextBO const * pContextBO_p, ServiceBO* pService_p);
-        static string writeProcessRequirements(ContextBO const * pContextBO_p, ProcessBO* pProcess_p);
+        static void writeServiceDependances(ServiceBO* pService_p, TamponSortie& tampon_p);
+        static void writeProcessRequirements(ContextBO const * pContextBO_p, ProcessBO* pProcess_p, TamponSortie& tampon_p);
 };
 
 #endif
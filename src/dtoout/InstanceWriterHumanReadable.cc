@@ -22,6 +22,7 @@
  */
 
 #include "dtoout/InstanceWriterHumanReadable.hh"
+#include "dtoout/TamponSortie.hh"
 #include "bo/BalanceCostBO.hh"
 #include "bo/ContextBO.hh"
 #include "bo/LocationBO.hh"
@@ -32,179 +33,171 @@
 #include "bo/RessourceBO.hh"
 #include "bo/ServiceBO.hh"
 #include <boost/foreach.hpp>
-#include <sstream>
 using namespace std;
 
-string InstanceWriterHumanReadable::writeOnString(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
-
-    oss_l << writeMajorTitle("Instance") << endl
-        << writeRessources(pContextBO_p)
-        << writeMachines(pContextBO_p)
-        << writeServices(pContextBO_p)
-        << writeProcesses(pContextBO_p)
-        << writeBalanceCost(pContextBO_p)
-        << writePoids(pContextBO_p);
-    return oss_l.str();
+namespace {
+    /**
+     * Ecrit les '=' qui encadrent un titre de niveau level_p
+     */
+    void writeBarre(int level_p, TamponSortie& tampon_p){
+        for ( int idx_l=0 ; idx_l < level_p ; idx_l++ ){
+            tampon_p << '=';
+        }
+    }
+}
+
+void InstanceWriterHumanReadable::writeOnTampon(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
+    writeMajorTitle("Instance", tampon_p);
+    tampon_p << '\n';
+    writeRessources(pContextBO_p, tampon_p);
+    writeMachines(pContextBO_p, tampon_p);
+    writeServices(pContextBO_p, tampon_p);
+    writeProcesses(pContextBO_p, tampon_p);
+    writeBalanceCost(pContextBO_p, tampon_p);
+    writePoids(pContextBO_p, tampon_p);
 }
 
-string InstanceWriterHumanReadable::writeRessources(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
-    oss_l << writeSectionTitle("Ressources") << endl;
+void InstanceWriterHumanReadable::writeRessources(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
+    writeSectionTitle("Ressources", tampon_p);
+    tampon_p << '\n';
     int nbRess_l = pContextBO_p->getNbRessources();
-    oss_l << writeQuantite(nbRess_l) << endl;
+    writeQuantite(nbRess_l, tampon_p);
+    tampon_p << '\n';
     
     for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
         RessourceBO* pRess_l = pContextBO_p->getRessource(idxRess_l);
-        oss_l << endl
-            << writeSubTitle("Ressource", idxRess_l, nbRess_l) << endl
-            << writeCarac("isTransient", pRess_l->isTransient()) << endl
-            << writeCarac("weightLoadCost", pRess_l->getWeightLoadCost()) << endl;
+        tampon_p << '\n';
+        writeSubTitle("Ressource", idxRess_l, nbRess_l, tampon_p);
+        writeCarac("isTransient", pRess_l->isTransient(), tampon_p);
+        writeCarac("weightLoadCost", pRess_l->getWeightLoadCost(), tampon_p);
     }
 
-    oss_l << endl;
-    return oss_l.str();
+    tampon_p << '\n';
 }
 
-string InstanceWriterHumanReadable::writeMachines(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
-    oss_l << writeSectionTitle("Machines") << endl;
+void InstanceWriterHumanReadable::writeMachines(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
+    writeSectionTitle("Machines", tampon_p);
+    tampon_p << '\n';
     int nbMachines_l = pContextBO_p->getNbMachines();
-    oss_l << writeQuantite(nbMachines_l) << endl;
+    writeQuantite(nbMachines_l, tampon_p);
+    tampon_p << '\n';
     
     for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
         MachineBO* pMachine_l = pContextBO_p->getMachine(idxMachine_l);
-        oss_l << endl
-            << writeSubTitle("Machine", idxMachine_l, nbMachines_l) << endl
-            << writeCarac("Neighborhood", pMachine_l->getNeighborhood()->getId()) << endl
-            << writeCarac("Location", pMachine_l->getLocation()->getId()) << endl
-            << writeListOfCaracs("Capa", pMachine_l->getCapas()) << endl
-            << writeListOfCaracs("SafetyCapa", pMachine_l->getSafetyCapas()) << endl
-            << writeListOfCaracs("MMC", pContextBO_p->getMMCBO()->getCosts(pMachine_l)) << endl;
+        tampon_p << '\n';
+        writeSubTitle("Machine", idxMachine_l, nbMachines_l, tampon_p);
+        writeCarac("Neighborhood", pMachine_l->getNeighborhood()->getId(), tampon_p);
+        writeCarac("Location", pMachine_l->getLocation()->getId(), tampon_p);
+        writeListOfCaracs("Capa", pMachine_l->getCapas(), tampon_p);
+        writeListOfCaracs("SafetyCapa", pMachine_l->getSafetyCapas(), tampon_p);
+        writeListOfCaracs("MMC", pContextBO_p->getMMCBO()->getCosts(pMachine_l), tampon_p);
     }
 
-    oss_l << endl;
-    return oss_l.str();
+    tampon_p << '\n';
 }
 
-string InstanceWriterHumanReadable::writeServices(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
-    oss_l << writeSectionTitle("Services") << endl;
+void InstanceWriterHumanReadable::writeServices(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
+    writeSectionTitle("Services", tampon_p);
+    tampon_p << '\n';
     int nbServices_l = pContextBO_p->getNbServices();
-    oss_l << writeQuantite(nbServices_l) << endl;
+    writeQuantite(nbServices_l, tampon_p);
+    tampon_p << '\n';
 
     for ( int idxService_l=0 ; idxService_l < nbServices_l ; idxService_l++ ){
         ServiceBO* pService_l = pContextBO_p->getService(idxService_l);
-        oss_l << endl
-            << writeSubTitle("Service", idxService_l, nbServices_l) << endl
-            << writeCarac("SpreadMin", pService_l->getSpreadMin()) << endl
-            << writeListOfCaracs("Dependances", pService_l->getServicesIDependOn()) << endl;
+        tampon_p << '\n';
+        writeSubTitle("Service", idxService_l, nbServices_l, tampon_p);
+        writeCarac("SpreadMin", pService_l->getSpreadMin(), tampon_p);
+        writeListOfCaracs("Dependances", pService_l->getServicesIDependOn(), tampon_p);
     }
 
-    oss_l << endl;
-    return oss_l.str();
+    tampon_p << '\n';
 }
 
-string InstanceWriterHumanReadable::writeProcesses(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
-    oss_l << writeSectionTitle("Processes") << endl;
+void InstanceWriterHumanReadable::writeProcesses(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
+    writeSectionTitle("Processes", tampon_p);
+    tampon_p << '\n';
     int nbProcesses_l = pContextBO_p->getNbProcesses();
-    oss_l << writeQuantite(nbProcesses_l) << endl;
+    writeQuantite(nbProcesses_l, tampon_p);
+    tampon_p << '\n';
 
     for ( int idxP_l=0 ; idxP_l < nbProcesses_l ; idxP_l++ ){
         ProcessBO* pProcess_l = pContextBO_p->getProcess(idxP_l);
-        oss_l << endl
-            << writeSubTitle("Process", idxP_l, nbProcesses_l) << endl
-            << writeCarac("Service", pProcess_l->getService()->getId()) << endl
-            << writeListOfCaracs("RessourcesRequises", pProcess_l->getRequirements()) << endl
-            << writeCarac("PMC", pProcess_l->getPMC()) << endl;
+        tampon_p << '\n';
+        writeSubTitle("Process", idxP_l, nbProcesses_l, tampon_p);
+        writeCarac("Service", pProcess_l->getService()->getId(), tampon_p);
+        writeListOfCaracs("RessourcesRequises", pProcess_l->getRequirements(), tampon_p);
+        writeCarac("PMC", pProcess_l->getPMC(), tampon_p);
     }
 
-    oss_l << endl;
-    return oss_l.str();
+    tampon_p << '\n';
 }
 
-string InstanceWriterHumanReadable::writeBalanceCost(ContextBO const * pContextBO_p){
-    ostringstream  oss_l;
-    oss_l << writeSectionTitle("BalanceCosts") << endl;
+void InstanceWriterHumanReadable::writeBalanceCost(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
+    writeSectionTitle("BalanceCosts", tampon_p);
+    tampon_p << '\n';
     int nbBC_l = pContextBO_p->getNbBalanceCosts();
-    oss_l << writeQuantite(nbBC_l) << endl;
+    writeQuantite(nbBC_l, tampon_p);
+    tampon_p << '\n';
 
     for ( int idxBC_l=0 ; idxBC_l < nbBC_l ; idxBC_l++ ){
         BalanceCostBO* pBC_l = pContextBO_p->getBalanceCost(idxBC_l);
-        oss_l << endl
-            << writeSubTitle("BalanceCost", idxBC_l, nbBC_l) << endl
-            << writeCarac("Ress1", pBC_l->getRessource1()->getId()) << endl
-            << writeCarac("Ress2", pBC_l->getRessource2()->getId()) << endl
-            << writeCarac("Target", pBC_l->getTarget()) << endl
-            << writeCarac("Poids", pBC_l->getPoids()) << endl; 
+        tampon_p << '\n';
+        writeSubTitle("BalanceCost", idxBC_l, nbBC_l, tampon_p);
+        writeCarac("Ress1", pBC_l->getRessource1()->getId(), tampon_p);
+        writeCarac("Ress2", pBC_l->getRessource2()->getId(), tampon_p);
+        writeCarac("Target", pBC_l->getTarget(), tampon_p);
+        writeCarac("Poids", pBC_l->getPoids(), tampon_p);
     }
 
-    oss_l << endl;
-    return oss_l.str();
-}
-
-string InstanceWriterHumanReadable::writePoids(ContextBO const * pContextBO_p){
-    ostringstream oss_l;
-    oss_l << writeSectionTitle("Poids") << endl
-        << writeCarac("PMC", pContextBO_p->getPoidsPMC()) << endl
-        << writeCarac("SMC", pContextBO_p->getPoidsSMC()) << endl
-        << writeCarac("MMC", pContextBO_p->getPoidsMMC()) << endl
-        << endl;
-    return oss_l.str();
+    tampon_p << '\n';
 }
 
-string InstanceWriterHumanReadable::writeTitle(const string& titre_p, int level_p){
-    ostringstream oss_l;
-    for ( int idx_l=0 ; idx_l < level_p ; idx_l++ ){
-        oss_l << "=";
-    }
-    ostringstream result_l;
-    result_l << oss_l.str() << " " << titre_p << " " << oss_l.str();
-    return result_l.str();
+void InstanceWriterHumanReadable::writePoids(ContextBO const * pContextBO_p, TamponSortie& tampon_p){
+    writeSectionTitle("Poids", tampon_p);
+    tampon_p << '\n';
+    writeCarac("PMC", pContextBO_p->getPoidsPMC(), tampon_p);
+    writeCarac("SMC", pContextBO_p->getPoidsSMC(), tampon_p);
+    writeCarac("MMC", pContextBO_p->getPoidsMMC(), tampon_p);
+    tampon_p << '\n';
 }
 
-string InstanceWriterHumanReadable::writeSubTitle(const string& typeEntite_p, int idx_p, int nbTotal_p){
-    ostringstream oss_l;
-    oss_l << typeEntite_p << " " << idx_p << " / " << nbTotal_p;
-    return writeTitle(oss_l.str(), 4);
+/*
+ * Nb : writeTitle et writeQuantite ne terminent pas leur ligne, contrairement aux sous-titres et aux caracteristiques
+ */
+void InstanceWriterHumanReadable::writeTitle(const string& titre_p, int level_p, TamponSortie& tampon_p){
+    writeBarre(level_p, tampon_p);
+    tampon_p << ' ' << titre_p << ' ';
+    writeBarre(level_p, tampon_p);
 }
 
-string InstanceWriterHumanReadable::writeCarac(const string& caracName_p, int carac_p){
-    ostringstream oss_l;
-    oss_l << "  * " << caracName_p << " : " << carac_p;
-    return oss_l.str();
+void InstanceWriterHumanReadable::writeSubTitle(const string& typeEntite_p, int idx_p, int nbTotal_p, TamponSortie& tampon_p){
+    writeBarre(4, tampon_p);
+    tampon_p << ' ' << typeEntite_p << ' ' << idx_p << " / " << nbTotal_p << ' ';
+    writeBarre(4, tampon_p);
+    tampon_p << '\n';
 }
 
-string InstanceWriterHumanReadable::writeListOfCaracs(const string& caracsName_p, const vector<int>& caracs_p){
-    ostringstream oss_l;
-    oss_l << "  * " << caracsName_p << " :";
-    BOOST_FOREACH(int carac_l, caracs_p){
-        oss_l << " " << carac_l;
-    }
-    return oss_l.str();
+void InstanceWriterHumanReadable::writeCarac(const string& caracName_p, int carac_p, TamponSortie& tampon_p){
+    tampon_p << "  * " << caracName_p << " : " << carac_p << '\n';
 }
 
-string InstanceWriterHumanReadable::writeListOfCaracs(const string& caracsName_p, const unordered_set<int>& caracs_p){
-    //FIXME : duplication de code avec la methode eponyme...
-    ostringstream oss_l;
-    oss_l << "  * " << caracsName_p << " :";
+void InstanceWriterHumanReadable::writeListOfCaracs(const string& caracsName_p, const vector<int>& caracs_p, TamponSortie& tampon_p){
+    tampon_p << "  * " << caracsName_p << " :";
     BOOST_FOREACH(int carac_l, caracs_p){
-        oss_l << " " << carac_l;
+        tampon_p << ' ' << carac_l;
     }
-    return oss_l.str();
+    tampon_p << '\n';
 }
 
-string InstanceWriterHumanReadable::writeMajorTitle(const string& title_p){
-    return writeTitle(title_p, 6);
+void InstanceWriterHumanReadable::writeMajorTitle(const string& title_p, TamponSortie& tampon_p){
+    writeTitle(title_p, 6, tampon_p);
 }
 
-string InstanceWriterHumanReadable::writeSectionTitle(const string& title_p){
-    return writeTitle(title_p, 5);
+void InstanceWriterHumanReadable::writeSectionTitle(const string& title_p, TamponSortie& tampon_p){
+    writeTitle(title_p, 5, tampon_p);
 }
 
-string InstanceWriterHumanReadable::writeQuantite(int quantite_p){
-    ostringstream oss_l;
-    oss_l << "quantite : " << quantite_p;
-    return oss_l.str();
+void InstanceWriterHumanReadable::writeQuantite(int quantite_p, TamponSortie& tampon_p){
+    tampon_p << "quantite : " << quantite_p;
 }
@@ -22,26 +22,26 @@
  */
 
 #include "dtoout/InstanceWriterInterface.hh"
-#include <fstream>
-#include <sstream>
+#include "dtoout/TamponSortie.hh"
 
 InstanceWriterInterface::~InstanceWriterInterface(){}
 
 void InstanceWriterInterface::write(ContextBO const * pContextBO_p, const string& out_filename_p){
-    ofstream ofs_p(out_filename_p.c_str());
-    if ( ! ofs_p ){
-        ostringstream oss_l;
-        oss_l << "Impossible de dumper l'instance dans le fichier " << out_filename_p << endl;
-        throw oss_l.str();
-    }
-
-    write(pContextBO_p, ofs_p);
+    TamponSortie tampon_l(out_filename_p);
+    writeOnTampon(pContextBO_p, tampon_l);
+    tampon_l.termine();
 }
 
 void InstanceWriterInterface::write(ContextBO const * pContextBO_p, ostream& os_p){
-    os_p << write(pContextBO_p);
+    TamponSortie tampon_l(os_p);
+    writeOnTampon(pContextBO_p, tampon_l);
+    tampon_l.termine();
 }
 
 string InstanceWriterInterface::write(ContextBO const * pContextBO_p){
-    return writeOnString(pContextBO_p);
+    string result_l;
+    TamponSortie tampon_l(result_l);
+    writeOnTampon(pContextBO_p, tampon_l);
+    tampon_l.termine();
+    return result_l;
 }
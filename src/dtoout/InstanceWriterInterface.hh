@@ -27,7 +27,12 @@
 using namespace std;
 
 class ContextBO;
+class TamponSortie;
 
+/**
+ * Les writers ecrivent au fil de l'eau dans un #TamponSortie : ecrire une instance dans un fichier
+ * ne demande pas de la construire en memoire au prealable
+ */
 class InstanceWriterInterface {
     public:
         virtual ~InstanceWriterInterface() = 0;
@@ -44,12 +49,11 @@ class InstanceWriterInterface {
 
         /**
          * Ecrit sur une string
-         * Wrapper de writeOnString afin d'eviter une forme de shadowing
          */
         string write(ContextBO const * pContextBO_p);
 
     protected:
-        virtual string writeOnString(ContextBO const * pContextBO_p) = 0;
+        virtual void writeOnTampon(ContextBO const * pContextBO_p, TamponSortie& tampon_p) = 0;
 };
 
 #endif
@@ -22,20 +22,32 @@
  */
 
 #include "dtoout/SolutionDtoout.hh"
+#include "dtoout/TamponSortie.hh"
 #include "alg/ContextALG.hh"
 #include "bo/ContextBO.hh"
 #include "bo/MachineBO.hh"
 #include "bo/ProcessBO.hh"
+#include "tools/Log.hh"
+#include "tools/MeilleureSolution.hh"
 #include <fstream>
 #include <sstream>
 #include <boost/foreach.hpp>
+#include <boost/thread.hpp>
+#include <cstdio>
 #include <limits>
+#include <sys/stat.h>
+#include <unistd.h>
 using namespace std;
 
 string SolutionDtoout::outFileName_m;
 pthread_mutex_t SolutionDtoout::mutex_m = PTHREAD_MUTEX_INITIALIZER;
-uint64_t SolutionDtoout::bestScoreWritten_m = numeric_limits<uint64_t>::max();
-vector<int> SolutionDtoout::bestSol_m;
+vector<char> SolutionDtoout::memoireTampon_m;
+uint64_t SolutionDtoout::versionEcrite_m = 0;
+boost::thread* SolutionDtoout::pEcrivain_m = 0;
+sem_t SolutionDtoout::semEcrivain_m;
+bool SolutionDtoout::isSemEcrivainInit_m = false;
+bool SolutionDtoout::isArretEcrivain_m = false;
+int SolutionDtoout::isAsynchrone_m = 0;
 
 void SolutionDtoout::setOutFileName(const string& outFileName_p){
     outFileName_m = outFileName_p;
@@ -60,52 +72,198 @@ void SolutionDtoout::writeSolInit(ContextBO* pContextBO_p, const string& outFile
 }
 
 bool SolutionDtoout::writeSol(const vector<int>& vSol_p, uint64_t score_p){
-    //Vu qu'on n'est pas cense passer souvent ici, on lock en global
+    //Cas le plus frequent : la solution ne bat pas la meilleure, pas besoin du verrou
+    if ( score_p >= getBestScore() ){
+        return false;
+    }
+
+    //Avec l'ecrivain : pas de verrou ni d'entree/sortie, la solution est seulement publiee
+    if ( __sync_fetch_and_add(&isAsynchrone_m, 0) ){
+        if ( ! MeilleureSolution::publie(vSol_p, score_p) ){
+            return false;
+        }
+        sem_post(&semEcrivain_m);
+        //L'ecrivain a pu etre arrete depuis le test : la solution n'est alors ecrite ni par lui, ni forcement
+        //par termineEcriture (cf #arreteEcrivain, qui baisse le drapeau avant de relire la version)
+        if ( ! __sync_fetch_and_add(&isAsynchrone_m, 0) ){
+            pthread_mutex_lock(&mutex_m);
+            try {
+                ecrisMeilleure();
+            } catch (...) {
+                pthread_mutex_unlock(&mutex_m);
+                throw;
+            }
+            pthread_mutex_unlock(&mutex_m);
+        }
+        return true;
+    }
+
     pthread_mutex_lock(&mutex_m);
     try {
-        if (score_p >= bestScoreWritten_m) {
+        //Les publications synchrones passent toutes par ici, sous le verrou : le score ne peut pas changer d'ici la publication
+        if (score_p >= getBestScore()) {
             pthread_mutex_unlock(&mutex_m);
             return false;
         }
 
-        ofstream ofs_l(outFileName_m.c_str());
-        if ( ! ofs_l ){
-            ostringstream oss_l;
-            oss_l << "Impossible d'ouvrir le flux de sortie " << outFileName_m
-                << " pour y ecrire une solution" << endl;
-            throw oss_l.str();
+        //Sans ecrivain, la solution n'est retenue que si elle a pu etre ecrite
+        ecrisFichier(vSol_p, outFileName_m);
+        MeilleureSolution::publie(vSol_p, score_p);
+        versionEcrite_m = MeilleureSolution::getVersion();
+    } catch (...) {
+        pthread_mutex_unlock(&mutex_m);
+        throw;
+    }
+    pthread_mutex_unlock(&mutex_m);
+    return true;
+}
+
+void SolutionDtoout::demarreEcrivain(){
+    pthread_mutex_lock(&mutex_m);
+    if ( ! pEcrivain_m ){
+        if ( ! isSemEcrivainInit_m ){
+            sem_init(&semEcrivain_m, 0, 0);
+            isSemEcrivainInit_m = true;
         }
+        isArretEcrivain_m = false;
+        pEcrivain_m = new boost::thread(&SolutionDtoout::ecrivain);
+        __sync_lock_test_and_set(&isAsynchrone_m, 1);
+    }
+    pthread_mutex_unlock(&mutex_m);
+}
 
-        copy(vSol_p.begin(), vSol_p.end(), ostream_iterator<int>(ofs_l, " "));
-        bestScoreWritten_m = score_p;
-        bestSol_m = vSol_p;
-    } catch (string exc) {
-        pthread_mutex_unlock(&mutex_m);
-        throw exc;
-    } catch (std::exception exc) {
+void SolutionDtoout::termineEcriture(){
+    arreteEcrivain();
+
+    //L'ecrivain est arrete : les ecritures sont de nouveau synchrones, sous le verrou
+    pthread_mutex_lock(&mutex_m);
+    try {
+        ecrisMeilleure();
+    } catch (...) {
         pthread_mutex_unlock(&mutex_m);
-        throw exc;
+        throw;
+    }
+    pthread_mutex_unlock(&mutex_m);
+}
+
+void SolutionDtoout::restaure(const vector<int>& vSol_p){
+    arreteEcrivain();
+
+    //La meilleure solution est consideree comme ecrite : plus personne ne l'ecrira
+    pthread_mutex_lock(&mutex_m);
+    versionEcrite_m = MeilleureSolution::getVersion();
+    try {
+        if ( ! vSol_p.empty() ){
+            ecrisFichier(vSol_p, outFileName_m);
+        }
     } catch (...) {
         pthread_mutex_unlock(&mutex_m);
-        throw string("Une exception a ete levee lors de l'ecriture d'une solution");
+        throw;
     }
     pthread_mutex_unlock(&mutex_m);
-    return true;
+}
+
+void SolutionDtoout::arreteEcrivain(){
+    pthread_mutex_lock(&mutex_m);
+    boost::thread* pEcrivain_l = pEcrivain_m;
+    __sync_lock_test_and_set(&isAsynchrone_m, 0);
+    __sync_synchronize();
+    isArretEcrivain_m = true;
+    pthread_mutex_unlock(&mutex_m);
+    if ( pEcrivain_l ){
+        sem_post(&semEcrivain_m);
+        pEcrivain_l->join();
+    }
+
+    pthread_mutex_lock(&mutex_m);
+    pEcrivain_m = 0;
+    pthread_mutex_unlock(&mutex_m);
+    delete pEcrivain_l;
+}
+
+void SolutionDtoout::ecrivain(){
+    bool isArret_l = false;
+    while ( ! isArret_l ){
+        while ( sem_wait(&semEcrivain_m) != 0 ){
+            //Interrompu par un signal : on se remet en attente
+        }
+        //Les publications arrivees pendant l'ecriture precedente sont fusionnees : seule la derniere est ecrite
+        while ( sem_trywait(&semEcrivain_m) == 0 ){
+        }
+
+        //Le verrou n'est dispute qu'avec termineEcriture et les ecritures synchrones, pas avec writeSol
+        pthread_mutex_lock(&mutex_m);
+        isArret_l = isArretEcrivain_m;
+        try {
+            ecrisMeilleure();
+        } catch (string s_l){
+            //Un echec n'est retente qu'a la solution suivante (ou par termineEcriture)
+            LOG(ERREUR) << s_l << endl;
+        }
+        pthread_mutex_unlock(&mutex_m);
+    }
+}
+
+void SolutionDtoout::ecrisMeilleure(){
+    const MeilleureSolution::InstantanePtr pBest_l = MeilleureSolution::getInstantane();
+    if ( pBest_l && versionEcrite_m != pBest_l->version ){
+        ecrisFichier(pBest_l->sol, outFileName_m);
+        versionEcrite_m = pBest_l->version;
+    }
+}
+
+void SolutionDtoout::ecrisFichier(const vector<int>& vSol_p, const string& nomFichier_p){
+    //Un fichier temporaire n'a de sens que pour un fichier regulier (on ne remplace pas /dev/null...)
+    struct stat stat_l;
+    const bool isSpecial_l = stat(nomFichier_p.c_str(), &stat_l) == 0 && ! S_ISREG(stat_l.st_mode);
+    const string nomTemporaire_l = isSpecial_l ? nomFichier_p : nomFichier_p + ".tmp";
+
+    try {
+        //Meme format qu'un ostream_iterator<int>(os, " ")
+        TamponSortie tampon_l(nomTemporaire_l, memoireTampon_m);
+        BOOST_FOREACH(int valeur_l, vSol_p){
+            tampon_l << valeur_l << ' ';
+        }
+        if ( ! isSpecial_l ){
+            tampon_l.synchronise();
+        }
+        tampon_l.termine();
+    } catch (string s_l) {
+        if ( ! isSpecial_l ){
+            unlink(nomTemporaire_l.c_str());
+        }
+        throw s_l;
+    }
+
+    if ( ! isSpecial_l && rename(nomTemporaire_l.c_str(), nomFichier_p.c_str()) != 0 ){
+        unlink(nomTemporaire_l.c_str());
+        ostringstream oss_l;
+        oss_l << "Erreur lors de l'ecriture de la solution dans " << nomFichier_p << endl;
+        throw oss_l.str();
+    }
 }
 
 uint64_t SolutionDtoout::getBestScore(){
-    return bestScoreWritten_m;
+    return MeilleureSolution::getScore();
 }
 
-const vector<int>& SolutionDtoout::getBestSol(){
-    return bestSol_m;
+vector<int> SolutionDtoout::getBestSol(){
+    const MeilleureSolution::InstantanePtr pBest_l = MeilleureSolution::getInstantane();
+    return pBest_l ? pBest_l->sol : vector<int>();
 }
 
 #ifdef UTEST
 void SolutionDtoout::reinit(const string& outfile_p){
+    //La meilleure solution est oubliee avant d'arreter l'ecrivain : il n'a plus rien a ecrire,
+    //et rien n'est ecrit sur l'ancien fichier (que le test precedent a pu rendre inaccessible)
+    pthread_mutex_lock(&mutex_m);
+    MeilleureSolution::reinit();
+    versionEcrite_m = MeilleureSolution::getVersion();
+    pthread_mutex_unlock(&mutex_m);
+    arreteEcrivain();
+
+    pthread_mutex_lock(&mutex_m);
     outFileName_m = outfile_p;
     pthread_mutex_unlock(&mutex_m);
-    bestScoreWritten_m = numeric_limits<uint64_t>::max();
-    bestSol_m.clear();
 }
-#endif
+#endif
\ No newline at end of file
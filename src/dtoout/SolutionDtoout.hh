@@ -27,17 +27,27 @@
 #include <string>
 #include <vector>
 #include <pthread.h>
+#include <semaphore.h>
 #include <stdint.h>
 using namespace std;
 
 class ContextBO;
 class ContextALG;
+namespace boost {
+    class thread;
+}
 
 /**
  * Classe en charge de l'ecriture de la meilleure solution
  *
- * Cette classe assure aussi la gestion de la memorisation du meilleur score/solution
+ * Cette classe alimente aussi la #MeilleureSolution partagee par les threads de recherche
  * Ces donnees sont initialisees sur la solution initiale. L'initialisation est assuree par le main
+ *
+ * Par defaut l'ecriture est synchrone. Une fois #demarreEcrivain() appele, les threads de recherche ne font
+ * que publier la solution (sans verrou ni allocation, cf MeilleureSolution::publie) et reveiller un thread
+ * dedie, qui ecrit la derniere connue (les ameliorations arrivees pendant une ecriture sont fusionnees),
+ * dans un fichier temporaire renomme une fois synchronise sur disque.
+ * Le fichier de sortie contient donc toujours une solution complete
  */
 class SolutionDtoout {
     public: /**
@@ -53,41 +63,111 @@ class SolutionDtoout {
 
         /**
          * Ecrit la solution, si elle bat la meilleure connue jusque la
+         * (si l'ecrivain tourne, elle est seulement memorisee et lui est confiee)
          * @param vSol_p La solution a ecrire
          * @param score_p Le score de la solution (aucune verification n'est faite !)
-         * @return TRUE si la solution a ete ecrite
+         * @return TRUE si la solution est la nouvelle meilleure
          */
         static bool writeSol(const vector<int>& vSol_p, uint64_t score_p);
 
+        /**
+         * Lance le thread d'ecriture : les appels suivants a #writeSol ne font plus d'entree/sortie
+         */
+        static void demarreEcrivain();
+
+        /**
+         * Arrete le thread d'ecriture (apres qu'il a ecrit la derniere solution qu'on lui a confiee),
+         * et ecrit de maniere synchrone la meilleure solution si elle ne l'a pas ete.
+         * Les ecritures suivantes sont de nouveau synchrones.
+         * A appeler a l'echeance, avant de rendre la main
+         */
+        static void termineEcriture();
+
+        /**
+         * Comme #termineEcriture, mais la meilleure solution (jugee incoherente par l'appelant) n'est pas ecrite :
+         * vSol_p, solution deja verifiee, est ecrite a sa place (rien n'est ecrit si elle est vide)
+         */
+        static void restaure(const vector<int>& vSol_p);
+
+        /**
+         * Raccourci pour MeilleureSolution::getScore() (lecture sans verrou)
+         */
         static uint64_t getBestScore();
 
         /**
-         * Retourne la meilleure solution trouvee jusque la (de score #getBestScore())
+         * Retourne une copie de la meilleure solution trouvee jusque la (de score #getBestScore())
          * Si aucune ecriture n'a eu lieu, retoune un vecteur vide (et le best score est "infini")
          * Le main est cense assurer cette premiere ecriture, sur la sol init, donc
          * les classes appellantes ne devraient pas se soucier de ce point
+         * (pour eviter la copie : MeilleureSolution::getInstantane())
          */
-        static const vector<int>& getBestSol();
+        static vector<int> getBestSol();
 
 #ifdef UTEST
+        /**
+         * Oublie la meilleure solution, arrete l'ecrivain sans rien ecrire, puis change de fichier de sortie
+         */
         static void reinit(const string& outfile_p);
 #endif
 
     private:
+        /**
+         * Ecrit la solution dans un fichier temporaire, le synchronise et le renomme en nomFichier_p
+         * (les fichiers speciaux, type /dev/null, sont ecrits directement). Sous #mutex_m
+         */
+        static void ecrisFichier(const vector<int>& vSol_p, const string& nomFichier_p);
+
+        /**
+         * Arrete le thread d'ecriture (apres qu'il a ecrit la derniere solution qu'on lui a confiee), sans rien ecrire d'autre
+         */
+        static void arreteEcrivain();
+
+        /**
+         * Ecrit la meilleure solution si elle ne l'a pas deja ete (sous #mutex_m)
+         */
+        static void ecrisMeilleure();
+
+        /**
+         * Boucle du thread d'ecriture
+         */
+        static void ecrivain();
+
         /**
          * Fichier sur lequel la solution doit etre ecrite
          */
         static string outFileName_m;
 
         /**
-         * Score de la meilleure solution ecrite
+         * Tampon de #ecrisFichier, garde d'une ecriture a l'autre (sous #mutex_m, comme toutes les ecritures)
+         */
+        static vector<char> memoireTampon_m;
+
+        /**
+         * Version (cf MeilleureSolution) de la derniere solution ecrite sur disque (sous #mutex_m)
          */
-        static uint64_t bestScoreWritten_m;
+        static uint64_t versionEcrite_m;
 
-        static vector<int> bestSol_m;
+        /**
+         * Thread d'ecriture (0 si l'ecriture est synchrone) et sa demande d'arret (sous #mutex_m)
+         */
+        static boost::thread* pEcrivain_m;
+        static bool isArretEcrivain_m;
+
+        /**
+         * Reveil du thread d'ecriture : un sem_post par publication, sans verrou
+         * (initialise au premier #demarreEcrivain, jamais detruit)
+         */
+        static sem_t semEcrivain_m;
+        static bool isSemEcrivainInit_m;
+
+        /**
+         * 1 tant que l'ecrivain tourne ; lu sans verrou par #writeSol
+         */
+        static int isAsynchrone_m;
 
         /**
          * Mutex utilise pour garantir qu'on ecrira pas deux solution en meme temps
+         * (ecritures synchrones et thread d'ecriture ; les publications asynchrones ne le prennent pas)
          * 
          * Nb : cas un peu plus sioux que juste l'ecriture simultanee dans le fichier (que l'on gere aussi) :
          * - le meilleur score est 1000
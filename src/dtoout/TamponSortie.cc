@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "dtoout/TamponSortie.hh"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+namespace {
+    /**
+     * Taille du tampon : assez pour que les appels systeme soient negligeables
+     */
+    const size_t TAILLE_TAMPON = 1 << 20;
+
+    /**
+     * Un int s'ecrit avec au plus 11 caracteres (signe compris)
+     */
+    const size_t TAILLE_MAX_ENTIER = 11;
+}
+
+TamponSortie::TamponSortie(const string& filename_p) :
+    bufferPropre_m(TAILLE_TAMPON),
+    buffer_m(bufferPropre_m),
+    taille_m(0),
+    nomFichier_m(filename_p),
+    fd_m(open(filename_p.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+    pOs_m(0),
+    pString_m(0)
+{
+    if ( fd_m < 0 ){
+        ostringstream oss_l;
+        oss_l << "Impossible d'ouvrir le fichier " << filename_p << " en ecriture" << endl;
+        throw oss_l.str();
+    }
+}
+
+TamponSortie::TamponSortie(const string& filename_p, vector<char>& memoire_p) :
+    buffer_m(memoire_p),
+    taille_m(0),
+    nomFichier_m(filename_p),
+    fd_m(open(filename_p.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+    pOs_m(0),
+    pString_m(0)
+{
+    if ( fd_m < 0 ){
+        ostringstream oss_l;
+        oss_l << "Impossible d'ouvrir le fichier " << filename_p << " en ecriture" << endl;
+        throw oss_l.str();
+    }
+    if ( buffer_m.size() < TAILLE_TAMPON ){
+        buffer_m.resize(TAILLE_TAMPON);
+    }
+}
+
+TamponSortie::TamponSortie(ostream& os_p) :
+    bufferPropre_m(TAILLE_TAMPON),
+    buffer_m(bufferPropre_m),
+    taille_m(0),
+    fd_m(-1),
+    pOs_m(&os_p),
+    pString_m(0)
+{}
+
+TamponSortie::TamponSortie(string& out_p) :
+    bufferPropre_m(TAILLE_TAMPON),
+    buffer_m(bufferPropre_m),
+    taille_m(0),
+    fd_m(-1),
+    pOs_m(0),
+    pString_m(&out_p)
+{}
+
+TamponSortie::~TamponSortie(){
+    if ( fd_m >= 0 ){
+        close(fd_m);
+    }
+}
+
+TamponSortie& TamponSortie::operator<<(int valeur_p){
+    if ( taille_m + TAILLE_MAX_ENTIER > buffer_m.size() ){
+        vide();
+    }
+    //Chiffres ecrits de droite a gauche dans un tampon local, puis recopies
+    char chiffres_l[TAILLE_MAX_ENTIER];
+    char* const pFin_l = chiffres_l + TAILLE_MAX_ENTIER;
+    char* p_l = pFin_l;
+    unsigned int reste_l = valeur_p < 0 ? -static_cast<unsigned int>(valeur_p) : valeur_p;
+    do {
+        *--p_l = '0' + reste_l % 10;
+        reste_l /= 10;
+    } while ( reste_l );
+    if ( valeur_p < 0 ){
+        *--p_l = '-';
+    }
+    memcpy(&buffer_m[taille_m], p_l, pFin_l - p_l);
+    taille_m += pFin_l - p_l;
+    return *this;
+}
+
+TamponSortie& TamponSortie::operator<<(char c_p){
+    if ( taille_m == buffer_m.size() ){
+        vide();
+    }
+    buffer_m[taille_m++] = c_p;
+    return *this;
+}
+
+TamponSortie& TamponSortie::operator<<(const char* texte_p){
+    ajoute(texte_p, strlen(texte_p));
+    return *this;
+}
+
+TamponSortie& TamponSortie::operator<<(const string& texte_p){
+    ajoute(texte_p.data(), texte_p.size());
+    return *this;
+}
+
+void TamponSortie::ajoute(const char* pTexte_p, size_t taille_p){
+    while ( taille_p > 0 ){
+        if ( taille_m == buffer_m.size() ){
+            vide();
+        }
+        const size_t nb_l = min(taille_p, buffer_m.size() - taille_m);
+        memcpy(&buffer_m[taille_m], pTexte_p, nb_l);
+        taille_m += nb_l;
+        pTexte_p += nb_l;
+        taille_p -= nb_l;
+    }
+}
+
+void TamponSortie::vide(){
+    if ( pString_m ){
+        pString_m->append(&buffer_m[0], taille_m);
+    } else if ( pOs_m ){
+        pOs_m->write(&buffer_m[0], taille_m);
+    } else {
+        for ( size_t ecrits_l=0 ; ecrits_l < taille_m ; ){
+            const ssize_t nb_l = ::write(fd_m, &buffer_m[ecrits_l], taille_m - ecrits_l);
+            if ( nb_l <= 0 ){
+                ostringstream oss_l;
+                oss_l << "Erreur lors de l'ecriture dans le fichier " << nomFichier_m << endl;
+                throw oss_l.str();
+            }
+            ecrits_l += nb_l;
+        }
+    }
+    taille_m = 0;
+}
+
+void TamponSortie::synchronise(){
+    vide();
+    if ( fd_m >= 0 && fsync(fd_m) != 0 ){
+        ostringstream oss_l;
+        oss_l << "Erreur lors de la synchronisation du fichier " << nomFichier_m << endl;
+        throw oss_l.str();
+    }
+}
+
+void TamponSortie::termine(){
+    vide();
+    if ( fd_m >= 0 ){
+        const int fd_l = fd_m;
+        fd_m = -1;
+        if ( close(fd_l) != 0 ){
+            ostringstream oss_l;
+            oss_l << "Erreur lors de l'ecriture dans le fichier " << nomFichier_m << endl;
+            throw oss_l.str();
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef TAMPONSORTIE_HH
+#define TAMPONSORTIE_HH
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * Tampon d'ecriture pour les writers d'instance et de solution : les entiers sont formates directement dans un
+ * grand tampon reutilise, vide sur la destination des qu'il est plein. La memoire utilisee ne
+ * depend donc pas de la taille du fichier produit (sauf si la destination est une string).
+ *
+ * Attention : #termine doit etre appele pour que la fin du tampon soit ecrite
+ * (le destructeur ne vide pas : il ne doit pas lever d'exception)
+ */
+class TamponSortie {
+    public:
+        /**
+         * Ecrit dans le fichier (cree ou tronque), par appels directs a write(2)
+         */
+        explicit TamponSortie(const string& filename_p);
+
+        /**
+         * Idem, mais le tampon est memoire_p (agrandi si besoin), que l'appelant garde d'une ecriture a
+         * l'autre pour ne pas reallouer le tampon a chaque fichier. Un seul TamponSortie a la fois par memoire
+         */
+        TamponSortie(const string& filename_p, vector<char>& memoire_p);
+        explicit TamponSortie(ostream& os_p);
+
+        /**
+         * Ajoute le texte a out_p
+         */
+        explicit TamponSortie(string& out_p);
+
+        ~TamponSortie();
+
+        TamponSortie& operator<<(int valeur_p);
+        TamponSortie& operator<<(char c_p);
+        TamponSortie& operator<<(const char* texte_p);
+        TamponSortie& operator<<(const string& texte_p);
+
+        /**
+         * Ajoute taille_p octets bruts (writers binaires)
+         */
+        void ajoute(const char* pTexte_p, size_t taille_p);
+
+        /**
+         * Vide le tampon et force l'ecriture du fichier sur disque (fsync) ; sans effet sur un flux ou une string
+         * (leve une exception en cas d'erreur d'ecriture)
+         */
+        void synchronise();
+
+        /**
+         * Vide le tampon et ferme le fichier (leve une exception en cas d'erreur d'ecriture)
+         */
+        void termine();
+
+    private:
+        TamponSortie(const TamponSortie&);
+        TamponSortie& operator=(const TamponSortie&);
+
+        /**
+         * Ecrit le contenu du tampon sur la destination
+         */
+        void vide();
+
+        /**
+         * Tampon utilise : bufferPropre_m, ou la memoire fournie par l'appelant
+         */
+        vector<char> bufferPropre_m;
+        vector<char>& buffer_m;
+        size_t taille_m;
+
+        /**
+         * Destination : un fichier (fd_m >= 0), un flux ou une string
+         */
+        string nomFichier_m;
+        int fd_m;
+        ostream* pOs_m;
+        string* pString_m;
+};
+
+#endif
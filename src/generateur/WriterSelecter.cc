@@ -22,6 +22,7 @@
  */
 
 #include "generateur/WriterSelecter.hh"
+#include "dtoout/InstanceWriterBinaire.hh"
 #include "dtoout/InstanceWriterDtoout.hh"
 #include "dtoout/InstanceWriterHumanReadable.hh"
 #include "tools/Log.hh"
@@ -32,6 +33,9 @@ shared_ptr<InstanceWriterInterface> WriterSelecter::getWriter(const string& writ
     if ( writer_p == "human" ){
         LOG(DEBUG) << "Ecriture de l'instance via un 'human readable writer'" << endl;
         result_l = shared_ptr<InstanceWriterInterface>(new InstanceWriterHumanReadable);
+    } else if ( writer_p == "binaire" ){
+        LOG(DEBUG) << "Ecriture de l'instance au format binaire" << endl;
+        result_l = shared_ptr<InstanceWriterInterface>(new InstanceWriterBinaire);
     } else {
         LOG(DEBUG) << "Ecriture de l'instance via le writer officiel (choix par defaut)" << endl;
     }
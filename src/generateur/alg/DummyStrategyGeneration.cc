@@ -76,7 +76,7 @@ void DummyStrategyGeneration::buildProcesses(shared_ptr<ContextBO> pContextBO_p)
     vector<int> vRequire_l(1, 1);
     ProcessBO* pProcess_l = new ProcessBO(0, pService_l, vRequire_l, 0);
     pContextBO_p->addProcess(pProcess_l);
-    pProcess_l->setMachineInit(pContextBO_p->getMachine(0));
+    pContextBO_p->setMachineInit(0, 0);
 }
 
 void DummyStrategyGeneration::buildBalanceCosts(shared_ptr<ContextBO> pContextBO_p){}
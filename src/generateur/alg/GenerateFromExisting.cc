@@ -23,9 +23,11 @@
 
 #include "generateur/alg/GenerateFromExisting.hh"
 #include "dtoin/InstanceReaderInterface.hh"
+#include "dtoin/InstanceReaderBinaire.hh"
 #include "dtoin/InstanceReaderDtoin.hh"
 #include "dtoin/InstanceReaderHumanReadable.hh"
 #include "dtoin/SolutionDtoin.hh"
+#include "tools/InstanceBinaire.hh"
 #include "tools/Log.hh"
 #include <fstream>
 #include <sstream>
@@ -66,6 +68,9 @@ shared_ptr<InstanceReaderInterface> GenerateFromExisting::getReader(const variab
     }
 
     shared_ptr<InstanceReaderInterface> result_l;
+    if ( InstanceBinaire::isBinaire(filename_l) ){
+        return shared_ptr<InstanceReaderInterface>(new InstanceReaderBinaire);
+    }
 
     char firstChar_l;
     ifs_l >> firstChar_l;
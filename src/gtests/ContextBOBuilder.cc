@@ -29,12 +29,13 @@
 #include "bo/MMCBO.hh"
 #include "bo/NeighborhoodBO.hh"
 #include "bo/ProcessBO.hh"
+#include "bo/RessourceBO.hh"
 #include "bo/ServiceBO.hh"
 
 ProcessBO* ContextBOBuilder::buildProcess(int idP_p, ServiceBO* pService_p, const vector<int>& vRequirements_p, int pmc_p, int idxMachineInit_p, ContextBO* pContextBO_p) {
     ProcessBO* pProcess_l = new ProcessBO(idP_p, pService_p, vRequirements_p, pmc_p);
-    pProcess_l->setMachineInit(pContextBO_p->getMachine(idxMachineInit_p));
     pContextBO_p->addProcess(pProcess_l);
+    pContextBO_p->setMachineInit(pContextBO_p->getNbProcesses() - 1, idxMachineInit_p);
     return pProcess_l;
 }
 
@@ -86,3 +87,198 @@ void ContextBOBuilder::buildDefaultMMC(ContextBO* pContextBO_p){
     const int nbMachine_l = pContextBO_p->getNbMachines();
     pContextBO_p->setMMCBO(new MMCBO(vector<vector<int> >(nbMachine_l, vector<int>(nbMachine_l, 0))));
 }
+
+void ContextBOBuilder::buildInstanceCoreBO(ContextBO* pContextBO_p){
+    pContextBO_p->addRessource(new RessourceBO(0, false, 2));
+    pContextBO_p->addRessource(new RessourceBO(1, true, 3));
+
+    vector<int> capa_l(2, 0);
+    vector<int> safety_l(2, 0);
+    capa_l[0] = 10; capa_l[1] = 20; safety_l[0] = 5; safety_l[1] = 15;
+    ContextBOBuilder::buildMachine(0, 0, 1, capa_l, safety_l, pContextBO_p);
+    capa_l[0] = 30; capa_l[1] = 40; safety_l[0] = 25; safety_l[1] = 35;
+    ContextBOBuilder::buildMachine(1, 1, 0, capa_l, safety_l, pContextBO_p);
+
+    ServiceBO* pService0_l = ContextBOBuilder::buildService(0, 2, unordered_set<int>(), pContextBO_p);
+    unordered_set<int> dependances_l;
+    dependances_l.insert(0);
+    ServiceBO* pService1_l = ContextBOBuilder::buildService(1, 1, dependances_l, pContextBO_p);
+    vector<int> req_l(2, 0);
+    req_l[0] = 1; req_l[1] = 2;
+    ContextBOBuilder::buildProcess(0, pService0_l, req_l, 7, 1, pContextBO_p);
+    req_l[0] = 3; req_l[1] = 4;
+    ContextBOBuilder::buildProcess(1, pService1_l, req_l, 8, 0, pContextBO_p);
+    req_l[0] = 5; req_l[1] = 6;
+    ContextBOBuilder::buildProcess(2, pService0_l, req_l, 9, 1, pContextBO_p);
+
+    ContextBOBuilder::buildBalanceCost(0, 1, 2, 11, pContextBO_p);
+    ContextBOBuilder::buildDefaultMMC(pContextBO_p);
+}
+
+void ContextBOBuilder::buildInstanceEvaluator(ContextBO* pContextBO_p){
+    pContextBO_p->addRessource(new RessourceBO(0, true, 3));
+    pContextBO_p->addRessource(new RessourceBO(1, false, 5));
+
+    vector<int> capas_l; capas_l.push_back(20); capas_l.push_back(20);
+    vector<int> scM0_l; scM0_l.push_back(8); scM0_l.push_back(6);
+    vector<int> scM1_l; scM1_l.push_back(4); scM1_l.push_back(10);
+    vector<int> scM2_l; scM2_l.push_back(10); scM2_l.push_back(2);
+    ContextBOBuilder::buildMachine(0, 0, 0, capas_l, scM0_l, pContextBO_p);
+    ContextBOBuilder::buildMachine(1, 1, 0, capas_l, scM1_l, pContextBO_p);
+    ContextBOBuilder::buildMachine(2, 1, 1, capas_l, scM2_l, pContextBO_p);
+
+    ContextBOBuilder::buildBalanceCost(0, 1, 2, 3, pContextBO_p);
+
+    ServiceBO* pService0_l = ContextBOBuilder::buildService(0, 0, unordered_set<int>(), pContextBO_p);
+    ServiceBO* pService1_l = ContextBOBuilder::buildService(1, 0, unordered_set<int>(), pContextBO_p);
+
+    vector<int> req_l(2, 0);
+    req_l[0] = 5; req_l[1] = 2;
+    ContextBOBuilder::buildProcess(0, pService0_l, req_l, 10, 0, pContextBO_p);
+    req_l[0] = 3; req_l[1] = 7;
+    ContextBOBuilder::buildProcess(1, pService0_l, req_l, 20, 1, pContextBO_p);
+    req_l[0] = 4; req_l[1] = 4;
+    ContextBOBuilder::buildProcess(2, pService0_l, req_l, 30, 2, pContextBO_p);
+    req_l[0] = 6; req_l[1] = 1;
+    ContextBOBuilder::buildProcess(3, pService1_l, req_l, 40, 0, pContextBO_p);
+    req_l[0] = 2; req_l[1] = 5;
+    ContextBOBuilder::buildProcess(4, pService1_l, req_l, 50, 1, pContextBO_p);
+
+    vector<vector<int> > mmc_l(3, vector<int>(3, 0));
+    mmc_l[0][1] = 1; mmc_l[0][2] = 4;
+    mmc_l[1][0] = 2; mmc_l[1][2] = 3;
+    mmc_l[2][0] = 5; mmc_l[2][1] = 6;
+    pContextBO_p->setMMCBO(new MMCBO(mmc_l));
+
+    pContextBO_p->setPoidsPMC(1);
+    pContextBO_p->setPoidsSMC(7);
+    pContextBO_p->setPoidsMMC(2);
+}
+
+void ContextBOBuilder::buildInstanceCompoundMoves(ContextBO* pContextBO_p){
+    pContextBO_p->addRessource(new RessourceBO(0, true, 1));
+    pContextBO_p->addRessource(new RessourceBO(1, false, 2));
+
+    vector<int> capas_l; capas_l.push_back(12); capas_l.push_back(14);
+    vector<int> sc_l; sc_l.push_back(5); sc_l.push_back(6);
+    ContextBOBuilder::buildMachine(0, 0, 0, capas_l, sc_l, pContextBO_p);
+    ContextBOBuilder::buildMachine(1, 0, 1, capas_l, sc_l, pContextBO_p);
+    ContextBOBuilder::buildMachine(2, 1, 0, capas_l, sc_l, pContextBO_p);
+    ContextBOBuilder::buildMachine(3, 1, 1, capas_l, sc_l, pContextBO_p);
+
+    ContextBOBuilder::buildBalanceCost(0, 1, 1, 2, pContextBO_p);
+
+    unordered_set<int> dependances_l;
+    dependances_l.insert(0);
+    ServiceBO* pService0_l = ContextBOBuilder::buildService(0, 2, unordered_set<int>(), pContextBO_p);
+    ServiceBO* pService1_l = ContextBOBuilder::buildService(1, 1, dependances_l, pContextBO_p);
+    ServiceBO* pService2_l = ContextBOBuilder::buildService(2, 1, unordered_set<int>(), pContextBO_p);
+
+    vector<int> req_l(2, 0);
+    req_l[0] = 4; req_l[1] = 3;
+    ContextBOBuilder::buildProcess(0, pService0_l, req_l, 3, 0, pContextBO_p);
+    req_l[0] = 3; req_l[1] = 5;
+    ContextBOBuilder::buildProcess(1, pService0_l, req_l, 5, 3, pContextBO_p);
+    req_l[0] = 2; req_l[1] = 4;
+    ContextBOBuilder::buildProcess(2, pService1_l, req_l, 7, 0, pContextBO_p);
+    req_l[0] = 5; req_l[1] = 2;
+    ContextBOBuilder::buildProcess(3, pService1_l, req_l, 11, 2, pContextBO_p);
+    req_l[0] = 6; req_l[1] = 6;
+    ContextBOBuilder::buildProcess(4, pService2_l, req_l, 13, 1, pContextBO_p);
+    req_l[0] = 1; req_l[1] = 1;
+    ContextBOBuilder::buildProcess(5, pService2_l, req_l, 17, 3, pContextBO_p);
+
+    vector<vector<int> > mmc_l(4, vector<int>(4, 0));
+    for ( int from_l=0 ; from_l < 4 ; from_l++ ){
+        for ( int to_l=0 ; to_l < 4 ; to_l++ ){
+            mmc_l[from_l][to_l] = (from_l == to_l) ? 0 : from_l + 2*to_l;
+        }
+    }
+    pContextBO_p->setMMCBO(new MMCBO(mmc_l));
+
+    pContextBO_p->setPoidsPMC(1);
+    pContextBO_p->setPoidsSMC(10);
+    pContextBO_p->setPoidsMMC(1);
+}
+
+void ContextBOBuilder::buildInstanceFused(ContextBO* pContextBO_p){
+    pContextBO_p->addRessource(new RessourceBO(0, true, 2));
+    pContextBO_p->addRessource(new RessourceBO(1, false, 3));
+
+    vector<int> capas_l(2, 10);
+    vector<int> safety_l(2, 4);
+    ContextBOBuilder::buildMachine(0, 0, 0, capas_l, safety_l, pContextBO_p);
+    ContextBOBuilder::buildMachine(1, 0, 1, capas_l, safety_l, pContextBO_p);
+    ContextBOBuilder::buildMachine(2, 1, 0, capas_l, safety_l, pContextBO_p);
+    capas_l[1] = 6;
+    ContextBOBuilder::buildMachine(3, 1, 1, capas_l, safety_l, pContextBO_p);
+
+    ContextBOBuilder::buildBalanceCost(0, 1, 2, 5, pContextBO_p);
+
+    unordered_set<int> dep_l;
+    dep_l.insert(1);
+    ServiceBO* pService0_l = ContextBOBuilder::buildService(0, 2, dep_l, pContextBO_p);
+    ServiceBO* pService1_l = ContextBOBuilder::buildService(1, 1, unordered_set<int>(), pContextBO_p);
+    ServiceBO* pService2_l = ContextBOBuilder::buildService(2, 0, unordered_set<int>(), pContextBO_p);
+
+    vector<int> req_l(2, 0);
+    req_l[0] = 4; req_l[1] = 3;
+    ContextBOBuilder::buildProcess(0, pService0_l, req_l, 10, 0, pContextBO_p);
+    req_l[0] = 3; req_l[1] = 2;
+    ContextBOBuilder::buildProcess(1, pService0_l, req_l, 20, 2, pContextBO_p);
+    req_l[0] = 2; req_l[1] = 5;
+    ContextBOBuilder::buildProcess(2, pService1_l, req_l, 30, 0, pContextBO_p);
+    req_l[0] = 5; req_l[1] = 1;
+    ContextBOBuilder::buildProcess(3, pService2_l, req_l, 40, 1, pContextBO_p);
+    req_l[0] = 1; req_l[1] = 4;
+    ContextBOBuilder::buildProcess(4, pService2_l, req_l, 50, 3, pContextBO_p);
+
+    vector<vector<int> > mmc_l(4, vector<int>(4, 1));
+    for ( int idxMachine_l=0 ; idxMachine_l < 4 ; idxMachine_l++ ){
+        mmc_l[idxMachine_l][idxMachine_l] = 0;
+    }
+    mmc_l[0][3] = 7; mmc_l[2][1] = 4;
+    pContextBO_p->setMMCBO(new MMCBO(mmc_l));
+
+    pContextBO_p->setPoidsPMC(1);
+    pContextBO_p->setPoidsSMC(10);
+    pContextBO_p->setPoidsMMC(100);
+}
+
+void ContextBOBuilder::buildInstanceSweep(ContextBO* pContextBO_p){
+    pContextBO_p->addRessource(new RessourceBO(0, false, 1));
+    pContextBO_p->addRessource(new RessourceBO(1, true, 1));
+
+    ContextBOBuilder::buildMachine(0, 0, 0, vector<int>(2, 10), vector<int>(2, 5), pContextBO_p);
+    ContextBOBuilder::buildMachine(1, 0, 0, vector<int>(2, 10), vector<int>(2, 5), pContextBO_p);
+
+    ServiceBO* pService_l = ContextBOBuilder::buildService(0, 0, unordered_set<int>(), pContextBO_p);
+    vector<int> req_l(2, 0);
+    req_l[0] = 3; req_l[1] = 4;
+    ContextBOBuilder::buildProcess(0, pService_l, req_l, 0, 0, pContextBO_p);
+    req_l[0] = 5; req_l[1] = 3;
+    ContextBOBuilder::buildProcess(1, pService_l, req_l, 0, 1, pContextBO_p);
+    req_l[0] = 2; req_l[1] = 6;
+    ContextBOBuilder::buildProcess(2, pService_l, req_l, 0, 0, pContextBO_p);
+    ContextBOBuilder::buildDefaultMMC(pContextBO_p);
+}
+
+void ContextBOBuilder::buildInstanceConstraintState(ContextBO* pContextBO_p){
+    ContextBOBuilder::buildMachine(0, 0, 0, vector<int>(), vector<int>(), pContextBO_p);
+    ContextBOBuilder::buildMachine(1, 0, 1, vector<int>(), vector<int>(), pContextBO_p);
+    ContextBOBuilder::buildMachine(2, 1, 0, vector<int>(), vector<int>(), pContextBO_p);
+    ContextBOBuilder::buildMachine(3, 1, 1, vector<int>(), vector<int>(), pContextBO_p);
+
+    unordered_set<int> dependances_l;
+    dependances_l.insert(0);
+    ServiceBO* pService0_l = ContextBOBuilder::buildService(0, 2, unordered_set<int>(), pContextBO_p);
+    ServiceBO* pService1_l = ContextBOBuilder::buildService(1, 1, dependances_l, pContextBO_p);
+    ServiceBO* pService2_l = ContextBOBuilder::buildService(2, 0, unordered_set<int>(), pContextBO_p);
+
+    ContextBOBuilder::buildProcess(0, pService0_l, vector<int>(), 0, 0, pContextBO_p);
+    ContextBOBuilder::buildProcess(1, pService0_l, vector<int>(), 0, 3, pContextBO_p);
+    ContextBOBuilder::buildProcess(2, pService1_l, vector<int>(), 0, 2, pContextBO_p);
+    ContextBOBuilder::buildProcess(3, pService2_l, vector<int>(), 0, 1, pContextBO_p);
+    ContextBOBuilder::buildProcess(4, pService2_l, vector<int>(), 0, 2, pContextBO_p);
+    ContextBOBuilder::buildDefaultMMC(pContextBO_p);
+}
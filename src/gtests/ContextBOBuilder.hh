@@ -54,6 +54,43 @@ class ContextBOBuilder {
          */
         static void buildDefaultMMC(ContextBO* pContextBO_p);
 
+        /*
+         * Petites instances completes (solution initiale comprise), partagees par les tests unitaires
+         */
+
+        /**
+         * 2 machines (sur 2 locations et 2 neighborhoods), 2 ressources (la seconde transient),
+         * 2 services (le second dependant du premier), 3 process, 1 balance cost
+         */
+        static void buildInstanceCoreBO(ContextBO* pContextBO_p);
+
+        /**
+         * Construit une petite instance faisant intervenir tous les couts :
+         * 3 machines, 2 ressources (dont une transient), 1 balance cost, 2 services, 5 process
+         */
+        static void buildInstanceEvaluator(ContextBO* pContextBO_p);
+
+        /**
+         * Instance avec des contraintes de spread et de dependances, pour tester les mouvements composes
+         * 4 machines (locations 0, 0, 1, 1 ; neighborhoods 0, 1, 0, 1), 1 ressource transient et 1 non transient
+         */
+        static void buildInstanceCompoundMoves(ContextBO* pContextBO_p);
 
+        /**
+         * 4 machines reparties sur 2 locations et 2 neighborhoods, 2 ressources (dont une transient),
+         * 1 balance cost, 3 services (spread, dependance), 5 process
+         */
+        static void buildInstanceFused(ContextBO* pContextBO_p);
+
+        /**
+         * 2 machines, 2 ressources (la seconde transient), 3 process
+         */
+        static void buildInstanceSweep(ContextBO* pContextBO_p);
+
+        /**
+         * 4 machines : locations 0, 0, 1, 1 ; neighborhoods 0, 1, 0, 1
+         * Le service 1 depend du service 0, qui a un spread min de 2
+         */
+        static void buildInstanceConstraintState(ContextBO* pContextBO_p);
 };
 
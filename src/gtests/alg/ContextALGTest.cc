@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "alg/ContextALG.hh"
+#include "bo/ContextBO.hh"
+#include "bo/RessourceBO.hh"
+#include "bo/ServiceBO.hh"
+#include "gtests/ContextBOBuilder.hh"
+#include <vector>
+#include <tr1/unordered_set>
+#include <gtest/gtest.h>
+using namespace std;
+using namespace std::tr1;
+
+TEST(ContextALG, ressUsedOnMachine){
+    ContextBO contextBO_l;
+    contextBO_l.addRessource(new RessourceBO(0, false, 0));
+    contextBO_l.addRessource(new RessourceBO(1, true, 0));
+
+    ContextBOBuilder::buildMachine(0, 0, 0, vector<int>(2, 20), vector<int>(2, 10), &contextBO_l);
+    ContextBOBuilder::buildMachine(1, 0, 0, vector<int>(2, 20), vector<int>(2, 10), &contextBO_l);
+
+    ServiceBO* pService_l = ContextBOBuilder::buildService(0, 0, unordered_set<int>(), &contextBO_l);
+    vector<int> reqP0_l; reqP0_l.push_back(3); reqP0_l.push_back(5);
+    vector<int> reqP1_l; reqP1_l.push_back(4); reqP1_l.push_back(2);
+    ContextBOBuilder::buildProcess(0, pService_l, reqP0_l, 0, 0, &contextBO_l);
+    ContextBOBuilder::buildProcess(1, pService_l, reqP1_l, 0, 1, &contextBO_l);
+    ContextBOBuilder::buildDefaultMMC(&contextBO_l);
+
+    ContextALG contextALG_l(&contextBO_l);
+    EXPECT_EQ(contextALG_l.getRessUsedOnMachine(0, 0), 3);
+    EXPECT_EQ(contextALG_l.getRessUsedOnMachine(1, 1), 2);
+    EXPECT_EQ(contextALG_l.getTransientRessUsedOnMachine(1, 0), 0);
+
+    contextALG_l.assign(0, 1);
+    EXPECT_EQ(contextALG_l.getCurrentSol()[0], 1);
+    EXPECT_EQ(contextALG_l.getRessUsedOnMachine(0, 0), 0);
+    EXPECT_EQ(contextALG_l.getRessUsedOnMachine(0, 1), 7);
+    EXPECT_EQ(contextALG_l.getRessUsedOnMachine(1, 1), 7);
+    EXPECT_EQ(contextALG_l.getTransientRessUsedOnMachine(0, 0), 0);
+    EXPECT_EQ(contextALG_l.getTransientRessUsedOnMachine(1, 0), 5);
+
+    contextALG_l.unassign(1);
+    EXPECT_EQ(contextALG_l.getCurrentSol()[1], -1);
+    EXPECT_EQ(contextALG_l.getRessUsedOnMachine(0, 1), 3);
+    EXPECT_EQ(contextALG_l.getTransientRessUsedOnMachine(1, 1), 2);
+    //le process desaffecte n'occupe aucun voisinage
+    const unordered_set<int> neighs_l = contextALG_l.getNeighsUsedByService(0);
+    EXPECT_EQ(1u, neighs_l.size());
+    EXPECT_EQ(1u, neighs_l.count(0));
+
+    contextALG_l.assign(0, 0);
+    contextALG_l.assign(1, 1);
+    EXPECT_EQ(contextALG_l.getCurrentSol(), contextBO_l.getSolInit());
+    EXPECT_EQ(contextALG_l.getRessUsedOnMachine(0, 1), 4);
+    EXPECT_EQ(contextALG_l.getTransientRessUsedOnMachine(1, 0), 0);
+    EXPECT_EQ(contextALG_l.getTransientRessUsedOnMachine(1, 1), 0);
+
+    vector<int> sol_l(2, 0);
+    contextALG_l.setCurrentSol(sol_l);
+    EXPECT_EQ(contextALG_l.getRessUsedOnMachine(0, 0), 7);
+    EXPECT_EQ(contextALG_l.getRessUsedOnMachine(0, 1), 0);
+    EXPECT_EQ(contextALG_l.getTransientRessUsedOnMachine(1, 1), 2);
+
+    //swapCurrentSol : meme effet que setCurrentSol, l'ancienne solution est rendue
+    vector<int> solSwap_l = contextBO_l.getSolInit();
+    contextALG_l.swapCurrentSol(solSwap_l);
+    EXPECT_EQ(sol_l, solSwap_l);
+    EXPECT_EQ(contextALG_l.getCurrentSol(), contextBO_l.getSolInit());
+    EXPECT_EQ(contextALG_l.getRessUsedOnMachine(0, 1), 4);
+    EXPECT_EQ(contextALG_l.getTransientRessUsedOnMachine(1, 1), 0);
+}
+
+/**
+ * Le FusedChecker est partage par tous les ContextALG de l'instance ; un ContextALG peut partir
+ * directement d'une solution donnee
+ */
+TEST(ContextALG, partageEtSolutionDeDepart){
+    ContextBO contextBO_l;
+    contextBO_l.addRessource(new RessourceBO(0, false, 0));
+    ContextBOBuilder::buildMachine(0, 0, 0, vector<int>(1, 20), vector<int>(1, 10), &contextBO_l);
+    ContextBOBuilder::buildMachine(1, 0, 0, vector<int>(1, 20), vector<int>(1, 10), &contextBO_l);
+    ServiceBO* pService_l = ContextBOBuilder::buildService(0, 0, unordered_set<int>(), &contextBO_l);
+    ContextBOBuilder::buildProcess(0, pService_l, vector<int>(1, 3), 0, 0, &contextBO_l);
+    ContextBOBuilder::buildProcess(1, pService_l, vector<int>(1, 4), 0, 0, &contextBO_l);
+    ContextBOBuilder::buildDefaultMMC(&contextBO_l);
+
+    ContextALG contextALG_l(&contextBO_l);
+    vector<int> sol_l(2, 1);
+    ContextALG depuisSol_l(&contextBO_l, sol_l, false);
+    EXPECT_EQ(contextALG_l.getFusedChecker(), depuisSol_l.getFusedChecker());
+    EXPECT_EQ(contextBO_l.getFusedChecker().get(), contextALG_l.getFusedChecker());
+    EXPECT_EQ(sol_l, depuisSol_l.getCurrentSol());
+    EXPECT_EQ(0, depuisSol_l.getRessUsedOnMachine(0, 0));
+    EXPECT_EQ(7, depuisSol_l.getRessUsedOnMachine(0, 1));
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "alg/MCTS/BanditPolicyALG.hh"
+#include <boost/scoped_ptr.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+using namespace std;
+
+namespace {
+    /** Par defaut, toutes les evaluations du fils sont egales (variance nulle) */
+    NodeContentALG contenu(uint32_t nbSimu_p, float sumEval_p, float sumEval2_p = -1.f){
+        NodeContentALG res_l;
+        res_l.nbSimu_m = nbSimu_p;
+        res_l.sumEval_m = sumEval_p;
+        res_l.sumEval2_m = (sumEval2_p < 0 && nbSimu_p != 0) ? sumEval_p * sumEval_p / nbSimu_p : sumEval2_p;
+        return res_l;
+    }
+
+    /** La formule historique de la MCTS, fils par fils */
+    size_t uctReference(const vector<NodeContentALG>& fils_p, uint32_t nbSimuPere_p, double c_p){
+        size_t res_l = 0;
+        double max_l = -numeric_limits<double>::infinity();
+        for ( size_t i_l=0 ; i_l < fils_p.size() ; ++i_l ){
+            double val_l = numeric_limits<double>::infinity();
+            if ( fils_p[i_l].nbSimu_m != 0 ){
+                double ni_l = fils_p[i_l].nbSimu_m;
+                val_l = fils_p[i_l].sumEval_m / ni_l + c_p * sqrt(2. * log((double) nbSimuPere_p) / ni_l);
+            }
+            if ( val_l > max_l ){
+                max_l = val_l;
+                res_l = i_l;
+            }
+        }
+        return res_l;
+    }
+}
+
+TEST(BanditPolicyALG, build){
+    boost::scoped_ptr<BanditPolicyALG> pPolicy_l(BanditPolicyALG::build("ucb1tuned", 0.5));
+    EXPECT_EQ(0.5, pPolicy_l->getConstant());
+    EXPECT_THROW(BanditPolicyALG::build("epsilonGlouton", 0.1), string);
+}
+
+TEST(BanditPolicyALG, filsNonVisitePrefere){
+    const char* noms_l[] = {"ucb1", "ucb1tuned", "rang"};
+    vector<NodeContentALG> fils_l;
+    fils_l.push_back(contenu(10, 9));
+    fils_l.push_back(contenu(0, 0));
+    fils_l.push_back(contenu(0, 0));
+    for ( int i_l=0 ; i_l < 3 ; ++i_l ){
+        boost::scoped_ptr<BanditPolicyALG> pPolicy_l(BanditPolicyALG::build(noms_l[i_l], 0.1));
+        EXPECT_EQ(1u, pPolicy_l->choose(&fils_l[0], fils_l.size(), 10)) << noms_l[i_l];
+        EXPECT_EQ(0u, pPolicy_l->choose(&fils_l[0], 1, 10)) << noms_l[i_l];
+    }
+}
+
+TEST(BanditPolicyALG, exploitationExploration){
+    const char* noms_l[] = {"ucb1", "ucb1tuned", "rang"};
+    // le fils 0 a la meilleure moyenne, le fils 2 est tres peu visite
+    vector<NodeContentALG> fils_l;
+    fils_l.push_back(contenu(500, 400));
+    fils_l.push_back(contenu(497, 300));
+    fils_l.push_back(contenu(3, 1.5));
+    for ( int i_l=0 ; i_l < 3 ; ++i_l ){
+        boost::scoped_ptr<BanditPolicyALG> pGlouton_l(BanditPolicyALG::build(noms_l[i_l], 0.));
+        EXPECT_EQ(0u, pGlouton_l->choose(&fils_l[0], fils_l.size(), 1000)) << noms_l[i_l];
+        boost::scoped_ptr<BanditPolicyALG> pCurieux_l(BanditPolicyALG::build(noms_l[i_l], 10.));
+        EXPECT_EQ(2u, pCurieux_l->choose(&fils_l[0], fils_l.size(), 1000)) << noms_l[i_l];
+    }
+}
+
+TEST(BanditPolicyALG, ucb1TunedVariance){
+    boost::scoped_ptr<BanditPolicyALG> pPolicy_l(BanditPolicyALG::build("ucb1tuned", 0.1));
+    // meme moyenne, meme nombre de visites : le fils aux evaluations dispersees est explore
+    vector<NodeContentALG> fils_l;
+    fils_l.push_back(contenu(10000, 5000));
+    fils_l.push_back(contenu(10000, 5000, 5000));
+    EXPECT_EQ(1u, pPolicy_l->choose(&fils_l[0], fils_l.size(), 20000));
+    swap(fils_l[0], fils_l[1]);
+    EXPECT_EQ(0u, pPolicy_l->choose(&fils_l[0], fils_l.size(), 20000));
+}
+
+TEST(BanditPolicyALG, ucb1CommeAvant){
+    boost::scoped_ptr<BanditPolicyALG> pPolicy_l(BanditPolicyALG::build("ucb1", 0.1));
+    srand(42);
+    for ( int essai_l=0 ; essai_l < 200 ; ++essai_l ){
+        vector<NodeContentALG> fils_l;
+        uint32_t nbSimuPere_l = 0;
+        int nbFils_l = 1 + rand() % 50;
+        for ( int i_l=0 ; i_l < nbFils_l ; ++i_l ){
+            uint32_t n_l = 1 + rand() % 10000;
+            fils_l.push_back(contenu(n_l, n_l * (rand() % 1000) / 1000.f));
+            nbSimuPere_l += n_l;
+        }
+        EXPECT_EQ(uctReference(fils_l, nbSimuPere_l, 0.1),
+                  pPolicy_l->choose(&fils_l[0], fils_l.size(), nbSimuPere_l));
+    }
+}
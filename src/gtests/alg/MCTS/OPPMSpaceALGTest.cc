@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "alg/MCTS/oneprocessdecisions/OPPMSpaceALG.hh"
+#include "alg/ContextALG.hh"
+#include "bo/ContextBO.hh"
+#include "bo/MMCBO.hh"
+#include "bo/RessourceBO.hh"
+#include "bo/ServiceBO.hh"
+#include "gtests/ContextBOBuilder.hh"
+#include <boost/scoped_ptr.hpp>
+#include <vector>
+#include <tr1/unordered_set>
+#include <gtest/gtest.h>
+using namespace std;
+using namespace std::tr1;
+
+TEST(OPPMSpaceALG, processDecides){
+    ContextBO contextBO_l;
+    contextBO_l.addRessource(new RessourceBO(0, false, 0));
+    for ( int i_l=0 ; i_l < 3 ; ++i_l ){
+        ContextBOBuilder::buildMachine(i_l, 0, 0, vector<int>(1, 100), vector<int>(1, 100), &contextBO_l);
+    }
+    ServiceBO* pService_l = ContextBOBuilder::buildService(0, 0, unordered_set<int>(), &contextBO_l);
+    for ( int i_l=0 ; i_l < 4 ; ++i_l ){
+        ContextBOBuilder::buildProcess(i_l, pService_l, vector<int>(1, 10), 0, i_l % 3, &contextBO_l);
+    }
+    ContextBOBuilder::buildDefaultMMC(&contextBO_l);
+    ContextALG contextALG_l(&contextBO_l);
+
+    OPPMSpaceALG space_l;
+    space_l.setpContext(&contextALG_l);
+    EXPECT_FALSE(space_l.isSolution());
+
+    // une decision par machine pour le premier process libre
+    OPPMSpaceALG::DecisionsPool decisions_l = space_l.generateDecisions();
+    ASSERT_EQ(3u, decisions_l.size());
+    for ( int i_l=0 ; i_l < 3 ; ++i_l ){
+        EXPECT_EQ(0, decisions_l[i_l].target_m);
+        EXPECT_EQ(i_l, decisions_l[i_l].min_m);
+        EXPECT_EQ(i_l, decisions_l[i_l].max_m);
+    }
+
+    // les process decides dans le desordre (ou deux fois) sont sautes
+    space_l.addDecision(DecisionALG(0, 1, 1));
+    space_l.addDecision(DecisionALG(2, 0, 0));
+    space_l.addDecision(DecisionALG(2, 0, 0));
+    space_l.addDecision(DecisionALG(0, 2, 2));
+    EXPECT_EQ(1, space_l.generateDecisions()[0].target_m);
+
+    // le clone reprend ou en est l'original, sans le modifier
+    boost::scoped_ptr<SpaceALG> pClone_l(space_l.clone());
+    pClone_l->addDecision(DecisionALG(1, 2, 2));
+    EXPECT_EQ(3, pClone_l->generateDecisions()[0].target_m);
+    EXPECT_FALSE(pClone_l->isSolution());
+    EXPECT_EQ(1, space_l.generateDecisions()[0].target_m);
+
+    pClone_l->addDecision(DecisionALG(3, 0, 0));
+    EXPECT_TRUE(pClone_l->isSolution());
+    EXPECT_TRUE(pClone_l->generateDecisions().empty());
+    EXPECT_FALSE(space_l.isSolution());
+}
+
+TEST(OPPMSpaceALG, bound){
+    ContextBO contextBO_l;
+    contextBO_l.addRessource(new RessourceBO(0, false, 0));
+    for ( int i_l=0 ; i_l < 3 ; ++i_l ){
+        ContextBOBuilder::buildMachine(i_l, 0, 0, vector<int>(1, 100), vector<int>(1, 100), &contextBO_l);
+    }
+    ServiceBO* pService_l = ContextBOBuilder::buildService(0, 0, unordered_set<int>(), &contextBO_l);
+    ContextBOBuilder::buildProcess(0, pService_l, vector<int>(1, 10), 5, 0, &contextBO_l);
+    ContextBOBuilder::buildProcess(1, pService_l, vector<int>(1, 10), 7, 1, &contextBO_l);
+    vector<vector<int> > mmc_l(3, vector<int>(3, 0));
+    mmc_l[0][2] = 4; mmc_l[1][0] = 1;
+    contextBO_l.setMMCBO(new MMCBO(mmc_l));
+    contextBO_l.setPoidsPMC(10);
+    contextBO_l.setPoidsMMC(100);
+    ContextALG contextALG_l(&contextBO_l);
+
+    OPPMSpaceALG space_l;
+    space_l.setpContext(&contextALG_l);
+    EXPECT_EQ(0., space_l.bound());
+
+    // un process laisse sur sa machine initiale ne coute rien
+    boost::scoped_ptr<SpaceALG> pClone_l(space_l.clone());
+    pClone_l->addDecision(DecisionALG(1, 1, 1));
+    EXPECT_EQ(0., pClone_l->bound());
+
+    // PMC et MMC ponderes des process deplaces, comptes une seule fois
+    space_l.addDecision(DecisionALG(1, 0, 0));
+    EXPECT_EQ(10. * 7 + 100. * 1, space_l.bound());
+    space_l.addDecision(DecisionALG(0, 2, 2));
+    space_l.addDecision(DecisionALG(0, 2, 2));
+    EXPECT_EQ(170. + 10. * 5 + 100. * 4, space_l.bound());
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "alg/MCTS/SolutionALG.hh"
+#include "alg/MCTS/ConstraintSystemALG.hh"
+#include "alg/ContextALG.hh"
+#include "bo/ContextBO.hh"
+#include "bo/RessourceBO.hh"
+#include "bo/ServiceBO.hh"
+#include "gtests/ContextBOBuilder.hh"
+#include <vector>
+#include <tr1/unordered_set>
+#include <gtest/gtest.h>
+using namespace std;
+using namespace std::tr1;
+
+namespace {
+    vector<int> machines(int premiere_p, int derniere_p){
+        vector<int> res_l;
+        for ( int i_l=premiere_p ; i_l <= derniere_p ; ++i_l ){
+            res_l.push_back(i_l);
+        }
+        return res_l;
+    }
+}
+
+TEST(SolutionALG, decisions){
+    ContextBO contextBO_l;
+    contextBO_l.addRessource(new RessourceBO(0, false, 0));
+    for ( int i_l=0 ; i_l < 6 ; ++i_l ){
+        ContextBOBuilder::buildMachine(i_l, 0, 0, vector<int>(1, 15), vector<int>(1, 15), &contextBO_l);
+    }
+    ServiceBO* pService0_l = ContextBOBuilder::buildService(0, 0, unordered_set<int>(), &contextBO_l);
+    ServiceBO* pService1_l = ContextBOBuilder::buildService(1, 0, unordered_set<int>(), &contextBO_l);
+    ContextBOBuilder::buildProcess(0, pService0_l, vector<int>(1, 10), 0, 0, &contextBO_l);
+    ContextBOBuilder::buildProcess(1, pService1_l, vector<int>(1, 10), 0, 1, &contextBO_l);
+    ContextBOBuilder::buildDefaultMMC(&contextBO_l);
+    ContextALG contextALG_l(&contextBO_l);
+    ConstraintSystemALG constraints_l;
+    constraints_l.setpContext(&contextALG_l);
+
+    SolutionALG solution_l(2);
+    solution_l.setpConstraintSystem(&constraints_l);
+    EXPECT_EQ(machines(0, 5), solution_l.getAvaiableMachines(0));
+
+    // une decision "une machine" puis deux coupes successives d'intervalle
+    solution_l.addDecision(DecisionALG(1, 4, 4));
+    solution_l.addDecision(DecisionALG(0, 1, 4));
+    solution_l.addDecision(DecisionALG(0, 3, 5));
+    EXPECT_EQ(machines(3, 4), solution_l.getAvaiableMachines(0));
+    EXPECT_EQ(machines(4, 4), solution_l.getAvaiableMachines(1));
+
+    // les decisions s'ajoutent aux contraintes de capacite
+    solution_l.assign(1, 4);
+    EXPECT_EQ(machines(3, 3), solution_l.getAvaiableMachines(0));
+
+    // des decisions contradictoires ne laissent aucune machine
+    solution_l.addDecision(DecisionALG(0, 0, 2));
+    EXPECT_TRUE(solution_l.getAvaiableMachines(0).empty());
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "alg/MCTS/TreeALG.hh"
+#include "alg/MCTS/TreeALGDefs.hh"
+#include "alg/MCTS/TreeArenaImplALGDefs.hh"
+#include "alg/MCTS/TreeSimpleImplALGDefs.hh"
+#include <string>
+#include <gtest/gtest.h>
+using namespace std;
+
+namespace {
+    template<typename Tree>
+    typename Tree::iterator ajoute(Tree& tree_p, typename Tree::iterator pere_p, uint32_t nbSimu_p){
+        NodeContentALG contenu_l;
+        contenu_l.nbSimu_m = nbSimu_p;
+        contenu_l.sumEval_m = nbSimu_p / 2.f;
+        return tree_p.addChildren(pere_p, contenu_l);
+    }
+
+    /** Racine (1000) avec 4 fils : A (600) et C (300) ont chacun 3 fils
+     * ayant eux meme 2 fils, B (90) a 3 fils feuilles, D (10) est une feuille.
+     * Les visites d'un pere majorent celles de ses fils.
+     */
+    template<typename Tree>
+    void construis(Tree& tree_p){
+        typename Tree::iterator root_l = tree_p.root();
+        root_l->nbSimu_m = 1000;
+        uint32_t visites_l[] = {600, 90, 300, 10};
+        for ( int i_l=0 ; i_l < 4 ; ++i_l ){
+            typename Tree::iterator fils_l = ajoute(tree_p, tree_p.root(), visites_l[i_l]);
+            if ( i_l == 3 ) continue;
+            for ( int j_l=0 ; j_l < 3 ; ++j_l ){
+                typename Tree::iterator petitFils_l = ajoute(tree_p, fils_l, visites_l[i_l] / 4);
+                if ( i_l == 1 ) continue;
+                ajoute(tree_p, petitFils_l, visites_l[i_l] / 10);
+                petitFils_l = tree_p.child(fils_l, j_l);
+                ajoute(tree_p, petitFils_l, visites_l[i_l] / 10);
+                fils_l = tree_p.child(tree_p.root(), i_l);
+            }
+        }
+    }
+
+    template<typename Tree>
+    void testeShrink(){
+        Tree tree_l;
+        construis(tree_l);
+        // 1 + 4 + (3 + 6) * 2 + 3
+        EXPECT_EQ(26u, tree_l.getNbNodes());
+        EXPECT_EQ(0u, tree_l.shrink(26));
+
+        // les noeuds internes les moins visites sont les petits fils de C (75)
+        EXPECT_EQ(3u, tree_l.shrink(23));
+        EXPECT_EQ(20u, tree_l.getNbNodes());
+        typename Tree::iterator c_l = tree_l.child(tree_l.root(), 2);
+        EXPECT_EQ(3u, tree_l.nbChildren(c_l));
+        EXPECT_FALSE(tree_l.hasChildren(tree_l.child(c_l, 0)));
+        EXPECT_EQ(75u, tree_l.child(c_l, 0)->nbSimu_m);
+        EXPECT_EQ(37.5f, tree_l.child(c_l, 0)->sumEval_m);
+        EXPECT_TRUE(tree_l.hasChildren(tree_l.child(tree_l.child(tree_l.root(), 0), 0)));
+
+        // puis B (90) avant les petits fils de A (150)
+        EXPECT_EQ(1u, tree_l.shrink(18));
+        EXPECT_EQ(17u, tree_l.getNbNodes());
+        typename Tree::iterator b_l = tree_l.child(tree_l.root(), 1);
+        EXPECT_FALSE(tree_l.hasChildren(b_l));
+        EXPECT_EQ(90u, b_l->nbSimu_m);
+        EXPECT_TRUE(tree_l.hasChildren(tree_l.child(tree_l.child(tree_l.root(), 0), 0)));
+
+        // au pire, il ne reste que les fils de la racine
+        tree_l.shrink(1);
+        EXPECT_EQ(5u, tree_l.getNbNodes());
+        EXPECT_EQ(4u, tree_l.nbChildren(tree_l.root()));
+        EXPECT_EQ(600u, tree_l.child(tree_l.root(), 0)->nbSimu_m);
+
+        // un noeud replie peut etre redeveloppe
+        ajoute(tree_l, tree_l.child(tree_l.root(), 0), 1);
+        EXPECT_EQ(6u, tree_l.getNbNodes());
+    }
+
+    /** Un fils epuise reste connu de son pere apres le repli de celui ci */
+    template<typename Tree>
+    void testeEpuises(){
+        Tree tree_l;
+        NodeContentALG contenu_l;
+        contenu_l.nbSimu_m = 10;
+        typename Tree::iterator root_l = tree_l.root();
+        typename Tree::iterator pere_l = tree_l.addChildren(root_l, contenu_l);
+        for ( int i_l=0 ; i_l < 3 ; ++i_l ){
+            NodeContentALG fils_l(DecisionALG(0, i_l, i_l));
+            fils_l.nbSimu_m = 1;
+            tree_l.addChildren(pere_l, fils_l);
+        }
+        typename Tree::iterator epuise_l = tree_l.child(pere_l, 1);
+        tree_l.deleteExhausted(epuise_l);
+        pere_l = tree_l.child(tree_l.root(), 0);
+        EXPECT_EQ(2u, tree_l.nbChildren(pere_l));
+        EXPECT_TRUE(tree_l.isExhausted(pere_l, DecisionALG(0, 1, 1)));
+        EXPECT_FALSE(tree_l.isExhausted(pere_l, DecisionALG(0, 0, 0)));
+
+        // le repli conserve la liste du noeud replie
+        EXPECT_EQ(1u, tree_l.shrink(2));
+        EXPECT_FALSE(tree_l.hasChildren(pere_l));
+        EXPECT_TRUE(tree_l.isExhausted(pere_l, DecisionALG(0, 1, 1)));
+        EXPECT_FALSE(tree_l.isExhausted(pere_l, DecisionALG(0, 2, 2)));
+
+        // un noeud epuise a son tour libere sa liste et passe dans celle de son pere
+        tree_l.deleteExhausted(pere_l);
+        EXPECT_FALSE(tree_l.hasChildren(tree_l.root()));
+        EXPECT_TRUE(tree_l.isExhausted(tree_l.root(), DecisionALG()));
+    }
+}
+
+TEST(TreeALG, shrinkArena){
+    testeShrink< TreeALG< TreeArenaImplALG<NodeContentALG> > >();
+}
+
+TEST(TreeALG, shrinkSimple){
+    testeShrink< TreeALG< TreeSimpleImplALG<NodeContentALG> > >();
+}
+
+TEST(TreeALG, epuisesArena){
+    testeEpuises< TreeALG< TreeArenaImplALG<NodeContentALG> > >();
+}
+
+TEST(TreeALG, epuisesSimple){
+    testeEpuises< TreeALG< TreeSimpleImplALG<NodeContentALG> > >();
+}
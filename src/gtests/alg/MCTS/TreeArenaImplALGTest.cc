@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "alg/MCTS/TreeALG.hh"
+#include "alg/MCTS/TreeALGDefs.hh"
+#include "alg/MCTS/TreeArenaImplALGDefs.hh"
+#include <gtest/gtest.h>
+using namespace std;
+
+namespace {
+    /** Contenu minimal comptant les clear, pour verifier que les noeuds
+     * effaces sont bien nettoyes
+     */
+    struct ContenuTest
+    {
+        ContenuTest(int val_p = 0) : val_m(val_p) {}
+        void clear() {++nbClear_m; val_m = -1;}
+        int val_m;
+        static int nbClear_m;
+    };
+    int ContenuTest::nbClear_m = 0;
+
+    typedef TreeArenaImplALG<ContenuTest> Arbre;
+    typedef Arbre::iterator Iterateur;
+
+    vector<int> valeursFils(Arbre& arbre_p, const Iterateur& it_p){
+        vector<int> res_l;
+        for ( size_t i_l=0 ; i_l < arbre_p.nbChildren(it_p) ; ++i_l ){
+            res_l.push_back(arbre_p.child(it_p, i_l)->val_m);
+        }
+        return res_l;
+    }
+}
+
+TEST(TreeArenaImplALG, ajoutEtParcours){
+    Arbre arbre_l;
+    Iterateur root_l = arbre_l.root();
+    EXPECT_TRUE(root_l.isRoot());
+    EXPECT_FALSE(arbre_l.hasChildren(root_l));
+
+    // 5 fils : la plage des fils demenage 3 fois (1 -> 2 -> 4 -> 8)
+    for ( int i_l=0 ; i_l < 5 ; ++i_l ){
+        Iterateur fils_l = arbre_l.addChildren(root_l, ContenuTest(i_l));
+        EXPECT_FALSE(fils_l.isRoot());
+        EXPECT_EQ(0, fils_l.father()->val_m);
+    }
+    Iterateur fils2_l = arbre_l.child(root_l, 2);
+    arbre_l.addChildren(fils2_l, ContenuTest(20));
+    arbre_l.addChildren(fils2_l, ContenuTest(21));
+    Iterateur petitFils_l = arbre_l.child(fils2_l, 0);
+
+    // les fils gardent leur ordre et les liens vers le pere suivent les demenagements
+    int attendus_l[] = {0, 1, 2, 3, 4};
+    EXPECT_EQ(vector<int>(attendus_l, attendus_l + 5), valeursFils(arbre_l, root_l));
+    EXPECT_EQ(2, petitFils_l.father()->val_m);
+    EXPECT_TRUE(petitFils_l.father().father().isRoot());
+    EXPECT_EQ(8u, arbre_l.getNbNodes());
+    EXPECT_EQ(5u, arbre_l.children(root_l).size());
+    // les contenus des fils sont contigus
+    ContenuTest* pContenus_l = arbre_l.childrenContents(root_l);
+    for ( int i_l=0 ; i_l < 5 ; ++i_l ){
+        EXPECT_EQ(i_l, pContenus_l[i_l].val_m);
+    }
+
+    // meme chose au travers de l'interface utilisee par la MCTS
+    TreeALG< TreeArenaImplALG<NodeContentALG> > tree_l;
+    TreeALG< TreeArenaImplALG<NodeContentALG> >::iterator rootTree_l = tree_l.root();
+    NodeContentALG contenu_l;
+    contenu_l.nbSimu_m = 3;
+    tree_l.addChildren(rootTree_l, contenu_l);
+    EXPECT_EQ(1u, tree_l.nbChildren(rootTree_l));
+    EXPECT_EQ(3u, tree_l.child(rootTree_l, 0)->nbSimu_m);
+}
+
+TEST(TreeArenaImplALG, suppression){
+    Arbre arbre_l;
+    Iterateur root_l = arbre_l.root();
+    for ( int i_l=0 ; i_l < 4 ; ++i_l ){
+        Iterateur fils_l = arbre_l.addChildren(root_l, ContenuTest(i_l));
+        for ( int j_l=0 ; j_l < 3 ; ++j_l ){
+            Iterateur petitFils_l = arbre_l.addChildren(fils_l, ContenuTest(10*i_l + j_l));
+            arbre_l.addChildren(petitFils_l, ContenuTest(100*i_l + j_l));
+        }
+    }
+    EXPECT_EQ(1u + 4 + 12 + 12, arbre_l.getNbNodes());
+
+    // on efface le fils 1 et ses 6 descendants : les suivants sont decales
+    ContenuTest::nbClear_m = 0;
+    Iterateur fils1_l = arbre_l.child(root_l, 1);
+    arbre_l.deleteNode(fils1_l);
+    EXPECT_EQ(7, ContenuTest::nbClear_m);
+    EXPECT_EQ(Arbre::NIL, fils1_l.idx_m);
+    EXPECT_EQ(1u + 3 + 9 + 9, arbre_l.getNbNodes());
+
+    int attendus_l[] = {0, 2, 3};
+    EXPECT_EQ(vector<int>(attendus_l, attendus_l + 3), valeursFils(arbre_l, root_l));
+    Iterateur fils2_l = arbre_l.child(root_l, 1);
+    int attendusPetitsFils_l[] = {20, 21, 22};
+    EXPECT_EQ(vector<int>(attendusPetitsFils_l, attendusPetitsFils_l + 3), valeursFils(arbre_l, fils2_l));
+    // les petits fils du noeud decale pointent vers sa nouvelle place
+    EXPECT_EQ(2, arbre_l.child(fils2_l, 0).father()->val_m);
+    EXPECT_EQ(21, arbre_l.child(arbre_l.child(fils2_l, 1), 0).father()->val_m);
+
+    // effacer le dernier fils d'un noeud en fait une feuille
+    Iterateur feuille_l = arbre_l.child(arbre_l.child(fils2_l, 0), 0);
+    arbre_l.deleteNode(feuille_l);
+    EXPECT_FALSE(arbre_l.hasChildren(arbre_l.child(fils2_l, 0)));
+
+    // effacer la racine ne laisse qu'elle
+    arbre_l.deleteNode(root_l);
+    root_l = arbre_l.root();
+    EXPECT_FALSE(arbre_l.hasChildren(root_l));
+    EXPECT_EQ(1u, arbre_l.getNbNodes());
+}
+
+TEST(TreeArenaImplALG, recyclage){
+    Arbre arbre_l;
+    Iterateur root_l = arbre_l.root();
+
+    // plus d'un bloc de noeuds, avec un sous arbre profond
+    for ( int i_l=0 ; i_l < 1000 ; ++i_l ){
+        arbre_l.addChildren(root_l, ContenuTest(i_l));
+    }
+    Iterateur courant_l = root_l;
+    for ( uint32_t i_l=0 ; i_l < Arbre::TAILLE_BLOC ; ++i_l ){
+        courant_l = arbre_l.addChildren(courant_l, ContenuTest(i_l));
+    }
+    size_t capacite_l = arbre_l.getCapacity();
+    EXPECT_EQ(2*(size_t) Arbre::TAILLE_BLOC, capacite_l);
+    EXPECT_EQ(1u + Arbre::TAILLE_BLOC + 1000, arbre_l.getNbNodes());
+
+    // les plages liberees par l'effacement sont reutilisees sans nouveau bloc
+    for ( int essai_l=0 ; essai_l < 3 ; ++essai_l ){
+        Iterateur chaine_l = arbre_l.child(root_l, 1000);
+        arbre_l.deleteNode(chaine_l);
+        EXPECT_EQ(1000u, arbre_l.nbChildren(root_l));
+
+        courant_l = arbre_l.addChildren(root_l, ContenuTest(-1));
+        for ( uint32_t i_l=1 ; i_l < Arbre::TAILLE_BLOC ; ++i_l ){
+            courant_l = arbre_l.addChildren(courant_l, ContenuTest(i_l));
+        }
+        EXPECT_EQ(capacite_l, arbre_l.getCapacity());
+    }
+}
@@ -37,7 +37,8 @@ void testEgaliteContextsBO(const ContextBO& context1_l, const ContextBO& context
     EXPECT_NE(context1_l.getProcess(0), context2_l.getProcess(0));
     //TODO : ajouter ce test lorsque le contexte initial contiendra au moins un balance cost
     //EXPECT_NE(context1_l->getBalanceCost(0), context2_l->getBalanceCost(0));
-    EXPECT_NE(context1_l.getMMCBO(), context2_l.getMMCBO());
+    //La MMC, immuable, est partagee par les copies (shared_ptr : pas de double delete)
+    EXPECT_EQ(context1_l.getMMCBO(), context2_l.getMMCBO());
 }
 
 TEST(ContextBO, cpyCtr){
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+#include "bo/ContextBO.hh"
+#include "bo/InstanceCoreBO.hh"
+#include "bo/ProcessBO.hh"
+#include "bo/RessourceBO.hh"
+#include "bo/ServiceBO.hh"
+#include "dtoin/SolutionDtoin.hh"
+#include "gtests/ContextBOBuilder.hh"
+#include "gtests/dtoin/TestDtoinHelper.hh"
+#include <sstream>
+#include <vector>
+#include <tr1/unordered_set>
+#include <gtest/gtest.h>
+using namespace std;
+using namespace std::tr1;
+
+TEST(InstanceCoreBO, donneesAPlat){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceCoreBO(&contextBO_l);
+    boost::shared_ptr<InstanceCoreBO const> pCore_l = contextBO_l.getInstanceCore();
+
+    EXPECT_EQ(3, pCore_l->getNbProcesses());
+    EXPECT_EQ(2, pCore_l->getNbRessources());
+    EXPECT_EQ(2, pCore_l->getNbMachines());
+
+    const int requirements_l[] = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(vector<int>(requirements_l, requirements_l + 6), pCore_l->getRequirements());
+    const int capas_l[] = {10, 20, 30, 40};
+    EXPECT_EQ(vector<int>(capas_l, capas_l + 4), pCore_l->getCapas());
+    const int capasByRess_l[] = {10, 30, 20, 40};
+    EXPECT_EQ(vector<int>(capasByRess_l, capasByRess_l + 4), pCore_l->getCapasByRess());
+    const int safetyByRess_l[] = {5, 25, 15, 35};
+    EXPECT_EQ(vector<int>(safetyByRess_l, safetyByRess_l + 4), pCore_l->getSafetyCapasByRess());
+
+    const int solInit_l[] = {1, 0, 1};
+    EXPECT_EQ(vector<int>(solInit_l, solInit_l + 3), pCore_l->getSolInit());
+    EXPECT_EQ(pCore_l->getSolInit(), contextBO_l.getSolInit());
+    const int services_l[] = {0, 1, 0};
+    EXPECT_EQ(vector<int>(services_l, services_l + 3), pCore_l->getServiceOfProcess());
+    EXPECT_EQ(9, pCore_l->getPMC()[2]);
+
+    EXPECT_EQ(vector<int>(1, 1), pCore_l->getTransientRessources());
+    EXPECT_EQ(3, pCore_l->getWeightLoadCost()[1]);
+    EXPECT_EQ(1, pCore_l->getMachineLocation()[1]);
+    EXPECT_EQ(1, pCore_l->getMachineNeighborhood()[0]);
+    EXPECT_EQ(2, pCore_l->getSpreadMin()[0]);
+    EXPECT_EQ(2, pCore_l->getNbMaxProcessesByService());
+
+    const int processesService0_l[] = {0, 2};
+    IndexCSR::Plage processes_l = pCore_l->getProcessesByService().getLigne(0);
+    EXPECT_EQ(vector<int>(processesService0_l, processesService0_l + 2), vector<int>(processes_l.first, processes_l.second));
+    EXPECT_EQ(1, pCore_l->getProcessesByService().getTaille(1));
+    EXPECT_EQ(0, pCore_l->getServicesIDependOn().getTaille(0));
+    EXPECT_TRUE(pCore_l->getServicesIDependOn().contient(1, 0));
+    EXPECT_TRUE(pCore_l->getServicesDependingOnMe().contient(0, 1));
+    EXPECT_EQ(0, pCore_l->getServicesDependingOnMe().getTaille(1));
+
+    EXPECT_EQ(0, pCore_l->getBCRess1()[0]);
+    EXPECT_EQ(1, pCore_l->getBCRess2()[0]);
+    EXPECT_EQ(2, pCore_l->getBCTarget()[0]);
+    EXPECT_EQ(11, pCore_l->getBCPoids()[0]);
+}
+
+/**
+ * Le core est reconstruit si l'instance est modifiee, et a la lecture de la solution initiale.
+ * Celui qui a ete distribue avant reste valide (et decrit l'instance d'avant)
+ */
+TEST(InstanceCoreBO, construction){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceCoreBO(&contextBO_l);
+    boost::shared_ptr<InstanceCoreBO const> pAncien_l = contextBO_l.getInstanceCore();
+    EXPECT_EQ(3, (int) pAncien_l->getSolInit().size());
+
+    ContextBOBuilder::buildProcess(3, contextBO_l.getService(1), vector<int>(2, 1), 0, 1, &contextBO_l);
+    EXPECT_EQ(4, (int) contextBO_l.getSolInit().size());
+    EXPECT_EQ(3, pAncien_l->getNbProcesses());
+    EXPECT_EQ(3, (int) pAncien_l->getSolInit().size());
+
+    pAncien_l = contextBO_l.getInstanceCore();
+    istringstream iss_l("0 1 1 0");
+    SolutionDtoin::read(iss_l, &contextBO_l);
+    const int solInit_l[] = {0, 1, 1, 0};
+    EXPECT_EQ(vector<int>(solInit_l, solInit_l + 4), contextBO_l.getSolInit());
+    const int solAvant_l[] = {1, 0, 1, 1};
+    EXPECT_EQ(vector<int>(solAvant_l, solAvant_l + 4), pAncien_l->getSolInit());
+
+    contextBO_l.setMachineInit(3, 1);
+    EXPECT_EQ(1, contextBO_l.getSolInit()[3]);
+
+    //Les copies partagent le core deja construit tant qu'elles ne sont pas modifiees
+    pAncien_l = contextBO_l.getInstanceCore();
+    ContextBO copie_l(contextBO_l);
+    EXPECT_EQ(pAncien_l, copie_l.getInstanceCore());
+    copie_l.setMachineInit(3, 0);
+    EXPECT_EQ(0, copie_l.getSolInit()[3]);
+    EXPECT_EQ(1, contextBO_l.getSolInit()[3]);
+}
+
+/**
+ * Pour une instance lue, la matrice des requirements est stockee une seule fois : partagee par
+ * les ProcessBO, par l'#InstanceCoreBO et par les copies du contexte
+ */
+TEST(InstanceCoreBO, requirementsPartages){
+    ContextBO contextBO_l;
+    TestDtoinHelper::loadTestDataRessource(&contextBO_l);
+    TestDtoinHelper::loadTestDataMachine(&contextBO_l);
+    TestDtoinHelper::loadTestDataService(&contextBO_l);
+    TestDtoinHelper::loadTestDataProcess(&contextBO_l);
+    TestDtoinHelper::loadTestDataBalanceCost(&contextBO_l);
+    TestDtoinHelper::loadTestDataPoids(&contextBO_l);
+    TestDtoinHelper::loadTestDataSolInit(&contextBO_l);
+
+    const vector<int>* pStock_l = contextBO_l.getProcess(0)->getStockRequirements().get();
+    EXPECT_EQ(pStock_l, &contextBO_l.getInstanceCore()->getRequirements());
+
+    ContextBO copie_l(contextBO_l);
+    EXPECT_EQ(pStock_l, copie_l.getProcess(2)->getStockRequirements().get());
+    EXPECT_EQ(6, copie_l.getProcess(2)->getRequirement(0));
+    EXPECT_TRUE(*contextBO_l.getProcess(1) == *copie_l.getProcess(1));
+
+    //Un process ajoute a la main a sa propre ligne : le core recopie alors les requirements
+    ContextBOBuilder::buildProcess(3, copie_l.getService(0), vector<int>(2, 5), 0, 0, &copie_l);
+    const vector<int>& requirements_l = copie_l.getInstanceCore()->getRequirements();
+    EXPECT_NE(pStock_l, &requirements_l);
+    ASSERT_EQ(8u, requirements_l.size());
+    EXPECT_EQ(vector<int>(pStock_l->begin(), pStock_l->end()), vector<int>(requirements_l.begin(), requirements_l.begin() + 6));
+    EXPECT_EQ(5, requirements_l[7]);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+#include "bo/MMCBO.hh"
+#include <cstdlib>
+#include <vector>
+#include <gtest/gtest.h>
+using namespace std;
+
+static void expectMemesCouts(const MMCBO& mmc_p, const vector<vector<int> >& costs_p){
+    ASSERT_EQ(mmc_p.getNbMachines(), (int) costs_p.size());
+    for ( size_t idxFrom_l=0 ; idxFrom_l < costs_p.size() ; idxFrom_l++ ){
+        for ( size_t idxTo_l=0 ; idxTo_l < costs_p.size() ; idxTo_l++ ){
+            EXPECT_EQ(costs_p[idxFrom_l][idxTo_l], mmc_p.getCost(idxFrom_l, idxTo_l));
+        }
+    }
+}
+
+/**
+ * Couts structures par location, comme dans les instances du challenge
+ */
+TEST(MMCBO, blocs){
+    const int nbMachines_l = 60;
+    const int nbLocations_l = 4;
+    vector<vector<int> > costs_l(nbMachines_l, vector<int>(nbMachines_l));
+    for ( int idxFrom_l=0 ; idxFrom_l < nbMachines_l ; idxFrom_l++ ){
+        for ( int idxTo_l=0 ; idxTo_l < nbMachines_l ; idxTo_l++ ){
+            costs_l[idxFrom_l][idxTo_l] = 3 * (idxFrom_l % nbLocations_l) + (idxTo_l % nbLocations_l);
+        }
+    }
+
+    MMCBO mmc_l(costs_l);
+    EXPECT_TRUE(mmc_l.isBlocs());
+    EXPECT_EQ(mmc_l.getNbClassesLignes(), nbLocations_l);
+    EXPECT_EQ(mmc_l.getNbClassesColonnes(), nbLocations_l);
+    EXPECT_LT(mmc_l.getTailleOctets() * 4, nbMachines_l * nbMachines_l * sizeof(int));
+    expectMemesCouts(mmc_l, costs_l);
+}
+
+/**
+ * Aucune structure : matrice a plat, sur 8 puis 16 bits, puis sur 32 bits
+ */
+TEST(MMCBO, plat){
+    const int nbMachines_l = 50;
+    const int maxCouts_l[] = {10, 1000, 1000000};
+    srand(42);
+    for ( int idxCas_l=0 ; idxCas_l < 3 ; idxCas_l++ ){
+        vector<vector<int> > costs_l(nbMachines_l, vector<int>(nbMachines_l));
+        vector<int> aPlat_l;
+        for ( int idxFrom_l=0 ; idxFrom_l < nbMachines_l ; idxFrom_l++ ){
+            for ( int idxTo_l=0 ; idxTo_l < nbMachines_l ; idxTo_l++ ){
+                costs_l[idxFrom_l][idxTo_l] = idxFrom_l == idxTo_l ? 0 : rand() % maxCouts_l[idxCas_l];
+                aPlat_l.push_back(costs_l[idxFrom_l][idxTo_l]);
+            }
+        }
+
+        MMCBO mmc_l(nbMachines_l, aPlat_l);
+        EXPECT_TRUE(aPlat_l.empty());
+        EXPECT_FALSE(mmc_l.isBlocs());
+        expectMemesCouts(mmc_l, costs_l);
+        EXPECT_TRUE(mmc_l == MMCBO(costs_l));
+
+        const size_t tailleBrute_l = nbMachines_l * nbMachines_l * sizeof(int);
+        if ( idxCas_l == 0 ){
+            EXPECT_LT(mmc_l.getTailleOctets() * 3, tailleBrute_l);
+        } else if ( idxCas_l == 1 ){
+            EXPECT_LT(mmc_l.getTailleOctets(), tailleBrute_l);
+        }
+
+        costs_l[1][2]++;
+        EXPECT_TRUE(mmc_l != MMCBO(costs_l));
+    }
+}
+
+/**
+ * Quelques lignes identiques, mais pas assez pour que les blocs soient rentables
+ */
+TEST(MMCBO, lignesRepeteesAPlat){
+    const int nbMachines_l = 50;
+    srand(7);
+    vector<vector<int> > costs_l(nbMachines_l, vector<int>(nbMachines_l));
+    for ( int idxFrom_l=0 ; idxFrom_l < nbMachines_l ; idxFrom_l++ ){
+        for ( int idxTo_l=0 ; idxTo_l < nbMachines_l ; idxTo_l++ ){
+            costs_l[idxFrom_l][idxTo_l] = idxFrom_l % 3 == 2 ? costs_l[idxFrom_l / 2][idxTo_l] : rand() % 20;
+        }
+    }
+
+    MMCBO mmc_l(costs_l);
+    EXPECT_FALSE(mmc_l.isBlocs());
+    EXPECT_LT(mmc_l.getNbClassesLignes(), nbMachines_l);
+    expectMemesCouts(mmc_l, costs_l);
+}
+
+TEST(MMCBO, valeursNegativesEtGrandes){
+    vector<vector<int> > costs_l(3, vector<int>(3, 0));
+    costs_l[0][1] = -5;
+    costs_l[0][2] = 7;
+    costs_l[2][0] = 100000;
+    MMCBO mmc_l(costs_l);
+    EXPECT_EQ(mmc_l.getCost(0, 1), -5);
+    EXPECT_EQ(mmc_l.getCost(0, 2), 7);
+    EXPECT_EQ(mmc_l.getCost(2, 0), 100000);
+    EXPECT_EQ(mmc_l.getCost(1, 1), 0);
+}
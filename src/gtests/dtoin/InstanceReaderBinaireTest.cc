@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "dtoin/InstanceReaderBinaire.hh"
+#include "dtoout/InstanceWriterBinaire.hh"
+#include "bo/ContextBO.hh"
+#include "bo/MMCBO.hh"
+#include "bo/RessourceBO.hh"
+#include "bo/ServiceBO.hh"
+#include "gtests/ContextBOBuilder.hh"
+#include "gtests/dtoin/TestDtoinHelper.hh"
+#include "tools/InstanceBinaire.hh"
+#include <cstring>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+using namespace std;
+
+namespace {
+    /**
+     * 1 ressource, 1 machine, 2 services (le second de spreadMin et de dependances donnes), 1 process
+     */
+    string writeInstanceServices(int spreadMin_p, int dependance_p){
+        ContextBO context_l;
+        context_l.addRessource(new RessourceBO(0, false, 1));
+        ContextBOBuilder::buildMachine(0, 0, 0, vector<int>(1, 10), vector<int>(1, 10), &context_l);
+        ServiceBO* pService_l = ContextBOBuilder::buildService(0, 0, unordered_set<int>(), &context_l);
+        unordered_set<int> dependances_l;
+        dependances_l.insert(dependance_p);
+        ContextBOBuilder::buildService(1, spreadMin_p, dependances_l, &context_l);
+        ContextBOBuilder::buildProcess(0, pService_l, vector<int>(1, 1), 0, 0, &context_l);
+        ContextBOBuilder::buildDefaultMMC(&context_l);
+        InstanceWriterBinaire writer_l;
+        return writer_l.write(&context_l);
+    }
+
+    /**
+     * Remplace les index des dependances de l'instance de writeInstanceServices, en recalculant le checksum
+     */
+    string remplaceDebutsDependances(const string& donnees_p, int32_t debut0_p, int32_t debut1_p, int32_t debut2_p){
+        string result_l(donnees_p);
+        //8 tableaux d'au plus 2 valeurs (8 octets chacun) precedent les index : ressources, machines, mmc, spreadMin
+        const size_t pos_l = sizeof(InstanceBinaire::Entete) + 8 * InstanceBinaire::tailleTableau(1);
+        const int32_t debuts_l[] = {debut0_p, debut1_p, debut2_p};
+        memcpy(&result_l[pos_l], debuts_l, sizeof(debuts_l));
+        const size_t tailleCorps_l = result_l.size() - sizeof(InstanceBinaire::Entete) - sizeof(uint64_t);
+        const uint64_t checksum_l = InstanceBinaire::checksum(result_l.data() + sizeof(InstanceBinaire::Entete), tailleCorps_l);
+        memcpy(&result_l[result_l.size() - sizeof(uint64_t)], &checksum_l, sizeof(checksum_l));
+        return result_l;
+    }
+
+    /**
+     * Copie l'instance dans un buffer aligne sur 8 octets, comme le serait un fichier mappe
+     */
+    vector<uint64_t> toBufferAligne(const string& donnees_p){
+        vector<uint64_t> result_l((donnees_p.size() + 7) / 8);
+        memcpy(&result_l[0], donnees_p.data(), donnees_p.size());
+        return result_l;
+    }
+}
+
+TEST(dtoin, InstanceReaderBinaireAllerRetour){
+    ContextBO contextInit_l;
+    TestDtoinHelper::loadTestData(&contextInit_l);
+
+    InstanceWriterBinaire writer_l;
+    const string donnees_l = writer_l.write(&contextInit_l);
+    ASSERT_EQ(sizeof(InstanceBinaire::Entete), 64u);
+    ASSERT_EQ(0u, donnees_l.size() % 8);
+    EXPECT_EQ(donnees_l, writer_l.write(&contextInit_l));
+
+    //Le checksum du corps, calcule au fil de l'ecriture, termine le fichier
+    uint64_t checksum_l;
+    memcpy(&checksum_l, donnees_l.data() + donnees_l.size() - sizeof(checksum_l), sizeof(checksum_l));
+    const vector<uint64_t> corps_l = toBufferAligne(donnees_l.substr(sizeof(InstanceBinaire::Entete),
+                donnees_l.size() - sizeof(InstanceBinaire::Entete) - sizeof(checksum_l)));
+    EXPECT_EQ(InstanceBinaire::checksum(reinterpret_cast<const char*>(&corps_l[0]), corps_l.size() * 8), checksum_l);
+
+    vector<uint64_t> buffer_l = toBufferAligne(donnees_l);
+    InstanceReaderBinaire reader_l;
+    ContextBO contextLu_l = reader_l.readBuffer(reinterpret_cast<const char*>(&buffer_l[0]), donnees_l.size());
+    TestDtoinHelper::loadTestDataSolInit(&contextLu_l);
+
+    EXPECT_TRUE(contextInit_l == contextLu_l);
+    EXPECT_EQ(contextInit_l.getNbLocations(), contextLu_l.getNbLocations());
+    EXPECT_EQ(contextInit_l.getNbNeighborhoods(), contextLu_l.getNbNeighborhoods());
+    EXPECT_EQ(contextInit_l.getNbBalanceCosts(), contextLu_l.getNbBalanceCosts());
+    EXPECT_EQ(contextInit_l.getPoidsMMC(), contextLu_l.getPoidsMMC());
+    for ( int idxS_l=0 ; idxS_l < contextInit_l.getNbServices() ; idxS_l++ ){
+        EXPECT_TRUE(*contextInit_l.getService(idxS_l) == *contextLu_l.getService(idxS_l));
+    }
+    EXPECT_TRUE(*contextInit_l.getMMCBO() == *contextLu_l.getMMCBO());
+}
+
+TEST(dtoin, InstanceReaderBinaireRejette){
+    ContextBO context_l;
+    TestDtoinHelper::loadTestData(&context_l);
+    InstanceWriterBinaire writer_l;
+    const string donnees_l = writer_l.write(&context_l);
+    InstanceReaderBinaire reader_l;
+
+    //Corps corrompu : detecte par le checksum
+    string corrompu_l(donnees_l);
+    corrompu_l[corrompu_l.size() - 13] ^= 0x10;
+    vector<uint64_t> buffer_l = toBufferAligne(corrompu_l);
+    EXPECT_ANY_THROW(reader_l.readBuffer(reinterpret_cast<const char*>(&buffer_l[0]), corrompu_l.size()));
+
+    //Fichier tronque
+    buffer_l = toBufferAligne(donnees_l);
+    EXPECT_ANY_THROW(reader_l.readBuffer(reinterpret_cast<const char*>(&buffer_l[0]), donnees_l.size() - 8));
+    EXPECT_ANY_THROW(reader_l.readBuffer(reinterpret_cast<const char*>(&buffer_l[0]), 10));
+
+    //Version inconnue
+    string version_l(donnees_l);
+    version_l[8] = 42;
+    buffer_l = toBufferAligne(version_l);
+    EXPECT_ANY_THROW(reader_l.readBuffer(reinterpret_cast<const char*>(&buffer_l[0]), version_l.size()));
+
+    //Fichier texte
+    const string texte_l("1\n0 1\n");
+    buffer_l = toBufferAligne(texte_l);
+    EXPECT_ANY_THROW(reader_l.readBuffer(reinterpret_cast<const char*>(&buffer_l[0]), texte_l.size()));
+}
+
+TEST(dtoin, InstanceReaderBinaireRejetteServicesHorsBornes){
+    InstanceReaderBinaire reader_l;
+    string donnees_l = writeInstanceServices(1, 0);
+    vector<uint64_t> buffer_l = toBufferAligne(donnees_l);
+    EXPECT_NO_THROW(reader_l.readBuffer(reinterpret_cast<const char*>(&buffer_l[0]), donnees_l.size()));
+
+    //Les checksums sont valides : seules les verifications de bornes peuvent rejeter ces instances
+    const int dependances_l[] = {2, -1};
+    for ( int idx_l=0 ; idx_l < 2 ; idx_l++ ){
+        donnees_l = writeInstanceServices(1, dependances_l[idx_l]);
+        buffer_l = toBufferAligne(donnees_l);
+        EXPECT_ANY_THROW(reader_l.readBuffer(reinterpret_cast<const char*>(&buffer_l[0]), donnees_l.size()));
+    }
+
+    const int spreadMins_l[] = {2, -1};
+    for ( int idx_l=0 ; idx_l < 2 ; idx_l++ ){
+        donnees_l = writeInstanceServices(spreadMins_l[idx_l], 0);
+        buffer_l = toBufferAligne(donnees_l);
+        EXPECT_ANY_THROW(reader_l.readBuffer(reinterpret_cast<const char*>(&buffer_l[0]), donnees_l.size()));
+    }
+}
+
+TEST(dtoin, InstanceReaderBinaireRejetteIndexDependances){
+    InstanceReaderBinaire reader_l;
+    const string donnees_l = writeInstanceServices(1, 0);
+    string modifie_l = remplaceDebutsDependances(donnees_l, 0, 0, 1);
+    vector<uint64_t> buffer_l = toBufferAligne(modifie_l);
+    EXPECT_NO_THROW(reader_l.readBuffer(reinterpret_cast<const char*>(&buffer_l[0]), modifie_l.size()));
+
+    //Ne commence pas a 0, ne finit pas a nbDependances, decroissant
+    const int32_t debuts_l[][3] = {{1, 1, 1}, {0, 0, 0}, {0, 1, 0}};
+    for ( int idx_l=0 ; idx_l < 3 ; idx_l++ ){
+        modifie_l = remplaceDebutsDependances(donnees_l, debuts_l[idx_l][0], debuts_l[idx_l][1], debuts_l[idx_l][2]);
+        buffer_l = toBufferAligne(modifie_l);
+        EXPECT_ANY_THROW(reader_l.readBuffer(reinterpret_cast<const char*>(&buffer_l[0]), modifie_l.size()));
+    }
+}
@@ -26,8 +26,48 @@
 #include "bo/MachineBO.hh"
 #include "bo/MMCBO.hh"
 #include "bo/NeighborhoodBO.hh"
+#include "dtoin/MachineDtoin.hh"
 #include "gtests/dtoin/TestDtoinHelper.hh"
+#include <sstream>
+#include <string>
 #include <gtest/gtest.h>
+using namespace std;
+
+namespace {
+    /**
+     * Section machines de nbMachines_p machines (pour 2 ressources), avec des blancs irreguliers.
+     * Si idxMachineErreur_p est positif, un cout de la MMC de cette machine est invalide
+     */
+    string getSectionMachines(int nbMachines_p, int idxMachineErreur_p){
+        ostringstream oss_l;
+        oss_l << nbMachines_p << "\n";
+        for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_p ; idxMachine_l++ ){
+            oss_l << idxMachine_l % 3 << " " << idxMachine_l / 2 << "\t" << 100 + idxMachine_l << " " << 2000 * idxMachine_l
+                << "  " << 50 + idxMachine_l << " " << 1000 * idxMachine_l << "\n";
+            for ( int idxDest_l=0 ; idxDest_l < nbMachines_p ; idxDest_l++ ){
+                if ( idxMachine_l == idxMachineErreur_p && idxDest_l == 2 ){
+                    oss_l << "x ";
+                } else {
+                    oss_l << (idxMachine_l * 7 + idxDest_l * 13) % (idxDest_l % 2 ? 11 : 1000) << (idxDest_l % 5 ? " " : "\n ");
+                }
+            }
+            oss_l << "\r\n";
+        }
+        return oss_l.str();
+    }
+
+    string lisSectionMachines(const string& section_p, int nbThreads_p, ContextBO* pContext_p){
+        TestDtoinHelper::loadTestDataRessource(pContext_p);
+        istringstream iss_l(section_p + "  1 2");
+        MachineDtoin reader_l(nbThreads_p);
+        try {
+            reader_l.read(iss_l, pContext_p);
+        } catch (string& s_l){
+            return s_l;
+        }
+        return "";
+    }
+}
 
 TEST(dtoin, MachineDtoin){
     ContextBO context_l;
@@ -75,7 +115,7 @@ TEST(dtoin, MachineDtoin){
     EXPECT_EQ(context_l.getMachine(3)->getSafetyCapa(1), 80);
 
     //MMC
-    MMCBO* pMMC_l = context_l.getMMCBO();
+    MMCBO const * pMMC_l = context_l.getMMCBO();
     EXPECT_EQ(pMMC_l->getCost(0, 0), 0);
     EXPECT_EQ(pMMC_l->getCost(0, 1), 1);
     EXPECT_EQ(pMMC_l->getCost(0, 2), 4);
@@ -93,3 +133,59 @@ TEST(dtoin, MachineDtoin){
     EXPECT_EQ(pMMC_l->getCost(3, 2), 2);
     EXPECT_EQ(pMMC_l->getCost(3, 3), 0);
 }
+
+TEST(dtoin, MachineDtoinParallele){
+    const int nbMachines_l = 13;
+    const string section_l = getSectionMachines(nbMachines_l, -1);
+    ContextBO contextSequentiel_l;
+    ASSERT_EQ("", lisSectionMachines(section_l, 1, &contextSequentiel_l));
+
+    for ( int nbThreads_l=2 ; nbThreads_l <= nbMachines_l + 2 ; nbThreads_l++ ){
+        ContextBO context_l;
+        ASSERT_EQ("", lisSectionMachines(section_l, nbThreads_l, &context_l));
+        ASSERT_EQ(nbMachines_l, context_l.getNbMachines());
+        EXPECT_EQ(contextSequentiel_l.getNbLocations(), context_l.getNbLocations());
+        EXPECT_EQ(contextSequentiel_l.getNbNeighborhoods(), context_l.getNbNeighborhoods());
+        for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
+            const MachineBO* pAttendue_l = contextSequentiel_l.getMachine(idxMachine_l);
+            const MachineBO* pMachine_l = context_l.getMachine(idxMachine_l);
+            EXPECT_EQ(pAttendue_l->getNeighborhood()->getId(), pMachine_l->getNeighborhood()->getId());
+            EXPECT_EQ(pAttendue_l->getLocation()->getId(), pMachine_l->getLocation()->getId());
+            for ( int idxRess_l=0 ; idxRess_l < 2 ; idxRess_l++ ){
+                EXPECT_EQ(pAttendue_l->getCapa(idxRess_l), pMachine_l->getCapa(idxRess_l));
+                EXPECT_EQ(pAttendue_l->getSafetyCapa(idxRess_l), pMachine_l->getSafetyCapa(idxRess_l));
+            }
+            for ( int idxDest_l=0 ; idxDest_l < nbMachines_l ; idxDest_l++ ){
+                EXPECT_EQ(contextSequentiel_l.getMMCBO()->getCost(idxMachine_l, idxDest_l),
+                        context_l.getMMCBO()->getCost(idxMachine_l, idxDest_l));
+            }
+        }
+    }
+    EXPECT_EQ(2000 * 12, contextSequentiel_l.getMachine(12)->getCapa(1));
+    EXPECT_EQ((12 * 7 + 4 * 13) % 1000, contextSequentiel_l.getMMCBO()->getCost(12, 4));
+}
+
+TEST(dtoin, MachineDtoinParalleleErreurs){
+    //Meme message qu'en sequentiel, quelle que soit la tranche en erreur
+    for ( int idxMachineErreur_l=0 ; idxMachineErreur_l < 9 ; idxMachineErreur_l++ ){
+        ContextBO contextSequentiel_l;
+        const string section_l = getSectionMachines(9, idxMachineErreur_l);
+        const string erreur_l = lisSectionMachines(section_l, 1, &contextSequentiel_l);
+        EXPECT_NE(string::npos, erreur_l.find("machine move cost attendu")) << erreur_l;
+        for ( int nbThreads_l=2 ; nbThreads_l <= 5 ; nbThreads_l++ ){
+            ContextBO context_l;
+            EXPECT_EQ(erreur_l, lisSectionMachines(section_l, nbThreads_l, &context_l));
+        }
+    }
+
+    //Section tronquee
+    const string section_l = getSectionMachines(9, -1);
+    const string sectionTronquee_l = section_l.substr(0, section_l.size() * 2 / 3);
+    ContextBO contextSequentiel_l;
+    const string erreur_l = lisSectionMachines(sectionTronquee_l, 1, &contextSequentiel_l);
+    EXPECT_NE("", erreur_l);
+    for ( int nbThreads_l=2 ; nbThreads_l <= 5 ; nbThreads_l++ ){
+        ContextBO context_l;
+        EXPECT_EQ(erreur_l, lisSectionMachines(sectionTronquee_l, nbThreads_l, &context_l));
+    }
+}
@@ -52,6 +52,14 @@ TEST(dtoin, ProcessDtoin){
     EXPECT_EQ(context_l.getProcess(2)->getRequirement(1), 200);
     EXPECT_EQ(context_l.getProcess(2)->getPMC(), 1);
 
+    //Une consommation par ressource, pas une par process, dans une seule matrice P x R
+    for ( int idxP_l=0 ; idxP_l < context_l.getNbProcesses() ; idxP_l++ ){
+        EXPECT_EQ((int) context_l.getProcess(idxP_l)->getRequirements().size(), context_l.getNbRessources());
+        EXPECT_EQ(context_l.getProcess(0)->getStockRequirements(), context_l.getProcess(idxP_l)->getStockRequirements());
+        EXPECT_EQ(idxP_l, context_l.getProcess(idxP_l)->getLigneRequirements());
+    }
+    EXPECT_EQ(6u, context_l.getProcess(0)->getStockRequirements()->size());
+
     ASSERT_EQ(context_l.getService(0)->getNbProcesses(), 2);
     EXPECT_TRUE(context_l.getService(0)->containsProcess(0));
     EXPECT_TRUE(context_l.getService(0)->containsProcess(1));
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "dtoin/ScannerDtoin.hh"
+#include <climits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+using namespace std;
+
+namespace {
+    /**
+     * @return le message de l'exception levee par lireEntier sur le premier entier de contenu_p
+     */
+    string erreurLecture(const string& contenu_p){
+        istringstream iss_l(contenu_p);
+        ScannerDtoin scanner_l(iss_l, "test");
+        try {
+            scanner_l.lireEntier("valeur");
+        } catch (string& s_l){
+            return s_l;
+        }
+        return "";
+    }
+}
+
+TEST(dtoin, ScannerDtoinLecture){
+    istringstream iss_l(" 12\t-7\r\n0\n\n2147483647 -2147483648 3 4 5 ");
+    ScannerDtoin scanner_l(iss_l, "test");
+    EXPECT_EQ(12, scanner_l.lireEntier("a"));
+    EXPECT_EQ(-7, scanner_l.lireEntier("b"));
+    EXPECT_EQ(0, scanner_l.lireEntier("c"));
+    EXPECT_EQ(INT_MAX, scanner_l.lireEntier("d"));
+    EXPECT_EQ(INT_MIN, scanner_l.lireEntier("e"));
+    int tab_l[3];
+    scanner_l.lireEntiers(tab_l, 3, "f");
+    EXPECT_EQ(3, tab_l[0]);
+    EXPECT_EQ(5, tab_l[2]);
+    EXPECT_TRUE(scanner_l.isFini());
+}
+
+TEST(dtoin, ScannerDtoinToutesLongueurs){
+    //Couvre le cas 1 chiffre, le decodage par mots (2 a 7 chiffres) et la boucle (8 chiffres et plus)
+    vector<int> attendus_l;
+    ostringstream oss_l;
+    int valeur_l = 0;
+    for ( int nbChiffres_l=1 ; nbChiffres_l <= 9 ; nbChiffres_l++ ){
+        valeur_l = valeur_l * 10 + (nbChiffres_l % 10);
+        attendus_l.push_back(valeur_l);
+        attendus_l.push_back(-valeur_l);
+        oss_l << valeur_l << " " << -valeur_l << (nbChiffres_l % 2 ? "\n" : "\t");
+    }
+    attendus_l.push_back(7);
+    oss_l << "0000007";
+
+    istringstream iss_l(oss_l.str());
+    ScannerDtoin scanner_l(iss_l, "test");
+    vector<int> lus_l(attendus_l.size());
+    scanner_l.lireEntiers(&lus_l[0], lus_l.size(), "valeur");
+    EXPECT_EQ(attendus_l, lus_l);
+    EXPECT_TRUE(scanner_l.isFini());
+}
+
+TEST(dtoin, ScannerDtoinErreurs){
+    EXPECT_EQ("", erreurLecture("42"));
+    EXPECT_EQ("test:1:1 : valeur attendu, fin de fichier atteinte", erreurLecture(""));
+    EXPECT_EQ("test:3:3 : valeur attendu (entier 32 bits), trouve '12a'", erreurLecture("\n \n  12a 4"));
+    EXPECT_NE("", erreurLecture("-"));
+    EXPECT_NE("", erreurLecture("- 3"));
+    EXPECT_NE("", erreurLecture("2147483648"));
+    EXPECT_NE("", erreurLecture("-2147483649"));
+    EXPECT_NE("", erreurLecture("123456789012345678901234"));
+    EXPECT_NE("", erreurLecture("1.5"));
+
+    //Un '\0' au milieu du texte est refuse (a la lecture qui le rencontre)
+    istringstream issNul_l(string("1\0 2", 4));
+    ScannerDtoin scannerNul_l(issNul_l, "test");
+    EXPECT_EQ(1, scannerNul_l.lireEntier("valeur"));
+    EXPECT_FALSE(scannerNul_l.isFini());
+    EXPECT_ANY_THROW(scannerNul_l.lireEntier("valeur"));
+
+    istringstream iss_l("3\n 9");
+    ScannerDtoin scanner_l(iss_l, "test");
+    EXPECT_EQ(3, scanner_l.lireEntier("nb", 0, 5));
+    try {
+        scanner_l.lireEntier("indice", 0, 5);
+        FAIL();
+    } catch (string& s_l){
+        EXPECT_EQ("test:2:2 : indice (9) hors de l'intervalle [0, 5]", s_l);
+    }
+}
+
+TEST(dtoin, ScannerDtoinLocaliseTokens){
+    const string texte_l = "5\n 10 -2\t\t333\n\n4 55 6 ";
+    for ( int nbThreads_l=1 ; nbThreads_l <= 12 ; nbThreads_l++ ){
+        istringstream iss_l(texte_l);
+        ScannerDtoin scanner_l(iss_l, "test");
+        EXPECT_EQ(5, scanner_l.lireEntier("a"));
+
+        vector<size_t> rangs_l;
+        rangs_l.push_back(0);
+        rangs_l.push_back(2);
+        rangs_l.push_back(2);
+        rangs_l.push_back(5);
+        rangs_l.push_back(6);
+        rangs_l.push_back(9);
+        const vector<size_t> offsets_l = scanner_l.localiseTokens(rangs_l, nbThreads_l);
+        ASSERT_EQ(rangs_l.size(), offsets_l.size());
+        EXPECT_EQ(texte_l.find("10"), offsets_l[0]);
+        EXPECT_EQ(texte_l.find("333"), offsets_l[1]);
+        EXPECT_EQ(texte_l.find("333"), offsets_l[2]);
+        EXPECT_EQ(texte_l.find("6 "), offsets_l[3]);
+        EXPECT_EQ(texte_l.size(), offsets_l[4]);
+        EXPECT_EQ(texte_l.size(), offsets_l[5]);
+
+        //Une vue lit a partir de la position donnee, et le parent peut reprendre ou elle s'arrete
+        ScannerDtoin vue_l(scanner_l, offsets_l[1]);
+        EXPECT_EQ(333, vue_l.lireEntier("b"));
+        EXPECT_EQ(4, vue_l.lireEntier("c"));
+        scanner_l.setOffset(vue_l.getOffset());
+        EXPECT_EQ(55, scanner_l.lireEntier("d"));
+        EXPECT_EQ(6, scanner_l.lireEntier("e"));
+        EXPECT_TRUE(scanner_l.isFini());
+    }
+}
@@ -74,6 +74,16 @@ void TestDtoinHelper::loadTestDataSolInit(ContextBO* pContextBO_p){
     reader_l.read(iss_l, pContextBO_p);
 }
 
+void TestDtoinHelper::loadTestData(ContextBO* pContextBO_p){
+    loadTestDataRessource(pContextBO_p);
+    loadTestDataMachine(pContextBO_p);
+    loadTestDataService(pContextBO_p);
+    loadTestDataProcess(pContextBO_p);
+    loadTestDataBalanceCost(pContextBO_p);
+    loadTestDataPoids(pContextBO_p);
+    loadTestDataSolInit(pContextBO_p);
+}
+
 string TestDtoinHelper::getMachineTestData(){
     return string("4 \
  \
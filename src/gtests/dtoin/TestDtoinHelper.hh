@@ -39,6 +39,11 @@ class TestDtoinHelper {
         static void loadTestDataPoids(ContextBO* pContextBO_p);
         static void loadTestDataSolInit(ContextBO* pContextBO_p);
 
+        /**
+         * Toutes les sections ci-dessus, solution initiale comprise
+         */
+        static void loadTestData(ContextBO* pContextBO_p);
+
     private:
         static string getMachineTestData();
         static string getRessourceTestData();
@@ -23,6 +23,9 @@
 
 #include "dtoout/SolutionDtoout.hh"
 #include <boost/thread.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <gtest/gtest.h>
 using namespace boost;
 using namespace boost::date_time;
@@ -80,3 +83,56 @@ TEST(SolutionDtoout, unlockIfWrongFile){
     ASSERT_TRUE(thread_l.timed_join(boost::posix_time::millisec(3000)));
 
 }
+
+TEST(SolutionDtoout, ecrivainAsynchrone){
+    const string nomFichier_l = "/tmp/SolutionDtooutTest_ecrivain.txt";
+    SolutionDtoout::reinit(nomFichier_l);
+    ASSERT_TRUE(SolutionDtoout::writeSol(vector<int>(3, 7), 1000));
+    SolutionDtoout::demarreEcrivain();
+
+    //Rafale d'ameliorations : seule la derniere doit se retrouver dans le fichier
+    vector<int> sol_l(4);
+    for ( int idx_l=0 ; idx_l < 200 ; idx_l++ ){
+        sol_l[0] = idx_l;
+        sol_l[3] = -idx_l;
+        ASSERT_TRUE(SolutionDtoout::writeSol(sol_l, 999 - idx_l));
+        ASSERT_FALSE(SolutionDtoout::writeSol(vector<int>(), 999 - idx_l));
+    }
+    EXPECT_EQ(800u, SolutionDtoout::getBestScore());
+    EXPECT_EQ(sol_l, SolutionDtoout::getBestSol());
+    SolutionDtoout::termineEcriture();
+
+    ifstream ifs_l(nomFichier_l.c_str());
+    string contenu_l((istreambuf_iterator<char>(ifs_l)), istreambuf_iterator<char>());
+    EXPECT_EQ("199 0 0 -199 ", contenu_l);
+    EXPECT_FALSE(ifstream((nomFichier_l + ".tmp").c_str()));
+
+    //De nouveau synchrone
+    sol_l[1] = 5;
+    ASSERT_TRUE(SolutionDtoout::writeSol(sol_l, 10));
+    ifstream ifs2_l(nomFichier_l.c_str());
+    contenu_l.assign(istreambuf_iterator<char>(ifs2_l), istreambuf_iterator<char>());
+    EXPECT_EQ("199 5 0 -199 ", contenu_l);
+    remove(nomFichier_l.c_str());
+}
+
+TEST(SolutionDtoout, restaureSolutionVerifiee){
+    const string nomFichier_l = "/tmp/SolutionDtooutTest_restaure.txt";
+    SolutionDtoout::reinit(nomFichier_l);
+    ASSERT_TRUE(SolutionDtoout::writeSol(vector<int>(3, 7), 1000));
+    SolutionDtoout::demarreEcrivain();
+    ASSERT_TRUE(SolutionDtoout::writeSol(vector<int>(3, 1), 10));
+
+    //La meilleure solution (jugee incoherente) est remplacee sur disque par la solution verifiee
+    SolutionDtoout::restaure(vector<int>(3, 7));
+    ifstream ifs_l(nomFichier_l.c_str());
+    string contenu_l((istreambuf_iterator<char>(ifs_l)), istreambuf_iterator<char>());
+    EXPECT_EQ("7 7 7 ", contenu_l);
+
+    //...et n'est plus ecrite ensuite
+    SolutionDtoout::termineEcriture();
+    ifstream ifs2_l(nomFichier_l.c_str());
+    contenu_l.assign(istreambuf_iterator<char>(ifs2_l), istreambuf_iterator<char>());
+    EXPECT_EQ("7 7 7 ", contenu_l);
+    remove(nomFichier_l.c_str());
+}
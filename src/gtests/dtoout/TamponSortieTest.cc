@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "dtoout/TamponSortie.hh"
+#include "dtoout/InstanceWriterDtoout.hh"
+#include "dtoout/InstanceWriterHumanReadable.hh"
+#include "dtoin/InstanceReaderDtoin.hh"
+#include "bo/ContextBO.hh"
+#include "gtests/dtoin/TestDtoinHelper.hh"
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+using namespace std;
+
+namespace {
+    string litFichier(const string& filename_p){
+        ifstream ifs_l(filename_p.c_str(), ios::binary);
+        return string((istreambuf_iterator<char>(ifs_l)), istreambuf_iterator<char>());
+    }
+}
+
+TEST(TamponSortie, formatage){
+    //Assez de texte pour vider le tampon plusieurs fois
+    ostringstream attendu_l;
+    string result_l;
+    TamponSortie tampon_l(result_l);
+    const string texteLong_l(3000000, 'x');
+    for ( int idx_l=-300000 ; idx_l < 300000 ; idx_l += 7 ){
+        tampon_l << idx_l << ' ';
+        attendu_l << idx_l << ' ';
+    }
+    tampon_l << INT_MIN << '\n' << INT_MAX << "fin" << texteLong_l << string("!");
+    attendu_l << INT_MIN << '\n' << INT_MAX << "fin" << texteLong_l << string("!");
+    tampon_l.termine();
+    EXPECT_EQ(attendu_l.str(), result_l);
+}
+
+TEST(TamponSortie, destinations){
+    const string filename_l = "/tmp/TamponSortieTest.txt";
+    {
+        TamponSortie tampon_l(filename_l);
+        tampon_l << 12 << " ab " << -3;
+        tampon_l.termine();
+    }
+    EXPECT_EQ("12 ab -3", litFichier(filename_l));
+    remove(filename_l.c_str());
+
+    ostringstream oss_l;
+    TamponSortie tamponFlux_l(oss_l);
+    tamponFlux_l << 0 << 'c';
+    tamponFlux_l.termine();
+    EXPECT_EQ("0c", oss_l.str());
+
+    EXPECT_ANY_THROW(TamponSortie("/W/T/F.txt"));
+}
+
+TEST(TamponSortie, memoireReutilisee){
+    const string filename_l = "/tmp/TamponSortieTest_memoire.txt";
+    vector<char> memoire_l;
+    {
+        TamponSortie tampon_l(filename_l, memoire_l);
+        tampon_l << 1 << ' ' << 2;
+        tampon_l.termine();
+    }
+    EXPECT_EQ("1 2", litFichier(filename_l));
+    ASSERT_FALSE(memoire_l.empty());
+
+    //La seconde ecriture reprend le meme tampon, sans reallocation
+    const char* pMemoire_l = &memoire_l[0];
+    {
+        TamponSortie tampon_l(filename_l, memoire_l);
+        tampon_l << -4;
+        tampon_l.termine();
+    }
+    EXPECT_EQ("-4", litFichier(filename_l));
+    EXPECT_EQ(pMemoire_l, &memoire_l[0]);
+    remove(filename_l.c_str());
+}
+
+TEST(TamponSortie, writersInstance){
+    ContextBO context_l;
+    TestDtoinHelper::loadTestData(&context_l);
+
+    //Meme texte quelle que soit la destination, et relecture a l'identique
+    InstanceWriterDtoout writer_l;
+    const string texte_l = writer_l.write(&context_l);
+    const string filename_l = "/tmp/TamponSortieTest_instance.txt";
+    writer_l.write(&context_l, filename_l);
+    EXPECT_EQ(texte_l, litFichier(filename_l));
+
+    InstanceReaderDtoin reader_l;
+    ContextBO contextRelu_l = reader_l.read(filename_l);
+    EXPECT_EQ(texte_l, writer_l.write(&contextRelu_l));
+    remove(filename_l.c_str());
+
+    InstanceWriterHumanReadable writerHR_l;
+    ostringstream oss_l;
+    writerHR_l.write(&context_l, oss_l);
+    EXPECT_EQ(writerHR_l.write(&context_l), oss_l.str());
+    EXPECT_NE(string::npos, oss_l.str().find("==== Machine 3 / 4 ====\n  * Neighborhood : 1\n"));
+}
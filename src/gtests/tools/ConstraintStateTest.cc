@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "bo/ContextBO.hh"
+#include "bo/ServiceBO.hh"
+#include "gtests/ContextBOBuilder.hh"
+#include "tools/ConstraintState.hh"
+#include <vector>
+#include <tr1/unordered_set>
+#include <gtest/gtest.h>
+using namespace std;
+using namespace std::tr1;
+
+TEST(ConstraintState, miseAJour){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceConstraintState(&contextBO_l);
+    ConstraintState state_l(&contextBO_l);
+    state_l.reset(contextBO_l.getSolInit());
+    EXPECT_TRUE(state_l.isValid());
+    EXPECT_EQ(state_l.getNbLocationsUsed(0), 2);
+    EXPECT_EQ(state_l.getNbProcessesOnNeigh(2, 0), 1);
+
+    /* Deux process du service 2 sur la meme machine, puis on les separe */
+    state_l.moveProcess(3, 1, 2);
+    EXPECT_EQ(state_l.getNbConflicts(), 1);
+    EXPECT_FALSE(state_l.checkConflict());
+    state_l.moveProcess(4, 2, 0);
+    EXPECT_EQ(state_l.getNbConflicts(), 0);
+    EXPECT_TRUE(state_l.isServiceOnMachine(2, 2));
+    EXPECT_TRUE(state_l.isServiceOnMachine(2, 0));
+    EXPECT_FALSE(state_l.isServiceOnMachine(2, 1));
+
+    /* Le service 0 ne s'etend plus que sur une location */
+    state_l.moveProcess(1, 3, 1);
+    EXPECT_EQ(state_l.getNbLocationsUsed(0), 1);
+    EXPECT_FALSE(state_l.checkSpread());
+    EXPECT_TRUE(state_l.checkDependances());
+
+    /* Le service 0 quitte le neighborhood 0, ou le service 1 se trouve */
+    state_l.moveProcess(0, 0, 3);
+    EXPECT_TRUE(state_l.checkSpread());
+    EXPECT_FALSE(state_l.checkDependances());
+}
+
+TEST(ConstraintState, faisabiliteMouvement){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceConstraintState(&contextBO_l);
+    const vector<int>& solInit_l = contextBO_l.getSolInit();
+    ConstraintState state_l(&contextBO_l);
+    state_l.reset(solInit_l);
+
+    /* On compare chaque mouvement elementaire a une validation complete de la solution obtenue */
+    for ( int idxP_l=0 ; idxP_l < contextBO_l.getNbProcesses() ; idxP_l++ ){
+        for ( int idxMachine_l=0 ; idxMachine_l < contextBO_l.getNbMachines() ; idxMachine_l++ ){
+            vector<int> solApres_l(solInit_l);
+            solApres_l[idxP_l] = idxMachine_l;
+            ConstraintState stateApres_l(&contextBO_l);
+            stateApres_l.reset(solApres_l);
+
+            EXPECT_EQ(state_l.isFeasibleMove(idxP_l, solInit_l[idxP_l], idxMachine_l), stateApres_l.isValid())
+                << "process " << idxP_l << " vers la machine " << idxMachine_l;
+            EXPECT_EQ(state_l.isConflictOkForMove(idxP_l, solInit_l[idxP_l], idxMachine_l), stateApres_l.checkConflict());
+            EXPECT_EQ(state_l.isSpreadOkForMove(idxP_l, solInit_l[idxP_l], idxMachine_l), stateApres_l.checkSpread());
+            EXPECT_EQ(state_l.isDependancesOkForMove(idxP_l, solInit_l[idxP_l], idxMachine_l), stateApres_l.checkDependances());
+
+            /* L'etat deplace doit etre identique a celui construit de zero */
+            state_l.moveProcess(idxP_l, solInit_l[idxP_l], idxMachine_l);
+            EXPECT_EQ(state_l.isValid(), stateApres_l.isValid());
+            state_l.moveProcess(idxP_l, idxMachine_l, solInit_l[idxP_l]);
+            EXPECT_TRUE(state_l.isValid());
+        }
+    }
+}
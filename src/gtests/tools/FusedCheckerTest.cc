@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+#include "alg/ContextALG.hh"
+#include "bo/ContextBO.hh"
+#include "bo/MMCBO.hh"
+#include "bo/RessourceBO.hh"
+#include "bo/ServiceBO.hh"
+#include "gtests/ContextBOBuilder.hh"
+#include "tools/Checker.hh"
+#include "tools/FusedChecker.hh"
+#include <vector>
+#include <tr1/unordered_set>
+#include <gtest/gtest.h>
+using namespace std;
+using namespace std::tr1;
+
+static void expectSameResult(const CheckerResult& attendu_p, const CheckerResult& result_p){
+    EXPECT_EQ(attendu_p.valid, result_p.valid);
+    EXPECT_EQ(attendu_p.dominated, result_p.dominated);
+    EXPECT_EQ(attendu_p.violation, result_p.violation);
+    EXPECT_EQ(attendu_p.idx1, result_p.idx1);
+    EXPECT_EQ(attendu_p.idx2, result_p.idx2);
+    EXPECT_EQ(attendu_p.loadCost, result_p.loadCost);
+    EXPECT_EQ(attendu_p.balanceCost, result_p.balanceCost);
+    EXPECT_EQ(attendu_p.pmc, result_p.pmc);
+    EXPECT_EQ(attendu_p.smc, result_p.smc);
+    EXPECT_EQ(attendu_p.mmc, result_p.mmc);
+    EXPECT_EQ(attendu_p.score, result_p.score);
+}
+
+/**
+ * Compare, sur toutes les affectations possibles, le FusedChecker au Checker
+ */
+TEST(FusedChecker, coherenceAvecChecker){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceFused(&contextBO_l);
+    FusedChecker fusedChecker_l(&contextBO_l);
+    const int nbP_l = contextBO_l.getNbProcesses();
+    const int nbMachines_l = contextBO_l.getNbMachines();
+
+    int nbSol_l = 1;
+    for ( int idxP_l=0 ; idxP_l < nbP_l ; idxP_l++ ){
+        nbSol_l *= nbMachines_l;
+    }
+
+    int nbValides_l = 0;
+    vector<int> sol_l(nbP_l);
+    for ( int code_l=0 ; code_l < nbSol_l ; code_l++ ){
+        int reste_l = code_l;
+        for ( int idxP_l=0 ; idxP_l < nbP_l ; idxP_l++ ){
+            sol_l[idxP_l] = reste_l % nbMachines_l;
+            reste_l /= nbMachines_l;
+        }
+
+        Checker checker_l(&contextBO_l, sol_l);
+        const CheckerResult result_l = fusedChecker_l.evaluate(sol_l);
+        ASSERT_EQ(result_l.valid, checker_l.isValid());
+        EXPECT_EQ(result_l.valid, result_l.violation == CheckerResult::AUCUNE);
+        EXPECT_EQ(result_l.loadCost, checker_l.computeLoadCost());
+        EXPECT_EQ(result_l.balanceCost, checker_l.computeBalanceCost());
+        EXPECT_EQ(result_l.pmc, checker_l.computePMC());
+        EXPECT_EQ(result_l.smc, checker_l.computeSMC());
+        EXPECT_EQ(result_l.mmc, checker_l.computeMMC());
+        EXPECT_EQ(result_l.score, checker_l.computeScore());
+        EXPECT_EQ(checker_l.evaluate().score, result_l.score);
+        if ( result_l.valid ){
+            nbValides_l++;
+        }
+    }
+
+    // On s'assure que l'instance n'est pas degeneree
+    EXPECT_GT(nbValides_l, 0);
+    EXPECT_LT(nbValides_l, nbSol_l);
+}
+
+TEST(FusedChecker, violations){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceFused(&contextBO_l);
+    FusedChecker fusedChecker_l(&contextBO_l);
+    vector<int> sol_l = contextBO_l.getSolInit();
+
+    CheckerResult result_l = fusedChecker_l.evaluate(sol_l);
+    EXPECT_TRUE(result_l.valid);
+    EXPECT_EQ(result_l.pmc + result_l.smc + result_l.mmc, (uint64_t) 0);
+
+    // Le process 2 ne tient pas avec le 4 sur la machine 3 (ressource 1 : 5 + 4 > 6)
+    sol_l[2] = 3;
+    result_l = fusedChecker_l.evaluate(sol_l);
+    EXPECT_FALSE(result_l.valid);
+    EXPECT_EQ(result_l.violation, CheckerResult::CAPA);
+    EXPECT_EQ(result_l.idx1, 1);
+    EXPECT_EQ(result_l.idx2, 3);
+
+    // Deux process du service 0 sur la machine 2
+    sol_l = contextBO_l.getSolInit();
+    sol_l[0] = 2;
+    result_l = fusedChecker_l.evaluate(sol_l);
+    EXPECT_EQ(result_l.violation, CheckerResult::CONFLIT);
+    EXPECT_EQ(result_l.idx1, 0);
+    EXPECT_EQ(result_l.idx2, 2);
+
+    // Le service 0 sur une seule location
+    sol_l = contextBO_l.getSolInit();
+    sol_l[1] = 1;
+    result_l = fusedChecker_l.evaluate(sol_l);
+    EXPECT_EQ(result_l.violation, CheckerResult::SPREAD);
+    EXPECT_EQ(result_l.idx1, 0);
+
+    // Le service 0 sur le neighborhood 1, ou le service 1 n'est pas
+    sol_l = contextBO_l.getSolInit();
+    sol_l[1] = 3;
+    result_l = fusedChecker_l.evaluate(sol_l);
+    EXPECT_EQ(result_l.violation, CheckerResult::DEPENDANCE);
+    EXPECT_EQ(result_l.idx1, 0);
+    EXPECT_EQ(result_l.idx2, 1);
+
+    // Process non affecte
+    sol_l = contextBO_l.getSolInit();
+    sol_l[2] = -2;
+    result_l = fusedChecker_l.evaluate(sol_l);
+    EXPECT_EQ(result_l.violation, CheckerResult::AFFECTATION);
+    EXPECT_EQ(result_l.idx1, 2);
+}
+
+/**
+ * L'evaluation multi-thread doit donner exactement le meme resultat que l'evaluation sequentielle,
+ * y compris la premiere violation, quel que soit le decoupage (plus de threads que de machines compris)
+ */
+TEST(FusedChecker, multiThread){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceFused(&contextBO_l);
+    FusedChecker fusedChecker_l(&contextBO_l);
+    const int nbP_l = contextBO_l.getNbProcesses();
+    const int nbMachines_l = contextBO_l.getNbMachines();
+    const int nbThreads_l[] = {2, 3, 7};
+
+    vector<int> sol_l(nbP_l, 0);
+    bool fini_l = false;
+    while ( ! fini_l ){
+        const CheckerResult attendu_l = fusedChecker_l.evaluate(sol_l);
+        for ( int idx_l=0 ; idx_l < 3 ; idx_l++ ){
+            expectSameResult(attendu_l, fusedChecker_l.evaluate(sol_l, nbThreads_l[idx_l]));
+        }
+
+        // solution suivante (on enumere toutes les affectations)
+        int idxP_l = 0;
+        while ( idxP_l < nbP_l && ++sol_l[idxP_l] == nbMachines_l ){
+            sol_l[idxP_l] = 0;
+            idxP_l++;
+        }
+        fini_l = (idxP_l == nbP_l);
+    }
+
+    sol_l = contextBO_l.getSolInit();
+    sol_l[3] = -2;
+    expectSameResult(fusedChecker_l.evaluate(sol_l), fusedChecker_l.evaluate(sol_l, 3));
+}
+
+/**
+ * Evaluation bornee : une solution dont le score depasse la borne est dominee,
+ * les autres ont exactement le resultat de l'evaluation complete
+ */
+TEST(FusedChecker, evaluateBounded){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceFused(&contextBO_l);
+    FusedChecker fusedChecker_l(&contextBO_l);
+    const int nbP_l = contextBO_l.getNbProcesses();
+    const int nbMachines_l = contextBO_l.getNbMachines();
+    const int nbThreads_l[] = {1, 2, 7};
+
+    vector<int> sol_l(nbP_l, 0);
+    bool fini_l = false;
+    int nbDominees_l = 0;
+    while ( ! fini_l ){
+        const CheckerResult attendu_l = fusedChecker_l.evaluate(sol_l);
+        EXPECT_FALSE(attendu_l.dominated);
+        const uint64_t bornes_l[] = {0, attendu_l.score / 2, attendu_l.score - 1, attendu_l.score, attendu_l.score + 1};
+        for ( int idxBorne_l=0 ; idxBorne_l < 5 ; idxBorne_l++ ){
+            if ( attendu_l.score == 0 && idxBorne_l == 2 ){
+                continue;
+            }
+            for ( int idx_l=0 ; idx_l < 3 ; idx_l++ ){
+                CheckerResult result_l;
+                fusedChecker_l.evaluateBounded(sol_l, bornes_l[idxBorne_l], result_l, nbThreads_l[idx_l]);
+                if ( attendu_l.score > bornes_l[idxBorne_l] ){
+                    EXPECT_TRUE(result_l.dominated);
+                    nbDominees_l++;
+                } else {
+                    expectSameResult(attendu_l, result_l);
+                }
+            }
+        }
+
+        // solution suivante (on enumere toutes les affectations)
+        int idxP_l = 0;
+        while ( idxP_l < nbP_l && ++sol_l[idxP_l] == nbMachines_l ){
+            sol_l[idxP_l] = 0;
+            idxP_l++;
+        }
+        fini_l = (idxP_l == nbP_l);
+    }
+    EXPECT_LT(0, nbDominees_l);
+
+    // Une affectation invalide est toujours signalee
+    sol_l = contextBO_l.getSolInit();
+    sol_l[0] = nbMachines_l;
+    CheckerResult result_l;
+    fusedChecker_l.evaluateBounded(sol_l, 0, result_l);
+    EXPECT_FALSE(result_l.dominated);
+    EXPECT_EQ(CheckerResult::AFFECTATION, result_l.violation);
+}
+
+/**
+ * Les memes buffers, reutilises d'une solution a l'autre (avec des bornes et des nombres de threads
+ * differents, et apres une evaluation interrompue), donnent les memes resultats que des buffers neufs
+ */
+TEST(FusedChecker, buffersReutilises){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceFused(&contextBO_l);
+    FusedChecker fusedChecker_l(&contextBO_l);
+    const int nbP_l = contextBO_l.getNbProcesses();
+    const int nbMachines_l = contextBO_l.getNbMachines();
+    const int nbThreads_l[] = {1, 3, 2, 1};
+
+    FusedCheckerBuffers buffers_l;
+    vector<int> sol_l(nbP_l, 0);
+    bool fini_l = false;
+    int idxEval_l = 0;
+    while ( ! fini_l ){
+        const CheckerResult attendu_l = fusedChecker_l.evaluate(sol_l);
+
+        CheckerResult result_l;
+        fusedChecker_l.evaluateBounded(&sol_l[0], nbP_l, attendu_l.score / 2, result_l, buffers_l, nbThreads_l[idxEval_l % 4]);
+        EXPECT_EQ(attendu_l.score / 2 < attendu_l.score, result_l.dominated);
+        fusedChecker_l.evaluate(&sol_l[0], nbP_l, result_l, buffers_l, nbThreads_l[idxEval_l % 4]);
+        expectSameResult(attendu_l, result_l);
+        idxEval_l++;
+
+        // solution suivante (on enumere toutes les affectations)
+        int idxP_l = 0;
+        while ( idxP_l < nbP_l && ++sol_l[idxP_l] == nbMachines_l ){
+            sol_l[idxP_l] = 0;
+            idxP_l++;
+        }
+        fini_l = (idxP_l == nbP_l);
+    }
+}
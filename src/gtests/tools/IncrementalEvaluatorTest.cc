@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "bo/ContextBO.hh"
+#include "bo/MMCBO.hh"
+#include "bo/RessourceBO.hh"
+#include "bo/ServiceBO.hh"
+#include "gtests/ContextBOBuilder.hh"
+#include "tools/Checker.hh"
+#include "tools/IncrementalEvaluator.hh"
+#include <vector>
+#include <tr1/unordered_set>
+#include <gtest/gtest.h>
+using namespace std;
+using namespace std::tr1;
+
+TEST(IncrementalEvaluator, scoreInit){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceEvaluator(&contextBO_l);
+
+    IncrementalEvaluator evaluator_l(&contextBO_l, contextBO_l.getSolInit());
+    Checker checker_l(&contextBO_l, contextBO_l.getSolInit());
+    EXPECT_EQ(evaluator_l.getScore(), checker_l.computeScore());
+    EXPECT_EQ(evaluator_l.getLoadCost(), checker_l.computeLoadCost());
+    EXPECT_EQ(evaluator_l.getBalanceCost(), checker_l.computeBalanceCost());
+    EXPECT_EQ(evaluator_l.getPMC(), (uint64_t) 0);
+    EXPECT_EQ(evaluator_l.getSMC(), (uint64_t) 0);
+    EXPECT_EQ(evaluator_l.getMMC(), (uint64_t) 0);
+}
+
+TEST(IncrementalEvaluator, deltaEtApplyMove){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceEvaluator(&contextBO_l);
+    IncrementalEvaluator evaluator_l(&contextBO_l, contextBO_l.getSolInit());
+
+    /* On enchaine des mouvements, dont des retours sur la machine init,
+     * et on compare a chaque fois avec une evaluation complete */
+    const int moves_l[][2] = { {0, 1}, {3, 2}, {1, 2}, {0, 2}, {0, 0}, {4, 0}, {2, 1}, {3, 0}, {1, 0} };
+    const int nbMoves_l = sizeof(moves_l) / sizeof(moves_l[0]);
+
+    for ( int idxMove_l=0 ; idxMove_l < nbMoves_l ; idxMove_l++ ){
+        const int idxP_l = moves_l[idxMove_l][0];
+        const int idxMachine_l = moves_l[idxMove_l][1];
+        const uint64_t scoreAvant_l = evaluator_l.getScore();
+        const int64_t delta_l = evaluator_l.computeDeltaMove(idxP_l, idxMachine_l);
+
+        evaluator_l.applyMove(idxP_l, idxMachine_l);
+        Checker checker_l(&contextBO_l, evaluator_l.getCurrentSol());
+        EXPECT_EQ(evaluator_l.getScore(), checker_l.computeScore());
+        EXPECT_EQ((int64_t) (evaluator_l.getScore() - scoreAvant_l), delta_l);
+        EXPECT_EQ(evaluator_l.getLoadCost(), checker_l.computeLoadCost());
+        EXPECT_EQ(evaluator_l.getBalanceCost(), checker_l.computeBalanceCost());
+        EXPECT_EQ(evaluator_l.getPMC(), checker_l.computePMC());
+        EXPECT_EQ(evaluator_l.getSMC(), checker_l.computeSMC());
+        EXPECT_EQ(evaluator_l.getMMC(), checker_l.computeMMC());
+    }
+}
+
+TEST(IncrementalEvaluator, undo){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceEvaluator(&contextBO_l);
+    IncrementalEvaluator evaluator_l(&contextBO_l, contextBO_l.getSolInit());
+    const uint64_t scoreInit_l = evaluator_l.getScore();
+
+    evaluator_l.applyMove(0, 1);
+    evaluator_l.applyMove(1, 2);
+    const vector<int> solIntermediaire_l = evaluator_l.getCurrentSol();
+    const uint64_t scoreIntermediaire_l = evaluator_l.getScore();
+    const int journalSize_l = evaluator_l.getJournalSize();
+    EXPECT_EQ(journalSize_l, 2);
+
+    evaluator_l.applyMove(3, 2);
+    evaluator_l.applyMove(4, 0);
+    evaluator_l.rollback(journalSize_l);
+    EXPECT_EQ(evaluator_l.getCurrentSol(), solIntermediaire_l);
+    EXPECT_EQ(evaluator_l.getScore(), scoreIntermediaire_l);
+
+    EXPECT_TRUE(evaluator_l.undoLastMove());
+    EXPECT_TRUE(evaluator_l.undoLastMove());
+    EXPECT_FALSE(evaluator_l.undoLastMove());
+    EXPECT_EQ(evaluator_l.getCurrentSol(), contextBO_l.getSolInit());
+    EXPECT_EQ(evaluator_l.getScore(), scoreInit_l);
+
+    evaluator_l.applyMove(2, 0);
+    evaluator_l.clearJournal();
+    EXPECT_FALSE(evaluator_l.undoLastMove());
+    EXPECT_EQ(evaluator_l.getCurrentSol()[2], 0);
+}
+
+TEST(IncrementalEvaluator, capaTransient){
+    ContextBO contextBO_l;
+    contextBO_l.addRessource(new RessourceBO(0, true, 0));
+
+    ContextBOBuilder::buildMachine(0, 0, 0, vector<int>(1, 15), vector<int>(1, 10), &contextBO_l);
+    ContextBOBuilder::buildMachine(1, 0, 0, vector<int>(1, 20), vector<int>(1, 10), &contextBO_l);
+
+    ServiceBO* pService_l = ContextBOBuilder::buildService(0, 0, unordered_set<int>(), &contextBO_l);
+    ContextBOBuilder::buildProcess(0, pService_l, vector<int>(1, 14), 0, 0, &contextBO_l);
+    ContextBOBuilder::buildProcess(1, pService_l, vector<int>(1, 4), 0, 1, &contextBO_l);
+    ContextBOBuilder::buildDefaultMMC(&contextBO_l);
+
+    IncrementalEvaluator evaluator_l(&contextBO_l, contextBO_l.getSolInit());
+    EXPECT_TRUE(evaluator_l.isCapaOkForMove(0, 1));
+    EXPECT_FALSE(evaluator_l.isCapaOkForMove(1, 0));
+
+    /* Le process 0 reserve toujours sa place sur la machine 0 */
+    evaluator_l.applyMove(0, 1);
+    EXPECT_EQ(evaluator_l.getTransientRessUsedOnMachine(0, 0), 14);
+    EXPECT_FALSE(evaluator_l.isCapaOkForMove(1, 0));
+    EXPECT_TRUE(evaluator_l.isCapaOkForMove(0, 0));
+
+    evaluator_l.applyMove(0, 0);
+    EXPECT_EQ(evaluator_l.getTransientRessUsedOnMachine(0, 0), 0);
+    EXPECT_EQ(evaluator_l.getRessUsedOnMachine(0, 0), 14);
+}
+
+/**
+ * Compare le resultat d'un mouvement compose avec une evaluation complete par le Checker
+ */
+static void checkCompoundMove(ContextBO const * pContextBO_p, IncrementalEvaluator* pEvaluator_p, const vector<int>& solApres_p, bool valid_p, int64_t delta_p){
+    Checker checkerAvant_l(pContextBO_p, pEvaluator_p->getCurrentSol());
+    Checker checkerApres_l(pContextBO_p, solApres_p);
+    EXPECT_EQ(checkerApres_l.isValid(), valid_p);
+    EXPECT_EQ((int64_t) (checkerApres_l.computeScore() - checkerAvant_l.computeScore()), delta_p);
+}
+
+TEST(IncrementalEvaluator, swap){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceCompoundMoves(&contextBO_l);
+    ASSERT_TRUE(check(&contextBO_l));
+
+    IncrementalEvaluator evaluator_l(&contextBO_l, contextBO_l.getSolInit());
+    const vector<int> solInit_l = contextBO_l.getSolInit();
+    int nbValid_l = 0;
+    int nbInvalid_l = 0;
+
+    for ( int idxP1_l=0 ; idxP1_l < contextBO_l.getNbProcesses() ; idxP1_l++ ){
+        for ( int idxP2_l=idxP1_l+1 ; idxP2_l < contextBO_l.getNbProcesses() ; idxP2_l++ ){
+            int64_t delta_l;
+            const bool valid_l = evaluator_l.evaluateSwap(idxP1_l, idxP2_l, delta_l);
+            EXPECT_EQ(evaluator_l.getCurrentSol(), solInit_l);
+
+            vector<int> solApres_l(solInit_l);
+            swap(solApres_l[idxP1_l], solApres_l[idxP2_l]);
+            checkCompoundMove(&contextBO_l, &evaluator_l, solApres_l, valid_l, delta_l);
+            (valid_l ? nbValid_l : nbInvalid_l)++;
+        }
+    }
+
+    /* On s'assure que le test couvre les deux cas */
+    EXPECT_GT(nbValid_l, 0);
+    EXPECT_GT(nbInvalid_l, 0);
+}
+
+TEST(IncrementalEvaluator, shiftSwap){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceCompoundMoves(&contextBO_l);
+    IncrementalEvaluator evaluator_l(&contextBO_l, contextBO_l.getSolInit());
+    const vector<int> solInit_l = contextBO_l.getSolInit();
+    const int nbP_l = contextBO_l.getNbProcesses();
+    int nbValid_l = 0;
+    int nbInvalid_l = 0;
+
+    for ( int idxP1_l=0 ; idxP1_l < nbP_l ; idxP1_l++ ){
+        for ( int idxP2_l=0 ; idxP2_l < nbP_l ; idxP2_l++ ){
+            for ( int idxP3_l=0 ; idxP3_l < nbP_l ; idxP3_l++ ){
+                if ( idxP1_l == idxP2_l || idxP1_l == idxP3_l || idxP2_l == idxP3_l ){
+                    continue;
+                }
+                int64_t delta_l;
+                const bool valid_l = evaluator_l.evaluateShiftSwap(idxP1_l, idxP2_l, idxP3_l, delta_l);
+                EXPECT_EQ(evaluator_l.getCurrentSol(), solInit_l);
+
+                vector<int> solApres_l(solInit_l);
+                solApres_l[idxP1_l] = solInit_l[idxP2_l];
+                solApres_l[idxP2_l] = solInit_l[idxP3_l];
+                solApres_l[idxP3_l] = solInit_l[idxP1_l];
+                checkCompoundMove(&contextBO_l, &evaluator_l, solApres_l, valid_l, delta_l);
+                (valid_l ? nbValid_l : nbInvalid_l)++;
+            }
+        }
+    }
+
+    EXPECT_GT(nbValid_l, 0);
+    EXPECT_GT(nbInvalid_l, 0);
+}
+
+TEST(IncrementalEvaluator, compoundMove){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceCompoundMoves(&contextBO_l);
+    IncrementalEvaluator evaluator_l(&contextBO_l, contextBO_l.getSolInit());
+    const int nbP_l = contextBO_l.getNbProcesses();
+    const int nbMachines_l = contextBO_l.getNbMachines();
+
+    /* Tous les doubles deplacements possibles */
+    for ( int idxP1_l=0 ; idxP1_l < nbP_l ; idxP1_l++ ){
+        for ( int idxP2_l=idxP1_l+1 ; idxP2_l < nbP_l ; idxP2_l++ ){
+            for ( int idxM1_l=0 ; idxM1_l < nbMachines_l ; idxM1_l++ ){
+                for ( int idxM2_l=0 ; idxM2_l < nbMachines_l ; idxM2_l++ ){
+                    IncrementalEvaluator::ProcessMove moves_l[2];
+                    moves_l[0].idxP = idxP1_l;
+                    moves_l[0].idxMachine = idxM1_l;
+                    moves_l[1].idxP = idxP2_l;
+                    moves_l[1].idxMachine = idxM2_l;
+                    int64_t delta_l;
+                    const bool valid_l = evaluator_l.evaluateCompoundMove(moves_l, 2, delta_l);
+
+                    vector<int> solApres_l(evaluator_l.getCurrentSol());
+                    solApres_l[idxP1_l] = idxM1_l;
+                    solApres_l[idxP2_l] = idxM2_l;
+                    checkCompoundMove(&contextBO_l, &evaluator_l, solApres_l, valid_l, delta_l);
+                }
+            }
+        }
+    }
+
+    /* Une fois applique, le mouvement compose peut etre annule */
+    IncrementalEvaluator::ProcessMove moves_l[2];
+    moves_l[0].idxP = 0;
+    moves_l[0].idxMachine = 1;
+    moves_l[1].idxP = 4;
+    moves_l[1].idxMachine = 2;
+    evaluator_l.applyCompoundMove(moves_l, 2);
+    EXPECT_EQ(evaluator_l.getJournalSize(), 2);
+    evaluator_l.rollback(0);
+    EXPECT_EQ(evaluator_l.getCurrentSol(), contextBO_l.getSolInit());
+}
+
+TEST(IncrementalEvaluator, evaluateAllMachines){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceEvaluator(&contextBO_l);
+    IncrementalEvaluator evaluator_l(&contextBO_l, contextBO_l.getSolInit());
+    MachineSweep::Result result_l;
+
+    /* Le balayage doit donner, pour chaque machine, le meme delta et la meme faisabilite (capa)
+     * que l'evaluation d'un mouvement isole, y compris apres quelques mouvements */
+    const int moves_l[][2] = { {0, 1}, {3, 2}, {1, 2} };
+    for ( int idxMove_l=0 ; idxMove_l <= 3 ; idxMove_l++ ){
+        for ( int idxP_l=0 ; idxP_l < contextBO_l.getNbProcesses() ; idxP_l++ ){
+            evaluator_l.evaluateAllMachines(idxP_l, result_l);
+            for ( int idxMachine_l=0 ; idxMachine_l < contextBO_l.getNbMachines() ; idxMachine_l++ ){
+                EXPECT_EQ(result_l.getDelta(idxMachine_l), evaluator_l.computeDeltaMove(idxP_l, idxMachine_l));
+                EXPECT_EQ((bool) result_l.fit[idxMachine_l], evaluator_l.isCapaOkForMove(idxP_l, idxMachine_l));
+            }
+        }
+        if ( idxMove_l < 3 ){
+            evaluator_l.applyMove(moves_l[idxMove_l][0], moves_l[idxMove_l][1]);
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+#include "tools/IndexCSR.hh"
+#include <boost/foreach.hpp>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+using namespace std;
+
+TEST(IndexCSR, construction){
+    vector<pair<int, int> > couples_l;
+    couples_l.push_back(make_pair(2, 5));
+    couples_l.push_back(make_pair(0, 3));
+    couples_l.push_back(make_pair(2, 1));
+    couples_l.push_back(make_pair(0, 4));
+    couples_l.push_back(make_pair(2, 4));
+    IndexCSR index_l(4, couples_l);
+
+    EXPECT_EQ(4, index_l.getNbLignes());
+    EXPECT_EQ(5, index_l.getNbValeurs());
+    EXPECT_EQ(2, index_l.getTaille(0));
+    EXPECT_EQ(0, index_l.getTaille(1));
+    EXPECT_EQ(3, index_l.getTaille(2));
+    EXPECT_EQ(0, index_l.getTaille(3));
+
+    //Lignes triees
+    vector<int> ligne2_l;
+    BOOST_FOREACH(int valeur_l, index_l.getLigne(2)){
+        ligne2_l.push_back(valeur_l);
+    }
+    const int attendu_l[] = {1, 4, 5};
+    EXPECT_EQ(vector<int>(attendu_l, attendu_l + 3), ligne2_l);
+
+    EXPECT_TRUE(index_l.contient(0, 4));
+    EXPECT_FALSE(index_l.contient(0, 5));
+    EXPECT_FALSE(index_l.contient(1, 4));
+}
+
+TEST(IndexCSR, transpose){
+    vector<pair<int, int> > couples_l;
+    couples_l.push_back(make_pair(0, 1));
+    couples_l.push_back(make_pair(2, 1));
+    couples_l.push_back(make_pair(2, 0));
+    IndexCSR transpose_l = IndexCSR(3, couples_l).transpose(2);
+
+    EXPECT_EQ(2, transpose_l.getNbLignes());
+    EXPECT_EQ(1, transpose_l.getTaille(0));
+    EXPECT_TRUE(transpose_l.contient(0, 2));
+    EXPECT_EQ(2, transpose_l.getTaille(1));
+    EXPECT_TRUE(transpose_l.contient(1, 0));
+    EXPECT_TRUE(transpose_l.contient(1, 2));
+}
+
+TEST(IndexCSR, vide){
+    IndexCSR vide_l;
+    EXPECT_EQ(0, vide_l.getNbLignes());
+
+    IndexCSR sansValeur_l(2, vector<pair<int, int> >());
+    IndexCSR::Plage ligne_l = sansValeur_l.getLigne(1);
+    EXPECT_EQ(ligne_l.first, ligne_l.second);
+    EXPECT_FALSE(sansValeur_l.contient(1, 0));
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "alg/ContextALG.hh"
+#include "bo/ContextBO.hh"
+#include "bo/RessourceBO.hh"
+#include "bo/ServiceBO.hh"
+#include "gtests/ContextBOBuilder.hh"
+#include "tools/MachineSweep.hh"
+#include <vector>
+#include <tr1/unordered_set>
+#include <gtest/gtest.h>
+using namespace std;
+using namespace std::tr1;
+
+/**
+ * Les consommations maintenues par MachineSweep doivent etre celles du ContextALG
+ */
+static void checkUsage(ContextBO const * pContextBO_p, const MachineSweep::Usage& usage_p, const vector<int>& sol_p){
+    ContextALG contextALG_l(pContextBO_p);
+    contextALG_l.setCurrentSol(sol_p);
+    const int nbMachines_l = pContextBO_p->getNbMachines();
+    for ( int idxRess_l=0 ; idxRess_l < pContextBO_p->getNbRessources() ; idxRess_l++ ){
+        for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
+            EXPECT_EQ(usage_p.used[idxRess_l*nbMachines_l + idxMachine_l], contextALG_l.getRessUsedOnMachine(idxRess_l, idxMachine_l));
+            EXPECT_EQ(usage_p.transientUsed[idxRess_l*nbMachines_l + idxMachine_l], contextALG_l.getTransientRessUsedOnMachine(idxRess_l, idxMachine_l));
+        }
+    }
+}
+
+TEST(MachineSweep, usage){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceSweep(&contextBO_l);
+    MachineSweep sweep_l(&contextBO_l);
+
+    MachineSweep::Usage usage_l;
+    sweep_l.initUsage(usage_l);
+    vector<int> sol_l(3, -1);
+    checkUsage(&contextBO_l, usage_l, sol_l);
+
+    sweep_l.assign(usage_l, 0, 0);
+    sol_l[0] = 0;
+    checkUsage(&contextBO_l, usage_l, sol_l);
+
+    sweep_l.assign(usage_l, 1, 0);
+    sol_l[1] = 0;
+    checkUsage(&contextBO_l, usage_l, sol_l);
+
+    sweep_l.unassign(usage_l, 0, 0);
+    sweep_l.assign(usage_l, 0, 1);
+    sol_l[0] = 1;
+    checkUsage(&contextBO_l, usage_l, sol_l);
+}
+
+TEST(MachineSweep, fitProcessNonAffecte){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceSweep(&contextBO_l);
+    MachineSweep sweep_l(&contextBO_l);
+    MachineSweep::Usage usage_l;
+    MachineSweep::Result result_l;
+    sweep_l.initUsage(usage_l);
+
+    /* Rien n'est affecte : les transients reservent 4 + 6 sur la machine 0 et 3 sur la machine 1.
+     * Le process 1 (transient 3) ne tient donc pas sur la machine 0, mais tient sur sa machine init */
+    sweep_l.sweep(1, -1, usage_l, result_l);
+    EXPECT_EQ(result_l.fit[0], 0);
+    EXPECT_EQ(result_l.fit[1], 1);
+
+    // Le process 0 tient sur sa machine init, ou il a deja reserve sa transient
+    sweep_l.sweep(0, -1, usage_l, result_l);
+    EXPECT_EQ(result_l.fit[0], 1);
+    EXPECT_EQ(result_l.fit[1], 1);
+
+    /* Une fois les process 0 et 1 sur la machine 1 (ressource 1 a 7), le process 2 (6) n'y tient plus.
+     * Sur sa machine init, il tient tout juste : 4 + 6 reserves par les transients */
+    sweep_l.assign(usage_l, 1, 1);
+    sweep_l.assign(usage_l, 0, 1);
+    sweep_l.sweep(2, -1, usage_l, result_l);
+    EXPECT_EQ(result_l.fit[0], 1);
+    EXPECT_EQ(result_l.fit[1], 0);
+
+    /* Load cost sur la machine 0 (safety 5, vide) : la ressource 0 passe a 2, la ressource 1 a 6
+     * (les reservations transient n'entrent pas dans le load cost) */
+    EXPECT_EQ(result_l.loadCostDelta[0], 1);
+}
+
+TEST(MachineSweep, sweepFitCommeSweep){
+    ContextBO contextBO_l;
+    ContextBOBuilder::buildInstanceSweep(&contextBO_l);
+    MachineSweep sweep_l(&contextBO_l);
+    MachineSweep::Usage usage_l;
+    MachineSweep::Result result_l;
+    vector<unsigned char> fit_l;
+    sweep_l.initUsage(usage_l);
+
+    vector<int> sol_l(3, -1);
+    const int affectations_l[] = {1, 1, 0, 1, 2, 0};
+    for ( int etape_l=0 ; etape_l < 4 ; etape_l++ ){
+        for ( int idxP_l=0 ; idxP_l < 3 ; idxP_l++ ){
+            sweep_l.sweep(idxP_l, sol_l[idxP_l], usage_l, result_l);
+            sweep_l.sweepFit(idxP_l, sol_l[idxP_l], usage_l, fit_l);
+            EXPECT_EQ(result_l.fit, fit_l);
+        }
+        if ( etape_l < 3 ){
+            const int idxP_l = affectations_l[2*etape_l];
+            sol_l[idxP_l] = affectations_l[2*etape_l + 1];
+            sweep_l.assign(usage_l, idxP_l, sol_l[idxP_l]);
+        }
+    }
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "tools/MeilleureSolution.hh"
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <gtest/gtest.h>
+using namespace std;
+
+namespace {
+    /**
+     * Publie des solutions de score decroissant ; sol[0] porte le score pour verifier la coherence des instantanes
+     */
+    void publieSerie(int debut_p, int pas_p, int nb_p){
+        vector<int> sol_l(50);
+        for ( int idx_l=0 ; idx_l < nb_p ; idx_l++ ){
+            const int score_l = 100000 - debut_p - idx_l * pas_p;
+            sol_l[0] = score_l;
+            sol_l[49] = score_l;
+            MeilleureSolution::publie(sol_l, score_l);
+        }
+    }
+
+    void verifieInstantanes(int nb_p, bool* pIsCoherent_p){
+        for ( int idx_l=0 ; idx_l < nb_p ; idx_l++ ){
+            MeilleureSolution::InstantanePtr pInstantane_l = MeilleureSolution::getInstantane();
+            if ( pInstantane_l && (pInstantane_l->sol[0] != static_cast<int>(pInstantane_l->score)
+                        || pInstantane_l->sol[49] != static_cast<int>(pInstantane_l->score)) ){
+                *pIsCoherent_p = false;
+            }
+        }
+    }
+}
+
+/**
+ * La meilleure solution est partagee par tout le processus : chaque test part d'un etat vierge,
+ * et n'en laisse pas aux tests suivants (SolutionDtoout, qui l'alimente aussi)
+ */
+class MeilleureSolutionFixture : public testing::Test {
+    protected:
+        virtual void SetUp(){
+            MeilleureSolution::reinit();
+        }
+
+        virtual void TearDown(){
+            MeilleureSolution::reinit();
+        }
+};
+
+TEST_F(MeilleureSolutionFixture, publication){
+    EXPECT_FALSE(MeilleureSolution::getInstantane());
+    MeilleureSolution::Abonnement abonnement_l;
+    EXPECT_FALSE(abonnement_l.isNouvelle());
+
+    EXPECT_TRUE(MeilleureSolution::publie(vector<int>(3, 1), 50));
+    EXPECT_FALSE(MeilleureSolution::publie(vector<int>(3, 2), 50));
+    EXPECT_EQ(50u, MeilleureSolution::getScore());
+    EXPECT_TRUE(abonnement_l.isNouvelle());
+
+    MeilleureSolution::InstantanePtr pVu_l = abonnement_l.prends();
+    ASSERT_TRUE(pVu_l);
+    EXPECT_FALSE(abonnement_l.isNouvelle());
+    EXPECT_EQ(vector<int>(3, 1), pVu_l->sol);
+    EXPECT_EQ(MeilleureSolution::getVersion(), pVu_l->version);
+
+    //L'instantane deja lu n'est pas touche par une nouvelle publication
+    EXPECT_TRUE(MeilleureSolution::publie(vector<int>(2, 3), 40));
+    EXPECT_EQ(vector<int>(3, 1), pVu_l->sol);
+    EXPECT_EQ(50u, pVu_l->score);
+    EXPECT_EQ(pVu_l->version + 1, MeilleureSolution::getVersion());
+    EXPECT_TRUE(abonnement_l.isNouvelle());
+    EXPECT_EQ(40u, abonnement_l.prends()->score);
+}
+
+TEST_F(MeilleureSolutionFixture, attente){
+    MeilleureSolution::Abonnement abonnement_l;
+    EXPECT_FALSE(abonnement_l.attend(20));
+
+    boost::thread thread_l(boost::bind(publieSerie, 0, 1, 1));
+    EXPECT_TRUE(abonnement_l.attend(10000));
+    thread_l.join();
+    EXPECT_EQ(100000u, abonnement_l.prends()->score);
+    EXPECT_FALSE(abonnement_l.attend(0));
+}
+
+TEST_F(MeilleureSolutionFixture, concurrence){
+    const int nbThreads_l = 4;
+    const int nbPublications_l = 2000;
+    bool isCoherent_l = true;
+    boost::thread_group threads_l;
+    for ( int idxThread_l=0 ; idxThread_l < nbThreads_l ; idxThread_l++ ){
+        threads_l.create_thread(boost::bind(publieSerie, idxThread_l, nbThreads_l, nbPublications_l));
+        threads_l.create_thread(boost::bind(verifieInstantanes, nbPublications_l, &isCoherent_l));
+    }
+    threads_l.join_all();
+
+    EXPECT_TRUE(isCoherent_l);
+    const uint64_t scoreMin_l = 100000 - (nbThreads_l - 1) - (nbPublications_l - 1) * nbThreads_l;
+    EXPECT_EQ(scoreMin_l, MeilleureSolution::getScore());
+    EXPECT_EQ(scoreMin_l, MeilleureSolution::getInstantane()->score);
+}
+
+TEST_F(MeilleureSolutionFixture, recyclage){
+    ASSERT_TRUE(MeilleureSolution::publie(vector<int>(3, 1), 50));
+    const MeilleureSolution::Instantane* pPremier_l = MeilleureSolution::getInstantane().get();
+
+    //Le premier instantane n'est plus lu une fois remplace : il sert a la publication suivante
+    ASSERT_TRUE(MeilleureSolution::publie(vector<int>(3, 2), 40));
+    ASSERT_TRUE(MeilleureSolution::publie(vector<int>(3, 3), 30));
+    EXPECT_EQ(pPremier_l, MeilleureSolution::getInstantane().get());
+    EXPECT_EQ(vector<int>(3, 3), MeilleureSolution::getInstantane()->sol);
+
+    //Un instantane encore lu n'est jamais reutilise
+    MeilleureSolution::InstantanePtr pLu_l = MeilleureSolution::getInstantane();
+    ASSERT_TRUE(MeilleureSolution::publie(vector<int>(3, 4), 20));
+    ASSERT_TRUE(MeilleureSolution::publie(vector<int>(3, 5), 10));
+    EXPECT_EQ(vector<int>(3, 3), pLu_l->sol);
+    EXPECT_EQ(30u, pLu_l->score);
+    EXPECT_EQ(10u, MeilleureSolution::getScore());
+}
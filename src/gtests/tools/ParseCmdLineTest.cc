@@ -66,6 +66,11 @@ TEST(ParseCmdLine, defaultOutFile){
     variables_map opt_l = ParseCmdLine::parse(helper_l.argc(), helper_l.argv());
 
     EXPECT_NE(opt_l["out"].as<string>(), "");
+    EXPECT_EQ(opt_l["threads"].as<int>(), 1);
+    EXPECT_EQ(opt_l["loadThreads"].as<int>(), 1);
+    EXPECT_EQ(opt_l["mctsPolicy"].as<string>(), "ucb1");
+    EXPECT_EQ(opt_l["mctsConstant"].as<double>(), 0.1);
+    EXPECT_EQ(opt_l["mctsMaxNodes"].as<int>(), 20000000);
 
 
 }
@@ -24,12 +24,18 @@
 #include "alg/ContextALG.hh"
 #include "alg/dummyStrategyOptim/DummyStrategyOptim.hh"
 #include "alg/StrategySelecter.hh"
+#include "dtoin/InstanceReaderBinaire.hh"
 #include "dtoin/InstanceReaderDtoin.hh"
 #include "dtoin/SolutionDtoin.hh"
 #include "dtoout/InstanceWriterDtoout.hh"
 #include "dtoout/SolutionDtoout.hh"
+#include "tools/FusedChecker.hh"
+#include "tools/InstanceBinaire.hh"
+#include "tools/MeilleureSolution.hh"
+#include "tools/MemoryUsage.hh"
 #include "tools/ParseCmdLine.hh"
 #include "tools/Log.hh"
+#include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
 #include <ctime>
 #include <string>
@@ -38,7 +44,27 @@
 using namespace std;
 using namespace boost;
 
+/**
+ * Ce que le main doit connaitre du run pour verifier la meilleure solution a l'echeance.
+ * Le run peut encore tourner a ce moment la (ou etre deja termine) : l'instance est donc partagee
+ */
+struct Verification {
+  Verification() : nbThreads(1) {}
+  boost::mutex mutex;
+  shared_ptr<ContextBO> pContextBO;
+  shared_ptr<FusedChecker const> pChecker;
+  int nbThreads;
+
+  /**
+   * Derniere solution verifiee (la solution initiale, si elle est valide) : ecrite a la place
+   * d'une meilleure solution incoherente
+   */
+  vector<int> solVerifiee;
+};
+
 struct Run {
+  Run(const shared_ptr<Verification>& pVerification_p) : pVerification_m(pVerification_p) {}
+
   void operator()(const variables_map& opt_p){
     LOG(INFO) << "temps limite : " << opt_p["time"].as<int>() << " s" << endl
       << "instance file  : ./" << opt_p["param"].as<string>() << endl
@@ -50,16 +76,48 @@ struct Run {
       /* Lecture du fichier d'instance et de solution initiale
       */
       LOG(INFO) << "reading instance" << endl;
-      InstanceReaderDtoin reader_l;
-      ContextBO contextBO_l = reader_l.read(opt_p["param"].as<string>());
-      SolutionDtoin::read(opt_p["init"].as<string>(), &contextBO_l);
+      posix_time::ptime debutLecture_l = posix_time::microsec_clock::local_time();
+      const string instanceFilename_l = opt_p["param"].as<string>();
+      shared_ptr<InstanceReaderInterface> pReader_l;
+      if ( InstanceBinaire::isBinaire(instanceFilename_l) ){
+        pReader_l.reset(new InstanceReaderBinaire);
+      } else {
+        pReader_l.reset(new InstanceReaderDtoin(opt_p["loadThreads"].as<int>()));
+      }
+      shared_ptr<ContextBO> pContextBO_l(new ContextBO(pReader_l->read(instanceFilename_l)));
+      SolutionDtoin::read(opt_p["init"].as<string>(), pContextBO_l.get());
+      LOG(INFO) << "instance read in " << (posix_time::microsec_clock::local_time() - debutLecture_l).total_milliseconds()
+        << " ms (" << pContextBO_l->getNbProcesses() << " process, " << pContextBO_l->getNbMachines() << " machines), peak RSS : "
+        << MemoryUsage::getPeakRSSKo() / 1024 << " Mo" << endl;
 
       /* Lancement de la sequence d'optim.
       */
       LOG(INFO) << "creating context" << endl;
-      ContextALG contextALG_l(&contextBO_l);
-      //Initialise SolutionDtoout::bestSol_m
-      contextALG_l.checkCompletAndMajBestSol(contextALG_l.getCurrentSol(), false);
+      ContextALG contextALG_l(pContextBO_l.get());
+      const int nbThreadsCheck_l = opt_p["threads"].as<int>();
+      shared_ptr<FusedChecker const> pChecker_l = pContextBO_l->getFusedChecker();
+      {
+        boost::mutex::scoped_lock lock_l(pVerification_m->mutex);
+        pVerification_m->pContextBO = pContextBO_l;
+        pVerification_m->pChecker = pChecker_l;
+        pVerification_m->nbThreads = nbThreadsCheck_l;
+      }
+
+      //Initialise la MeilleureSolution partagee (seulement si la solution initiale est valide)
+      CheckerResult resultInit_l;
+      pChecker_l->evaluate(contextALG_l.getCurrentSol(), resultInit_l, nbThreadsCheck_l);
+      if ( resultInit_l.valid ){
+        SolutionDtoout::writeSol(contextALG_l.getCurrentSol(), resultInit_l.score);
+        boost::mutex::scoped_lock lock_l(pVerification_m->mutex);
+        pVerification_m->solVerifiee = contextALG_l.getCurrentSol();
+      } else {
+        LOG(ERREUR) << "La solution initiale n'est pas valide (violation " << resultInit_l.violation
+          << " : " << resultInit_l.idx1 << ", " << resultInit_l.idx2 << ") : elle ne sera pas ecrite" << endl;
+      }
+      //La solution initiale a ete ecrite de maniere synchrone (le fichier de sortie est donc utilisable) :
+      //les ameliorations suivantes sont confiees au thread d'ecriture
+      SolutionDtoout::demarreEcrivain();
+
       StrategyOptim* pStrategy_l = StrategySelecter::buildStrategy(opt_p);
       LOG(INFO) << "running method" << endl;
       pStrategy_l->run(contextALG_l, time(0) + opt_p["time"].as<int>(), opt_p);
@@ -75,18 +133,61 @@ struct Run {
     }
 
   }
+
+  shared_ptr<Verification> pVerification_m;
 };
 
+/**
+ * Verifie la meilleure solution publiee, avant son ecriture finale
+ * @return false si elle est invalide ou mal scoree (elle ne doit alors pas etre ecrite)
+ */
+static bool verifieMeilleureSolution(Verification& verification_p){
+  boost::mutex::scoped_lock lock_l(verification_p.mutex);
+  if ( ! verification_p.pChecker ){
+    return true;
+  }
+  const MeilleureSolution::InstantanePtr pBest_l = MeilleureSolution::getInstantane();
+  if ( ! pBest_l ){
+    LOG(ERREUR) << "Aucune solution valide n'a ete trouvee" << endl;
+    return true;
+  }
+
+  CheckerResult resultFinal_l;
+  verification_p.pChecker->evaluate(pBest_l->sol, resultFinal_l, verification_p.nbThreads);
+  if ( resultFinal_l.valid && resultFinal_l.score == pBest_l->score ){
+    LOG(INFO) << "best solution checked : " << resultFinal_l.score << endl;
+    return true;
+  }
+  LOG(ERREUR) << "La meilleure solution est incoherente (valide : " << resultFinal_l.valid
+    << ", score : " << resultFinal_l.score << " au lieu de " << pBest_l->score
+    << ") : la derniere solution verifiee est ecrite a sa place" << endl;
+  return false;
+}
+
 int main(int argc, char **argv) {
     variables_map opt_l = ParseCmdLine::parse(argc, argv);
     ParseCmdLine::traitementOptionsSimples(opt_l);
 
-    Run run_l;
+    shared_ptr<Verification> pVerification_l(new Verification);
+    Run run_l(pVerification_l);
     thread thread_l(run_l, opt_l);
     if ( thread_l.timed_join(posix_time::seconds(opt_l["time"].as<int>())) ){
       LOG(INFO) << "Run killed because time limit has been reached" << endl;
     }
 
+    //Ecriture synchrone de la meilleure solution, que le run soit termine ou non, une fois verifiee
+    //(sinon la derniere solution verifiee remplace ce que l'ecrivain a pu ecrire entre temps)
+    try {
+      if ( verifieMeilleureSolution(*pVerification_l) ){
+        SolutionDtoout::termineEcriture();
+      } else {
+        boost::mutex::scoped_lock lock_l(pVerification_l->mutex);
+        SolutionDtoout::restaure(pVerification_l->solVerifiee);
+      }
+    } catch (string s_l){
+      LOG(ERREUR) << "Levee de l'exception : " << s_l << endl;
+    }
+
 
     return 0;
 }
@@ -22,28 +22,26 @@
  */
 
 #include "tools/Checker.hh"
+#include "tools/ConstraintState.hh"
 #include "tools/Log.hh"
 #include "alg/ContextALG.hh"
-#include "bo/BalanceCostBO.hh"
 #include "bo/ContextBO.hh"
-#include "bo/LocationBO.hh"
-#include "bo/MachineBO.hh"
+#include "bo/InstanceCoreBO.hh"
 #include "bo/MMCBO.hh"
-#include "bo/ProcessBO.hh"
 #include "bo/RessourceBO.hh"
-#include "bo/ServiceBO.hh"
 #include <boost/foreach.hpp>
-#include <set>
 #include <vector>
 using namespace std;
 
 Checker::Checker(ContextALG const * pContextALG_p) :
     pContextALG_m(pContextALG_p),
+    pCore_m(pContextALG_p->getInstanceCore()),
     contextToDelete_m(false)
 {}
 
 Checker::Checker(ContextBO const * pContextBO_p, const vector<int>& sol_p) :
     pContextALG_m(buildMyContextALG(pContextBO_p, sol_p)),
+    pCore_m(pContextALG_m->getInstanceCore()),
     contextToDelete_m(true)
 {}
 
@@ -58,24 +56,34 @@ Checker::~Checker(){
 }
 
 bool Checker::isValid(){
-    return checkCapaIncludingTransient()
-        && checkConflict()
-        && checkSpread()
-        && checkDependances();
+    if ( ! checkCapaIncludingTransient() ){
+        return false;
+    }
+
+    return getConstraintState().isValid();
+}
+
+CheckerResult Checker::evaluate(int nbThreads_p){
+    return pContextALG_m->getFusedChecker()->evaluate(pContextALG_m->getCurrentSol(), nbThreads_p);
+}
+
+CheckerResult Checker::evaluateBounded(uint64_t bound_p, int nbThreads_p){
+    CheckerResult result_l;
+    pContextALG_m->getFusedChecker()->evaluateBounded(pContextALG_m->getCurrentSol(), bound_p, result_l, nbThreads_p);
+    return result_l;
 }
 
 uint64_t Checker::computeScore(){
-    ContextBO const * pContextBO_l = pContextALG_m->getContextBO();
     return computeLoadCost()
         + computeBalanceCost()
-        + pContextBO_l->getPoidsPMC() * computePMC()
-        + pContextBO_l->getPoidsSMC() * computeSMC()
-        + pContextBO_l->getPoidsMMC() * computeMMC();
+        + pCore_m->getPoidsPMC() * computePMC()
+        + pCore_m->getPoidsSMC() * computeSMC()
+        + pCore_m->getPoidsMMC() * computeMMC();
 }
 
 bool Checker::checkCapaIncludingTransient(){
     ContextBO const * pContextBO_l = pContextALG_m->getContextBO();
-    const int nbRess_l = pContextBO_l->getNbRessources();
+    const int nbRess_l = pCore_m->getNbRessources();
 
     for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
         RessourceBO const * pRess_l = pContextBO_l->getRessource(idxRess_l);
@@ -87,31 +95,18 @@ bool Checker::checkCapaIncludingTransient(){
 }
 
 bool Checker::checkCapaIncludingTransient(RessourceBO const * pRess_p){
-    ContextBO const * pContextBO_l = pContextALG_m->getContextBO();
-    const vector<int>& currentSol_l = pContextALG_m->getCurrentSol();
-    vector<int> vUsedRess_l(pContextBO_l->getNbMachines(), 0);
-
-    const int nbProcess_l = pContextBO_l->getNbProcesses();
-    for ( int idxP_l=0 ; idxP_l < nbProcess_l ; idxP_l++ ){
-        ProcessBO const * pProcess_l = pContextBO_l->getProcess(idxP_l);
-        const int idxCurMachine_l = currentSol_l[idxP_l];
-        vUsedRess_l[idxCurMachine_l] += pProcess_l->getRequirement(pRess_p);
-
-        if ( pRess_p->isTransient() ){
-            int idxMachineInit_l = pProcess_l->getMachineInit()->getId();
-            if ( idxCurMachine_l != idxMachineInit_l ){
-                vUsedRess_l[idxMachineInit_l] += pProcess_l->getRequirement(pRess_p);
-            }
-        }
-    }
+    const int idxRess_l = pRess_p->getId();
+    const int nbMachines_l = pCore_m->getNbMachines();
+    const vector<int>& capa_l = pCore_m->getCapasByRess();
 
-    const int nbMachines_l = pContextBO_l->getNbMachines();
     for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
-        const int capa_l = pContextBO_l->getMachine(idxMachine_l)->getCapa(pRess_p);
-        if ( vUsedRess_l[idxMachine_l] > capa_l ){
+        const int capaMachine_l = capa_l[idxRess_l*nbMachines_l + idxMachine_l];
+        const int usedRess_l = pContextALG_m->getRessUsedOnMachine(idxRess_l, idxMachine_l)
+            + pContextALG_m->getTransientRessUsedOnMachine(idxRess_l, idxMachine_l);
+        if ( usedRess_l > capaMachine_l ){
             LOG(DEBUG) << "La solution viole la contrainte de capa pour la ressource " 
                 << pRess_p->getId() << " sur la machine " << idxMachine_l 
-                << " (requirement : " << vUsedRess_l[idxMachine_l] << ", capa : " << capa_l << ")" << endl;
+                << " (requirement : " << usedRess_l << ", capa : " << capaMachine_l << ")" << endl;
             return false;
         }
     }
@@ -119,84 +114,33 @@ bool Checker::checkCapaIncludingTransient(RessourceBO const * pRess_p){
     return true;
 }
 
-bool Checker::checkConflict(){
-    set<pair<int, int> > assocesMachineService_l;
-    const vector<int>& curSol_l = pContextALG_m->getCurrentSol();
-    ContextBO const * pContextBO_l = pContextALG_m->getContextBO();
-
-    for ( int idxP_l=0 ; idxP_l < pContextBO_l->getNbProcesses() ; idxP_l++ ){
-        const int idxCurMachine_l = curSol_l[idxP_l];
-        const int idxService_l = pContextBO_l->getProcess(idxP_l)->getService()->getId();
-        pair<int, int> assoceMachineService_l(idxCurMachine_l, idxService_l);
-        if ( assocesMachineService_l.find(assoceMachineService_l) != assocesMachineService_l.end() ){
-            LOG(DEBUG) << "La solution viole la contrainte de conflit : plusieurs processes du service "
-                << idxService_l << " sur la machine " << idxCurMachine_l << endl;
-            return false;
-        }
-        assocesMachineService_l.insert(assoceMachineService_l);
+ConstraintState const & Checker::getConstraintState(){
+    const vector<int>& sol_l = pContextALG_m->getCurrentSol();
+    if ( ! pConstraintState_m ){
+        pConstraintState_m.reset(new ConstraintState(pContextALG_m->getContextBO()));
+    } else if ( sol_l == solConstraintState_m ){
+        return *pConstraintState_m;
     }
+    pConstraintState_m->reset(sol_l);
+    solConstraintState_m = sol_l;
+    return *pConstraintState_m;
+}
 
-    return true;
+bool Checker::checkConflict(){
+    return getConstraintState().checkConflict();
 }
 
 bool Checker::checkSpread(){
-    const vector<int>& curSol_l = pContextALG_m->getCurrentSol();
-    ContextBO const * pContextBO_l = pContextALG_m->getContextBO();
-    vector<set<int> > memory_l(pContextBO_l->getNbServices());; //memory_l[idxService] => liste des locations utilisees
-
-    for ( int idxP_l=0 ; idxP_l < pContextBO_l->getNbProcesses() ; idxP_l++ ){
-        const int idxService_l = pContextBO_l->getProcess(idxP_l)->getService()->getId();
-        const int idxLocation_l = pContextBO_l->getMachine(curSol_l[idxP_l])->getLocation()->getId();
-        memory_l[idxService_l].insert(idxLocation_l);
-    }
-
-    for ( int idxS_l=0 ; idxS_l < pContextBO_l->getNbServices() ; idxS_l++ ){
-        const int spreadMin_l = pContextBO_l->getService(idxS_l)->getSpreadMin();
-        if ( spreadMin_l > (int) memory_l[idxS_l].size() ){
-            LOG(DEBUG) << "La solution viole la contrainte de spread : le service "
-                << idxS_l << " s'etend sur " << memory_l[idxS_l].size() 
-                << " locations mais a un spread min de " << spreadMin_l << endl;
-            return false;
-        }
-    }
-
-    return true;
+    return getConstraintState().checkSpread();
 }
 
 bool Checker::checkDependances(){
-    ContextBO const * pContextBO_l = pContextALG_m->getContextBO();
-    const int nbServices_l = pContextBO_l->getNbServices();
-
-    for ( int idxS1_l=0 ; idxS1_l < nbServices_l ; idxS1_l++ ){
-        ServiceBO const * pS1_l = pContextBO_l->getService(idxS1_l);
-        if ( pS1_l->getServicesIDependOn().empty() ){
-            continue;
-        }
-
-        unordered_set<int> neighsUsedBy1_l = pContextALG_m->getNeighsUsedByService(pS1_l);
-
-        BOOST_FOREACH(int idxS2_l, pS1_l->getServicesIDependOn()){
-            unordered_set<int> neighsUsedBy2_l = pContextALG_m->getNeighsUsedByService(idxS2_l);
-
-            BOOST_FOREACH(int idxN_l, neighsUsedBy1_l){
-                if ( neighsUsedBy2_l.find(idxN_l) == neighsUsedBy2_l.end() ){
-                    LOG(DEBUG) << "La solution viole la contrainte de dependances : "
-                        << "le service " << idxS1_l << " utilise le neighborhood "
-                        << idxN_l << " mais depend du service " << idxS2_l
-                        << " qui n'y est pas present" << endl;
-                    return false;
-                }
-            }
-        }
-    }
-
-    return true;
+    return getConstraintState().checkDependances();
 }
 
 uint64_t Checker::computeLoadCost(){
     uint64_t result_l(0);
-    ContextBO const * pContextBO_l = pContextALG_m->getContextBO();
-    const int nbRess_l = pContextBO_l->getNbRessources();
+    const int nbRess_l = pCore_m->getNbRessources();
     for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
         int loadCostRess_l = computeLoadCost(idxRess_l);
         result_l += loadCostRess_l;
@@ -207,19 +151,17 @@ uint64_t Checker::computeLoadCost(){
 
 uint64_t Checker::computeLoadCost(int idxRess_p){
     uint64_t result_l(0);
-    const int nbMachine_l = pContextALG_m->getContextBO()->getNbMachines();
+    const int nbMachine_l = pCore_m->getNbMachines();
     for ( int idxMachine_l=0 ; idxMachine_l < nbMachine_l ; idxMachine_l++ ){
         result_l += computeLoadCost(idxRess_p, idxMachine_l);
     }
-    result_l *= pContextALG_m->getContextBO()->getRessource(idxRess_p)->getWeightLoadCost();
+    result_l *= pCore_m->getWeightLoadCost()[idxRess_p];
     LOG(USELESS) << "\tload cost pour la ress " << idxRess_p << " : " << result_l << endl;
     return result_l;
 }
 
 uint64_t Checker::computeLoadCost(int idxRess_p, int idxMachine_p){
-    MachineBO* pMachine_l = pContextALG_m->getContextBO()->getMachine(idxMachine_p);
-
-    int safetyCapa_l = pMachine_l->getSafetyCapa(idxRess_p);
+    const int safetyCapa_l = pCore_m->getSafetyCapas()[idxMachine_p*pCore_m->getNbRessources() + idxRess_p];
     uint64_t result_l = max(0, pContextALG_m->getRessUsedOnMachine(idxRess_p, idxMachine_p) - safetyCapa_l);
     LOG(USELESS) << "\t\tload cost pour la ress " << idxRess_p << " sur la machine "
         << idxMachine_p << " : " << result_l << endl;
@@ -227,7 +169,7 @@ uint64_t Checker::computeLoadCost(int idxRess_p, int idxMachine_p){
 }
 
 uint64_t Checker::computeBalanceCost(){
-    const int nbMachines_l = pContextALG_m->getContextBO()->getNbMachines();
+    const int nbMachines_l = pCore_m->getNbMachines();
     uint64_t result_l(0);
     for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
         result_l += computeBalanceCost(idxMachine_l);
@@ -237,7 +179,7 @@ uint64_t Checker::computeBalanceCost(){
 }
 
 uint64_t Checker::computeBalanceCost(int idxMachine_p){
-    const int nbBalanceCost_l = pContextALG_m->getContextBO()->getNbBalanceCosts();
+    const int nbBalanceCost_l = pCore_m->getNbBalanceCosts();
     uint64_t result_l(0);
 
     for ( int idxBC_l=0 ; idxBC_l < nbBalanceCost_l ; idxBC_l++ ){
@@ -248,32 +190,29 @@ uint64_t Checker::computeBalanceCost(int idxMachine_p){
 }
 
 uint64_t Checker::computeBalanceCost(int idxMachine_p, int idxBC_l ){
-    BalanceCostBO const * pBC_l = pContextALG_m->getContextBO()->getBalanceCost(idxBC_l);
-    RessourceBO* pRess1_l = pBC_l->getRessource1();
-    RessourceBO* pRess2_l = pBC_l->getRessource2();
-    const int qteRess1Used_l = pContextALG_m->getRessUsedOnMachine(pRess1_l->getId(), idxMachine_p);
-    const int qteRess2Used_l = pContextALG_m->getRessUsedOnMachine(pRess2_l->getId(), idxMachine_p);
-    const int capaRess1_l = pContextALG_m->getContextBO()->getMachine(idxMachine_p)->getCapa(pRess1_l);
-    const int capaRess2_l = pContextALG_m->getContextBO()->getMachine(idxMachine_p)->getCapa(pRess2_l);
+    const int idxRess1_l = pCore_m->getBCRess1()[idxBC_l];
+    const int idxRess2_l = pCore_m->getBCRess2()[idxBC_l];
+    const int* pCapa_l = &pCore_m->getCapas()[idxMachine_p*pCore_m->getNbRessources()];
 
-    const int a1_l = capaRess1_l - qteRess1Used_l;
-    const int a2_l = capaRess2_l - qteRess2Used_l;
+    const int a1_l = pCapa_l[idxRess1_l] - pContextALG_m->getRessUsedOnMachine(idxRess1_l, idxMachine_p);
+    const int a2_l = pCapa_l[idxRess2_l] - pContextALG_m->getRessUsedOnMachine(idxRess2_l, idxMachine_p);
 
     /* FIXME : si on boucle d'abord sur les bc, *puis* sur les machine, on n'aura
      * a effectuer qu'une multiplication par bc et non une par couple (bc, machine)
      * (ceci dit, il peut etre interessant de conserver la possibilite d'estimer les bc sur une machine donnee...)
      */
-    return pBC_l->getPoids() * max(0, pBC_l->getTarget()*a1_l - a2_l);
+    return pCore_m->getBCPoids()[idxBC_l] * max(0, pCore_m->getBCTarget()[idxBC_l]*a1_l - a2_l);
 }
 
 uint64_t Checker::computePMC(){
     uint64_t result_l = 0;
 
     const vector<int>& curSol_l = pContextALG_m->getCurrentSol();
+    const vector<int>& solInit_l = pCore_m->getSolInit();
+    const vector<int>& pmc_l = pCore_m->getPMC();
     for ( int idx_l=0 ; idx_l < (int) curSol_l.size() ; idx_l++ ){
-        ProcessBO const * pProcess_l = pContextALG_m->getContextBO()->getProcess(idx_l);
-        if ( curSol_l[idx_l] != pProcess_l->getMachineInit()->getId() ){
-            result_l += pProcess_l->getPMC();
+        if ( curSol_l[idx_l] != solInit_l[idx_l] ){
+            result_l += pmc_l[idx_l];
         }
     }
 
@@ -282,14 +221,14 @@ uint64_t Checker::computePMC(){
 
 uint64_t Checker::computeSMC(){
     const vector<int>& curSol_l = pContextALG_m->getCurrentSol();
+    const vector<int>& solInit_l = pCore_m->getSolInit();
+    const vector<int>& serviceOfProcess_l = pCore_m->getServiceOfProcess();
     const int nbProcess_l = curSol_l.size();
-    const int nbServices_l = pContextALG_m->getContextBO()->getNbServices();
-    vector<int> nbProcessMovedByService_l(nbServices_l, 0);
+    vector<int> nbProcessMovedByService_l(pCore_m->getNbServices(), 0);
 
     for ( int idxP_l=0 ; idxP_l < (int) nbProcess_l ; idxP_l++ ){
-        ProcessBO const * pProcess_l = pContextALG_m->getContextBO()->getProcess(idxP_l);
-        if ( curSol_l[idxP_l] != pProcess_l->getMachineInit()->getId() ){
-            nbProcessMovedByService_l[pProcess_l->getService()->getId()]++;
+        if ( curSol_l[idxP_l] != solInit_l[idxP_l] ){
+            nbProcessMovedByService_l[serviceOfProcess_l[idxP_l]]++;
         }
     }
 
@@ -303,12 +242,13 @@ uint64_t Checker::computeSMC(){
 
 uint64_t Checker::computeMMC(){
     const vector<int>& curSol_l = pContextALG_m->getCurrentSol();
+    const vector<int>& solInit_l = pCore_m->getSolInit();
     const int nbP_l = curSol_l.size();
-    MMCBO* pMMCBO_l = pContextALG_m->getContextBO()->getMMCBO();
+    MMCBO const * pMMCBO_l = pCore_m->getMMCBO();
     uint64_t result_l(0);
 
     for ( int idxP_l=0 ; idxP_l < nbP_l ; idxP_l++ ){
-        result_l += pMMCBO_l->getCost(pContextALG_m->getContextBO()->getProcess(idxP_l)->getMachineInit()->getId() , curSol_l[idxP_l]);
+        result_l += pMMCBO_l->getCost(solInit_l[idxP_l], curSol_l[idxP_l]);
     }
 
     return result_l;
@@ -324,8 +264,6 @@ bool check(ContextBO const * pContextBO_p){
     return check(&contextALG_l);
 }
 
-ContextALG const * Checker::buildMyContextALG(ContextBO const * pContextBO, const vector<int> sol_p){
-    ContextALG* pResult_l = new ContextALG(pContextBO, false, false);
-    pResult_l->setCurrentSol(sol_p);
-    return pResult_l;
+ContextALG const * Checker::buildMyContextALG(ContextBO const * pContextBO, const vector<int>& sol_p){
+    return new ContextALG(pContextBO, sol_p, false);
 }
@@ -25,11 +25,16 @@
 #define CHECKER_HH
 #include <vector>
 #include <stdint.h>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include "tools/FusedChecker.hh"
 using namespace std;
 
 
+class ConstraintState;
 class ContextALG;
 class ContextBO;
+class InstanceCoreBO;
 class MachineBO;
 class RessourceBO;
 
@@ -43,6 +48,11 @@ class Checker {
     public:
         Checker(ContextALG const * pContextALG_p);
 
+        /**
+         * Construit (et copie la solution dans) un ContextALG dedie : couteux.
+         * Pour seulement valider et scorer une solution, utiliser FusedChecker::evaluate(), qui lit
+         * la solution sans la copier et sans allouer
+         */
         Checker(ContextBO const * pContextBO_p, const vector<int>& sol_p);
 
         /**
@@ -59,6 +69,18 @@ class Checker {
 
         bool isValid();
 
+        /**
+         * Verifie la solution et calcule tous ses couts en une seule passe (cf #FusedChecker).
+         * A preferer a l'enchainement isValid() puis computeScore()
+         * @param Nombre de threads sur lesquels repartir l'evaluation (le resultat n'en depend pas)
+         */
+        CheckerResult evaluate(int nbThreads_p=1);
+
+        /**
+         * Comme evaluate(), mais abandonne des que le score depasse la borne (cf FusedChecker::evaluateBounded())
+         */
+        CheckerResult evaluateBounded(uint64_t bound_p, int nbThreads_p=1);
+
         /**
          * Calcule le score en supposant que l'instance est valide.
          * Dans le cas contrainte, le comportement est indetermine
@@ -91,10 +113,16 @@ class Checker {
     private:
         bool checkCapaIncludingTransient(RessourceBO const * pRess_p);
 
+        /**
+         * Etat des contraintes de placement de la solution courante du ContextALG.
+         * Construit au premier appel, il n'est recalcule que si la solution courante a change depuis
+         */
+        ConstraintState const & getConstraintState();
+
         /**
          * Permet de construire un ContextALG customise, et const
          */
-        ContextALG const * buildMyContextALG(ContextBO const * pContextBO, const vector<int> sol_p);
+        ContextALG const * buildMyContextALG(ContextBO const * pContextBO, const vector<int>& sol_p);
 
         /**
          * Le const permet surtout a la classe cliente de s'assurer qu'on ne pourri
@@ -103,11 +131,22 @@ class Checker {
          */
         ContextALG const * pContextALG_m;
 
+        /**
+         * Donnees a plat de l'instance, sur lesquelles s'appuient les calculs de couts
+         */
+        boost::shared_ptr<InstanceCoreBO const> pCore_m;
+
         /**
          * Si le context a ete cree sur mesure par le checker, il faut le deleter nous meme
          */
         bool contextToDelete_m;
 
+        /**
+         * Cf getConstraintState() : l'etat, et la solution sur laquelle il a ete calcule
+         */
+        boost::scoped_ptr<ConstraintState> pConstraintState_m;
+        vector<int> solConstraintState_m;
+
 };
 
 #endif
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "tools/ConstraintState.hh"
+#include "tools/Log.hh"
+#include "bo/ContextBO.hh"
+#include "bo/InstanceCoreBO.hh"
+#include "tools/IndexCSR.hh"
+#include <boost/foreach.hpp>
+#include <algorithm>
+using namespace std;
+
+ConstraintState::ConstraintState(ContextBO const * pContextBO_p) :
+    pCore_m(pContextBO_p->getInstanceCore()),
+    nbServices_m(pCore_m->getNbServices()),
+    nbMachines_m(pCore_m->getNbMachines()),
+    nbLocations_m(pCore_m->getNbLocations()),
+    nbNeighs_m(pCore_m->getNbNeighborhoods()),
+    serviceOfProcess_m(pCore_m->getServiceOfProcess()),
+    machineLocation_m(pCore_m->getMachineLocation()),
+    machineNeigh_m(pCore_m->getMachineNeighborhood()),
+    spreadMin_m(pCore_m->getSpreadMin()),
+    servicesIDependOn_m(pCore_m->getServicesIDependOn()),
+    servicesDependingOnMe_m(pCore_m->getServicesDependingOnMe()),
+    serviceOnMachine_m(nbServices_m * nbMachines_m, false),
+    nbPByServiceLocation_m(nbServices_m * nbLocations_m, 0),
+    nbLocationsByService_m(nbServices_m, 0),
+    nbPByServiceNeigh_m(nbServices_m * nbNeighs_m, 0)
+{}
+
+void ConstraintState::reset(const vector<int>& sol_p){
+    serviceOnMachine_m.assign(serviceOnMachine_m.size(), false);
+    conflicts_m.clear();
+    nbPByServiceLocation_m.assign(nbPByServiceLocation_m.size(), 0);
+    nbLocationsByService_m.assign(nbLocationsByService_m.size(), 0);
+    nbPByServiceNeigh_m.assign(nbPByServiceNeigh_m.size(), 0);
+
+    for ( int idxP_l=0 ; idxP_l < (int) sol_p.size() ; idxP_l++ ){
+        addProcess(idxP_l, sol_p[idxP_l]);
+    }
+}
+
+void ConstraintState::addProcess(int idxP_p, int idxMachine_p){
+    const int idxService_l = serviceOfProcess_m[idxP_p];
+
+    const int idxOccupation_l = idxService_l*nbMachines_m + idxMachine_p;
+    if ( serviceOnMachine_m[idxOccupation_l] ){
+        conflicts_m.push_back(make_pair(idxService_l, idxMachine_p));
+    } else {
+        serviceOnMachine_m[idxOccupation_l] = true;
+    }
+
+    int& nbPOnLocation_l = nbPByServiceLocation_m[idxService_l*nbLocations_m + machineLocation_m[idxMachine_p]];
+    if ( nbPOnLocation_l == 0 ){
+        nbLocationsByService_m[idxService_l]++;
+    }
+    nbPOnLocation_l++;
+
+    nbPByServiceNeigh_m[idxService_l*nbNeighs_m + machineNeigh_m[idxMachine_p]]++;
+}
+
+void ConstraintState::removeProcess(int idxP_p, int idxMachine_p){
+    const int idxService_l = serviceOfProcess_m[idxP_p];
+
+    /* S'il reste un autre process du service sur la machine, le bit doit rester leve */
+    vector<pair<int, int> >::iterator it_l = find(conflicts_m.begin(), conflicts_m.end(), make_pair(idxService_l, idxMachine_p));
+    if ( it_l != conflicts_m.end() ){
+        conflicts_m.erase(it_l);
+    } else {
+        serviceOnMachine_m[idxService_l*nbMachines_m + idxMachine_p] = false;
+    }
+
+    int& nbPOnLocation_l = nbPByServiceLocation_m[idxService_l*nbLocations_m + machineLocation_m[idxMachine_p]];
+    nbPOnLocation_l--;
+    if ( nbPOnLocation_l == 0 ){
+        nbLocationsByService_m[idxService_l]--;
+    }
+
+    nbPByServiceNeigh_m[idxService_l*nbNeighs_m + machineNeigh_m[idxMachine_p]]--;
+}
+
+void ConstraintState::moveProcess(int idxP_p, int idxMachineOld_p, int idxMachineNew_p){
+    if ( idxMachineOld_p == idxMachineNew_p ){
+        return;
+    }
+    removeProcess(idxP_p, idxMachineOld_p);
+    addProcess(idxP_p, idxMachineNew_p);
+}
+
+bool ConstraintState::isConflictOkForMove(int idxP_p, int idxMachineOld_p, int idxMachineNew_p) const {
+    return idxMachineOld_p == idxMachineNew_p
+        || ! serviceOnMachine_m[serviceOfProcess_m[idxP_p]*nbMachines_m + idxMachineNew_p];
+}
+
+bool ConstraintState::isSpreadOkForMove(int idxP_p, int idxMachineOld_p, int idxMachineNew_p) const {
+    const int idxLocOld_l = machineLocation_m[idxMachineOld_p];
+    const int idxLocNew_l = machineLocation_m[idxMachineNew_p];
+    if ( idxLocOld_l == idxLocNew_l ){
+        return true;
+    }
+
+    const int idxService_l = serviceOfProcess_m[idxP_p];
+    const int nbLocations_l = nbLocationsByService_m[idxService_l]
+        - (nbPByServiceLocation_m[idxService_l*nbLocations_m + idxLocOld_l] == 1)
+        + (nbPByServiceLocation_m[idxService_l*nbLocations_m + idxLocNew_l] == 0);
+    return nbLocations_l >= spreadMin_m[idxService_l];
+}
+
+bool ConstraintState::isDependancesOkForMove(int idxP_p, int idxMachineOld_p, int idxMachineNew_p) const {
+    const int idxNeighOld_l = machineNeigh_m[idxMachineOld_p];
+    const int idxNeighNew_l = machineNeigh_m[idxMachineNew_p];
+    if ( idxNeighOld_l == idxNeighNew_l ){
+        return true;
+    }
+
+    const int idxService_l = serviceOfProcess_m[idxP_p];
+    if ( nbPByServiceNeigh_m[idxService_l*nbNeighs_m + idxNeighNew_l] == 0 ){
+        BOOST_FOREACH(int idxS2_l, servicesIDependOn_m.getLigne(idxService_l)){
+            if ( nbPByServiceNeigh_m[idxS2_l*nbNeighs_m + idxNeighNew_l] == 0 ){
+                return false;
+            }
+        }
+    }
+
+    if ( nbPByServiceNeigh_m[idxService_l*nbNeighs_m + idxNeighOld_l] == 1 ){
+        BOOST_FOREACH(int idxS2_l, servicesDependingOnMe_m.getLigne(idxService_l)){
+            if ( nbPByServiceNeigh_m[idxS2_l*nbNeighs_m + idxNeighOld_l] > 0 ){
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ConstraintState::isFeasibleMove(int idxP_p, int idxMachineOld_p, int idxMachineNew_p) const {
+    return isConflictOkForMove(idxP_p, idxMachineOld_p, idxMachineNew_p)
+        && isSpreadOkForMove(idxP_p, idxMachineOld_p, idxMachineNew_p)
+        && isDependancesOkForMove(idxP_p, idxMachineOld_p, idxMachineNew_p);
+}
+
+bool ConstraintState::isValidAfterMove(int idxP_p, int idxMachineOld_p, int idxMachineNew_p) const {
+    if ( idxMachineOld_p == idxMachineNew_p ){
+        return true;
+    }
+
+    const int idxService_l = serviceOfProcess_m[idxP_p];
+    if ( nbLocationsByService_m[idxService_l] < spreadMin_m[idxService_l] ){
+        return false;
+    }
+
+    const int idxNeighOld_l = machineNeigh_m[idxMachineOld_p];
+    const int idxNeighNew_l = machineNeigh_m[idxMachineNew_p];
+    if ( idxNeighOld_l == idxNeighNew_l ){
+        return true;
+    }
+
+    /* Le service est present sur le nouveau neighborhood : ceux dont il depend doivent y etre */
+    BOOST_FOREACH(int idxS2_l, servicesIDependOn_m.getLigne(idxService_l)){
+        if ( nbPByServiceNeigh_m[idxS2_l*nbNeighs_m + idxNeighNew_l] == 0 ){
+            return false;
+        }
+    }
+
+    /* S'il a quitte l'ancien neighborhood, ceux qui dependent de lui ne doivent plus y etre */
+    if ( nbPByServiceNeigh_m[idxService_l*nbNeighs_m + idxNeighOld_l] == 0 ){
+        BOOST_FOREACH(int idxS2_l, servicesDependingOnMe_m.getLigne(idxService_l)){
+            if ( nbPByServiceNeigh_m[idxS2_l*nbNeighs_m + idxNeighOld_l] > 0 ){
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ConstraintState::isValid() const {
+    return checkConflict()
+        && checkSpread()
+        && checkDependances();
+}
+
+bool ConstraintState::checkConflict() const {
+    if ( ! conflicts_m.empty() ){
+        LOG(DEBUG) << "La solution viole la contrainte de conflit : plusieurs processes du service "
+            << conflicts_m.front().first << " sur la machine " << conflicts_m.front().second << endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool ConstraintState::checkSpread() const {
+    for ( int idxS_l=0 ; idxS_l < nbServices_m ; idxS_l++ ){
+        if ( spreadMin_m[idxS_l] > nbLocationsByService_m[idxS_l] ){
+            LOG(DEBUG) << "La solution viole la contrainte de spread : le service "
+                << idxS_l << " s'etend sur " << nbLocationsByService_m[idxS_l]
+                << " locations mais a un spread min de " << spreadMin_m[idxS_l] << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ConstraintState::checkDependances() const {
+    for ( int idxS1_l=0 ; idxS1_l < nbServices_m ; idxS1_l++ ){
+        BOOST_FOREACH(int idxS2_l, servicesIDependOn_m.getLigne(idxS1_l)){
+            for ( int idxN_l=0 ; idxN_l < nbNeighs_m ; idxN_l++ ){
+                if ( nbPByServiceNeigh_m[idxS1_l*nbNeighs_m + idxN_l] > 0
+                        && nbPByServiceNeigh_m[idxS2_l*nbNeighs_m + idxN_l] == 0 ){
+                    LOG(DEBUG) << "La solution viole la contrainte de dependances : "
+                        << "le service " << idxS1_l << " utilise le neighborhood "
+                        << idxN_l << " mais depend du service " << idxS2_l
+                        << " qui n'y est pas present" << endl;
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+int ConstraintState::getNbConflicts() const {
+    return conflicts_m.size();
+}
+
+bool ConstraintState::isServiceOnMachine(int idxService_p, int idxMachine_p) const {
+    return serviceOnMachine_m[idxService_p*nbMachines_m + idxMachine_p];
+}
+
+int ConstraintState::getNbLocationsUsed(int idxService_p) const {
+    return nbLocationsByService_m[idxService_p];
+}
+
+int ConstraintState::getNbProcessesOnNeigh(int idxService_p, int idxNeigh_p) const {
+    return nbPByServiceNeigh_m[idxService_p*nbNeighs_m + idxNeigh_p];
+}
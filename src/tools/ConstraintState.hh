@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef CONSTRAINTSTATE_HH
+#define CONSTRAINTSTATE_HH
+#include <utility>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+using namespace std;
+
+class ContextBO;
+class IndexCSR;
+class InstanceCoreBO;
+
+/**
+ * Etat des contraintes de placement (conflit, spread, dependances) d'une solution,
+ * stocke dans des tableaux plats :
+ * - un bit par couple (service, machine) indiquant que le service y a un process
+ * - le nombre de process de chaque service sur chaque location (et le nombre de locations utilisees)
+ * - le nombre de process de chaque service sur chaque neighborhood
+ *
+ * Les mises a jour (ajout/retrait d'un process sur une machine) et les requetes de faisabilite
+ * d'un mouvement se font en O(1) (au nombre de dependances du service pres).
+ * La validation d'une solution complete s'appuie sur ces memes tableaux.
+ */
+class ConstraintState {
+    public:
+        /**
+         * Construit un etat vide (aucun process place)
+         * @param Le ContextBO decrivant l'instance (il doit survivre a l'etat)
+         */
+        ConstraintState(ContextBO const * pContextBO_p);
+
+        /**
+         * Vide l'etat puis y place tous les process de la solution
+         */
+        void reset(const vector<int>& sol_p);
+
+        /**
+         * Ajoute ou retire un process sur une machine
+         */
+        void addProcess(int idxP_p, int idxMachine_p);
+        void removeProcess(int idxP_p, int idxMachine_p);
+
+        /**
+         * Deplace un process (equivalent a un retrait puis un ajout)
+         */
+        void moveProcess(int idxP_p, int idxMachineOld_p, int idxMachineNew_p);
+
+        /**
+         * Faisabilite d'un mouvement, a partir d'un etat valide.
+         * L'etat n'est pas modifie.
+         */
+        bool isConflictOkForMove(int idxP_p, int idxMachineOld_p, int idxMachineNew_p) const;
+        bool isSpreadOkForMove(int idxP_p, int idxMachineOld_p, int idxMachineNew_p) const;
+        bool isDependancesOkForMove(int idxP_p, int idxMachineOld_p, int idxMachineNew_p) const;
+        bool isFeasibleMove(int idxP_p, int idxMachineOld_p, int idxMachineNew_p) const;
+
+        /**
+         * Verifie, apres que le process a ete deplace, les contraintes de spread et de dependances
+         * qui peuvent avoir ete violees par ce mouvement.
+         * Utile pour les mouvements composes, qu'on applique avant de les verifier
+         */
+        bool isValidAfterMove(int idxP_p, int idxMachineOld_p, int idxMachineNew_p) const;
+
+        /**
+         * Validation de tout l'etat
+         */
+        bool isValid() const;
+        bool checkConflict() const;
+        bool checkSpread() const;
+        bool checkDependances() const;
+
+        int getNbConflicts() const;
+        bool isServiceOnMachine(int idxService_p, int idxMachine_p) const;
+        int getNbLocationsUsed(int idxService_p) const;
+        int getNbProcessesOnNeigh(int idxService_p, int idxNeigh_p) const;
+
+    private:
+        boost::shared_ptr<InstanceCoreBO const> pCore_m;
+
+        const int nbServices_m;
+        const int nbMachines_m;
+        const int nbLocations_m;
+        const int nbNeighs_m;
+
+        /**
+         * Donnees de l'instance, lues dans l'#InstanceCoreBO
+         */
+        const vector<int>& serviceOfProcess_m;
+        const vector<int>& machineLocation_m;
+        const vector<int>& machineNeigh_m;
+        const vector<int>& spreadMin_m;
+
+        /**
+         * servicesIDependOn_m.getLigne(idxS) = services dont depend idxS
+         * servicesDependingOnMe_m.getLigne(idxS) = services qui dependent de idxS
+         */
+        const IndexCSR& servicesIDependOn_m;
+        const IndexCSR& servicesDependingOnMe_m;
+
+        /**
+         * serviceOnMachine_m[idxS * nbMachines + idxMachine] : le service a un process sur la machine.
+         * Si un second process du meme service arrive sur la machine, le couple (service, machine)
+         * est memorise dans conflicts_m (autant de fois que de process surnumeraires)
+         */
+        vector<bool> serviceOnMachine_m;
+        vector<pair<int, int> > conflicts_m;
+
+        /**
+         * nbPByServiceLocation_m[idxS * nbLocations + idxLoc] = nombre de process du service sur la location
+         * nbLocationsByService_m[idxS] = nombre de locations distinctes utilisees par le service
+         * nbPByServiceNeigh_m[idxS * nbNeighs + idxNeigh] = nombre de process du service sur le neighborhood
+         */
+        vector<int> nbPByServiceLocation_m;
+        vector<int> nbLocationsByService_m;
+        vector<int> nbPByServiceNeigh_m;
+};
+
+#endif
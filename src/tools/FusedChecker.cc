@@ -0,0 +1,654 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+#include "tools/FusedChecker.hh"
+#include "tools/Log.hh"
+#include "bo/ContextBO.hh"
+#include "bo/InstanceCoreBO.hh"
+#include "bo/MMCBO.hh"
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+#include <boost/thread.hpp>
+#include <algorithm>
+#include <climits>
+#include <limits>
+using namespace std;
+
+CheckerResult::CheckerResult() :
+    valid(true),
+    dominated(false),
+    violation(AUCUNE),
+    idx1(-1),
+    idx2(-1),
+    loadCost(0),
+    balanceCost(0),
+    pmc(0),
+    smc(0),
+    mmc(0),
+    score(0)
+{}
+
+/**
+ * Trie les machines selon la cle donnee (tri par denombrement, stable)
+ */
+static void sortMachinesByKey(const vector<int>& keyOfMachine_p, int nbKeys_p, vector<int>& machines_p, vector<int>& start_p){
+    start_p.assign(nbKeys_p + 1, 0);
+    BOOST_FOREACH(int key_l, keyOfMachine_p){
+        start_p[key_l + 1]++;
+    }
+    for ( int idxKey_l=0 ; idxKey_l < nbKeys_p ; idxKey_l++ ){
+        start_p[idxKey_l + 1] += start_p[idxKey_l];
+    }
+
+    vector<int> pos_l(start_p.begin(), start_p.end() - 1);
+    machines_p.resize(keyOfMachine_p.size());
+    for ( int idxMachine_l=0 ; idxMachine_l < (int) keyOfMachine_p.size() ; idxMachine_l++ ){
+        machines_p[pos_l[keyOfMachine_p[idxMachine_l]]++] = idxMachine_l;
+    }
+}
+
+FusedChecker::FusedChecker(ContextBO const * pContextBO_p) :
+    pCore_m(pContextBO_p->getInstanceCore()),
+    pMMCBO_m(pCore_m->getMMCBO()),
+    nbRess_m(pCore_m->getNbRessources()),
+    nbMachines_m(pCore_m->getNbMachines()),
+    nbServices_m(pCore_m->getNbServices()),
+    nbBC_m(pCore_m->getNbBalanceCosts()),
+    poidsPMC_m(pCore_m->getPoidsPMC()),
+    poidsSMC_m(pCore_m->getPoidsSMC()),
+    poidsMMC_m(pCore_m->getPoidsMMC()),
+    serviceOfProcess_m(pCore_m->getServiceOfProcess()),
+    machineInit_m(pCore_m->getSolInit()),
+    pmc_m(pCore_m->getPMC()),
+    requirements_m(pCore_m->getRequirements()),
+    transientRess_m(pCore_m->getTransientRessources()),
+    weightLoadCost_m(pCore_m->getWeightLoadCost()),
+    capa_m(pCore_m->getCapas()),
+    safetyCapa_m(pCore_m->getSafetyCapas()),
+    machineLocation_m(pCore_m->getMachineLocation()),
+    spreadMin_m(pCore_m->getSpreadMin()),
+    bcRess1_m(pCore_m->getBCRess1()),
+    bcRess2_m(pCore_m->getBCRess2()),
+    bcTarget_m(pCore_m->getBCTarget()),
+    bcPoids_m(pCore_m->getBCPoids()),
+    depStart_m(pCore_m->getServicesIDependOn().getDebuts()),
+    dependances_m(pCore_m->getServicesIDependOn().getValeurs())
+{
+    sortMachinesByKey(pCore_m->getMachineNeighborhood(), pCore_m->getNbNeighborhoods(), machinesByNeigh_m, neighStart_m);
+    vector<int> locationStart_l;
+    sortMachinesByKey(machineLocation_m, pCore_m->getNbLocations(), machinesByLocation_m, locationStart_l);
+}
+
+FusedChecker::~FusedChecker(){
+    BOOST_FOREACH(FusedCheckerBuffers* pBuffers_l, vpBuffersLibres_m){
+        delete pBuffers_l;
+    }
+}
+
+FusedCheckerBuffers* FusedChecker::emprunteBuffers() const {
+    boost::mutex::scoped_lock lock_l(mutexBuffers_m);
+    if ( vpBuffersLibres_m.empty() ){
+        return new FusedCheckerBuffers();
+    }
+    FusedCheckerBuffers* pResult_l = vpBuffersLibres_m.back();
+    vpBuffersLibres_m.pop_back();
+    return pResult_l;
+}
+
+void FusedChecker::rendBuffers(FusedCheckerBuffers* pBuffers_p) const {
+    boost::mutex::scoped_lock lock_l(mutexBuffers_m);
+    vpBuffersLibres_m.push_back(pBuffers_p);
+}
+
+/**
+ * Etat d'une evaluation : tableaux partiels de chaque thread, et chainage des process par machine
+ * (nextOnMachine est partage : chaque thread n'y ecrit que pour ses propres process)
+ */
+struct FusedCheckerBuffers::EvaluationState {
+    /**
+     * Marqueurs par service (derniere machine, location ou neighborhood ou le service a ete vu), qui ne
+     * sont pas remis a -1 a chaque evaluation : une evaluation y ecrit base + indice, puis la base avance
+     * du nombre d'indices, si bien que tout ce qu'ont laisse les precedentes est < base.
+     * Le tableau n'est reinitialise qu'a la premiere evaluation et quand la base deborde
+     */
+    struct Marqueurs {
+        vector<int> valeurs;
+        int base;
+
+        Marqueurs() :
+            base(0)
+        {}
+
+        void prepare(int nbServices_p, int nbIndices_p){
+            if ( (int) valeurs.size() != nbServices_p || (int64_t) base + 2 * (int64_t) nbIndices_p > INT_MAX ){
+                valeurs.assign(nbServices_p, -1);
+                base = 0;
+            } else {
+                base += nbIndices_p;
+            }
+        }
+
+        bool isVu(int idxS_p) const {
+            return valeurs[idxS_p] >= base;
+        }
+
+        bool isVu(int idxS_p, int idx_p) const {
+            return valeurs[idxS_p] == base + idx_p;
+        }
+
+        void marque(int idxS_p, int idx_p){
+            valeurs[idxS_p] = base + idx_p;
+        }
+
+        /**
+         * Indice marque pour le service (qui doit avoir ete vu par l'evaluation en cours)
+         */
+        int getIndice(int idxS_p) const {
+            return valeurs[idxS_p] - base;
+        }
+    };
+
+    /**
+     * Les process d'une machine sont chaines du dernier au premier dans chaque tranche :
+     * parcourir les tranches en sens inverse donne donc le meme ordre quel que soit le nombre
+     * de threads, et par consequent la meme premiere violation
+     */
+    struct Partiel {
+        /**
+         * Passe sur les process : consommations (machine par machine) et process chaines par machine
+         */
+        vector<int> used;
+        vector<int> transientUsed;
+        vector<int> firstOnMachine;
+        vector<int> nbMovedByService;
+        uint64_t pmc;
+        uint64_t smc;
+        uint64_t mmc;
+
+        /**
+         * La somme partielle des couts de la tranche depasse deja la borne
+         */
+        bool dominated;
+
+        /**
+         * Passe sur les machines : couts, et locations vues par chaque service sur la tranche de machines
+         * (firstLocationOfService et nbLocationsByService ne sont a jour que pour les services
+         * marques dans lastLocationOfService)
+         */
+        uint64_t loadCost;
+        uint64_t balanceCost;
+        Marqueurs lastMachineOfService;
+        vector<int> firstLocationOfService;
+        Marqueurs lastLocationOfService;
+        vector<int> nbLocationsByService;
+
+        /**
+         * Premiere violation rencontree par le thread sur sa tranche
+         */
+        CheckerResult violation;
+
+        /**
+         * Espace de travail du thread : consommations de la machine courante, et neighborhoods vus par service
+         */
+        vector<int> usedMachine;
+        vector<int> transientUsedMachine;
+        Marqueurs lastNeighOfService;
+        Marqueurs lastNeighChecked;
+
+        int getNbLocations(int idxS_p) const {
+            return lastLocationOfService.isVu(idxS_p) ? nbLocationsByService[idxS_p] : 0;
+        }
+    };
+
+    /**
+     * Prepare une nouvelle evaluation. Les tableaux gardent leur capacite d'un appel a l'autre :
+     * une fois dimensionnes par une premiere evaluation, les suivantes n'allouent plus
+     */
+    void init(const int* pSol_p, int nbProcesses_p, uint64_t bound_p, int nbThreads_p){
+        sol = pSol_p;
+        nbProcesses = nbProcesses_p;
+        bound = bound_p;
+        nbThreads = nbThreads_p;
+        moveCost = 0;
+        nextOnMachine.resize(nbProcesses_p);
+        partiels.resize(nbThreads_p);
+        BOOST_FOREACH(Partiel& partiel_l, partiels){
+            partiel_l.violation = CheckerResult();
+        }
+    }
+
+    const int* sol;
+    int nbProcesses;
+    uint64_t bound;
+    int nbThreads;
+
+    /**
+     * PMC, MMC et SMC ponderes, connus a l'issue de la passe sur les process
+     */
+    uint64_t moveCost;
+    vector<int> nextOnMachine;
+    vector<Partiel> partiels;
+
+    /**
+     * Fusion des resultats des tranches (inutile, et donc pas faite, sur un seul thread)
+     */
+    vector<int> nbMovedByService;
+    vector<int> nbLocationsByService;
+    vector<int> lastLocationOfService;
+};
+
+FusedCheckerBuffers::FusedCheckerBuffers() :
+    pState_m(0)
+{}
+
+FusedCheckerBuffers::FusedCheckerBuffers(const FusedCheckerBuffers&) :
+    pState_m(0)
+{}
+
+FusedCheckerBuffers& FusedCheckerBuffers::operator=(const FusedCheckerBuffers&){
+    return *this;
+}
+
+FusedCheckerBuffers::~FusedCheckerBuffers(){
+    delete pState_m;
+}
+
+/**
+ * Bornes de la tranche [debut, fin[ de idxThread_p quand on decoupe nb_p elements en nbThreads_p
+ */
+static int debutTranche(int nb_p, int nbThreads_p, int idxThread_p){
+    return (int) ((int64_t) nb_p * idxThread_p / nbThreads_p);
+}
+
+CheckerResult FusedChecker::evaluate(const vector<int>& sol_p, int nbThreads_p) const {
+    CheckerResult result_l;
+    evaluate(sol_p, result_l, nbThreads_p);
+    return result_l;
+}
+
+bool FusedChecker::addViolation(CheckerResult& result_p, CheckerResult::Violation violation_p, int idx1_p, int idx2_p){
+    if ( ! result_p.valid ){
+        return false;
+    }
+    result_p.valid = false;
+    result_p.violation = violation_p;
+    result_p.idx1 = idx1_p;
+    result_p.idx2 = idx2_p;
+    return true;
+}
+
+void FusedChecker::runParallel(Phase phase_p, EvaluationState& state_p) const {
+    if ( state_p.nbThreads == 1 ){
+        (this->*phase_p)(0, state_p);
+        return;
+    }
+
+    boost::thread_group threads_l;
+    for ( int idxThread_l=1 ; idxThread_l < state_p.nbThreads ; idxThread_l++ ){
+        threads_l.create_thread(boost::bind(phase_p, this, idxThread_l, boost::ref(state_p)));
+    }
+    (this->*phase_p)(0, state_p);
+    threads_l.join_all();
+}
+
+void FusedChecker::evaluate(const vector<int>& sol_p, CheckerResult& result_p, int nbThreads_p) const {
+    evaluateBounded(sol_p, numeric_limits<uint64_t>::max(), result_p, nbThreads_p);
+}
+
+void FusedChecker::evaluateBounded(const vector<int>& sol_p, uint64_t bound_p, CheckerResult& result_p, int nbThreads_p) const {
+    FusedCheckerBuffers* pBuffers_l = emprunteBuffers();
+    evaluateBounded(sol_p.empty() ? 0 : &sol_p[0], sol_p.size(), bound_p, result_p, *pBuffers_l, nbThreads_p);
+    rendBuffers(pBuffers_l);
+}
+
+void FusedChecker::evaluate(const int* pSol_p, int nbProcesses_p, CheckerResult& result_p, FusedCheckerBuffers& buffers_p, int nbThreads_p) const {
+    evaluateBounded(pSol_p, nbProcesses_p, numeric_limits<uint64_t>::max(), result_p, buffers_p, nbThreads_p);
+}
+
+void FusedChecker::evaluateBounded(const int* pSol_p, int nbProcesses_p, uint64_t bound_p, CheckerResult& result_p,
+        FusedCheckerBuffers& buffers_p, int nbThreads_p) const {
+    result_p = CheckerResult();
+    if ( ! buffers_p.pState_m ){
+        buffers_p.pState_m = new EvaluationState();
+    }
+    EvaluationState& state_l = *buffers_p.pState_m;
+    state_l.init(pSol_p, nbProcesses_p, bound_p, max(1, nbThreads_p));
+    const int nbThreads_l = state_l.nbThreads;
+
+    /* Passe sur les process, puis fusion de leurs resultats : premiere affectation invalide,
+     * PMC, MMC et SMC. Une affectation invalide l'emporte sur la domination
+     */
+    runParallel(&FusedChecker::processPhase, state_l);
+
+    for ( int idxThread_l=0 ; idxThread_l < nbThreads_l ; idxThread_l++ ){
+        const EvaluationState::Partiel& partiel_l = state_l.partiels[idxThread_l];
+        if ( ! partiel_l.violation.valid ){
+            result_p = partiel_l.violation;
+            LOG(DEBUG) << "La solution affecte le process " << result_p.idx1 << " a la machine inexistante " << result_p.idx2 << endl;
+            return;
+        }
+        result_p.dominated = result_p.dominated || partiel_l.dominated;
+        result_p.pmc += partiel_l.pmc;
+        result_p.mmc += partiel_l.mmc;
+    }
+    if ( nbThreads_l == 1 ){
+        result_p.smc = state_l.partiels[0].smc;
+    } else {
+        vector<int>& nbMovedByService_l = state_l.nbMovedByService;
+        nbMovedByService_l.assign(nbServices_m, 0);
+        BOOST_FOREACH(const EvaluationState::Partiel& partiel_l, state_l.partiels){
+            for ( int idxS_l=0 ; idxS_l < nbServices_m ; idxS_l++ ){
+                nbMovedByService_l[idxS_l] += partiel_l.nbMovedByService[idxS_l];
+            }
+        }
+        BOOST_FOREACH(int nbMoved_l, nbMovedByService_l){
+            result_p.smc = max(result_p.smc, (uint64_t) nbMoved_l);
+        }
+    }
+    state_l.moveCost = poidsPMC_m * result_p.pmc + poidsSMC_m * result_p.smc + poidsMMC_m * result_p.mmc;
+    if ( result_p.dominated || state_l.moveCost > bound_p ){
+        result_p.dominated = true;
+        return;
+    }
+
+    /* Passe sur les machines, puis fusion : load et balance cost, premiere violation de capa
+     * ou de conflit, et nombre de locations par service
+     */
+    runParallel(&FusedChecker::machinePhase, state_l);
+
+    vector<int>& nbLocationsByService_l = state_l.nbLocationsByService;
+    vector<int>& lastLocationOfService_l = state_l.lastLocationOfService;
+    if ( nbThreads_l > 1 ){
+        nbLocationsByService_l.assign(nbServices_m, 0);
+        lastLocationOfService_l.assign(nbServices_m, -1);
+    }
+    for ( int idxThread_l=0 ; idxThread_l < nbThreads_l ; idxThread_l++ ){
+        const EvaluationState::Partiel& partiel_l = state_l.partiels[idxThread_l];
+        if ( partiel_l.dominated ){
+            result_p.dominated = true;
+            return;
+        }
+        result_p.loadCost += partiel_l.loadCost;
+        result_p.balanceCost += partiel_l.balanceCost;
+        if ( result_p.valid && ! partiel_l.violation.valid ){
+            addViolation(result_p, partiel_l.violation.violation, partiel_l.violation.idx1, partiel_l.violation.idx2);
+        }
+
+        if ( nbThreads_l == 1 ){
+            continue;
+        }
+
+        /* Les tranches suivent l'ordre des locations : si une location est a cheval sur deux tranches,
+         * un service vu des deux cotes ne doit y etre compte qu'une fois
+         */
+        for ( int idxS_l=0 ; idxS_l < nbServices_m ; idxS_l++ ){
+            if ( ! partiel_l.lastLocationOfService.isVu(idxS_l) ){
+                continue;
+            }
+            nbLocationsByService_l[idxS_l] += partiel_l.nbLocationsByService[idxS_l];
+            if ( partiel_l.firstLocationOfService[idxS_l] == lastLocationOfService_l[idxS_l] ){
+                nbLocationsByService_l[idxS_l]--;
+            }
+            lastLocationOfService_l[idxS_l] = partiel_l.lastLocationOfService.getIndice(idxS_l);
+        }
+    }
+
+    result_p.score = result_p.loadCost + result_p.balanceCost + state_l.moveCost;
+    if ( result_p.score > bound_p ){
+        result_p.dominated = true;
+        return;
+    }
+
+    if ( ! result_p.valid ){
+        return;
+    }
+
+    const EvaluationState::Partiel& partiel0_l = state_l.partiels[0];
+    for ( int idxS_l=0 ; idxS_l < nbServices_m ; idxS_l++ ){
+        const int nbLocations_l = nbThreads_l == 1 ? partiel0_l.getNbLocations(idxS_l) : nbLocationsByService_l[idxS_l];
+        if ( nbLocations_l < spreadMin_m[idxS_l] ){
+            addViolation(result_p, CheckerResult::SPREAD, idxS_l, nbLocations_l);
+            LOG(DEBUG) << "La solution viole la contrainte de spread : le service " << idxS_l
+                << " s'etend sur " << nbLocations_l
+                << " locations mais a un spread min de " << spreadMin_m[idxS_l] << endl;
+            return;
+        }
+    }
+
+    /* Dependances, par tranches de neighborhoods
+     */
+    if ( dependances_m.empty() ){
+        return;
+    }
+    runParallel(&FusedChecker::dependancesPhase, state_l);
+    for ( int idxThread_l=0 ; idxThread_l < nbThreads_l ; idxThread_l++ ){
+        const CheckerResult& violation_l = state_l.partiels[idxThread_l].violation;
+        if ( ! violation_l.valid ){
+            addViolation(result_p, violation_l.violation, violation_l.idx1, violation_l.idx2);
+            return;
+        }
+    }
+}
+
+void FusedChecker::processPhase(int idxThread_p, EvaluationState& state_p) const {
+    EvaluationState::Partiel& partiel_l = state_p.partiels[idxThread_p];
+    const int nbRess_l = nbRess_m;
+    const int nbMachines_l = nbMachines_m;
+    const int nbP_l = state_p.nbProcesses;
+    const int idxPDebut_l = debutTranche(nbP_l, state_p.nbThreads, idxThread_p);
+    const int idxPFin_l = debutTranche(nbP_l, state_p.nbThreads, idxThread_p + 1);
+
+    partiel_l.used.assign(nbRess_l * nbMachines_l, 0);
+    partiel_l.transientUsed.assign(nbRess_l * nbMachines_l, 0);
+    partiel_l.firstOnMachine.assign(nbMachines_l, -1);
+    partiel_l.nbMovedByService.assign(nbServices_m, 0);
+    partiel_l.pmc = 0;
+    partiel_l.smc = 0;
+    partiel_l.mmc = 0;
+    partiel_l.dominated = false;
+    if ( idxPDebut_l == idxPFin_l ){
+        return;
+    }
+
+    /* Pointeurs et dimensions sont copies en local : sans cela, les ecritures dans used (des int,
+     * comme les requirements et les dimensions) obligent le compilateur a tout recharger a chaque iteration
+     */
+    int* pUsedAll_l = partiel_l.used.empty() ? 0 : &partiel_l.used[0];
+    int* pTransientAll_l = partiel_l.transientUsed.empty() ? 0 : &partiel_l.transientUsed[0];
+    const int* pRequirements_l = requirements_m.empty() ? 0 : &requirements_m[0];
+    const int* pSol_l = state_p.sol;
+    int* pNextOnMachine_l = &state_p.nextOnMachine[0];
+    int* pFirstOnMachine_l = partiel_l.firstOnMachine.empty() ? 0 : &partiel_l.firstOnMachine[0];
+    const uint64_t bound_l = state_p.bound;
+    uint64_t smc_l = 0;
+
+    for ( int idxP_l=idxPDebut_l ; idxP_l < idxPFin_l ; idxP_l++ ){
+        const int idxMachine_l = pSol_l[idxP_l];
+        if ( idxMachine_l < 0 || idxMachine_l >= nbMachines_l ){
+            addViolation(partiel_l.violation, CheckerResult::AFFECTATION, idxP_l, idxMachine_l);
+            return;
+        }
+
+        const int* pReq_l = pRequirements_l + idxP_l*nbRess_l;
+        int* pUsed_l = pUsedAll_l + idxMachine_l*nbRess_l;
+        for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+            pUsed_l[idxRess_l] += pReq_l[idxRess_l];
+        }
+
+        const int idxMachineInit_l = machineInit_m[idxP_l];
+        if ( idxMachine_l != idxMachineInit_l ){
+            BOOST_FOREACH(int idxRess_l, transientRess_m){
+                pTransientAll_l[idxMachineInit_l*nbRess_l + idxRess_l] += pReq_l[idxRess_l];
+            }
+            partiel_l.pmc += pmc_m[idxP_l];
+            smc_l = max(smc_l, (uint64_t) ++partiel_l.nbMovedByService[serviceOfProcess_m[idxP_l]]);
+            partiel_l.mmc += pMMCBO_m->getCost(idxMachineInit_l, idxMachine_l);
+
+            /* Les couts de la tranche minorent ceux de la solution complete
+             */
+            if ( poidsPMC_m * partiel_l.pmc + poidsSMC_m * smc_l + poidsMMC_m * partiel_l.mmc > bound_l ){
+                partiel_l.dominated = true;
+                return;
+            }
+        }
+
+        pNextOnMachine_l[idxP_l] = pFirstOnMachine_l[idxMachine_l];
+        pFirstOnMachine_l[idxMachine_l] = idxP_l;
+    }
+    partiel_l.smc = smc_l;
+}
+
+void FusedChecker::machinePhase(int idxThread_p, EvaluationState& state_p) const {
+    EvaluationState::Partiel& partiel_l = state_p.partiels[idxThread_p];
+    const int nbRess_l = nbRess_m;
+    const int nbMachines_l = nbMachines_m;
+    const int rankDebut_l = debutTranche(nbMachines_l, state_p.nbThreads, idxThread_p);
+    const int rankFin_l = debutTranche(nbMachines_l, state_p.nbThreads, idxThread_p + 1);
+
+    partiel_l.loadCost = 0;
+    partiel_l.balanceCost = 0;
+    partiel_l.dominated = false;
+    partiel_l.lastMachineOfService.prepare(nbServices_m, nbMachines_l);
+    partiel_l.lastLocationOfService.prepare(nbServices_m, pCore_m->getNbLocations());
+    partiel_l.firstLocationOfService.resize(nbServices_m);
+    partiel_l.nbLocationsByService.resize(nbServices_m);
+    vector<int>& used_l = partiel_l.usedMachine;
+    vector<int>& transientUsed_l = partiel_l.transientUsedMachine;
+    used_l.resize(nbRess_l);
+    transientUsed_l.resize(nbRess_l);
+
+    /* Machines regroupees par location : capa, load cost, balance cost,
+     * conflits (deux process d'un meme service sur la machine) et locations utilisees par service
+     */
+    for ( int rank_l=rankDebut_l ; rank_l < rankFin_l ; rank_l++ ){
+        const int idxMachine_l = machinesByLocation_m[rank_l];
+        const int idxLocation_l = machineLocation_m[idxMachine_l];
+
+        for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+            used_l[idxRess_l] = state_p.partiels[0].used[idxMachine_l*nbRess_l + idxRess_l];
+            transientUsed_l[idxRess_l] = state_p.partiels[0].transientUsed[idxMachine_l*nbRess_l + idxRess_l];
+        }
+        for ( int idxThread_l=1 ; idxThread_l < state_p.nbThreads ; idxThread_l++ ){
+            const EvaluationState::Partiel& autre_l = state_p.partiels[idxThread_l];
+            for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+                used_l[idxRess_l] += autre_l.used[idxMachine_l*nbRess_l + idxRess_l];
+                transientUsed_l[idxRess_l] += autre_l.transientUsed[idxMachine_l*nbRess_l + idxRess_l];
+            }
+        }
+
+        for ( int idxRess_l=0 ; idxRess_l < nbRess_l ; idxRess_l++ ){
+            const int idx_l = idxMachine_l*nbRess_l + idxRess_l;
+            if ( used_l[idxRess_l] + transientUsed_l[idxRess_l] > capa_m[idx_l]
+                    && addViolation(partiel_l.violation, CheckerResult::CAPA, idxRess_l, idxMachine_l) ){
+                LOG(DEBUG) << "La solution viole la contrainte de capa pour la ressource "
+                    << idxRess_l << " sur la machine " << idxMachine_l
+                    << " (requirement : " << used_l[idxRess_l] + transientUsed_l[idxRess_l] << ", capa : " << capa_m[idx_l] << ")" << endl;
+            }
+            partiel_l.loadCost += (uint64_t) weightLoadCost_m[idxRess_l] * max(0, used_l[idxRess_l] - safetyCapa_m[idx_l]);
+        }
+
+        for ( int idxBC_l=0 ; idxBC_l < nbBC_m ; idxBC_l++ ){
+            const int idxRess1_l = bcRess1_m[idxBC_l];
+            const int idxRess2_l = bcRess2_m[idxBC_l];
+            const int64_t a1_l = capa_m[idxMachine_l*nbRess_l + idxRess1_l] - used_l[idxRess1_l];
+            const int64_t a2_l = capa_m[idxMachine_l*nbRess_l + idxRess2_l] - used_l[idxRess2_l];
+            partiel_l.balanceCost += bcPoids_m[idxBC_l] * max((int64_t) 0, bcTarget_m[idxBC_l]*a1_l - a2_l);
+        }
+        if ( state_p.moveCost + partiel_l.loadCost + partiel_l.balanceCost > state_p.bound ){
+            partiel_l.dominated = true;
+            return;
+        }
+
+        BOOST_REVERSE_FOREACH(const EvaluationState::Partiel& autre_l, state_p.partiels){
+            for ( int idxP_l=autre_l.firstOnMachine[idxMachine_l] ; idxP_l != -1 ; idxP_l = state_p.nextOnMachine[idxP_l] ){
+                const int idxS_l = serviceOfProcess_m[idxP_l];
+                if ( partiel_l.lastMachineOfService.isVu(idxS_l, idxMachine_l)
+                        && addViolation(partiel_l.violation, CheckerResult::CONFLIT, idxS_l, idxMachine_l) ){
+                    LOG(DEBUG) << "La solution viole la contrainte de conflit : plusieurs processes du service "
+                        << idxS_l << " sur la machine " << idxMachine_l << endl;
+                }
+                partiel_l.lastMachineOfService.marque(idxS_l, idxMachine_l);
+                if ( ! partiel_l.lastLocationOfService.isVu(idxS_l) ){
+                    partiel_l.firstLocationOfService[idxS_l] = idxLocation_l;
+                    partiel_l.nbLocationsByService[idxS_l] = 1;
+                    partiel_l.lastLocationOfService.marque(idxS_l, idxLocation_l);
+                } else if ( ! partiel_l.lastLocationOfService.isVu(idxS_l, idxLocation_l) ){
+                    partiel_l.nbLocationsByService[idxS_l]++;
+                    partiel_l.lastLocationOfService.marque(idxS_l, idxLocation_l);
+                }
+            }
+        }
+    }
+}
+
+void FusedChecker::dependancesPhase(int idxThread_p, EvaluationState& state_p) const {
+    EvaluationState::Partiel& partiel_l = state_p.partiels[idxThread_p];
+
+    /* Chaque thread prend les neighborhoods qui commencent dans sa tranche de machines :
+     * pour chacun, on marque les services presents, puis on verifie que chacun d'eux
+     * y trouve les services dont il depend
+     */
+    const int nbNeighs_l = neighStart_m.size() - 1;
+    const int rankDebut_l = debutTranche(nbMachines_m, state_p.nbThreads, idxThread_p);
+    const int rankFin_l = debutTranche(nbMachines_m, state_p.nbThreads, idxThread_p + 1);
+    const int idxNDebut_l = lower_bound(neighStart_m.begin(), neighStart_m.begin() + nbNeighs_l, rankDebut_l) - neighStart_m.begin();
+    const int idxNFin_l = lower_bound(neighStart_m.begin(), neighStart_m.begin() + nbNeighs_l, rankFin_l) - neighStart_m.begin();
+
+    EvaluationState::Marqueurs& lastNeighOfService_l = partiel_l.lastNeighOfService;
+    EvaluationState::Marqueurs& lastNeighChecked_l = partiel_l.lastNeighChecked;
+    lastNeighOfService_l.prepare(nbServices_m, nbNeighs_l);
+    lastNeighChecked_l.prepare(nbServices_m, nbNeighs_l);
+    for ( int idxN_l=idxNDebut_l ; idxN_l < idxNFin_l ; idxN_l++ ){
+        for ( int rank_l=neighStart_m[idxN_l] ; rank_l < neighStart_m[idxN_l + 1] ; rank_l++ ){
+            const int idxMachine_l = machinesByNeigh_m[rank_l];
+            BOOST_REVERSE_FOREACH(const EvaluationState::Partiel& autre_l, state_p.partiels){
+                for ( int idxP_l=autre_l.firstOnMachine[idxMachine_l] ; idxP_l != -1 ; idxP_l = state_p.nextOnMachine[idxP_l] ){
+                    lastNeighOfService_l.marque(serviceOfProcess_m[idxP_l], idxN_l);
+                }
+            }
+        }
+
+        for ( int rank_l=neighStart_m[idxN_l] ; rank_l < neighStart_m[idxN_l + 1] ; rank_l++ ){
+            const int idxMachine_l = machinesByNeigh_m[rank_l];
+            BOOST_REVERSE_FOREACH(const EvaluationState::Partiel& autre_l, state_p.partiels){
+                for ( int idxP_l=autre_l.firstOnMachine[idxMachine_l] ; idxP_l != -1 ; idxP_l = state_p.nextOnMachine[idxP_l] ){
+                    const int idxS_l = serviceOfProcess_m[idxP_l];
+                    if ( lastNeighChecked_l.isVu(idxS_l, idxN_l) ){
+                        continue;
+                    }
+                    lastNeighChecked_l.marque(idxS_l, idxN_l);
+
+                    for ( int idxDep_l=depStart_m[idxS_l] ; idxDep_l < depStart_m[idxS_l + 1] ; idxDep_l++ ){
+                        if ( ! lastNeighOfService_l.isVu(dependances_m[idxDep_l], idxN_l) ){
+                            addViolation(partiel_l.violation, CheckerResult::DEPENDANCE, idxS_l, idxN_l);
+                            LOG(DEBUG) << "La solution viole la contrainte de dependances : "
+                                << "le service " << idxS_l << " utilise le neighborhood "
+                                << idxN_l << " mais depend du service " << dependances_m[idxDep_l]
+                                << " qui n'y est pas present" << endl;
+                            return;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
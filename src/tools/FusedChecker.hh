@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+#ifndef FUSEDCHECKER_HH
+#define FUSEDCHECKER_HH
+#include <vector>
+#include <stdint.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+using namespace std;
+
+class ContextBO;
+class InstanceCoreBO;
+class MMCBO;
+
+/**
+ * Resultat de l'evaluation d'une solution par le #FusedChecker
+ */
+struct CheckerResult {
+    enum Violation {
+        AUCUNE,
+        /**
+         * Un process est affecte a une machine qui n'existe pas (idx1 = process, idx2 = machine)
+         */
+        AFFECTATION,
+        /**
+         * idx1 = ressource, idx2 = machine
+         */
+        CAPA,
+        /**
+         * idx1 = service, idx2 = machine
+         */
+        CONFLIT,
+        /**
+         * idx1 = service, idx2 = nombre de locations utilisees
+         */
+        SPREAD,
+        /**
+         * idx1 = service, idx2 = neighborhood sur lequel il lui manque un service dont il depend
+         */
+        DEPENDANCE
+    };
+
+    CheckerResult();
+
+    bool valid;
+
+    /**
+     * Evaluation abandonnee (cf FusedChecker::evaluateBounded()) : le score depasse la borne.
+     * Les autres champs n'ont alors pas de signification
+     */
+    bool dominated;
+
+    /**
+     * Premiere violation rencontree (AUCUNE si la solution est valide)
+     */
+    Violation violation;
+    int idx1;
+    int idx2;
+
+    /**
+     * Couts, non ponderes pour PMC, SMC et MMC.
+     * Ils sont calcules meme si la solution viole une contrainte, sauf AFFECTATION (ils valent alors 0)
+     */
+    uint64_t loadCost;
+    uint64_t balanceCost;
+    uint64_t pmc;
+    uint64_t smc;
+    uint64_t mmc;
+
+    /**
+     * Score pondere
+     */
+    uint64_t score;
+};
+
+/**
+ * Tableaux de travail d'une evaluation par le #FusedChecker, a conserver d'un appel a l'autre par l'appelant
+ * (un jeu par thread appelant) : apres la premiere evaluation, les suivantes n'allouent plus rien
+ * (en sequentiel ; en parallele, seuls les threads sont crees a chaque appel).
+ * La copie ne copie pas les tableaux, qui sont simplement realloues a la premiere utilisation
+ */
+class FusedCheckerBuffers {
+    public:
+        FusedCheckerBuffers();
+        FusedCheckerBuffers(const FusedCheckerBuffers&);
+        FusedCheckerBuffers& operator=(const FusedCheckerBuffers&);
+        ~FusedCheckerBuffers();
+
+    private:
+        friend class FusedChecker;
+        struct EvaluationState;
+        EvaluationState* pState_m;
+};
+
+/**
+ * Verifie une solution et calcule tous ses couts en une seule passe sur les process,
+ * suivie d'une seule passe sur les machines (et d'un parcours par neighborhood pour les dependances),
+ * la ou l'enchainement Checker::isValid() puis Checker::computeScore() reparcourt la solution
+ * une fois par contrainte et par cout.
+ *
+ * Les donnees de l'instance sont lues dans l'#InstanceCoreBO : l'objet est
+ * immuable et peut etre reutilise (et partage entre threads) pour evaluer autant de solutions
+ * qu'on le souhaite.
+ */
+class FusedChecker {
+    public:
+        FusedChecker(ContextBO const * pContextBO_p);
+        ~FusedChecker();
+
+        /**
+         * @param La solution a evaluer
+         * @param (out) Le resultat
+         * @param Nombre de threads : les process, puis les machines, sont decoupes en autant de tranches
+         * dont les resultats partiels sont ensuite fusionnes. Le resultat est identique a celui de l'evaluation
+         * sequentielle (nbThreads = 1), premiere violation comprise
+         */
+        void evaluate(const vector<int>& sol_p, CheckerResult& result_p, int nbThreads_p=1) const;
+        CheckerResult evaluate(const vector<int>& sol_p, int nbThreads_p=1) const;
+
+        /**
+         * Comme evaluate(), mais abandonne des que la somme partielle des couts (tous positifs) depasse
+         * la borne : le resultat est alors marque dominated, sans score ni verification des contraintes
+         * restantes. Les couts sont accumules du moins cher au plus cher a calculer : PMC, MMC et SMC
+         * au fil de la passe sur les process, puis load et balance cost machine par machine ;
+         * spread et dependances ne sont verifies que si la solution n'est pas dominee.
+         * Une solution non dominee a exactement le resultat de evaluate(), avec un score <= borne
+         * @param La borne, typiquement le score de la meilleure solution connue moins un
+         */
+        void evaluateBounded(const vector<int>& sol_p, uint64_t bound_p, CheckerResult& result_p, int nbThreads_p=1) const;
+
+        /**
+         * Evaluation d'une solution empruntee (sol_p[idxP] = machine du process idxP), sans copie
+         * ni allocation : les tableaux de travail sont pris dans ceux de l'appelant.
+         * Les methodes precedentes s'y ramenent avec des #FusedCheckerBuffers empruntes a une reserve
+         * interne (protegee par un mutex) : elles n'allouent donc pas non plus une fois la reserve remplie
+         */
+        void evaluate(const int* pSol_p, int nbProcesses_p, CheckerResult& result_p, FusedCheckerBuffers& buffers_p, int nbThreads_p=1) const;
+        void evaluateBounded(const int* pSol_p, int nbProcesses_p, uint64_t bound_p, CheckerResult& result_p,
+                FusedCheckerBuffers& buffers_p, int nbThreads_p=1) const;
+
+    private:
+        typedef FusedCheckerBuffers::EvaluationState EvaluationState;
+
+        /**
+         * Traitement, par un thread, de sa tranche de process, de machines ou de neighborhoods
+         */
+        typedef void (FusedChecker::*Phase)(int idxThread_p, EvaluationState& state_p) const;
+        void processPhase(int idxThread_p, EvaluationState& state_p) const;
+        void machinePhase(int idxThread_p, EvaluationState& state_p) const;
+        void dependancesPhase(int idxThread_p, EvaluationState& state_p) const;
+
+        /**
+         * Execute la phase sur chaque tranche (la tranche 0 dans le thread appelant), et attend la fin de toutes
+         */
+        void runParallel(Phase phase_p, EvaluationState& state_p) const;
+
+        /**
+         * Memorise la violation si c'est la premiere
+         * @return TRUE si c'etait la premiere
+         */
+        static bool addViolation(CheckerResult& result_p, CheckerResult::Violation violation_p, int idx1_p, int idx2_p);
+
+        /**
+         * Reserve de tableaux de travail pour les evaluations sans #FusedCheckerBuffers explicites :
+         * un jeu par evaluation simultanee, rendu a la reserve a la fin de l'evaluation
+         */
+        FusedCheckerBuffers* emprunteBuffers() const;
+        void rendBuffers(FusedCheckerBuffers* pBuffers_p) const;
+        mutable boost::mutex mutexBuffers_m;
+        mutable vector<FusedCheckerBuffers*> vpBuffersLibres_m;
+
+        boost::shared_ptr<InstanceCoreBO const> pCore_m;
+        MMCBO const * pMMCBO_m;
+        const int nbRess_m;
+        const int nbMachines_m;
+        const int nbServices_m;
+        const int nbBC_m;
+        const uint64_t poidsPMC_m;
+        const uint64_t poidsSMC_m;
+        const uint64_t poidsMMC_m;
+
+        /**
+         * Donnees de l'instance, lues dans l'#InstanceCoreBO. Les capas y sont stockees
+         * machine par machine (capa_m[idxMachine * nbRess + idxRess]) : la passe sur les process
+         * ecrit alors les consommations d'un process dans une seule ligne de cache
+         */
+        const vector<int>& serviceOfProcess_m;
+        const vector<int>& machineInit_m;
+        const vector<int>& pmc_m;
+        const vector<int>& requirements_m;
+        const vector<int>& transientRess_m;
+        const vector<int>& weightLoadCost_m;
+        const vector<int>& capa_m;
+        const vector<int>& safetyCapa_m;
+        const vector<int>& machineLocation_m;
+        const vector<int>& spreadMin_m;
+        const vector<int>& bcRess1_m;
+        const vector<int>& bcRess2_m;
+        const vector<int>& bcTarget_m;
+        const vector<int>& bcPoids_m;
+
+        /**
+         * Machines triees par neighborhood : celles du neighborhood idxN sont
+         * machinesByNeigh_m[neighStart_m[idxN] .. neighStart_m[idxN+1][
+         */
+        vector<int> machinesByNeigh_m;
+        vector<int> neighStart_m;
+
+        /**
+         * Machines triees par location, pour compter les locations de chaque service
+         * sans table service x location
+         */
+        vector<int> machinesByLocation_m;
+
+        /**
+         * Index CSR de l'#InstanceCoreBO : les services dont depend idxS sont dependances_m[depStart_m[idxS] .. depStart_m[idxS+1][
+         */
+        const vector<int>& depStart_m;
+        const vector<int>& dependances_m;
+};
+
+#endif
@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "tools/IncrementalEvaluator.hh"
+#include "bo/ContextBO.hh"
+#include "bo/InstanceCoreBO.hh"
+#include "bo/MMCBO.hh"
+#include <algorithm>
+#include <cassert>
+using namespace std;
+
+IncrementalEvaluator::IncrementalEvaluator(ContextBO const * pContextBO_p, const vector<int>& sol_p) :
+    pCore_m(pContextBO_p->getInstanceCore()),
+    pMMCBO_m(pCore_m->getMMCBO()),
+    sweep_m(pContextBO_p),
+    nbRess_m(pCore_m->getNbRessources()),
+    nbMachines_m(pCore_m->getNbMachines()),
+    nbBC_m(pCore_m->getNbBalanceCosts()),
+    capa_m(pCore_m->getCapasByRess()),
+    safetyCapa_m(pCore_m->getSafetyCapasByRess()),
+    weightLoadCost_m(pCore_m->getWeightLoadCost()),
+    isTransient_m(pCore_m->getIsTransient()),
+    requirements_m(pCore_m->getRequirements()),
+    machineInit_m(pCore_m->getSolInit()),
+    service_m(pCore_m->getServiceOfProcess()),
+    pmc_m(pCore_m->getPMC()),
+    bcRess1_m(pCore_m->getBCRess1()),
+    bcRess2_m(pCore_m->getBCRess2()),
+    bcTarget_m(pCore_m->getBCTarget()),
+    bcPoids_m(pCore_m->getBCPoids()),
+    nbMovedByService_m(pCore_m->getNbServices()),
+    constraintState_m(pContextBO_p)
+{
+    /* Un service ne peut pas avoir plus de process deplaces que de process */
+    histoNbMoved_m.resize(pCore_m->getNbMaxProcessesByService() + 1);
+
+    reset(sol_p);
+}
+
+void IncrementalEvaluator::reset(const vector<int>& sol_p){
+    assert((int) sol_p.size() == pCore_m->getNbProcesses());
+    currentSol_m = sol_p;
+    journal_m.clear();
+
+    used_m.assign(nbRess_m * nbMachines_m, 0);
+    transientUsed_m.assign(nbRess_m * nbMachines_m, 0);
+    bcCosts_m.assign(nbMachines_m * nbBC_m, 0);
+    nbMovedByService_m.assign(nbMovedByService_m.size(), 0);
+    histoNbMoved_m.assign(histoNbMoved_m.size(), 0);
+    histoNbMoved_m[0] = nbMovedByService_m.size();
+    constraintState_m.reset(currentSol_m);
+    loadCost_m = 0;
+    balanceCost_m = 0;
+    pmcCost_m = 0;
+    smcCost_m = 0;
+    mmcCost_m = 0;
+
+    const int nbP_l = currentSol_m.size();
+    for ( int idxP_l=0 ; idxP_l < nbP_l ; idxP_l++ ){
+        const int idxMachine_l = currentSol_m[idxP_l];
+        const int idxMachineInit_l = machineInit_m[idxP_l];
+        const int idxReq_l = idxP_l*nbRess_m;
+        for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+            used_m[idxRess_l*nbMachines_m + idxMachine_l] += requirements_m[idxReq_l + idxRess_l];
+            if ( isTransient_m[idxRess_l] && idxMachine_l != idxMachineInit_l ){
+                transientUsed_m[idxRess_l*nbMachines_m + idxMachineInit_l] += requirements_m[idxReq_l + idxRess_l];
+            }
+        }
+
+        if ( idxMachine_l != idxMachineInit_l ){
+            pmcCost_m += pmc_m[idxP_l];
+            majNbMovedService(service_m[idxP_l], 1);
+        }
+        mmcCost_m += pMMCBO_m->getCost(idxMachineInit_l, idxMachine_l);
+    }
+
+    for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_m ; idxMachine_l++ ){
+        majCostsMachine(idxMachine_l, 1);
+    }
+}
+
+const vector<int>& IncrementalEvaluator::getCurrentSol() const {
+    return currentSol_m;
+}
+
+uint64_t IncrementalEvaluator::getScore() const {
+    return loadCost_m
+        + balanceCost_m
+        + pCore_m->getPoidsPMC() * pmcCost_m
+        + pCore_m->getPoidsSMC() * smcCost_m
+        + pCore_m->getPoidsMMC() * mmcCost_m;
+}
+
+uint64_t IncrementalEvaluator::getLoadCost() const {
+    return loadCost_m;
+}
+
+uint64_t IncrementalEvaluator::getBalanceCost() const {
+    return balanceCost_m;
+}
+
+uint64_t IncrementalEvaluator::getPMC() const {
+    return pmcCost_m;
+}
+
+uint64_t IncrementalEvaluator::getSMC() const {
+    return smcCost_m;
+}
+
+uint64_t IncrementalEvaluator::getMMC() const {
+    return mmcCost_m;
+}
+
+int IncrementalEvaluator::getRessUsedOnMachine(int idxRess_p, int idxMachine_p) const {
+    return used_m[idxRess_p*nbMachines_m + idxMachine_p];
+}
+
+int IncrementalEvaluator::getTransientRessUsedOnMachine(int idxRess_p, int idxMachine_p) const {
+    return transientUsed_m[idxRess_p*nbMachines_m + idxMachine_p];
+}
+
+int64_t IncrementalEvaluator::computeLoadCost(int idxRess_p, int idxMachine_p, int used_p) const {
+    return (int64_t) weightLoadCost_m[idxRess_p] * max(0, used_p - safetyCapa_m[idxRess_p*nbMachines_m + idxMachine_p]);
+}
+
+int64_t IncrementalEvaluator::computeBalanceCost(int idxBC_p, int idxMachine_p, int used1_p, int used2_p) const {
+    const int64_t a1_l = capa_m[bcRess1_m[idxBC_p]*nbMachines_m + idxMachine_p] - used1_p;
+    const int64_t a2_l = capa_m[bcRess2_m[idxBC_p]*nbMachines_m + idxMachine_p] - used2_p;
+    return bcPoids_m[idxBC_p] * max((int64_t) 0, bcTarget_m[idxBC_p]*a1_l - a2_l);
+}
+
+int64_t IncrementalEvaluator::computeDeltaMove(int idxP_p, int idxMachine_p) const {
+    const int idxMachineOld_l = currentSol_m[idxP_p];
+    if ( idxMachineOld_l == idxMachine_p ){
+        return 0;
+    }
+
+    const int idxReq_l = idxP_p*nbRess_m;
+    int64_t result_l(0);
+
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+        const int req_l = requirements_m[idxReq_l + idxRess_l];
+        if ( req_l == 0 ){
+            continue;
+        }
+        const int usedOld_l = used_m[idxRess_l*nbMachines_m + idxMachineOld_l];
+        const int usedNew_l = used_m[idxRess_l*nbMachines_m + idxMachine_p];
+        result_l += computeLoadCost(idxRess_l, idxMachineOld_l, usedOld_l - req_l)
+            - computeLoadCost(idxRess_l, idxMachineOld_l, usedOld_l)
+            + computeLoadCost(idxRess_l, idxMachine_p, usedNew_l + req_l)
+            - computeLoadCost(idxRess_l, idxMachine_p, usedNew_l);
+    }
+
+    for ( int idxBC_l=0 ; idxBC_l < nbBC_m ; idxBC_l++ ){
+        const int idxRess1_l = bcRess1_m[idxBC_l];
+        const int idxRess2_l = bcRess2_m[idxBC_l];
+        const int req1_l = requirements_m[idxReq_l + idxRess1_l];
+        const int req2_l = requirements_m[idxReq_l + idxRess2_l];
+        if ( req1_l == 0 && req2_l == 0 ){
+            continue;
+        }
+        result_l += computeBalanceCost(idxBC_l, idxMachineOld_l,
+                used_m[idxRess1_l*nbMachines_m + idxMachineOld_l] - req1_l,
+                used_m[idxRess2_l*nbMachines_m + idxMachineOld_l] - req2_l)
+            - bcCosts_m[idxMachineOld_l*nbBC_m + idxBC_l]
+            + computeBalanceCost(idxBC_l, idxMachine_p,
+                used_m[idxRess1_l*nbMachines_m + idxMachine_p] + req1_l,
+                used_m[idxRess2_l*nbMachines_m + idxMachine_p] + req2_l)
+            - bcCosts_m[idxMachine_p*nbBC_m + idxBC_l];
+    }
+
+    const int idxMachineInit_l = machineInit_m[idxP_p];
+    const int deltaMoved_l = (idxMachine_p != idxMachineInit_l) - (idxMachineOld_l != idxMachineInit_l);
+    if ( deltaMoved_l != 0 ){
+        result_l += (int64_t) pCore_m->getPoidsPMC() * deltaMoved_l * pmc_m[idxP_p];
+
+        result_l += (int64_t) pCore_m->getPoidsSMC() * computeDeltaSMC(service_m[idxP_p], deltaMoved_l);
+    }
+
+    result_l += (int64_t) pCore_m->getPoidsMMC()
+        * (pMMCBO_m->getCost(idxMachineInit_l, idxMachine_p) - pMMCBO_m->getCost(idxMachineInit_l, idxMachineOld_l));
+
+    return result_l;
+}
+
+int64_t IncrementalEvaluator::computeDeltaSMC(int idxService_p, int deltaMoved_p) const {
+    const int nbMoved_l = nbMovedByService_m[idxService_p];
+    if ( deltaMoved_p > 0 ){
+        return max(smcCost_m, (int64_t) nbMoved_l + 1) - smcCost_m;
+    } else if ( deltaMoved_p < 0 && nbMoved_l == smcCost_m && histoNbMoved_m[nbMoved_l] == 1 ){
+        return -1;
+    }
+    return 0;
+}
+
+void IncrementalEvaluator::evaluateAllMachines(int idxP_p, MachineSweep::Result& result_p) const {
+    const int idxMachineCur_l = currentSol_m[idxP_p];
+    sweep_m.sweep(idxP_p, idxMachineCur_l, used_m, transientUsed_m, result_p);
+
+    /* Le SMC ne depend que du fait que le process arrive ou non sur sa machine init */
+    const int idxMachineInit_l = machineInit_m[idxP_p];
+    const int poidsSMC_l = pCore_m->getPoidsSMC();
+    const int64_t deltaSMCAilleurs_l = poidsSMC_l * computeDeltaSMC(service_m[idxP_p], 1 - (idxMachineCur_l != idxMachineInit_l));
+    for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_m ; idxMachine_l++ ){
+        result_p.moveCostDelta[idxMachine_l] += deltaSMCAilleurs_l;
+    }
+    result_p.moveCostDelta[idxMachineInit_l] += poidsSMC_l * computeDeltaSMC(service_m[idxP_p], - (idxMachineCur_l != idxMachineInit_l)) - deltaSMCAilleurs_l;
+    result_p.moveCostDelta[idxMachineCur_l] = 0;
+}
+
+bool IncrementalEvaluator::isCapaOkForMove(int idxP_p, int idxMachine_p) const {
+    if ( currentSol_m[idxP_p] == idxMachine_p ){
+        return true;
+    }
+
+    const bool backHome_l = (idxMachine_p == machineInit_m[idxP_p]);
+    const int idxReq_l = idxP_p*nbRess_m;
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+        /* Un process qui revient sur sa machine init y occupe la place qu'il y reservait deja */
+        const int req_l = (backHome_l && isTransient_m[idxRess_l]) ? 0 : requirements_m[idxReq_l + idxRess_l];
+        const int idx_l = idxRess_l*nbMachines_m + idxMachine_p;
+        if ( used_m[idx_l] + transientUsed_m[idx_l] + req_l > capa_m[idx_l] ){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool IncrementalEvaluator::isFeasibleMove(int idxP_p, int idxMachine_p) const {
+    return isCapaOkForMove(idxP_p, idxMachine_p)
+        && constraintState_m.isFeasibleMove(idxP_p, currentSol_m[idxP_p], idxMachine_p);
+}
+
+void IncrementalEvaluator::applyMove(int idxP_p, int idxMachine_p){
+    MoveJournal move_l;
+    move_l.idxP = idxP_p;
+    move_l.idxMachineOld = currentSol_m[idxP_p];
+    journal_m.push_back(move_l);
+    doMove(idxP_p, idxMachine_p);
+}
+
+bool IncrementalEvaluator::undoLastMove(){
+    if ( journal_m.empty() ){
+        return false;
+    }
+
+    const MoveJournal& move_l = journal_m.back();
+    doMove(move_l.idxP, move_l.idxMachineOld);
+    journal_m.pop_back();
+    return true;
+}
+
+void IncrementalEvaluator::rollback(int journalSize_p){
+    while ( (int) journal_m.size() > journalSize_p ){
+        undoLastMove();
+    }
+}
+
+int IncrementalEvaluator::getJournalSize() const {
+    return journal_m.size();
+}
+
+void IncrementalEvaluator::clearJournal(){
+    journal_m.clear();
+}
+
+void IncrementalEvaluator::doMove(int idxP_p, int idxMachine_p){
+    const int idxMachineOld_l = currentSol_m[idxP_p];
+    if ( idxMachineOld_l == idxMachine_p ){
+        return;
+    }
+
+    const int idxMachineInit_l = machineInit_m[idxP_p];
+    majCostsMachine(idxMachineOld_l, -1);
+    majCostsMachine(idxMachine_p, -1);
+
+    const int idxReq_l = idxP_p*nbRess_m;
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+        used_m[idxRess_l*nbMachines_m + idxMachineOld_l] -= requirements_m[idxReq_l + idxRess_l];
+        used_m[idxRess_l*nbMachines_m + idxMachine_p] += requirements_m[idxReq_l + idxRess_l];
+        if ( isTransient_m[idxRess_l] ){
+            if ( idxMachineOld_l == idxMachineInit_l ){
+                transientUsed_m[idxRess_l*nbMachines_m + idxMachineInit_l] += requirements_m[idxReq_l + idxRess_l];
+            } else if ( idxMachine_p == idxMachineInit_l ){
+                transientUsed_m[idxRess_l*nbMachines_m + idxMachineInit_l] -= requirements_m[idxReq_l + idxRess_l];
+            }
+        }
+    }
+
+    majCostsMachine(idxMachineOld_l, 1);
+    majCostsMachine(idxMachine_p, 1);
+    constraintState_m.moveProcess(idxP_p, idxMachineOld_l, idxMachine_p);
+
+    const int deltaMoved_l = (idxMachine_p != idxMachineInit_l) - (idxMachineOld_l != idxMachineInit_l);
+    pmcCost_m += deltaMoved_l * pmc_m[idxP_p];
+    majNbMovedService(service_m[idxP_p], deltaMoved_l);
+    mmcCost_m += pMMCBO_m->getCost(idxMachineInit_l, idxMachine_p) - pMMCBO_m->getCost(idxMachineInit_l, idxMachineOld_l);
+
+    currentSol_m[idxP_p] = idxMachine_p;
+}
+
+bool IncrementalEvaluator::evaluateCompoundMove(const ProcessMove* pMoves_p, int nbMoves_p, int64_t& delta_p){
+    delta_p = 0;
+    if ( nbMoves_p == 0 ){
+        return true;
+    }
+
+    const uint64_t scoreAvant_l = getScore();
+    const int journalSize_l = journal_m.size();
+    machinesOld_m.resize(nbMoves_p);
+    for ( int idxMove_l=0 ; idxMove_l < nbMoves_p ; idxMove_l++ ){
+        machinesOld_m[idxMove_l] = currentSol_m[pMoves_p[idxMove_l].idxP];
+    }
+
+    applyCompoundMove(pMoves_p, nbMoves_p);
+    delta_p = (int64_t) (getScore() - scoreAvant_l);
+    const bool result_l = isValidAfterMoves(pMoves_p, &machinesOld_m[0], nbMoves_p);
+    rollback(journalSize_l);
+
+    return result_l;
+}
+
+bool IncrementalEvaluator::evaluateSwap(int idxP1_p, int idxP2_p, int64_t& delta_p){
+    ProcessMove moves_l[2];
+    moves_l[0].idxP = idxP1_p;
+    moves_l[0].idxMachine = currentSol_m[idxP2_p];
+    moves_l[1].idxP = idxP2_p;
+    moves_l[1].idxMachine = currentSol_m[idxP1_p];
+    return evaluateCompoundMove(moves_l, 2, delta_p);
+}
+
+bool IncrementalEvaluator::evaluateShiftSwap(int idxP1_p, int idxP2_p, int idxP3_p, int64_t& delta_p){
+    ProcessMove moves_l[3];
+    moves_l[0].idxP = idxP1_p;
+    moves_l[0].idxMachine = currentSol_m[idxP2_p];
+    moves_l[1].idxP = idxP2_p;
+    moves_l[1].idxMachine = currentSol_m[idxP3_p];
+    moves_l[2].idxP = idxP3_p;
+    moves_l[2].idxMachine = currentSol_m[idxP1_p];
+    return evaluateCompoundMove(moves_l, 3, delta_p);
+}
+
+void IncrementalEvaluator::applyCompoundMove(const ProcessMove* pMoves_p, int nbMoves_p){
+    for ( int idxMove_l=0 ; idxMove_l < nbMoves_p ; idxMove_l++ ){
+        applyMove(pMoves_p[idxMove_l].idxP, pMoves_p[idxMove_l].idxMachine);
+    }
+}
+
+bool IncrementalEvaluator::isValidAfterMoves(const ProcessMove* pMoves_p, const int* pMachinesOld_p, int nbMoves_p) const {
+    /* La solution de depart etant valide, tout conflit vient des mouvements */
+    if ( constraintState_m.getNbConflicts() != 0 ){
+        return false;
+    }
+
+    for ( int idxMove_l=0 ; idxMove_l < nbMoves_p ; idxMove_l++ ){
+        const int idxMachineOld_l = pMachinesOld_p[idxMove_l];
+        const int idxMachineNew_l = pMoves_p[idxMove_l].idxMachine;
+        if ( idxMachineOld_l == idxMachineNew_l ){
+            continue;
+        }
+
+        if ( ! isCapaOk(idxMachineOld_l) || ! isCapaOk(idxMachineNew_l) ){
+            return false;
+        }
+
+        if ( ! constraintState_m.isValidAfterMove(pMoves_p[idxMove_l].idxP, idxMachineOld_l, idxMachineNew_l) ){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool IncrementalEvaluator::isCapaOk(int idxMachine_p) const {
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+        const int idx_l = idxRess_l*nbMachines_m + idxMachine_p;
+        if ( used_m[idx_l] + transientUsed_m[idx_l] > capa_m[idx_l] ){
+            return false;
+        }
+    }
+    return true;
+}
+
+void IncrementalEvaluator::majCostsMachine(int idxMachine_p, int signe_p){
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+        loadCost_m += signe_p * computeLoadCost(idxRess_l, idxMachine_p, used_m[idxRess_l*nbMachines_m + idxMachine_p]);
+    }
+
+    for ( int idxBC_l=0 ; idxBC_l < nbBC_m ; idxBC_l++ ){
+        int64_t& bcCost_l = bcCosts_m[idxMachine_p*nbBC_m + idxBC_l];
+        if ( signe_p > 0 ){
+            bcCost_l = computeBalanceCost(idxBC_l, idxMachine_p,
+                    used_m[bcRess1_m[idxBC_l]*nbMachines_m + idxMachine_p],
+                    used_m[bcRess2_m[idxBC_l]*nbMachines_m + idxMachine_p]);
+        }
+        balanceCost_m += signe_p * bcCost_l;
+    }
+}
+
+void IncrementalEvaluator::majNbMovedService(int idxService_p, int increment_p){
+    if ( increment_p == 0 ){
+        return;
+    }
+
+    const int nbMovedOld_l = nbMovedByService_m[idxService_p];
+    const int nbMovedNew_l = nbMovedOld_l + increment_p;
+    nbMovedByService_m[idxService_p] = nbMovedNew_l;
+    histoNbMoved_m[nbMovedOld_l]--;
+    histoNbMoved_m[nbMovedNew_l]++;
+
+    if ( nbMovedNew_l > smcCost_m ){
+        smcCost_m = nbMovedNew_l;
+    } else if ( nbMovedOld_l == smcCost_m && histoNbMoved_m[nbMovedOld_l] == 0 ){
+        smcCost_m = nbMovedNew_l;
+    }
+}
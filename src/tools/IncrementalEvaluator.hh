@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef INCREMENTALEVALUATOR_HH
+#define INCREMENTALEVALUATOR_HH
+#include "tools/ConstraintState.hh"
+#include "tools/MachineSweep.hh"
+#include <vector>
+#include <stdint.h>
+#include <boost/shared_ptr.hpp>
+using namespace std;
+
+class ContextBO;
+class InstanceCoreBO;
+class MMCBO;
+
+/**
+ * Evaluateur incremental d'une solution : maintient les consommations par machine
+ * et par ressource (y compris les reservations transient sur les machines initiales),
+ * les termes de balance cost par machine, les sommes PMC et MMC, ainsi que l'histogramme
+ * du nombre de process deplaces par service.
+ *
+ * Cela permet de connaitre en O(R + B) la variation exacte du score lorsqu'on deplace
+ * un unique process, sans reparcourir toute la solution comme le fait le #Checker.
+ *
+ * Les mouvements appliques sont memorises dans un journal afin de pouvoir les annuler.
+ *
+ * Il permet aussi d'evaluer des mouvements composes (swap de 2 process, chaines de 3 process...)
+ * en ne touchant qu'aux machines, services et neighborhoods concernes.
+ *
+ * Attention : la faisabilite des mouvements n'est verifiee que relativement a la solution
+ * courante, qui est donc supposee valide.
+ */
+class IncrementalEvaluator {
+    public:
+        /**
+         * Mouvement elementaire : le process idxP est affecte a la machine idxMachine
+         */
+        struct ProcessMove {
+            int idxP;
+            int idxMachine;
+        };
+
+        /**
+         * @param Le ContextBO decrivant l'instance (il doit survivre a l'evaluateur)
+         * @param La solution a partir de laquelle on evalue les mouvements
+         */
+        IncrementalEvaluator(ContextBO const * pContextBO_p, const vector<int>& sol_p);
+
+        /**
+         * Repart d'une nouvelle solution (et vide le journal)
+         */
+        void reset(const vector<int>& sol_p);
+
+        const vector<int>& getCurrentSol() const;
+
+        /**
+         * Score de la solution courante (identique a Checker::computeScore)
+         */
+        uint64_t getScore() const;
+
+        uint64_t getLoadCost() const;
+        uint64_t getBalanceCost() const;
+        uint64_t getPMC() const;
+        uint64_t getSMC() const;
+        uint64_t getMMC() const;
+
+        /**
+         * Quantite de ressource consommee par les process affectes a la machine
+         * (hors reservations transient)
+         */
+        int getRessUsedOnMachine(int idxRess_p, int idxMachine_p) const;
+
+        /**
+         * Quantite de ressource reservee sur la machine par les process qui
+         * l'ont quittee (non nul uniquement pour les ressources transient)
+         */
+        int getTransientRessUsedOnMachine(int idxRess_p, int idxMachine_p) const;
+
+        /**
+         * Variation du score si on deplacait le process sur la machine donnee
+         * (la solution courante n'est pas modifiee). En O(R + B)
+         */
+        int64_t computeDeltaMove(int idxP_p, int idxMachine_p) const;
+
+        /**
+         * Evalue en une passe le deplacement du process vers chacune des machines (cf #MachineSweep).
+         * Contrairement a MachineSweep::sweep, le terme moveCostDelta inclut ici la variation du SMC :
+         * result_p.getDelta(idxMachine) == computeDeltaMove(idxP_p, idxMachine).
+         * Le masque fit ne tient compte que des capas.
+         */
+        void evaluateAllMachines(int idxP_p, MachineSweep::Result& result_p) const;
+
+        /**
+         * Indique si le deplacement du process respecte les capas (transient compris)
+         * de la machine d'arrivee. En O(R)
+         */
+        bool isCapaOkForMove(int idxP_p, int idxMachine_p) const;
+
+        /**
+         * Indique si le deplacement du process respecte toutes les contraintes
+         */
+        bool isFeasibleMove(int idxP_p, int idxMachine_p) const;
+
+        /**
+         * Deplace le process et memorise le mouvement dans le journal
+         */
+        void applyMove(int idxP_p, int idxMachine_p);
+
+        /**
+         * Evalue un mouvement compose (typiquement de 2 ou 3 process) : verifie qu'il
+         * respecte toutes les contraintes (capa transient comprise, conflit, spread, dependances)
+         * et calcule la variation exacte du score.
+         * La solution courante est inchangee au retour (les mouvements sont joues puis annules)
+         * @param Les mouvements elementaires (un meme process ne doit pas y figurer deux fois)
+         * @param Nombre de mouvements elementaires
+         * @param (out) Variation du score, renseignee meme si le mouvement n'est pas faisable
+         * @return TRUE si la solution obtenue serait valide
+         */
+        bool evaluateCompoundMove(const ProcessMove* pMoves_p, int nbMoves_p, int64_t& delta_p);
+
+        /**
+         * Cas particulier : les deux process echangent leurs machines
+         */
+        bool evaluateSwap(int idxP1_p, int idxP2_p, int64_t& delta_p);
+
+        /**
+         * Cas particulier (shift-swap) : p1 prend la machine de p2, p2 prend celle de p3,
+         * et p3 prend celle de p1
+         */
+        bool evaluateShiftSwap(int idxP1_p, int idxP2_p, int idxP3_p, int64_t& delta_p);
+
+        /**
+         * Applique un mouvement compose ; chaque mouvement elementaire est memorise dans le journal
+         */
+        void applyCompoundMove(const ProcessMove* pMoves_p, int nbMoves_p);
+
+        /**
+         * Annule le dernier mouvement du journal
+         * @return FALSE si le journal etait vide
+         */
+        bool undoLastMove();
+
+        /**
+         * Permet de revenir a un etat anterieur : on annule les mouvements jusqu'a
+         * ce que le journal soit de la taille donnee (cf #getJournalSize)
+         */
+        void rollback(int journalSize_p);
+        int getJournalSize() const;
+
+        /**
+         * Valide les mouvements effectues : ils ne pourront plus etre annules
+         */
+        void clearJournal();
+
+    private:
+        /**
+         * Element du journal : process deplace, et machine qu'il occupait avant le mouvement
+         */
+        struct MoveJournal {
+            int idxP;
+            int idxMachineOld;
+        };
+
+        /**
+         * Deplace effectivement le process, en maintenant toutes les structures
+         */
+        void doMove(int idxP_p, int idxMachine_p);
+
+        /**
+         * Verifie que la solution courante respecte les contraintes pour ce qui
+         * concerne les mouvements donnes (qui viennent d'etre appliques)
+         */
+        bool isValidAfterMoves(const ProcessMove* pMoves_p, const int* pMachinesOld_p, int nbMoves_p) const;
+        bool isCapaOk(int idxMachine_p) const;
+
+        /**
+         * Retire (signe_p = -1) ou ajoute (signe_p = 1) aux totaux les couts de load et de
+         * balance de la machine. On retire avant de modifier ses consommations, et on ajoute apres
+         */
+        void majCostsMachine(int idxMachine_p, int signe_p);
+
+        int64_t computeLoadCost(int idxRess_p, int idxMachine_p, int used_p) const;
+        int64_t computeBalanceCost(int idxBC_p, int idxMachine_p, int used1_p, int used2_p) const;
+
+        /**
+         * Variation du SMC (non pondere) si le nombre de process deplaces du service
+         * variait de deltaMoved_p (-1, 0 ou 1)
+         */
+        int64_t computeDeltaSMC(int idxService_p, int deltaMoved_p) const;
+
+        /**
+         * Incremente (ou decremente) le nombre de process deplaces du service
+         * en maintenant l'histogramme et le max
+         */
+        void majNbMovedService(int idxService_p, int increment_p);
+
+        boost::shared_ptr<InstanceCoreBO const> pCore_m;
+        MMCBO const * pMMCBO_m;
+        MachineSweep sweep_m;
+
+        const int nbRess_m;
+        const int nbMachines_m;
+        const int nbBC_m;
+
+        /**
+         * Donnees de l'instance, lues dans l'#InstanceCoreBO. Les tableaux indexes par (ressource, machine)
+         * sont stockes ressource par ressource : tab[idxRess * nbMachines + idxMachine]
+         */
+        const vector<int>& capa_m;
+        const vector<int>& safetyCapa_m;
+        const vector<int>& weightLoadCost_m;
+        const vector<char>& isTransient_m;
+
+        /**
+         * requirements_m[idxP * nbRess + idxRess]
+         */
+        const vector<int>& requirements_m;
+        const vector<int>& machineInit_m;
+        const vector<int>& service_m;
+        const vector<int>& pmc_m;
+
+        const vector<int>& bcRess1_m;
+        const vector<int>& bcRess2_m;
+        const vector<int>& bcTarget_m;
+        const vector<int>& bcPoids_m;
+
+        /**
+         * Etat de la solution courante
+         */
+        vector<int> currentSol_m;
+        vector<int> used_m;
+        vector<int> transientUsed_m;
+
+        /**
+         * bcCosts_m[idxMachine * nbBC + idxBC] = balance cost (pondere) du couple
+         */
+        vector<int64_t> bcCosts_m;
+
+        /**
+         * nbMovedByService_m[idxService] = nombre de process du service hors de leur machine init
+         * histoNbMoved_m[n] = nombre de services ayant n process deplaces
+         */
+        vector<int> nbMovedByService_m;
+        vector<int> histoNbMoved_m;
+
+        /**
+         * Etat des contraintes de conflit, spread et dependances
+         */
+        ConstraintState constraintState_m;
+
+        int64_t loadCost_m;
+        int64_t balanceCost_m;
+        int64_t pmcCost_m;
+        int64_t smcCost_m;
+        int64_t mmcCost_m;
+
+        vector<MoveJournal> journal_m;
+
+        /**
+         * Machines de depart des process d'un mouvement compose (cf evaluateCompoundMove) :
+         * garde sa capacite d'un appel a l'autre, pour ne pas allouer a chaque evaluation
+         */
+        vector<int> machinesOld_m;
+};
+
+#endif
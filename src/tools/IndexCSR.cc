@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+#include "tools/IndexCSR.hh"
+#include <algorithm>
+using namespace std;
+
+IndexCSR::IndexCSR() :
+    debuts_m(1, 0)
+{}
+
+IndexCSR::IndexCSR(int nbLignes_p, const vector<pair<int, int> >& couples_p) :
+    debuts_m(nbLignes_p + 1, 0),
+    valeurs_m(couples_p.size())
+{
+    //Tri par denombrement sur les lignes, puis tri de chaque ligne
+    for ( vector<pair<int, int> >::const_iterator it_l=couples_p.begin() ; it_l != couples_p.end() ; it_l++ ){
+        debuts_m[it_l->first + 1]++;
+    }
+    for ( int idxLigne_l=0 ; idxLigne_l < nbLignes_p ; idxLigne_l++ ){
+        debuts_m[idxLigne_l + 1] += debuts_m[idxLigne_l];
+    }
+    vector<int> curseurs_l(debuts_m.begin(), debuts_m.end() - 1);
+    for ( vector<pair<int, int> >::const_iterator it_l=couples_p.begin() ; it_l != couples_p.end() ; it_l++ ){
+        valeurs_m[curseurs_l[it_l->first]++] = it_l->second;
+    }
+    for ( int idxLigne_l=0 ; idxLigne_l < nbLignes_p ; idxLigne_l++ ){
+        sort(valeurs_m.begin() + debuts_m[idxLigne_l], valeurs_m.begin() + debuts_m[idxLigne_l + 1]);
+    }
+}
+
+int IndexCSR::getNbLignes() const{
+    return debuts_m.size() - 1;
+}
+
+int IndexCSR::getNbValeurs() const{
+    return valeurs_m.size();
+}
+
+IndexCSR::Plage IndexCSR::getLigne(int idxLigne_p) const{
+    if ( valeurs_m.empty() ){
+        return Plage(0, 0);
+    }
+    const int* pValeurs_l = &valeurs_m[0];
+    return Plage(pValeurs_l + debuts_m[idxLigne_p], pValeurs_l + debuts_m[idxLigne_p + 1]);
+}
+
+int IndexCSR::getTaille(int idxLigne_p) const{
+    return debuts_m[idxLigne_p + 1] - debuts_m[idxLigne_p];
+}
+
+bool IndexCSR::contient(int idxLigne_p, int valeur_p) const{
+    Plage ligne_l = getLigne(idxLigne_p);
+    return binary_search(ligne_l.first, ligne_l.second, valeur_p);
+}
+
+IndexCSR IndexCSR::transpose(int nbColonnes_p) const{
+    vector<pair<int, int> > couples_l;
+    couples_l.reserve(valeurs_m.size());
+    for ( int idxLigne_l=0 ; idxLigne_l < getNbLignes() ; idxLigne_l++ ){
+        for ( int idx_l=debuts_m[idxLigne_l] ; idx_l < debuts_m[idxLigne_l + 1] ; idx_l++ ){
+            couples_l.push_back(make_pair(valeurs_m[idx_l], idxLigne_l));
+        }
+    }
+    return IndexCSR(nbColonnes_p, couples_l);
+}
+
+const vector<int>& IndexCSR::getDebuts() const{
+    return debuts_m;
+}
+
+const vector<int>& IndexCSR::getValeurs() const{
+    return valeurs_m;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+#ifndef INDEXCSR_HH
+#define INDEXCSR_HH
+#include <utility>
+#include <vector>
+
+/**
+ * Index d'adjacence immuable au format CSR (compressed sparse row) : les valeurs associees a la ligne idx
+ * sont valeurs[debuts[idx] .. debuts[idx+1][, triees, dans un seul tableau contigu.
+ *
+ * Les acces ne font aucune allocation : getLigne() renvoie une plage de pointeurs sur le tableau,
+ * utilisable directement avec BOOST_FOREACH. Les plages restent valides tant que l'index existe.
+ */
+class IndexCSR {
+    public:
+        typedef std::pair<const int*, const int*> Plage;
+
+        IndexCSR();
+
+        /**
+         * @param Nombre de lignes
+         * @param Couples (ligne, valeur), dans un ordre quelconque
+         */
+        IndexCSR(int nbLignes_p, const std::vector<std::pair<int, int> >& couples_p);
+
+        int getNbLignes() const;
+        int getNbValeurs() const;
+
+        Plage getLigne(int idxLigne_p) const;
+        int getTaille(int idxLigne_p) const;
+
+        /**
+         * Recherche dichotomique dans la ligne
+         */
+        bool contient(int idxLigne_p, int valeur_p) const;
+
+        /**
+         * @param Nombre de lignes de l'index transpose (toutes les valeurs doivent y etre strictement inferieures)
+         * @return L'index inverse : la ligne v contient les lignes de "this" qui contiennent v
+         */
+        IndexCSR transpose(int nbColonnes_p) const;
+
+        /**
+         * Tableaux bruts, pour les boucles critiques
+         */
+        const std::vector<int>& getDebuts() const;
+        const std::vector<int>& getValeurs() const;
+
+    private:
+        std::vector<int> debuts_m;
+        std::vector<int> valeurs_m;
+};
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "tools/InstanceBinaire.hh"
+#include <cstring>
+#include <fstream>
+
+const char InstanceBinaire::MAGIC[8] = {'R', 'D', 'F', '1', '2', 'B', 'I', 'N'};
+const uint32_t InstanceBinaire::VERSION;
+const uint32_t InstanceBinaire::MARQUEUR_ENDIAN;
+const uint64_t InstanceBinaire::CHECKSUM_INITIAL;
+
+size_t InstanceBinaire::tailleTableau(size_t nbValeurs_p){
+    return (nbValeurs_p * sizeof(int32_t) + 7) & ~static_cast<size_t>(7);
+}
+
+uint64_t InstanceBinaire::tailleCorps(const Entete& entete_p){
+    const uint64_t R_l = entete_p.nbRessources;
+    const uint64_t M_l = entete_p.nbMachines;
+    const uint64_t S_l = entete_p.nbServices;
+    const uint64_t P_l = entete_p.nbProcesses;
+    const uint64_t B_l = entete_p.nbBalanceCosts;
+    return 2 * tailleTableau(R_l)
+        + 2 * tailleTableau(M_l) + 2 * tailleTableau(M_l * R_l) + tailleTableau(M_l * M_l)
+        + tailleTableau(S_l) + tailleTableau(S_l + 1) + tailleTableau(entete_p.nbDependances)
+        + 2 * tailleTableau(P_l) + tailleTableau(P_l * R_l)
+        + 4 * tailleTableau(B_l)
+        + tailleTableau(3);
+}
+
+uint64_t InstanceBinaire::checksum(const char* pCorps_p, size_t tailleCorps_p, uint64_t checksum_p){
+    uint64_t result_l = checksum_p;
+    for ( size_t pos_l=0 ; pos_l < tailleCorps_p ; pos_l += sizeof(uint64_t) ){
+        uint64_t mot_l;
+        memcpy(&mot_l, pCorps_p + pos_l, sizeof(uint64_t));
+        result_l = (result_l ^ mot_l) * 1099511628211ULL;
+    }
+    return result_l;
+}
+
+bool InstanceBinaire::isBinaire(const string& filename_p){
+    ifstream ifs_l(filename_p.c_str(), ios::binary);
+    char magic_l[sizeof(MAGIC)];
+    if ( ! ifs_l.read(magic_l, sizeof(magic_l)) ){
+        return false;
+    }
+    return memcmp(magic_l, MAGIC, sizeof(MAGIC)) == 0;
+}
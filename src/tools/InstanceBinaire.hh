@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef INSTANCEBINAIRE_HH
+#define INSTANCEBINAIRE_HH
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+using namespace std;
+
+/**
+ * Description du format binaire d'instance, partagee par InstanceWriterBinaire et
+ * InstanceReaderBinaire.
+ *
+ * Le fichier commence par une Entete de 64 octets, suivie du corps : une suite de tableaux
+ * d'int32 (ordre des octets de la machine, verifie via marqueurEndian), chacun complete
+ * a un multiple de 8 octets. Le fichier se termine par le checksum du corps (uint64) : place
+ * apres le corps, il permet de l'ecrire au fil de l'eau. Les tableaux sont, dans l'ordre :
+ * - ressources : transient[R], weightLoadCost[R]
+ * - machines : neighborhood[M], location[M], capa[M*R], safetyCapa[M*R], mmc[M*M]
+ * - services : spreadMin[S], debutsDependances[S+1], dependances[nbDependances]
+ * - processes : service[P], requirements[P*R], pmc[P]
+ * - balance costs : ressource1[B], ressource2[B], target[B], poids[B]
+ * - poids : PMC, SMC, MMC
+ *
+ * Les tableaux a deux dimensions sont ranges ligne par ligne (machine ou process majeur)
+ */
+class InstanceBinaire {
+    public:
+        static const char MAGIC[8];
+        static const uint32_t VERSION = 2;
+        static const uint32_t MARQUEUR_ENDIAN = 0x01020304;
+
+        struct Entete {
+            char magic[8];
+            uint32_t version;
+            uint32_t marqueurEndian;
+            int32_t nbRessources;
+            int32_t nbMachines;
+            int32_t nbLocations;
+            int32_t nbNeighborhoods;
+            int32_t nbServices;
+            int32_t nbDependances;
+            int32_t nbProcesses;
+            int32_t nbBalanceCosts;
+            uint64_t tailleCorps;
+            uint64_t reserve;
+        };
+
+        /**
+         * Taille occupee dans le corps par un tableau de nbValeurs_p int32 (padding compris)
+         */
+        static size_t tailleTableau(size_t nbValeurs_p);
+
+        /**
+         * Taille totale du corps decrit par l'entete
+         */
+        static uint64_t tailleCorps(const Entete& entete_p);
+
+        /**
+         * Checksum du corps (FNV-1a par mots de 64 bits). tailleCorps_p doit etre multiple de 8.
+         * Il se calcule par morceaux (multiples de 8 octets) : checksum(b, n2, checksum(a, n1)) est celui
+         * de la concatenation de a et b
+         */
+        static const uint64_t CHECKSUM_INITIAL = 14695981039346656037ULL;
+        static uint64_t checksum(const char* pCorps_p, size_t tailleCorps_p, uint64_t checksum_p = CHECKSUM_INITIAL);
+
+        /**
+         * @return true si le fichier commence par le magic du format binaire
+         */
+        static bool isBinaire(const string& filename_p);
+};
+
+#endif
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "tools/MachineSweep.hh"
+#include "bo/ContextBO.hh"
+#include "bo/InstanceCoreBO.hh"
+#include "bo/MMCBO.hh"
+#include <algorithm>
+using namespace std;
+
+int64_t MachineSweep::Result::getDelta(int idxMachine_p) const {
+    return loadCostDelta[idxMachine_p] + balanceCostDelta[idxMachine_p] + moveCostDelta[idxMachine_p];
+}
+
+MachineSweep::MachineSweep(ContextBO const * pContextBO_p) :
+    pCore_m(pContextBO_p->getInstanceCore()),
+    pMMCBO_m(pCore_m->getMMCBO()),
+    nbRess_m(pCore_m->getNbRessources()),
+    nbMachines_m(pCore_m->getNbMachines()),
+    nbBC_m(pCore_m->getNbBalanceCosts()),
+    poidsPMC_m(pCore_m->getPoidsPMC()),
+    poidsMMC_m(pCore_m->getPoidsMMC()),
+    capa_m(pCore_m->getCapasByRess()),
+    safetyCapa_m(pCore_m->getSafetyCapasByRess()),
+    weightLoadCost_m(pCore_m->getWeightLoadCost()),
+    isTransient_m(pCore_m->getIsTransient()),
+    requirements_m(pCore_m->getRequirements()),
+    machineInit_m(pCore_m->getSolInit()),
+    pmc_m(pCore_m->getPMC()),
+    bcRess1_m(pCore_m->getBCRess1()),
+    bcRess2_m(pCore_m->getBCRess2()),
+    bcTarget_m(pCore_m->getBCTarget()),
+    bcPoids_m(pCore_m->getBCPoids())
+{}
+
+int MachineSweep::getNbMachines() const {
+    return nbMachines_m;
+}
+
+void MachineSweep::initUsage(Usage& usage_p) const {
+    usage_p.used.assign(nbRess_m * nbMachines_m, 0);
+    usage_p.transientUsed.assign(nbRess_m * nbMachines_m, 0);
+
+    for ( int idxP_l=0 ; idxP_l < (int) machineInit_m.size() ; idxP_l++ ){
+        for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+            if ( isTransient_m[idxRess_l] ){
+                usage_p.transientUsed[idxRess_l*nbMachines_m + machineInit_m[idxP_l]] += requirements_m[idxP_l*nbRess_m + idxRess_l];
+            }
+        }
+    }
+}
+
+void MachineSweep::assign(Usage& usage_p, int idxP_p, int idxMachine_p) const {
+    const bool backHome_l = (idxMachine_p == machineInit_m[idxP_p]);
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+        const int req_l = requirements_m[idxP_p*nbRess_m + idxRess_l];
+        usage_p.used[idxRess_l*nbMachines_m + idxMachine_p] += req_l;
+        if ( backHome_l && isTransient_m[idxRess_l] ){
+            usage_p.transientUsed[idxRess_l*nbMachines_m + idxMachine_p] -= req_l;
+        }
+    }
+}
+
+void MachineSweep::unassign(Usage& usage_p, int idxP_p, int idxMachine_p) const {
+    const bool backHome_l = (idxMachine_p == machineInit_m[idxP_p]);
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+        const int req_l = requirements_m[idxP_p*nbRess_m + idxRess_l];
+        usage_p.used[idxRess_l*nbMachines_m + idxMachine_p] -= req_l;
+        if ( backHome_l && isTransient_m[idxRess_l] ){
+            usage_p.transientUsed[idxRess_l*nbMachines_m + idxMachine_p] += req_l;
+        }
+    }
+}
+
+void MachineSweep::sweep(int idxP_p, int idxMachineCur_p, const Usage& usage_p, Result& result_p) const {
+    sweep(idxP_p, idxMachineCur_p, usage_p.used, usage_p.transientUsed, result_p);
+}
+
+void MachineSweep::sweep(int idxP_p, int idxMachineCur_p, const vector<int>& used_p, const vector<int>& transientUsed_p, Result& result_p) const {
+    /* Copie locale : les ecritures dans les resultats (unsigned char) peuvent aliaser this,
+     * nbMachines_m serait relu a chaque tour et les boucles ne seraient pas vectorisables */
+    const int nbMachines_l = nbMachines_m;
+    result_p.fit.assign(nbMachines_l, 1);
+    result_p.loadCostDelta.assign(nbMachines_l, 0);
+    result_p.balanceCostDelta.assign(nbMachines_l, 0);
+    result_p.moveCostDelta.resize(nbMachines_l);
+    if ( nbMachines_l == 0 ){
+        return;
+    }
+
+    unsigned char* pFit_l = &result_p.fit[0];
+    int64_t* pLoad_l = &result_p.loadCostDelta[0];
+    int64_t* pBalance_l = &result_p.balanceCostDelta[0];
+    int64_t* pMove_l = &result_p.moveCostDelta[0];
+
+    /* Ajout du process sur chacune des machines : capa et load cost */
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+        const int req_l = requirements_m[idxP_p*nbRess_m + idxRess_l];
+        if ( req_l == 0 ){
+            continue;
+        }
+
+        const int* pUsed_l = &used_p[idxRess_l*nbMachines_l];
+        const int* pTransient_l = &transientUsed_p[idxRess_l*nbMachines_l];
+        const int* pCapa_l = &capa_m[idxRess_l*nbMachines_l];
+        const int* pSafety_l = &safetyCapa_m[idxRess_l*nbMachines_l];
+        const int64_t weight_l = weightLoadCost_m[idxRess_l];
+
+        for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
+            const int usedNew_l = pUsed_l[idxMachine_l] + req_l;
+            pFit_l[idxMachine_l] &= (usedNew_l + pTransient_l[idxMachine_l] <= pCapa_l[idxMachine_l]);
+            pLoad_l[idxMachine_l] += weight_l * (max(0, usedNew_l - pSafety_l[idxMachine_l]) - max(0, pUsed_l[idxMachine_l] - pSafety_l[idxMachine_l]));
+        }
+    }
+
+    /* Ajout du process sur chacune des machines : balance cost */
+    for ( int idxBC_l=0 ; idxBC_l < nbBC_m ; idxBC_l++ ){
+        const int req1_l = requirements_m[idxP_p*nbRess_m + bcRess1_m[idxBC_l]];
+        const int req2_l = requirements_m[idxP_p*nbRess_m + bcRess2_m[idxBC_l]];
+        if ( req1_l == 0 && req2_l == 0 ){
+            continue;
+        }
+
+        const int* pUsed1_l = &used_p[bcRess1_m[idxBC_l]*nbMachines_l];
+        const int* pUsed2_l = &used_p[bcRess2_m[idxBC_l]*nbMachines_l];
+        const int* pCapa1_l = &capa_m[bcRess1_m[idxBC_l]*nbMachines_l];
+        const int* pCapa2_l = &capa_m[bcRess2_m[idxBC_l]*nbMachines_l];
+        const int64_t target_l = bcTarget_m[idxBC_l];
+        const int64_t poids_l = bcPoids_m[idxBC_l];
+
+        for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
+            const int64_t a1_l = pCapa1_l[idxMachine_l] - pUsed1_l[idxMachine_l];
+            const int64_t a2_l = pCapa2_l[idxMachine_l] - pUsed2_l[idxMachine_l];
+            pBalance_l[idxMachine_l] += poids_l * (max((int64_t) 0, target_l*(a1_l - req1_l) - (a2_l - req2_l))
+                    - max((int64_t) 0, target_l*a1_l - a2_l));
+        }
+    }
+
+    /* Terme PMC + MMC */
+    const int64_t moveCostCur_l = (idxMachineCur_p == -1) ? 0 : computeMoveCost(idxP_p, idxMachineCur_p);
+    for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
+        pMove_l[idxMachine_l] = computeMoveCost(idxP_p, idxMachine_l) - moveCostCur_l;
+    }
+
+    /* Sur sa machine initiale, le process occupe la place qu'il y reservait deja */
+    const int idxMachineInit_l = machineInit_m[idxP_p];
+    if ( idxMachineInit_l != idxMachineCur_p ){
+        pFit_l[idxMachineInit_l] = computeFitInit(idxP_p, used_p, transientUsed_p);
+    }
+
+    /* Retrait du process de sa machine actuelle : c'est le meme pour toutes les machines d'arrivee */
+    if ( idxMachineCur_p != -1 ){
+        int64_t loadRetrait_l = 0;
+        int64_t balanceRetrait_l = 0;
+        computeDeltaOneMachine(idxP_p, idxMachineCur_p, used_p, -1, loadRetrait_l, balanceRetrait_l);
+        for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
+            pLoad_l[idxMachine_l] += loadRetrait_l;
+            pBalance_l[idxMachine_l] += balanceRetrait_l;
+        }
+
+        pFit_l[idxMachineCur_p] = 1;
+        pLoad_l[idxMachineCur_p] = 0;
+        pBalance_l[idxMachineCur_p] = 0;
+        pMove_l[idxMachineCur_p] = 0;
+    }
+}
+
+void MachineSweep::sweepFit(int idxP_p, int idxMachineCur_p, const Usage& usage_p, vector<unsigned char>& fit_p) const {
+    /* Copie locale, cf sweep() */
+    const int nbMachines_l = nbMachines_m;
+    fit_p.assign(nbMachines_l, 1);
+    if ( nbMachines_l == 0 ){
+        return;
+    }
+
+    unsigned char* pFit_l = &fit_p[0];
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+        const int req_l = requirements_m[idxP_p*nbRess_m + idxRess_l];
+        if ( req_l == 0 ){
+            continue;
+        }
+
+        const int* pUsed_l = &usage_p.used[idxRess_l*nbMachines_l];
+        const int* pTransient_l = &usage_p.transientUsed[idxRess_l*nbMachines_l];
+        const int* pCapa_l = &capa_m[idxRess_l*nbMachines_l];
+        for ( int idxMachine_l=0 ; idxMachine_l < nbMachines_l ; idxMachine_l++ ){
+            pFit_l[idxMachine_l] &= (pUsed_l[idxMachine_l] + pTransient_l[idxMachine_l] + req_l <= pCapa_l[idxMachine_l]);
+        }
+    }
+
+    const int idxMachineInit_l = machineInit_m[idxP_p];
+    if ( idxMachineInit_l != idxMachineCur_p ){
+        pFit_l[idxMachineInit_l] = computeFitInit(idxP_p, usage_p.used, usage_p.transientUsed);
+    }
+    if ( idxMachineCur_p != -1 ){
+        pFit_l[idxMachineCur_p] = 1;
+    }
+}
+
+unsigned char MachineSweep::computeFitInit(int idxP_p, const vector<int>& used_p, const vector<int>& transientUsed_p) const {
+    const int idxMachineInit_l = machineInit_m[idxP_p];
+    unsigned char fitInit_l = 1;
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+        const int idx_l = idxRess_l*nbMachines_m + idxMachineInit_l;
+        const int req_l = isTransient_m[idxRess_l] ? 0 : requirements_m[idxP_p*nbRess_m + idxRess_l];
+        fitInit_l &= (used_p[idx_l] + transientUsed_p[idx_l] + req_l <= capa_m[idx_l]);
+    }
+    return fitInit_l;
+}
+
+void MachineSweep::computeDeltaOneMachine(int idxP_p, int idxMachine_p, const vector<int>& used_p, int signe_p, int64_t& load_p, int64_t& balance_p) const {
+    load_p = 0;
+    for ( int idxRess_l=0 ; idxRess_l < nbRess_m ; idxRess_l++ ){
+        const int idx_l = idxRess_l*nbMachines_m + idxMachine_p;
+        const int usedNew_l = used_p[idx_l] + signe_p * requirements_m[idxP_p*nbRess_m + idxRess_l];
+        load_p += (int64_t) weightLoadCost_m[idxRess_l] * (max(0, usedNew_l - safetyCapa_m[idx_l]) - max(0, used_p[idx_l] - safetyCapa_m[idx_l]));
+    }
+
+    balance_p = 0;
+    for ( int idxBC_l=0 ; idxBC_l < nbBC_m ; idxBC_l++ ){
+        const int idx1_l = bcRess1_m[idxBC_l]*nbMachines_m + idxMachine_p;
+        const int idx2_l = bcRess2_m[idxBC_l]*nbMachines_m + idxMachine_p;
+        const int64_t a1_l = capa_m[idx1_l] - used_p[idx1_l];
+        const int64_t a2_l = capa_m[idx2_l] - used_p[idx2_l];
+        const int64_t req1_l = signe_p * requirements_m[idxP_p*nbRess_m + bcRess1_m[idxBC_l]];
+        const int64_t req2_l = signe_p * requirements_m[idxP_p*nbRess_m + bcRess2_m[idxBC_l]];
+        balance_p += bcPoids_m[idxBC_l] * (max((int64_t) 0, bcTarget_m[idxBC_l]*(a1_l - req1_l) - (a2_l - req2_l))
+                - max((int64_t) 0, bcTarget_m[idxBC_l]*a1_l - a2_l));
+    }
+}
+
+int64_t MachineSweep::computeMoveCost(int idxP_p, int idxMachine_p) const {
+    const int idxMachineInit_l = machineInit_m[idxP_p];
+    return poidsPMC_m * pmc_m[idxP_p] * (idxMachine_p != idxMachineInit_l)
+        + poidsMMC_m * pMMCBO_m->getCost(idxMachineInit_l, idxMachine_p);
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef MACHINESWEEP_HH
+#define MACHINESWEEP_HH
+#include <vector>
+#include <stdint.h>
+#include <boost/shared_ptr.hpp>
+
+class ContextBO;
+class InstanceCoreBO;
+class MMCBO;
+
+/**
+ * Evalue en une seule passe un process sur toutes les machines : pour chaque machine,
+ * indique si le process y tient (capa, transient comprise), et la variation des couts
+ * de load, de balance, et du terme PMC + MMC si on l'y deplacait.
+ *
+ * Les donnees sont stockees ressource par ressource (tab[idxRess * nbMachines + idxMachine])
+ * de sorte que les boucles internes parcourent les machines de facon contigue et sans branchement.
+ * Aux options par defaut (-O2, g++ 12) elles ne sont pas vectorisees (types de largeurs differentes,
+ * modele de cout "very-cheap") ; en -O3, celles des capas, du load cost et du retrait le sont.
+ *
+ * Cette classe ne lit que des donnees de l'instance : elle n'est jamais modifiee apres
+ * construction et peut donc etre partagee entre threads. L'etat de la solution (les consommations)
+ * est fourni par l'appelant, au meme format.
+ */
+class MachineSweep {
+    public:
+        /**
+         * Resultat d'un balayage. Les vecteurs sont indexes par machine, et ne sont
+         * realloues que si le nombre de machines change : il est donc conseille de reutiliser
+         * la meme instance d'un appel sur l'autre.
+         */
+        struct Result {
+            /**
+             * 1 si le process tient sur la machine, 0 sinon
+             */
+            std::vector<unsigned char> fit;
+            std::vector<int64_t> loadCostDelta;
+            std::vector<int64_t> balanceCostDelta;
+
+            /**
+             * Variation de poidsPMC * PMC + poidsMMC * MMC (le SMC, qui depend de tout le service, n'est pas inclus)
+             */
+            std::vector<int64_t> moveCostDelta;
+
+            int64_t getDelta(int idxMachine_p) const;
+        };
+
+        /**
+         * Consommations d'une solution (eventuellement partielle), au format attendu par #sweep
+         * Un process non affecte est considere comme ayant quitte sa machine initiale :
+         * il y reserve donc ses ressources transient.
+         */
+        struct Usage {
+            std::vector<int> used;
+            std::vector<int> transientUsed;
+        };
+
+        MachineSweep(ContextBO const * pContextBO_p);
+
+        /**
+         * Initialise les consommations d'une solution ou aucun process n'est affecte
+         */
+        void initUsage(Usage& usage_p) const;
+
+        /**
+         * Met a jour les consommations lorsqu'on affecte le process a une machine,
+         * ou qu'on l'en retire. En O(R)
+         */
+        void assign(Usage& usage_p, int idxP_p, int idxMachine_p) const;
+        void unassign(Usage& usage_p, int idxP_p, int idxMachine_p) const;
+
+        /**
+         * Evalue le deplacement du process vers chacune des machines
+         * @param Le process
+         * @param La machine sur laquelle il se trouve (-1 s'il n'est pas affecte)
+         * @param Les consommations de la solution courante (ressource par ressource)
+         * @param Les reservations transient de la solution courante (meme format)
+         * @param (out) Le resultat
+         */
+        void sweep(int idxP_p, int idxMachineCur_p, const std::vector<int>& used_p, const std::vector<int>& transientUsed_p, Result& result_p) const;
+        void sweep(int idxP_p, int idxMachineCur_p, const Usage& usage_p, Result& result_p) const;
+
+        /**
+         * Comme #sweep, mais ne calcule que le masque fit (pour les rollouts, qui ne lisent pas les couts)
+         * @param (out) fit_p 1 si le process tient sur la machine, 0 sinon
+         */
+        void sweepFit(int idxP_p, int idxMachineCur_p, const Usage& usage_p, std::vector<unsigned char>& fit_p) const;
+
+        int getNbMachines() const;
+
+    private:
+        /**
+         * Le process tient-il sur sa machine initiale, ou il occupe deja la place reservee par ses transients
+         */
+        unsigned char computeFitInit(int idxP_p, const std::vector<int>& used_p, const std::vector<int>& transientUsed_p) const;
+
+        /**
+         * Variation des couts de load et de balance de la machine lorsqu'on y ajoute (signe_p = 1)
+         * ou qu'on en retire (signe_p = -1) le process
+         */
+        void computeDeltaOneMachine(int idxP_p, int idxMachine_p, const std::vector<int>& used_p, int signe_p, int64_t& load_p, int64_t& balance_p) const;
+
+        /**
+         * Terme poidsPMC * PMC + poidsMMC * MMC du process s'il est sur la machine
+         */
+        int64_t computeMoveCost(int idxP_p, int idxMachine_p) const;
+
+        boost::shared_ptr<InstanceCoreBO const> pCore_m;
+        MMCBO const * pMMCBO_m;
+        const int nbRess_m;
+        const int nbMachines_m;
+        const int nbBC_m;
+        const int64_t poidsPMC_m;
+        const int64_t poidsMMC_m;
+
+        /**
+         * Donnees de l'instance, lues dans l'#InstanceCoreBO (capas ressource par ressource)
+         */
+        const std::vector<int>& capa_m;
+        const std::vector<int>& safetyCapa_m;
+        const std::vector<int>& weightLoadCost_m;
+        const std::vector<char>& isTransient_m;
+
+        /**
+         * requirements_m[idxP * nbRess + idxRess]
+         */
+        const std::vector<int>& requirements_m;
+        const std::vector<int>& machineInit_m;
+        const std::vector<int>& pmc_m;
+
+        const std::vector<int>& bcRess1_m;
+        const std::vector<int>& bcRess2_m;
+        const std::vector<int>& bcTarget_m;
+        const std::vector<int>& bcPoids_m;
+};
+
+#endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "tools/MeilleureSolution.hh"
+#include <limits>
+#include <ctime>
+using namespace std;
+
+uint64_t MeilleureSolution::score_m = numeric_limits<uint64_t>::max();
+uint64_t MeilleureSolution::version_m = 0;
+MeilleureSolution::InstantanePtr MeilleureSolution::pInstantane_m;
+boost::shared_ptr<MeilleureSolution::Instantane> MeilleureSolution::pReserve_m;
+pthread_mutex_t MeilleureSolution::mutex_m = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t MeilleureSolution::condPublication_m = PTHREAD_COND_INITIALIZER;
+int MeilleureSolution::nbAttentes_m = 0;
+
+namespace {
+    /**
+     * *pValeur_p = min(*pValeur_p, valeur_p), de maniere atomique
+     */
+    void abaisse(uint64_t* pValeur_p, uint64_t valeur_p){
+        uint64_t courante_l = __sync_fetch_and_add(pValeur_p, 0);
+        while ( valeur_p < courante_l ){
+            const uint64_t lue_l = __sync_val_compare_and_swap(pValeur_p, courante_l, valeur_p);
+            if ( lue_l == courante_l ){
+                return;
+            }
+            courante_l = lue_l;
+        }
+    }
+
+    /**
+     * *pValeur_p = max(*pValeur_p, valeur_p), de maniere atomique
+     */
+    void eleve(uint64_t* pValeur_p, uint64_t valeur_p){
+        uint64_t courante_l = __sync_fetch_and_add(pValeur_p, 0);
+        while ( valeur_p > courante_l ){
+            const uint64_t lue_l = __sync_val_compare_and_swap(pValeur_p, courante_l, valeur_p);
+            if ( lue_l == courante_l ){
+                return;
+            }
+            courante_l = lue_l;
+        }
+    }
+}
+
+uint64_t MeilleureSolution::getScore(){
+    return __sync_fetch_and_add(&score_m, 0);
+}
+
+uint64_t MeilleureSolution::getVersion(){
+    return __sync_fetch_and_add(&version_m, 0);
+}
+
+MeilleureSolution::InstantanePtr MeilleureSolution::getInstantane(){
+    return boost::atomic_load(&pInstantane_m);
+}
+
+bool MeilleureSolution::publie(const vector<int>& sol_p, uint64_t score_p){
+    if ( score_p >= getScore() ){
+        return false;
+    }
+    //L'instantane est construit dans le tampon de reserve : sol garde sa capacite, l'affectation n'alloue pas
+    boost::shared_ptr<Instantane> pNouveau_l = boost::atomic_exchange(&pReserve_m, boost::shared_ptr<Instantane>());
+    if ( ! pNouveau_l ){
+        pNouveau_l.reset(new Instantane);
+    }
+    pNouveau_l->score = score_p;
+    pNouveau_l->sol = sol_p;
+
+    //En cas d'echec du compare-and-swap, pCourant_l est mis a jour avec l'instantane qui l'a emporte
+    InstantanePtr pCourant_l = getInstantane();
+    do {
+        const uint64_t scoreCourant_l = pCourant_l ? pCourant_l->score : numeric_limits<uint64_t>::max();
+        if ( score_p >= scoreCourant_l ){
+            boost::atomic_store(&pReserve_m, pNouveau_l);
+            return false;
+        }
+        pNouveau_l->version = (pCourant_l ? pCourant_l->version : getVersion()) + 1;
+    } while ( ! boost::atomic_compare_exchange(&pInstantane_m, &pCourant_l, InstantanePtr(pNouveau_l)) );
+
+    //L'instantane est visible avant le score et la version : qui voit la nouvelle version lit la nouvelle solution
+    abaisse(&score_m, score_p);
+    eleve(&version_m, pNouveau_l->version);
+
+    //L'instantane remplace n'est plus accessible : s'il n'est plus lu, il sert a la prochaine publication
+    if ( pCourant_l && pCourant_l.unique() ){
+        boost::atomic_store(&pReserve_m, boost::const_pointer_cast<Instantane>(pCourant_l));
+    }
+
+    //La version est ecrite avant de compter les abonnes en attente (cf Abonnement::attend, qui fait l'inverse)
+    __sync_synchronize();
+    if ( __sync_fetch_and_add(&nbAttentes_m, 0) > 0 ){
+        pthread_mutex_lock(&mutex_m);
+        pthread_cond_broadcast(&condPublication_m);
+        pthread_mutex_unlock(&mutex_m);
+    }
+    return true;
+}
+
+#ifdef UTEST
+void MeilleureSolution::reinit(){
+    boost::atomic_store(&pInstantane_m, InstantanePtr());
+    __sync_lock_test_and_set(&score_m, numeric_limits<uint64_t>::max());
+}
+#endif
+
+MeilleureSolution::Abonnement::Abonnement() :
+    versionVue_m(getVersion())
+{}
+
+bool MeilleureSolution::Abonnement::isNouvelle() const{
+    return getVersion() != versionVue_m;
+}
+
+MeilleureSolution::InstantanePtr MeilleureSolution::Abonnement::prends(){
+    InstantanePtr result_l = getInstantane();
+    versionVue_m = result_l ? result_l->version : getVersion();
+    return result_l;
+}
+
+bool MeilleureSolution::Abonnement::attend(int delaiMs_p) const{
+    if ( isNouvelle() ){
+        return true;
+    }
+    timespec echeance_l;
+    clock_gettime(CLOCK_REALTIME, &echeance_l);
+    echeance_l.tv_sec += delaiMs_p / 1000;
+    echeance_l.tv_nsec += (delaiMs_p % 1000) * 1000000L;
+    if ( echeance_l.tv_nsec >= 1000000000L ){
+        echeance_l.tv_sec++;
+        echeance_l.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&mutex_m);
+    __sync_fetch_and_add(&nbAttentes_m, 1);
+    int retour_l = 0;
+    while ( getVersion() == versionVue_m && retour_l == 0 ){
+        retour_l = pthread_cond_timedwait(&condPublication_m, &mutex_m, &echeance_l);
+    }
+    const bool result_l = getVersion() != versionVue_m;
+    __sync_fetch_and_sub(&nbAttentes_m, 1);
+    pthread_mutex_unlock(&mutex_m);
+    return result_l;
+}
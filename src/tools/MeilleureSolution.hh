@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2011 Pierre-Etienne Bougué <pe.bougue(a)gmail.com>
+ * Copyright (c) 2011 Florian Colin <florian.colin28(a)gmail.com>
+ * Copyright (c) 2011 Kamal Fadlaoui <kamal.fadlaoui(a)gmail.com>
+ * Copyright (c) 2011 Quentin Lequy <quentin.lequy(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Pinot <guillaume.pinot(a)tremplin-utc.net>
+ * Copyright (c) 2011 Cédric Royer <cedroyer(a)gmail.com>
+ * Copyright (c) 2011 Guillaume Turri <guillaume.turri(a)gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef MEILLEURESOLUTION_HH
+#define MEILLEURESOLUTION_HH
+#include <boost/shared_ptr.hpp>
+#include <pthread.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Meilleure solution connue, partagee par tous les threads de recherche.
+ *
+ * Le score et le numero de version sont lus sans verrou, de maniere atomique (de quoi rejeter une
+ * solution avant meme de la valider ou de la scorer).
+ * La solution est publiee sous forme d'instantanes immuables, echanges facon RCU : un lecteur garde
+ * le sien aussi longtemps qu'il veut, meme si une meilleure solution est publiee entre temps.
+ * L'echange passe par boost::atomic_load / atomic_compare_exchange sur le shared_ptr, qui prennent
+ * un spinlock (pool de boost) le temps de copier le pointeur : la section critique est tres courte,
+ * mais lectures de l'instantane et publications ne sont pas sans verrou.
+ * Une publication remplit l'instantane dans un tampon de reserve (l'instantane remplace, des que plus
+ * personne ne le lit) avant de l'installer par compare-and-swap.
+ *
+ * Les workers qui tournent longtemps peuvent s'abonner (cf #Abonnement) pour savoir qu'une nouvelle
+ * solution est arrivee, sans relire le fichier de sortie : le test (lecture de la version) ne prend
+ * pas de verrou, seule la prise de l'instantane passe par le spinlock.
+ */
+class MeilleureSolution {
+    public:
+        /**
+         * Solution publiee ; jamais modifiee une fois publiee
+         */
+        struct Instantane {
+            uint64_t score;
+            uint64_t version;
+            std::vector<int> sol;
+        };
+        typedef boost::shared_ptr<const Instantane> InstantanePtr;
+
+        /**
+         * Suit les publications pour un worker : chaque abonnement retient la derniere version qu'il a vue
+         */
+        class Abonnement {
+            public:
+                /**
+                 * La solution connue a la creation est consideree comme vue
+                 */
+                Abonnement();
+
+                /**
+                 * @return true si une solution a ete publiee depuis la derniere vue (une lecture atomique)
+                 */
+                bool isNouvelle() const;
+
+                /**
+                 * @return la solution courante (nulle si aucune n'est connue), desormais consideree comme vue
+                 */
+                InstantanePtr prends();
+
+                /**
+                 * Bloque jusqu'a la publication d'une solution non encore vue, au plus delaiMs_p millisecondes
+                 * @return true si une telle solution est disponible
+                 */
+                bool attend(int delaiMs_p) const;
+
+            private:
+                uint64_t versionVue_m;
+        };
+
+        /**
+         * @return le score de la meilleure solution, "infini" si aucune n'est connue
+         */
+        static uint64_t getScore();
+
+        /**
+         * @return le numero de la derniere solution publiee (0 si aucune)
+         */
+        static uint64_t getVersion();
+
+        /**
+         * @return la meilleure solution (nulle si aucune n'est connue)
+         */
+        static InstantanePtr getInstantane();
+
+        /**
+         * Publie la solution si elle bat strictement la meilleure connue
+         * N'alloue de memoire que si le tampon de reserve est pris (premier appel, publications
+         * simultanees, ou ancien instantane encore lu)
+         * @return true si elle a ete publiee
+         */
+        static bool publie(const std::vector<int>& sol_p, uint64_t score_p);
+
+#ifdef UTEST
+        /**
+         * Oublie la meilleure solution (le numero de version, lui, continue de croitre)
+         */
+        static void reinit();
+#endif
+
+    private:
+        /**
+         * Le score et la version suivent l'instantane, de maniere monotone (minimum et maximum atomiques)
+         */
+        static uint64_t score_m;
+        static uint64_t version_m;
+        static InstantanePtr pInstantane_m;
+
+        /**
+         * Tampon dans lequel la prochaine publication est construite (nul s'il est pris)
+         */
+        static boost::shared_ptr<Instantane> pReserve_m;
+
+        /**
+         * Reveil des abonnes qui attendent (cf Abonnement::attend) : une publication ne prend le verrou
+         * que si #nbAttentes_m est non nul
+         */
+        static pthread_mutex_t mutex_m;
+        static pthread_cond_t condPublication_m;
+        static int nbAttentes_m;
+};
+
+#endif
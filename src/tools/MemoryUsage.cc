@@ -20,14 +20,14 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  *
  */
+#include "tools/MemoryUsage.hh"
+#include <sys/resource.h>
 
-#include "DecisionALG.hh"
-
-
-DecisionALG::DecisionALG()
-{
-}
-
-DecisionALG::~DecisionALG()
-{
+long MemoryUsage::getPeakRSSKo(){
+    struct rusage usage_l;
+    if ( getrusage(RUSAGE_SELF, &usage_l) != 0 ){
+        return 0;
+    }
+    //ru_maxrss est deja exprime en Ko sous Linux
+    return usage_l.ru_maxrss;
 }
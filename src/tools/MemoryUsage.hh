@@ -20,5 +20,16 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  *
  */
+#ifndef MEMORYUSAGE_HH
+#define MEMORYUSAGE_HH
 
-#include "RestrictionALG.hh"
+class MemoryUsage {
+    public:
+        /**
+         * @return Pic de memoire residente (RSS) du processus depuis son lancement, en Ko
+         * (0 si le systeme ne sait pas le fournir)
+         */
+        static long getPeakRSSKo();
+};
+
+#endif
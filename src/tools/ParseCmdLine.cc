@@ -45,7 +45,12 @@ options_description ParseCmdLine::getOptions(){
         ("out,o", value<string>()->default_value("defaultOutfile.txt"), "Nom du fichier a ecrire")
         ("seed,s", value<int>()->default_value(0), "graine du generateur aleatoire")
         ("name", value<string>(), "Affiche l'id de l'equipe")
-        ("strategy", value<string>(), "Nom de la strategy a construire");
+        ("strategy", value<string>(), "Nom de la strategy a construire")
+        ("threads", value<int>()->default_value(1), "nombre de threads pour la verification des solutions")
+        ("loadThreads", value<int>()->default_value(1), "nombre de threads pour la lecture du fichier d'instance")
+        ("mctsPolicy", value<string>()->default_value("ucb1"), "politique de descente de la MCTS (ucb1, ucb1tuned, rang)")
+        ("mctsConstant", value<double>()->default_value(0.1), "constante d'exploration de la politique de descente")
+        ("mctsMaxNodes", value<int>()->default_value(20000000), "nombre max de noeuds de l'arbre de la MCTS (0 : pas de limite)");
 
     return result_l;
 }
@@ -20,32 +20,33 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  *
  */
-
-#ifndef OPPMDECISIONALG_HH
-#define OPPMDECISIONALG_HH
-
-#include "src/alg/MCTS/DecisionALG.hh"
+#ifndef VECTEURTRIE_HH
+#define VECTEURTRIE_HH
+#include <algorithm>
 #include <vector>
 
-class OPPMDecisionALG : public DecisionALG
-{
-    public:
-        typedef int ProcessId;
-        typedef int MachineId;
-        typedef std::vector<MachineId> MachinePool;
-        
-        OPPMDecisionALG();
-        virtual ~OPPMDecisionALG();
-        
-        virtual void setTarget(ProcessId);
-        virtual void setRestrictedSubset(MachinePool const &);
-        
-        virtual RestrictionALG * getRestriction(SolutionALG *) const;
-        virtual bool workOnProcess(ProcessId) const;
-        
-    private:
-        ProcessId target_m;
-        MachinePool subset_m;
-};
+/**
+ * Ensembles d'indices stockes en vecteur trie, a la place d'un unordered_set :
+ * les BO les remplissent par indices croissants, ce qui revient a un push_back
+ */
+namespace VecteurTrie {
+    /**
+     * Insere la valeur si elle est absente
+     */
+    inline void insere(std::vector<int>& vecteur_p, int valeur_p){
+        if ( vecteur_p.empty() || vecteur_p.back() < valeur_p ){
+            vecteur_p.push_back(valeur_p);
+            return;
+        }
+        std::vector<int>::iterator it_l = std::lower_bound(vecteur_p.begin(), vecteur_p.end(), valeur_p);
+        if ( *it_l != valeur_p ){
+            vecteur_p.insert(it_l, valeur_p);
+        }
+    }
+
+    inline bool contient(const std::vector<int>& vecteur_p, int valeur_p){
+        return std::binary_search(vecteur_p.begin(), vecteur_p.end(), valeur_p);
+    }
+}
 
 #endif